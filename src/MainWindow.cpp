@@ -10,6 +10,7 @@
 #include "DistributedLoadDialog.h"
 #include "RestraintDialog.h"
 #include "SceneController.h"
+#include "app/DatModelReader.h"
 #include "app/UndoRedoService.h"
 #include "ui/MainWindowPresenter.h"
 
@@ -38,7 +39,6 @@
 #include <QFile>
 #include <QTextStream>
 #include <QStandardPaths>
-#include <QRegularExpression>
 #include <QLocale>
 #include <QDir>
 #include <QFrame>
@@ -51,6 +51,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <vector>
 
 #include <QVTKOpenGLNativeWidget.h>
 
@@ -86,9 +87,6 @@ MainWindow::MainWindow(QWidget *parent)
     presenterDeps.sections = &m_sections;
     presenterDeps.lastMaterialId = &m_lastMaterialId;
     presenterDeps.lastSectionId = &m_lastSectionId;
-    presenterDeps.supports = &m_supports;
-    presenterDeps.nodalLoads = &m_nodalLoads;
-    presenterDeps.memberLoads = &m_memberLoads;
     presenterDeps.lastNodalPreset = &m_lastNodalPreset;
     presenterDeps.lastDistributedPreset = &m_lastDistributedPreset;
     m_presenter = new Structura::UI::MainWindowPresenter(presenterDeps, this);
@@ -188,12 +186,12 @@ MainWindow::MainWindow(QWidget *parent)
 
     m_sceneController->initialize(m_vtkWidget);
     connect(m_selectionModel, &Structura::SelectionModel::selectionChanged, this,
-            [this](const QSet<QUuid> &nodes, const QSet<QUuid> &bars) {
+            [this]() {
                 if (!m_sceneController) {
                     return;
                 }
-                m_sceneController->setSelectedNodes(nodes);
-                m_sceneController->setSelectedBars(bars);
+                m_sceneController->setSelectedNodes(m_selectionModel->selectedNodes());
+                m_sceneController->setSelectedBars(m_selectionModel->selectedBars());
                 refreshPropertiesPanel();
                 updateStatus();
                 updateLoadActionsEnabled();
@@ -482,74 +480,59 @@ void MainWindow::refreshPropertiesPanel()
     }
     m_propertiesPanel->setSectionOptions(sectionOptions);
 
-    const QSet<QUuid> nodeIds = m_selectionModel ? m_selectionModel->selectedNodes() : QSet<QUuid>();
-    const QSet<QUuid> barIds = m_selectionModel ? m_selectionModel->selectedBars() : QSet<QUuid>();
-
-    m_propertiesPanel->setNodeEntries(buildNodeEntries(nodeIds));
-    m_propertiesPanel->setBarEntries(buildBarEntries(barIds));
+    if (m_selectionModel) {
+        m_propertiesPanel->setNodeEntries(buildNodeEntries(m_selectionModel->selectedNodes()));
+        m_propertiesPanel->setBarEntries(buildBarEntries(m_selectionModel->selectedBars()));
+    } else {
+        m_propertiesPanel->setNodeEntries({});
+        m_propertiesPanel->setBarEntries({});
+    }
     updateGridInfoOnPanel();
     updateLoadActionsEnabled();
 }
 
-QVector<PropertiesPanel::NodeEntry> MainWindow::buildNodeEntries(const QSet<QUuid> &nodeIds) const
+QVector<PropertiesPanel::NodeEntry> MainWindow::buildNodeEntries(const std::vector<Structura::Model::NodeHandle> &nodes) const
 {
     QVector<PropertiesPanel::NodeEntry> entries;
-    if (!m_sceneController) {
+    if (!m_sceneController || nodes.empty()) {
         return entries;
     }
-    for (const QUuid &id : nodeIds) {
-        const SceneController::Node *node = m_sceneController->findNode(id);
+
+    const auto &model = m_sceneController->model();
+    for (const auto &handle : nodes) {
+        const SceneController::Node *node = model.node(handle);
         if (!node) {
             continue;
         }
         PropertiesPanel::NodeEntry entry;
-        entry.id = id;
+        entry.id = node->id();
         entry.externalId = node->externalId();
         const auto pos = node->position();
         entry.x = pos[0];
         entry.y = pos[1];
         entry.z = pos[2];
-        entry.restraints.fill(false);
-        for (const auto &support : m_supports) {
-            if (support.nodeId == entry.externalId) {
-                for (int i = 0; i < 6; ++i) {
-                    entry.restraints[static_cast<std::size_t>(i)] = support.restraints[i];
-                }
-                break;
-            }
-        }
-        int loadCount = 0;
-        for (const auto &load : m_nodalLoads) {
-            if (load.nodeId == entry.externalId) {
-                ++loadCount;
-            }
-        }
-        entry.loadCount = loadCount;
+        entry.restraints = node->restraints();
+        entry.loadCount = static_cast<int>(model.nodalLoadsAtNode(entry.id).size());
         entries.append(entry);
     }
     return entries;
 }
 
-QVector<PropertiesPanel::BarEntry> MainWindow::buildBarEntries(const QSet<QUuid> &barIds) const
+QVector<PropertiesPanel::BarEntry> MainWindow::buildBarEntries(const std::vector<Structura::Model::BarHandle> &bars) const
 {
     QVector<PropertiesPanel::BarEntry> entries;
     if (!m_sceneController) {
         return entries;
     }
 
-    const auto nodeInfos = m_sceneController->nodeInfos();
-    QHash<QUuid, SceneController::NodeInfo> nodeMap;
-    for (const auto &info : nodeInfos) {
-        nodeMap.insert(info.id, info);
-    }
-
-    for (const QUuid &id : barIds) {
-        const SceneController::Bar *bar = m_sceneController->findBar(id);
+    const auto &model = m_sceneController->model();
+    for (const auto &handle : bars) {
+        const SceneController::Bar *bar = model.bar(handle);
         if (!bar) {
             continue;
         }
         PropertiesPanel::BarEntry entry;
-        entry.id = id;
+        entry.id = bar->id();
         entry.externalId = bar->externalId();
         entry.materialId = bar->materialId();
         entry.sectionId = bar->sectionId();
@@ -559,36 +542,55 @@ QVector<PropertiesPanel::BarEntry> MainWindow::buildBarEntries(const QSet<QUuid>
         const auto sectionInfo = findSection(entry.sectionId);
         entry.sectionName = sectionInfo ? sectionInfo->name : tr("Sem secao");
 
-        QVector3D startPos;
-        QVector3D endPos;
-        bool hasStart = false;
-        bool hasEnd = false;
-        auto startIt = nodeMap.constFind(bar->startNodeId());
-        if (startIt != nodeMap.constEnd()) {
-            entry.nodeI = startIt.value().externalId;
-            startPos = QVector3D(startIt.value().x, startIt.value().y, startIt.value().z);
-            hasStart = true;
-        }
-        auto endIt = nodeMap.constFind(bar->endNodeId());
-        if (endIt != nodeMap.constEnd()) {
-            entry.nodeJ = endIt.value().externalId;
-            endPos = QVector3D(endIt.value().x, endIt.value().y, endIt.value().z);
-            hasEnd = true;
+        const auto ends = model.barEndNodes(handle);
+        const SceneController::Node *start = model.node(ends[0]);
+        const SceneController::Node *end = model.node(ends[1]);
+        if (start) {
+            entry.nodeI = start->externalId();
         }
-        entry.length = (hasStart && hasEnd) ? (startPos - endPos).length() : 0.0;
-        int distributedLoads = 0;
-        for (const auto &load : m_memberLoads) {
-            if (load.memberId == entry.externalId) {
-                ++distributedLoads;
-            }
+        if (end) {
+            entry.nodeJ = end->externalId();
         }
-        entry.distributedLoadCount = distributedLoads;
+        entry.length = (start && end) ? start->position().distanceTo(end->position()) : 0.0;
+        entry.distributedLoadCount = static_cast<int>(model.memberLoadsOnBar(entry.id).size());
 
         entries.append(entry);
     }
     return entries;
 }
 
+QVector<QUuid> MainWindow::selectedNodeIds() const
+{
+    QVector<QUuid> ids;
+    if (!m_selectionModel || !m_sceneController) {
+        return ids;
+    }
+    const auto &model = m_sceneController->model();
+    ids.reserve(static_cast<int>(m_selectionModel->selectedNodes().size()));
+    for (const auto &handle : m_selectionModel->selectedNodes()) {
+        if (const auto *node = model.node(handle)) {
+            ids.append(node->id());
+        }
+    }
+    return ids;
+}
+
+QVector<QUuid> MainWindow::selectedBarIds() const
+{
+    QVector<QUuid> ids;
+    if (!m_selectionModel || !m_sceneController) {
+        return ids;
+    }
+    const auto &model = m_sceneController->model();
+    ids.reserve(static_cast<int>(m_selectionModel->selectedBars().size()));
+    for (const auto &handle : m_selectionModel->selectedBars()) {
+        if (const auto *bar = model.bar(handle)) {
+            ids.append(bar->id());
+        }
+    }
+    return ids;
+}
+
 void MainWindow::updateGridInfoOnPanel()
 {
     if (!m_propertiesPanel || !m_sceneController) {
@@ -934,64 +936,50 @@ void MainWindow::syncLoadVisuals()
         return;
     }
 
-    const auto nodeInfos = m_sceneController->nodeInfos();
-    QHash<int, SceneController::NodeInfo> nodesByExternal;
-    nodesByExternal.reserve(nodeInfos.size());
-    QHash<QUuid, SceneController::NodeInfo> nodesById;
-    nodesById.reserve(nodeInfos.size());
-    for (const auto &info : nodeInfos) {
-        nodesByExternal.insert(info.externalId, info);
-        nodesById.insert(info.id, info);
-    }
-
+    const auto &model = m_sceneController->model();
+    const auto nodalLoads = model.nodalLoads();
     QVector<SceneController::NodalLoadVisual> nodalVisuals;
-    nodalVisuals.reserve(m_nodalLoads.size());
-    for (const auto &load : m_nodalLoads) {
-        const auto it = nodesByExternal.constFind(load.nodeId);
-        if (it == nodesByExternal.constEnd()) {
+    nodalVisuals.reserve(static_cast<int>(nodalLoads.size()));
+    for (const auto &load : nodalLoads) {
+        const SceneController::Node *node = model.findNodePtr(load.nodeId());
+        if (!node) {
             continue;
         }
+        const auto &force = load.force();
+        const auto &moment = load.moment();
         SceneController::NodalLoadVisual visual;
-        visual.position = QVector3D(static_cast<float>(it->x), static_cast<float>(it->y), static_cast<float>(it->z));
-        visual.force = QVector3D(static_cast<float>(load.fx), static_cast<float>(load.fy), static_cast<float>(load.fz));
-        visual.moment = QVector3D(static_cast<float>(load.mx), static_cast<float>(load.my), static_cast<float>(load.mz));
+        visual.position = QVector3D(static_cast<float>(node->x()), static_cast<float>(node->y()), static_cast<float>(node->z()));
+        visual.force = QVector3D(static_cast<float>(force.x()), static_cast<float>(force.y()), static_cast<float>(force.z()));
+        visual.moment = QVector3D(static_cast<float>(moment.x()), static_cast<float>(moment.y()), static_cast<float>(moment.z()));
         nodalVisuals.append(visual);
     }
     m_sceneController->setNodalLoadVisuals(nodalVisuals);
 
-    const auto barInfos = m_sceneController->bars();
-    QHash<int, SceneController::BarInfo> barsByExternal;
-    barsByExternal.reserve(barInfos.size());
-    for (const auto &info : barInfos) {
-        if (info.externalId > 0) {
-            barsByExternal.insert(info.externalId, info);
-        }
-    }
-
+    const auto memberLoads = model.memberLoads();
     QVector<SceneController::MemberLoadVisual> memberVisuals;
-    memberVisuals.reserve(m_memberLoads.size());
-    for (const auto &load : m_memberLoads) {
-        const auto barIt = barsByExternal.constFind(load.memberId);
-        if (barIt == barsByExternal.constEnd()) {
+    memberVisuals.reserve(static_cast<int>(memberLoads.size()));
+    for (const auto &load : memberLoads) {
+        const SceneController::Bar *bar = model.findBarPtr(load.barId());
+        if (!bar) {
             continue;
         }
 
-        const auto startNodeIt = nodesById.constFind(barIt->startNodeId);
-        const auto endNodeIt = nodesById.constFind(barIt->endNodeId);
-        if (startNodeIt == nodesById.constEnd() || endNodeIt == nodesById.constEnd()) {
+        const SceneController::Node *startNode = model.findNodePtr(bar->startNodeId());
+        const SceneController::Node *endNode = model.findNodePtr(bar->endNodeId());
+        if (!startNode || !endNode) {
             continue;
         }
 
-        const QVector3D start(static_cast<float>(startNodeIt->x), static_cast<float>(startNodeIt->y), static_cast<float>(startNodeIt->z));
-        const QVector3D end(static_cast<float>(endNodeIt->x), static_cast<float>(endNodeIt->y), static_cast<float>(endNodeIt->z));
+        const QVector3D start(static_cast<float>(startNode->x()), static_cast<float>(startNode->y()), static_cast<float>(startNode->z()));
+        const QVector3D end(static_cast<float>(endNode->x()), static_cast<float>(endNode->y()), static_cast<float>(endNode->z()));
         const QVector3D barVector = end - start;
         if (barVector.lengthSquared() < 1e-6f) {
             continue;
         }
 
-        QVector3D loadVector(static_cast<float>(load.qx), static_cast<float>(load.qy), static_cast<float>(load.qz));
-        const bool isLocal = load.system.compare(QStringLiteral("LOCAL"), Qt::CaseInsensitive) == 0
-            || load.system.compare(QStringLiteral("L"), Qt::CaseInsensitive) == 0;
+        const auto &q = load.intensity();
+        QVector3D loadVector(static_cast<float>(q.x()), static_cast<float>(q.y()), static_cast<float>(q.z()));
+        const bool isLocal = load.system() == SceneController::MemberLoad::System::Local;
         if (isLocal) {
             QVector3D xDir = barVector.normalized();
             QVector3D reference(0.0f, 0.0f, 1.0f);
@@ -1012,9 +1000,9 @@ void MainWindow::syncLoadVisuals()
                 zDir = QVector3D(0.0f, 0.0f, 1.0f);
             }
             zDir.normalize();
-            loadVector = static_cast<float>(load.qx) * xDir
-                       + static_cast<float>(load.qy) * yDir
-                       + static_cast<float>(load.qz) * zDir;
+            loadVector = static_cast<float>(q.x()) * xDir
+                       + static_cast<float>(q.y()) * yDir
+                       + static_cast<float>(q.z()) * zDir;
         }
 
         if (loadVector.lengthSquared() < 1e-6f) {
@@ -1053,33 +1041,18 @@ void MainWindow::syncSupportVisuals()
         return;
     }
 
-    const auto nodeInfos = m_sceneController->nodeInfos();
-    QHash<int, SceneController::NodeInfo> nodesByExternal;
-    nodesByExternal.reserve(nodeInfos.size());
-    for (const auto &info : nodeInfos) {
-        nodesByExternal.insert(info.externalId, info);
-    }
-
+    const auto supportedNodes = m_sceneController->model().supportedNodes();
     QVector<SceneController::SupportVisual> supportVisuals;
-    supportVisuals.reserve(m_supports.size());
+    supportVisuals.reserve(static_cast<int>(supportedNodes.size()));
     
-    for (const auto &support : m_supports) {
-        const auto it = nodesByExternal.constFind(support.nodeId);
-        if (it == nodesByExternal.constEnd()) {
-            continue;
-        }
-        
+    for (const auto &node : supportedNodes) {
         SceneController::SupportVisual visual;
         visual.position = QVector3D(
-            static_cast<float>(it->x),
-            static_cast<float>(it->y),
-            static_cast<float>(it->z)
+            static_cast<float>(node.x()),
+            static_cast<float>(node.y()),
+            static_cast<float>(node.z())
         );
-        
-        for (int i = 0; i < 6; ++i) {
-            visual.restraints[i] = support.restraints[i];
-        }
-        
+        visual.restraints = node.restraints();
         supportVisuals.append(visual);
     }
     
@@ -1335,8 +1308,8 @@ void MainWindow::updateGridActionsEnabled()
 void MainWindow::updateLoadActionsEnabled()
 {
     const bool hasSelection = (m_selectionModel != nullptr);
-    const bool hasNodeSelection = hasSelection && !m_selectionModel->selectedNodes().isEmpty();
-    const bool hasBarSelection = hasSelection && !m_selectionModel->selectedBars().isEmpty();
+    const bool hasNodeSelection = hasSelection && !selectedNodeIds().isEmpty();
+    const bool hasBarSelection = hasSelection && !selectedBarIds().isEmpty();
     if (m_applyNodalLoadAction) {
         m_applyNodalLoadAction->setEnabled(hasNodeSelection);
     }
@@ -1531,7 +1504,7 @@ void MainWindow::onApplyNodalLoad()
         return;
     }
 
-    const QSet<QUuid> selectedNodes = m_selectionModel->selectedNodes();
+    const QVector<QUuid> selectedNodes = selectedNodeIds();
     if (selectedNodes.isEmpty()) {
         QMessageBox::information(this, tr("Forca concentrada (nos)"),
                                  tr("Selecione ao menos um no para aplicar a carga."));
@@ -1557,19 +1530,20 @@ void MainWindow::onApplyNodalLoad()
     bool changed = false;
     int affected = 0;
 
+    const auto &model = m_sceneController->model();
     for (const QUuid &nodeId : selectedNodes) {
-        const SceneController::Node *node = m_sceneController->findNode(nodeId);
-        if (!node) {
+        if (!model.findNodePtr(nodeId)) {
             continue;
         }
-        const int externalId = node->externalId();
-        const int beforeCount = m_nodalLoads.size();
-        m_nodalLoads.erase(std::remove_if(m_nodalLoads.begin(), m_nodalLoads.end(),
-                                          [externalId](const NodalLoad &load) {
-                                              return load.nodeId == externalId;
-                                          }),
-                           m_nodalLoads.end());
-        const bool hadPrevious = beforeCount != m_nodalLoads.size();
+        // A node carries at most one load: replace what is there
+        std::vector<QUuid> previous;
+        for (const auto &load : model.nodalLoadsAtNode(nodeId)) {
+            previous.push_back(load.id());
+        }
+        for (const QUuid &loadId : previous) {
+            m_sceneController->removeNodalLoad(loadId);
+        }
+        const bool hadPrevious = !previous.empty();
 
         if (removeLoad) {
             if (hadPrevious) {
@@ -1579,15 +1553,11 @@ void MainWindow::onApplyNodalLoad()
             continue;
         }
 
-        NodalLoad record;
-        record.nodeId = externalId;
-        record.fx = values.fx;
-        record.fy = values.fy;
-        record.fz = values.fz;
-        record.mx = values.mx;
-        record.my = values.my;
-        record.mz = values.mz;
-        m_nodalLoads.append(record);
+        m_sceneController->addNodalLoad(SceneController::NodalLoad(QUuid::createUuid(),
+                                                                   m_sceneController->loadCaseId(),
+                                                                   nodeId,
+                                                                   Structura::Model::Vector3(values.fx, values.fy, values.fz),
+                                                                   Structura::Model::Vector3(values.mx, values.my, values.mz)));
         changed = true;
         ++affected;
     }
@@ -1622,7 +1592,7 @@ void MainWindow::onApplyDistributedLoad()
         return;
     }
 
-    const QSet<QUuid> selectedBars = m_selectionModel->selectedBars();
+    const QVector<QUuid> selectedBars = selectedBarIds();
     if (selectedBars.isEmpty()) {
         QMessageBox::information(this, tr("Carga distribuida (barras)"),
                                  tr("Selecione ao menos uma barra para aplicar a carga."));
@@ -1656,23 +1626,22 @@ void MainWindow::onApplyDistributedLoad()
     bool changed = false;
     int affected = 0;
 
+    const auto &model = m_sceneController->model();
+    const auto loadSystem = system == QLatin1String("LOCAL") ? SceneController::MemberLoad::System::Local
+                                                             : SceneController::MemberLoad::System::Global;
     for (const QUuid &barId : selectedBars) {
-        SceneController::Bar *bar = m_sceneController->findBar(barId);
-        if (!bar) {
+        if (!model.findBarPtr(barId)) {
             continue;
         }
-        const int externalId = bar->externalId();
-        if (externalId <= 0) {
-            continue;
+        // A bar carries at most one distributed load: replace what is there
+        std::vector<QUuid> previous;
+        for (const auto &load : model.memberLoadsOnBar(barId)) {
+            previous.push_back(load.id());
         }
-
-        const int beforeCount = m_memberLoads.size();
-        m_memberLoads.erase(std::remove_if(m_memberLoads.begin(), m_memberLoads.end(),
-                                           [externalId](const MemberLoad &load) {
-                                               return load.memberId == externalId;
-                                           }),
-                            m_memberLoads.end());
-        const bool hadPrevious = beforeCount != m_memberLoads.size();
+        for (const QUuid &loadId : previous) {
+            m_sceneController->removeMemberLoad(loadId);
+        }
+        const bool hadPrevious = !previous.empty();
 
         if (removeLoad) {
             if (hadPrevious) {
@@ -1682,13 +1651,11 @@ void MainWindow::onApplyDistributedLoad()
             continue;
         }
 
-        MemberLoad record;
-        record.memberId = externalId;
-        record.system = system;
-        record.qx = values.qx;
-        record.qy = values.qy;
-        record.qz = values.qz;
-        m_memberLoads.append(record);
+        m_sceneController->addMemberLoad(SceneController::MemberLoad(QUuid::createUuid(),
+                                                                     m_sceneController->loadCaseId(),
+                                                                     barId,
+                                                                     Structura::Model::Vector3(values.qx, values.qy, values.qz),
+                                                                     loadSystem));
         changed = true;
         ++affected;
     }
@@ -1721,7 +1688,7 @@ void MainWindow::onApplyRestraints()
         return;
     }
 
-    const QSet<QUuid> selectedNodes = m_selectionModel->selectedNodes();
+    const QVector<QUuid> selectedNodes = selectedNodeIds();
     if (selectedNodes.isEmpty()) {
         QMessageBox::information(this, tr("Restricoes nodais"),
                                  tr("Selecione ao menos um no para aplicar restricoes."));
@@ -1773,42 +1740,9 @@ void MainWindow::onApplyRestraints()
     // Apply restraints to all selected nodes
     int affected = 0;
     for (const QUuid &nodeId : selectedNodes) {
-        SceneController::Node *node = m_sceneController->findNode(nodeId);
-        if (!node) {
-            continue;
+        if (m_sceneController->setNodeRestraints(nodeId, newRestraints)) {
+            ++affected;
         }
-        
-        for (int i = 0; i < 6; ++i) {
-            node->setRestraint(i, newRestraints[i]);
-        }
-        
-        // Update support visualization
-        const int externalId = node->externalId();
-        m_supports.erase(std::remove_if(m_supports.begin(), m_supports.end(),
-                                        [externalId](const NodeSupport &sup) {
-                                            return sup.nodeId == externalId;
-                                        }),
-                         m_supports.end());
-        
-        // Only add to m_supports if at least one restraint is active
-        bool hasAnyRestraint = false;
-        for (bool r : newRestraints) {
-            if (r) {
-                hasAnyRestraint = true;
-                break;
-            }
-        }
-        
-        if (hasAnyRestraint) {
-            NodeSupport support;
-            support.nodeId = externalId;
-            for (int i = 0; i < 6; ++i) {
-                support.restraints[i] = newRestraints[i];
-            }
-            m_supports.append(support);
-        }
-        
-        ++affected;
     }
     
     // Update visualization
@@ -1878,11 +1812,11 @@ bool MainWindow::eventFilter(QObject *obj, QEvent *event)
         const auto toDisplay = [&](const QPoint &p) -> QPoint {
             return QPoint(p.x(), m_sceneController->viewportHeight() - 1 - p.y());
         };
-        const auto pickNodeAt = [&](const QPoint &p) -> QUuid {
+        const auto pickNodeAt = [&](const QPoint &p) -> Structura::Model::NodeHandle {
             const QPoint disp = toDisplay(p);
             return m_sceneController->pickNode(disp.x(), disp.y());
         };
-        const auto pickBarAt = [&](const QPoint &p) -> QUuid {
+        const auto pickBarAt = [&](const QPoint &p) -> Structura::Model::BarHandle {
             const QPoint disp = toDisplay(p);
             return m_sceneController->pickBar(disp.x(), disp.y());
         };
@@ -1911,9 +1845,9 @@ bool MainWindow::eventFilter(QObject *obj, QEvent *event)
                 } else {
                     setHoverInsertPoint(std::nullopt);
                 }
-                const QUuid nodeId = pickNodeAt(mm->pos());
-                if (!nodeId.isNull()) {
-                    m_sceneController->setHighlightedNode(nodeId);
+                const Structura::Model::NodeHandle node = pickNodeAt(mm->pos());
+                if (node.isValid()) {
+                    m_sceneController->setHighlightedNode(node);
                 } else {
                     m_sceneController->clearHighlightedNode();
                 }
@@ -1934,9 +1868,9 @@ bool MainWindow::eventFilter(QObject *obj, QEvent *event)
             switch (event->type()) {
             case QEvent::MouseMove: {
                 auto *mm = static_cast<QMouseEvent *>(event);
-                const QUuid nodeId = pickNodeAt(mm->pos());
-                if (!nodeId.isNull()) {
-                    m_sceneController->setHighlightedNode(nodeId);
+                const Structura::Model::NodeHandle node = pickNodeAt(mm->pos());
+                if (node.isValid()) {
+                    m_sceneController->setHighlightedNode(node);
                 } else {
                     m_sceneController->clearHighlightedNode();
                 }
@@ -1945,11 +1879,13 @@ bool MainWindow::eventFilter(QObject *obj, QEvent *event)
             case QEvent::MouseButtonPress: {
                 auto *me = static_cast<QMouseEvent *>(event);
                 if (me->button() == Qt::LeftButton) {
-                    const QUuid pickedNode = pickNodeAt(me->pos());
-                    if (!pickedNode.isNull()) {
+                    const Structura::Model::NodeHandle pickedHandle = pickNodeAt(me->pos());
+                    const SceneController::Node *picked = m_sceneController->model().node(pickedHandle);
+                    if (picked) {
+                        const QUuid pickedNode = picked->id();
                         if (m_command == Command::InsertBarFirst) {
                             m_firstBarNodeId = pickedNode;
-                            m_sceneController->setHighlightedNode(pickedNode);
+                            m_sceneController->setHighlightedNode(pickedHandle);
                             setCommand(Command::InsertBarSecond);
                         } else {
                             if (pickedNode == m_firstBarNodeId) {
@@ -2196,9 +2132,9 @@ bool MainWindow::eventFilter(QObject *obj, QEvent *event)
             switch (event->type()) {
             case QEvent::MouseMove: {
                 auto *mm = static_cast<QMouseEvent *>(event);
-                const QUuid nodeId = pickNodeAt(mm->pos());
-                if (!nodeId.isNull()) {
-                    m_sceneController->setHighlightedNode(nodeId);
+                const Structura::Model::NodeHandle node = pickNodeAt(mm->pos());
+                if (node.isValid()) {
+                    m_sceneController->setHighlightedNode(node);
                 } else {
                     m_sceneController->clearHighlightedNode();
                 }
@@ -2210,8 +2146,8 @@ bool MainWindow::eventFilter(QObject *obj, QEvent *event)
                     return false;
                 }
 
-                const QUuid nodeId = pickNodeAt(me->pos());
-                const QUuid barId = nodeId.isNull() ? pickBarAt(me->pos()) : QUuid();
+                const Structura::Model::NodeHandle node = pickNodeAt(me->pos());
+                const Structura::Model::BarHandle bar = node.isValid() ? Structura::Model::BarHandle() : pickBarAt(me->pos());
 
                 Structura::SelectionModel::Mode mode = Structura::SelectionModel::Mode::Replace;
                 if (me->modifiers().testFlag(Qt::ControlModifier)) {
@@ -2220,12 +2156,12 @@ bool MainWindow::eventFilter(QObject *obj, QEvent *event)
                     mode = Structura::SelectionModel::Mode::Add;
                 }
 
-                if (!nodeId.isNull()) {
-                    m_selectionModel->selectNode(nodeId, mode);
+                if (node.isValid()) {
+                    m_selectionModel->selectNode(node, mode);
                     return true;
                 }
-                if (!barId.isNull()) {
-                    m_selectionModel->selectBar(barId, mode);
+                if (bar.isValid()) {
+                    m_selectionModel->selectBar(bar, mode);
                     return true;
                 }
 
@@ -2453,9 +2389,6 @@ void MainWindow::resetModel()
     }
     m_materials.clear();
     m_sections.clear();
-    m_supports.clear();
-    m_nodalLoads.clear();
-    m_memberLoads.clear();
     m_lastMaterialId = QUuid();
     m_lastSectionId = QUuid();
     m_lastNodalPreset = {};
@@ -2471,240 +2404,86 @@ bool MainWindow::loadFromDat(const QString &filePath)
         QMessageBox::critical(this, tr("Erro"), tr("Nao foi possivel abrir %1").arg(QDir::toNativeSeparators(filePath)));
         return false;
     }
+    const QByteArray contents = file.readAll();
+    file.close();
 
-    QTextStream stream(&file);
-    stream.setLocale(QLocale::c());
-
-    enum class Section { None, Materials, Sections, Nodes, Members, NodalLoads, MemberLoads };
-    Section current = Section::None;
-
-    QVector<MaterialInfo> materialsTmp;
-    QVector<SectionInfo> sectionsTmp;
-    struct LoadedNode {
-        int id;
-        double x;
-        double y;
-        double z;
-        std::array<int, 6> restraints;
-    };
-    QVector<LoadedNode> nodesTmp;
-    struct LoadedMember {
-        int id;
-        int nodeI;
-        int nodeJ;
-        int materialId;
-        int sectionId;
-    };
-    QVector<LoadedMember> membersTmp;
-    QVector<NodeSupport> supportsTmp;
-    QVector<NodalLoad> nodalLoadsTmp;
-    QVector<MemberLoad> memberLoadsTmp;
-
-    int lineNumber = 0;
-    QRegularExpression whitespace("\\s+");
-
-    auto toInt = [&](const QString &token, bool *ok = nullptr) -> int {
-        bool localOk = false;
-        int value = token.toInt(&localOk);
-        if (ok) *ok = localOk;
-        return value;
-    };
-
-    auto toDouble = [&](const QString &token, bool *ok = nullptr) -> double {
-        bool localOk = false;
-        double value = token.toDouble(&localOk);
-        if (ok) *ok = localOk;
-        return value;
-    };
-
-    while (!stream.atEnd()) {
-        const QString line = stream.readLine();
-        ++lineNumber;
-        const QString trimmed = line.trimmed();
-
-        if (trimmed.isEmpty() || trimmed.startsWith(QLatin1Char('#'))) {
-            continue;
-        }
-
-        if (trimmed.startsWith(QLatin1Char('['))) {
-            if (trimmed.compare("[MATERIALS]", Qt::CaseInsensitive) == 0) {
-                current = Section::Materials;
-            } else if (trimmed.compare("[SECTIONS]", Qt::CaseInsensitive) == 0) {
-                current = Section::Sections;
-            } else if (trimmed.compare("[NODES]", Qt::CaseInsensitive) == 0) {
-                current = Section::Nodes;
-            } else if (trimmed.compare("[MEMBERS]", Qt::CaseInsensitive) == 0) {
-                current = Section::Members;
-            } else if (trimmed.compare("[NODAL_LOADS]", Qt::CaseInsensitive) == 0) {
-                current = Section::NodalLoads;
-            } else if (trimmed.compare("[MEMBER_LOADS]", Qt::CaseInsensitive) == 0) {
-                current = Section::MemberLoads;
-            } else {
-                current = Section::None;
-            }
-            continue;
-        }
+    // Read into a model of its own so a bad file leaves the scene untouched
+    Structura::App::InMemoryModelRepository model;
+    const QUuid loadCaseId = QUuid::createUuid();
+    model.addLoadCase(Structura::Model::LoadCase(loadCaseId, 1, tr("Caso 1")));
+    const Structura::App::DatReadResult result = Structura::App::readDatModel(contents, model, loadCaseId);
 
-        QStringList parts = trimmed.split(whitespace, Qt::SkipEmptyParts);
-        if (parts.isEmpty()) {
-            continue;
-        }
-
-        bool ok = false;
-        switch (current) {
-        case Section::Materials: {
-            if (parts.size() < 3) {
-                QMessageBox::warning(this, tr("Erro"), tr("Linha de material invalida (%1)").arg(lineNumber));
-                return false;
-            }
-            MaterialInfo mat;
-            mat.uuid = QUuid::createUuid();
-            mat.externalId = toInt(parts[0], &ok);
-            if (!ok) {
-                QMessageBox::warning(this, tr("Erro"), tr("ID de material invalido na linha %1").arg(lineNumber));
-                return false;
-            }
-            mat.name = tr("Material %1").arg(mat.externalId);
-            mat.youngModulus = toDouble(parts[1], &ok);
-            if (!ok) {
-                QMessageBox::warning(this, tr("Erro"), tr("Valor de E invalido na linha %1").arg(lineNumber));
-                return false;
-            }
-            mat.shearModulus = toDouble(parts[2], &ok);
-            if (!ok) {
-                QMessageBox::warning(this, tr("Erro"), tr("Valor de G invalido na linha %1").arg(lineNumber));
-                return false;
-            }
-            materialsTmp.append(mat);
-            break;
-        }
-        case Section::Sections: {
-            if (parts.size() < 5) {
-                QMessageBox::warning(this, tr("Erro"), tr("Linha de secao invalida (%1)").arg(lineNumber));
-                return false;
-            }
-            SectionInfo sec;
-            sec.uuid = QUuid::createUuid();
-            sec.externalId = toInt(parts[0], &ok);
-            if (!ok) {
-                QMessageBox::warning(this, tr("Erro"), tr("ID de secao invalido na linha %1").arg(lineNumber));
-                return false;
-            }
-            sec.name = tr("Secao %1").arg(sec.externalId);
-            sec.area = toDouble(parts[1], &ok);
-            sec.iz = toDouble(parts[2], &ok);
-            sec.iy = toDouble(parts[3], &ok);
-            sec.j = toDouble(parts[4], &ok);
-            if (!ok) {
-                QMessageBox::warning(this, tr("Erro"), tr("Valores da secao invalidos na linha %1").arg(lineNumber));
-                return false;
-            }
-            sectionsTmp.append(sec);
-            break;
-        }
-        case Section::Nodes: {
-            if (parts.size() < 10) {
-                QMessageBox::warning(this, tr("Erro"), tr("Linha de no invalida (%1)").arg(lineNumber));
-                return false;
-            }
-            LoadedNode node;
-            node.id = toInt(parts[0], &ok);
-            if (!ok) {
-                QMessageBox::warning(this, tr("Erro"), tr("ID de no invalido na linha %1").arg(lineNumber));
-                return false;
-            }
-            node.x = toDouble(parts[1], &ok);
-            node.y = toDouble(parts[2], &ok);
-            node.z = toDouble(parts[3], &ok);
-            if (!ok) {
-                QMessageBox::warning(this, tr("Erro"), tr("Coordenadas invalidas na linha %1").arg(lineNumber));
-                return false;
-            }
-            for (int i = 0; i < 6; ++i) {
-                node.restraints[i] = (i + 4 < parts.size()) ? toInt(parts[4 + i], &ok) : 0;
-                if (!ok) {
-                    node.restraints[i] = 0;
-                }
-            }
-            nodesTmp.append(node);
-            break;
-        }
-        case Section::Members: {
-            if (parts.size() < 5) {
-                QMessageBox::warning(this, tr("Erro"), tr("Linha de barra invalida (%1)").arg(lineNumber));
-                return false;
-            }
-            LoadedMember member;
-            member.id = toInt(parts[0], &ok);
-            member.nodeI = toInt(parts[1], &ok);
-            member.nodeJ = toInt(parts[2], &ok);
-            member.materialId = toInt(parts[3], &ok);
-            member.sectionId = toInt(parts[4], &ok);
-            if (!ok) {
-                QMessageBox::warning(this, tr("Erro"), tr("Linha de barra invalida (%1)").arg(lineNumber));
-                return false;
-            }
-            membersTmp.append(member);
-            break;
-        }
-        case Section::NodalLoads: {
-            if (parts.size() < 7) {
-                // allow blank data lines
-                break;
-            }
-            NodalLoad load;
-            load.nodeId = toInt(parts[0], &ok);
-            if (!ok) break;
-            load.fx = toDouble(parts[1], &ok);
-            load.fy = toDouble(parts[2], &ok);
-            load.fz = toDouble(parts[3], &ok);
-            load.mx = toDouble(parts[4], &ok);
-            load.my = toDouble(parts[5], &ok);
-            load.mz = toDouble(parts[6], &ok);
-            nodalLoadsTmp.append(load);
-            break;
-        }
-        case Section::MemberLoads: {
-            if (parts.size() < 5) {
-                break;
-            }
-            MemberLoad load;
-            load.memberId = toInt(parts[0], &ok);
-            if (!ok) break;
-            load.system = parts[1].toUpper();
-            load.qx = toDouble(parts[2], &ok);
-            load.qy = toDouble(parts[3], &ok);
-            load.qz = toDouble(parts[4], &ok);
-            memberLoadsTmp.append(load);
-            break;
-        }
-        case Section::None:
-        default:
-            break;
-        }
+    using Structura::App::DatReadError;
+    QString error;
+    switch (result.error) {
+    case DatReadError::None:
+        break;
+    case DatReadError::InvalidMaterialLine:
+        error = tr("Linha de material invalida (%1)").arg(result.line);
+        break;
+    case DatReadError::InvalidMaterialId:
+        error = tr("ID de material invalido na linha %1").arg(result.line);
+        break;
+    case DatReadError::InvalidYoungModulus:
+        error = tr("Valor de E invalido na linha %1").arg(result.line);
+        break;
+    case DatReadError::InvalidShearModulus:
+        error = tr("Valor de G invalido na linha %1").arg(result.line);
+        break;
+    case DatReadError::InvalidSectionLine:
+        error = tr("Linha de secao invalida (%1)").arg(result.line);
+        break;
+    case DatReadError::InvalidSectionId:
+        error = tr("ID de secao invalido na linha %1").arg(result.line);
+        break;
+    case DatReadError::InvalidSectionValues:
+        error = tr("Valores da secao invalidos na linha %1").arg(result.line);
+        break;
+    case DatReadError::InvalidNodeLine:
+        error = tr("Linha de no invalida (%1)").arg(result.line);
+        break;
+    case DatReadError::InvalidNodeId:
+        error = tr("ID de no invalido na linha %1").arg(result.line);
+        break;
+    case DatReadError::InvalidCoordinates:
+        error = tr("Coordenadas invalidas na linha %1").arg(result.line);
+        break;
+    case DatReadError::InvalidMemberLine:
+        error = tr("Linha de barra invalida (%1)").arg(result.line);
+        break;
     }
-
-    file.close();
-
-    // Build supports from node data
-    supportsTmp.clear();
-    for (const auto &node : nodesTmp) {
-        NodeSupport support;
-        support.nodeId = node.id;
-        for (int i = 0; i < 6; ++i) {
-            support.restraints[i] = node.restraints[i] != 0;
-        }
-        supportsTmp.append(support);
+    if (!result.ok()) {
+        QMessageBox::warning(this, tr("Erro"), error);
+        return false;
+    }
+    for (int memberId : result.danglingMembers) {
+        QMessageBox::warning(this, tr("Erro"), tr("Barra %1 referencia nos inexistentes").arg(memberId));
     }
 
     resetModel();
 
-    m_materials = materialsTmp;
-    m_sections = sectionsTmp;
-    m_supports = supportsTmp;
-    m_nodalLoads = nodalLoadsTmp;
-    m_memberLoads = memberLoadsTmp;
-
+    m_materials.reserve(static_cast<int>(model.materialCount()));
+    for (const auto &material : model.materials()) {
+        MaterialInfo mat;
+        mat.uuid = material.id();
+        mat.externalId = material.externalId();
+        mat.name = tr("Material %1").arg(mat.externalId);
+        mat.youngModulus = material.youngModulus();
+        mat.shearModulus = material.shearModulus();
+        m_materials.append(mat);
+    }
+    m_sections.reserve(static_cast<int>(model.sectionCount()));
+    for (const auto &section : model.sections()) {
+        SectionInfo sec;
+        sec.uuid = section.id();
+        sec.externalId = section.externalId();
+        sec.name = tr("Secao %1").arg(sec.externalId);
+        sec.area = section.area();
+        sec.iz = section.iz();
+        sec.iy = section.iy();
+        sec.j = section.torsionalConstant();
+        m_sections.append(sec);
+    }
     if (!m_materials.isEmpty()) {
         m_lastMaterialId = m_materials.first().uuid;
     }
@@ -2712,50 +2491,7 @@ bool MainWindow::loadFromDat(const QString &filePath)
         m_lastSectionId = m_sections.first().uuid;
     }
 
-    // maps for lookup
-    QHash<int, QUuid> materialMap;
-    for (MaterialInfo &mat : m_materials) {
-        materialMap.insert(mat.externalId, mat.uuid);
-        if (mat.name.trimmed().isEmpty()) {
-            mat.name = tr("Material %1").arg(mat.externalId);
-        }
-    }
-    QHash<int, QUuid> sectionMap;
-    for (SectionInfo &sec : m_sections) {
-        sectionMap.insert(sec.externalId, sec.uuid);
-        if (sec.name.trimmed().isEmpty()) {
-            sec.name = tr("Secao %1").arg(sec.externalId);
-        }
-    }
-
-    QHash<int, QUuid> nodeUuidMap;
-    for (const auto &node : nodesTmp) {
-        const QUuid uuid = m_sceneController->addPointWithId(node.x, node.y, node.z, node.id);
-        nodeUuidMap.insert(node.id, uuid);
-        
-        // Apply restraints to the node
-        SceneController::Node *sceneNode = m_sceneController->findNode(uuid);
-        if (sceneNode) {
-            for (int i = 0; i < 6; ++i) {
-                sceneNode->setRestraint(i, node.restraints[i] != 0);
-            }
-        }
-    }
-
-    for (const auto &member : membersTmp) {
-        const QUuid startId = nodeUuidMap.value(member.nodeI);
-        const QUuid endId = nodeUuidMap.value(member.nodeJ);
-        if (startId.isNull() || endId.isNull()) {
-            QMessageBox::warning(this, tr("Erro"), tr("Barra %1 referencia nos inexistentes").arg(member.id));
-            continue;
-        }
-        const QUuid materialUuid = materialMap.value(member.materialId);
-        const QUuid sectionUuid = sectionMap.value(member.sectionId);
-        const QUuid barId = m_sceneController->addBar(startId, endId, materialUuid, sectionUuid);
-        if (!barId.isNull()) {
-            m_sceneController->setBarExternalId(barId, member.id);
-        }
-    }
+    m_sceneController->setModel(std::move(model));
 
     syncLoadVisuals();
     syncSupportVisuals();
@@ -2848,23 +2584,7 @@ bool MainWindow::saveToDat(const QString &filePath)
         return a.externalId < b.externalId;
     });
 
-    QVector<NodeSupport> supports = m_supports;
-    // ensure support entries for all nodes
-    for (const auto &node : sortedNodes) {
-        bool found = false;
-        for (const auto &sup : supports) {
-            if (sup.nodeId == node.externalId) {
-                found = true;
-                break;
-            }
-        }
-        if (!found) {
-            NodeSupport sup{};
-            sup.nodeId = node.externalId;
-            sup.restraints[0] = sup.restraints[1] = sup.restraints[2] = sup.restraints[3] = sup.restraints[4] = sup.restraints[5] = false;
-            supports.append(sup);
-        }
-    }
+    const auto &model = m_sceneController->model();
 
     auto members = bars;
     std::sort(members.begin(), members.end(), [](const SceneController::BarInfo &a, const SceneController::BarInfo &b) {
@@ -2889,12 +2609,10 @@ bool MainWindow::saveToDat(const QString &filePath)
     stream << "# ID    X (m)    Y (m)    Z (m)    UX  UY  UZ  RX  RY  RZ\n";
     for (const auto &node : sortedNodes) {
         int restraints[6] = {0,0,0,0,0,0};
-        for (const auto &sup : supports) {
-            if (sup.nodeId == node.externalId) {
-                for (int i = 0; i < 6; ++i) {
-                    restraints[i] = sup.restraints[i] ? 1 : 0;
-                }
-                break;
+        if (const SceneController::Node *modelNode = model.findNodePtr(node.id)) {
+            const std::uint8_t mask = modelNode->restraintMask();
+            for (int i = 0; i < 6; ++i) {
+                restraints[i] = (mask >> i) & 1u;
             }
         }
         stream << QString::asprintf("%-8d %10.6f %10.6f %10.6f    %d   %d   %d   %d   %d   %d\n",
@@ -2928,21 +2646,34 @@ bool MainWindow::saveToDat(const QString &filePath)
 
     stream << "[NODAL_LOADS]\n";
     stream << "# Node_ID   Fx (N)    Fy (N)   Fz (N)   Mx (Nm)   My (Nm)   Mz (Nm)\n";
-    for (const auto &load : m_nodalLoads) {
+    for (const auto &load : model.nodalLoads()) {
+        const auto nodeIt = nodeInfoMap.constFind(load.nodeId());
+        if (nodeIt == nodeInfoMap.constEnd()) {
+            continue;
+        }
+        const auto &force = load.force();
+        const auto &moment = load.moment();
         stream << QString::asprintf("%-8d %10.6f %10.6f %10.6f %10.6f %10.6f %10.6f\n",
-                                     load.nodeId, load.fx, load.fy, load.fz, load.mx, load.my, load.mz);
+                                     nodeIt.value().externalId,
+                                     force.x(), force.y(), force.z(),
+                                     moment.x(), moment.y(), moment.z());
     }
     stream << "\n";
 
     stream << "[MEMBER_LOADS]\n";
     stream << "# Formato: Member_ID  Sistema(Local/Global)  qx (N/m)  qy (N/m)  qz (N/m)\n";
     stream << "# Sistemas aceitos: LOCAL, GLOBAL (ou L/G)\n";
-    for (const auto &load : m_memberLoads) {
-        QByteArray systemBytes = load.system.isEmpty() ? QByteArray("LOCAL") : load.system.toUpper().toLatin1();
+    for (const auto &load : model.memberLoads()) {
+        const SceneController::Bar *bar = model.findBarPtr(load.barId());
+        if (!bar) {
+            continue;
+        }
+        const char *system = load.system() == SceneController::MemberLoad::System::Local ? "LOCAL" : "GLOBAL";
+        const auto &q = load.intensity();
         stream << QString::asprintf("%-12d %-10s %12.6f %12.6f %12.6f\n",
-                                     load.memberId,
-                                     systemBytes.constData(),
-                                     load.qx, load.qy, load.qz);
+                                     bar->externalId(),
+                                     system,
+                                     q.x(), q.y(), q.z());
     }
 
     file.close();
@@ -3030,8 +2761,8 @@ void MainWindow::updateStatus()
         break;
     default:
     {
-        const int nodeCount = m_selectionModel ? m_selectionModel->selectedNodes().size() : 0;
-        const int barCount = m_selectionModel ? m_selectionModel->selectedBars().size() : 0;
+        const int nodeCount = selectedNodeIds().size();
+        const int barCount = selectedBarIds().size();
         if (nodeCount > 0 || barCount > 0) {
             showStatusMessage(tr("Selecionados: %1 no(s), %2 barra(s)").arg(nodeCount).arg(barCount));
         } else {
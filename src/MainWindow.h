@@ -79,9 +79,6 @@ private:
     using Presenter = Structura::UI::MainWindowPresenter;
     using MaterialInfo = Presenter::MaterialInfo;
     using SectionInfo = Presenter::SectionInfo;
-    using NodeSupport = Presenter::NodeSupport;
-    using NodalLoad = Presenter::NodalLoad;
-    using MemberLoad = Presenter::MemberLoad;
     using NodalLoadPreset = Presenter::NodalLoadPreset;
     using DistributedLoadPreset = Presenter::DistributedLoadPreset;
 
@@ -137,8 +134,10 @@ private:
     void setupRightToolColumn();
     void ensurePropertiesPanel();
     void refreshPropertiesPanel();
-    QVector<PropertiesPanel::NodeEntry> buildNodeEntries(const QSet<QUuid> &nodeIds) const;
-    QVector<PropertiesPanel::BarEntry> buildBarEntries(const QSet<QUuid> &barIds) const;
+    QVector<PropertiesPanel::NodeEntry> buildNodeEntries(const std::vector<Structura::Model::NodeHandle> &nodes) const;
+    QVector<PropertiesPanel::BarEntry> buildBarEntries(const std::vector<Structura::Model::BarHandle> &bars) const;
+    QVector<QUuid> selectedNodeIds() const;
+    QVector<QUuid> selectedBarIds() const;
     void updateGridInfoOnPanel();
     bool computeWorldPointForInsert(const QPoint &widgetPos, double &x, double &y, double &z, bool applySnap) const;
     void setHoverInsertPoint(const std::optional<QVector3D> &point);
@@ -216,9 +215,6 @@ private:
     QVector<SectionInfo> m_sections;
     QUuid m_lastMaterialId;
     QUuid m_lastSectionId;
-    QVector<NodeSupport> m_supports;
-    QVector<NodalLoad> m_nodalLoads;
-    QVector<MemberLoad> m_memberLoads;
     NodalLoadPreset m_lastNodalPreset;
     DistributedLoadPreset m_lastDistributedPreset;
 
@@ -209,12 +209,12 @@ void SceneController::clearNodes()
         m_pointColors->Modified();
     }
 
-    m_nodes.clear();
+    m_model.clearNodes();
     m_nodePointIds.clear();
-    m_pointIdToNodeId.clear();
-    m_nodeIndexById.clear();
-    m_highlightNodeId = QUuid();
-    m_selectedNodeIds.clear();
+    m_pointIdToNode.clear();
+    m_highlightNode = {};
+    m_selectedNodes.clear();
+    m_selectedNodeSet.clear();
     m_nextNodeExternalId = 1;
 
     m_points->Modified();
@@ -236,9 +236,11 @@ void SceneController::clearBars()
         m_barColors->Modified();
     }
 
-    m_bars.clear();
-    m_barIndexById.clear();
-    m_selectedBarIds.clear();
+    m_model.clearBars();
+    m_barCellIds.clear();
+    m_cellIdToBar.clear();
+    m_selectedBars.clear();
+    m_selectedBarSet.clear();
 
     m_barData->Modified();
 }
@@ -287,6 +289,7 @@ void SceneController::clearGrid()
 
 void SceneController::clearLoads()
 {
+    resetLoadCase();
     m_nodalLoadVisuals.clear();
     m_memberLoadVisuals.clear();
 
@@ -341,6 +344,7 @@ SceneController::SceneController(QObject *parent)
     initializeGridGhostRendering();
     initializeBarLcsRendering();
     initializePickers();
+    resetLoadCase();
 }
 
 SceneController::~SceneController() = default;
@@ -408,23 +412,10 @@ QUuid SceneController::addPointWithId(double x, double y, double z, int external
         }
     }
 
-    const vtkIdType pointId = m_points->InsertNextPoint(x, y, z);
-    m_vertices->InsertNextCell(1);
-    m_vertices->InsertCellPoint(pointId);
-
     QUuid nodeId = QUuid::createUuid();
-    Node node(nodeId, externalId, x, y, z);
-    m_nodes.push_back(node);
-    m_nodePointIds.push_back(pointId);
-
-    if (static_cast<std::size_t>(pointId + 1) > m_pointIdToNodeId.size()) {
-        m_pointIdToNodeId.resize(static_cast<std::size_t>(pointId) + 1);
-    }
-    m_pointIdToNodeId[static_cast<std::size_t>(pointId)] = nodeId;
-    m_nodeIndexById.insert(nodeId, static_cast<int>(m_nodes.size()) - 1);
-
+    m_model.addNode(Node(nodeId, externalId, x, y, z));
+    insertNodePoint(m_model.nodeCount() - 1);
     if (m_pointColors) {
-        m_pointColors->InsertNextTypedTuple(m_defaultNodeColor);
         m_pointColors->Modified();
         m_pointCloud->GetPointData()->SetScalars(m_pointColors);
     }
@@ -983,6 +974,32 @@ std::optional<QUuid> SceneController::nearestGridLineId(GridLine::Axis axis,
     return bestId;
 }
 
+bool SceneController::addNodalLoad(const NodalLoad &load)
+{
+    if (!m_model.findNodePtr(load.nodeId())) {
+        return false;
+    }
+    return m_model.addNodalLoad(load);
+}
+
+bool SceneController::removeNodalLoad(const QUuid &loadId)
+{
+    return m_model.removeNodalLoad(loadId);
+}
+
+bool SceneController::addMemberLoad(const MemberLoad &load)
+{
+    if (!m_model.findBarPtr(load.barId())) {
+        return false;
+    }
+    return m_model.addMemberLoad(load);
+}
+
+bool SceneController::removeMemberLoad(const QUuid &loadId)
+{
+    return m_model.removeMemberLoad(loadId);
+}
+
 void SceneController::setNodalLoadVisuals(const QVector<NodalLoadVisual> &visuals)
 {
     m_nodalLoadVisuals = visuals;
@@ -1138,14 +1155,15 @@ bool SceneController::worldPointOnViewPlane(int displayX, int displayY, double &
 
 int SceneController::nodeCount() const
 {
-    return static_cast<int>(m_nodes.size());
+    return static_cast<int>(m_model.nodeCount());
 }
 
 std::vector<SceneController::NodeInfo> SceneController::nodeInfos() const
 {
     std::vector<NodeInfo> result;
-    result.reserve(m_nodes.size());
-    for (const auto &node : m_nodes) {
+    const auto nodes = m_model.nodes();
+    result.reserve(nodes.size());
+    for (const auto &node : nodes) {
         const auto pos = node.position();
         result.push_back(NodeInfo{ node.id(), node.externalId(), pos[0], pos[1], pos[2] });
     }
@@ -1154,70 +1172,57 @@ std::vector<SceneController::NodeInfo> SceneController::nodeInfos() const
 
 const SceneController::Node *SceneController::findNode(const QUuid &id) const
 {
-    const int index = nodeIndex(id);
-    if (index < 0) {
-        return nullptr;
-    }
-    return &m_nodes[static_cast<std::size_t>(index)];
+    return m_model.findNodePtr(id);
 }
 
-SceneController::Node *SceneController::findNode(const QUuid &id)
-{
-    const int index = nodeIndex(id);
-    if (index < 0) {
-        return nullptr;
-    }
-    return &m_nodes[static_cast<std::size_t>(index)];
-}
-
-QUuid SceneController::pickNode(int displayX, int displayY) const
+Structura::Model::NodeHandle SceneController::pickNode(int displayX, int displayY) const
 {
     if (!m_nodePicker || !m_renderer) {
         return {};
     }
     if (m_nodePicker->Pick(displayX, displayY, 0.0, m_renderer)) {
         vtkIdType pid = m_nodePicker->GetPointId();
-        if (pid >= 0 && pid < static_cast<vtkIdType>(m_pointIdToNodeId.size())) {
-            return m_pointIdToNodeId[static_cast<std::size_t>(pid)];
+        if (pid >= 0 && pid < static_cast<vtkIdType>(m_pointIdToNode.size())) {
+            return m_pointIdToNode[static_cast<std::size_t>(pid)];
         }
     }
     return {};
 }
 
-QUuid SceneController::pickBar(int displayX, int displayY) const
+Structura::Model::BarHandle SceneController::pickBar(int displayX, int displayY) const
 {
     if (!m_barPicker || !m_renderer) {
         return {};
     }
     if (m_barPicker->Pick(displayX, displayY, 0.0, m_renderer)) {
         vtkIdType cid = m_barPicker->GetCellId();
-        if (cid >= 0 && cid < static_cast<vtkIdType>(m_bars.size())) {
-            return m_bars[static_cast<std::size_t>(cid)].id();
+        if (cid >= 0 && cid < static_cast<vtkIdType>(m_cellIdToBar.size())) {
+            return m_cellIdToBar[static_cast<std::size_t>(cid)];
         }
     }
     return {};
 }
 
-void SceneController::setHighlightedNode(const QUuid &nodeId)
+void SceneController::setHighlightedNode(Structura::Model::NodeHandle node)
 {
     if (!m_pointColors) {
         return;
     }
 
-    if (nodeId == m_highlightNodeId) {
+    if (node == m_highlightNode) {
         return;
     }
 
-    if (!m_highlightNodeId.isNull()) {
-        if (m_selectedNodeIds.contains(m_highlightNodeId)) {
-            applyNodeColor(m_highlightNodeId, m_selectedNodeColor);
+    if (m_highlightNode.isValid()) {
+        if (m_selectedNodeSet.contains(m_highlightNode)) {
+            applyNodeColor(m_highlightNode, m_selectedNodeColor);
         } else {
-            applyNodeColor(m_highlightNodeId, m_defaultNodeColor);
+            applyNodeColor(m_highlightNode, m_defaultNodeColor);
         }
     }
-    m_highlightNodeId = nodeId;
-    if (!m_highlightNodeId.isNull()) {
-        applyNodeColor(m_highlightNodeId, m_hoverNodeColor);
+    m_highlightNode = node;
+    if (m_highlightNode.isValid()) {
+        applyNodeColor(m_highlightNode, m_hoverNodeColor);
     }
 
     m_pointColors->Modified();
@@ -1227,40 +1232,40 @@ void SceneController::setHighlightedNode(const QUuid &nodeId)
 
 void SceneController::clearHighlightedNode()
 {
-    setHighlightedNode(QUuid());
+    setHighlightedNode({});
 }
 
-void SceneController::setSelectedNodes(const QSet<QUuid> &nodeIds)
+void SceneController::setSelectedNodes(const std::vector<Structura::Model::NodeHandle> &nodes)
 {
-    if (!m_pointColors) {
-        m_selectedNodeIds = nodeIds;
+    if (m_selectedNodes == nodes) {
         return;
     }
 
-    if (m_selectedNodeIds == nodeIds) {
-        return;
+    Structura::Model::EntityHandleSet<Structura::Model::Node> selected;
+    for (const auto &node : nodes) {
+        selected.insert(node);
     }
 
-    for (const QUuid &id : m_selectedNodeIds) {
-        if (nodeIds.contains(id)) {
-            continue;
+    if (m_pointColors) {
+        for (const auto &node : m_selectedNodes) {
+            if (selected.contains(node) || node == m_highlightNode) {
+                continue;
+            }
+            applyNodeColor(node, m_defaultNodeColor);
         }
-        if (id == m_highlightNodeId) {
-            continue;
+        for (const auto &node : nodes) {
+            if (m_selectedNodeSet.contains(node) || node == m_highlightNode) {
+                continue;
+            }
+            applyNodeColor(node, m_selectedNodeColor);
         }
-        applyNodeColor(id, m_defaultNodeColor);
     }
 
-    for (const QUuid &id : nodeIds) {
-        if (id == m_highlightNodeId) {
-            continue;
-        }
-        if (!m_selectedNodeIds.contains(id)) {
-            applyNodeColor(id, m_selectedNodeColor);
-        }
+    m_selectedNodes = nodes;
+    m_selectedNodeSet = std::move(selected);
+    if (!m_pointColors) {
+        return;
     }
-
-    m_selectedNodeIds = nodeIds;
     m_pointColors->Modified();
     m_pointCloud->Modified();
     requestRender();
@@ -1283,11 +1288,11 @@ bool SceneController::updateNodePositions(const QVector<QUuid> &nodeIds, const Q
     bool changed = false;
     for (int i = 0; i < nodeIds.size(); ++i) {
         const QUuid &id = nodeIds.at(i);
-        const int idx = nodeIndex(id);
-        if (idx < 0 || static_cast<std::size_t>(idx) >= m_nodePointIds.size()) {
+        const vtkIdType pointId = nodePointId(id);
+        if (pointId < 0) {
             continue;
         }
-        Node &node = m_nodes[static_cast<std::size_t>(idx)];
+        Node node = *m_model.findNodePtr(id);
         const QVector3D pos = positions.at(i);
         const auto current = node.position();
         if (qFuzzyCompare(current[0] + 1.0, pos.x() + 1.0) &&
@@ -1296,9 +1301,9 @@ bool SceneController::updateNodePositions(const QVector<QUuid> &nodeIds, const Q
             continue;
         }
 
-        const vtkIdType pointId = m_nodePointIds[static_cast<std::size_t>(idx)];
         m_points->SetPoint(pointId, pos.x(), pos.y(), pos.z());
         node.setPosition(pos.x(), pos.y(), pos.z());
+        m_model.updateNode(node);
         changed = true;
     }
 
@@ -1317,31 +1322,18 @@ QUuid SceneController::addBar(const QUuid &startNodeId,
                               const QUuid &materialId,
                               const QUuid &sectionId)
 {
-    const int startIndex = nodeIndex(startNodeId);
-    const int endIndex = nodeIndex(endNodeId);
-    if (startIndex < 0 || endIndex < 0 || startIndex == endIndex) {
-        return {};
-    }
-    if (static_cast<std::size_t>(startIndex) >= m_nodePointIds.size()
-        || static_cast<std::size_t>(endIndex) >= m_nodePointIds.size()) {
+    vtkIdType ids[2] = { nodePointId(startNodeId), nodePointId(endNodeId) };
+    if (ids[0] < 0 || ids[1] < 0 || ids[0] == ids[1]) {
         return {};
     }
 
-    vtkIdType ids[2] = {
-        m_nodePointIds[static_cast<std::size_t>(startIndex)],
-        m_nodePointIds[static_cast<std::size_t>(endIndex)]
-    };
-    m_barLines->InsertNextCell(2, ids);
+    const QUuid barId = QUuid::createUuid();
+    m_model.addBar(Bar(barId, startNodeId, endNodeId, materialId, sectionId));
+    insertBarCell(m_model.barCount() - 1);
     m_barLines->Modified();
     m_barData->SetLines(m_barLines);
     m_barData->Modified();
-
-    const QUuid barId = QUuid::createUuid();
-    Bar bar(barId, startNodeId, endNodeId, materialId, sectionId);
-    m_bars.push_back(bar);
-    m_barIndexById.insert(barId, static_cast<int>(m_bars.size()) - 1);
     if (m_barColors) {
-        m_barColors->InsertNextTypedTuple(m_defaultBarColor);
         m_barColors->Modified();
         m_barData->GetCellData()->SetScalars(m_barColors);
     }
@@ -1357,25 +1349,30 @@ void SceneController::assignBarProperties(const std::vector<QUuid> &barIds,
 {
     bool changed = false;
     for (const QUuid &id : barIds) {
-        const int idx = barIndex(id);
-        if (idx < 0) {
+        const Bar *current = m_model.findBarPtr(id);
+        if (!current) {
             continue;
         }
-        Bar &bar = m_bars[static_cast<std::size_t>(idx)];
+        Bar bar = *current;
+        bool barChanged = false;
         if (materialId.has_value()) {
             const QUuid newMat = materialId.value();
             if (bar.materialId() != newMat) {
                 bar.setMaterialId(newMat);
-                changed = true;
+                barChanged = true;
             }
         }
         if (sectionId.has_value()) {
             const QUuid newSec = sectionId.value();
             if (bar.sectionId() != newSec) {
                 bar.setSectionId(newSec);
-                changed = true;
+                barChanged = true;
             }
         }
+        if (barChanged) {
+            m_model.updateBar(bar);
+            changed = true;
+        }
     }
     if (changed) {
         requestRender();
@@ -1385,8 +1382,9 @@ void SceneController::assignBarProperties(const std::vector<QUuid> &barIds,
 std::vector<SceneController::BarInfo> SceneController::bars() const
 {
     std::vector<BarInfo> result;
-    result.reserve(m_bars.size());
-    for (const auto &bar : m_bars) {
+    const auto bars = m_model.bars();
+    result.reserve(bars.size());
+    for (const auto &bar : bars) {
         result.push_back(BarInfo{
             bar.id(),
             bar.startNodeId(),
@@ -1401,56 +1399,38 @@ std::vector<SceneController::BarInfo> SceneController::bars() const
 
 const SceneController::Bar *SceneController::findBar(const QUuid &id) const
 {
-    const int idx = barIndex(id);
-    if (idx < 0) {
-        return nullptr;
-    }
-    return &m_bars[static_cast<std::size_t>(idx)];
-}
-
-SceneController::Bar *SceneController::findBar(const QUuid &id)
-{
-    const int idx = barIndex(id);
-    if (idx < 0) {
-        return nullptr;
-    }
-    return &m_bars[static_cast<std::size_t>(idx)];
+    return m_model.findBarPtr(id);
 }
 
-void SceneController::setSelectedBars(const QSet<QUuid> &barIds)
+void SceneController::setSelectedBars(const std::vector<Structura::Model::BarHandle> &bars)
 {
-    if (!m_barColors) {
-        m_selectedBarIds = barIds;
+    if (m_selectedBars == bars) {
         return;
     }
 
-    if (m_selectedBarIds == barIds) {
-        return;
+    Structura::Model::EntityHandleSet<Structura::Model::Bar> selected;
+    for (const auto &bar : bars) {
+        selected.insert(bar);
     }
 
-    for (const QUuid &id : m_selectedBarIds) {
-        if (barIds.contains(id)) {
-            continue;
+    if (m_barColors) {
+        for (const auto &bar : m_selectedBars) {
+            if (!selected.contains(bar)) {
+                applyBarColor(barCellId(bar), m_defaultBarColor);
+            }
         }
-        const int idx = barIndex(id);
-        if (idx < 0) {
-            continue;
+        for (const auto &bar : bars) {
+            if (!m_selectedBarSet.contains(bar)) {
+                applyBarColor(barCellId(bar), m_selectedBarColor);
+            }
         }
-        applyBarColor(idx, m_defaultBarColor);
     }
 
-    for (const QUuid &id : barIds) {
-        if (m_selectedBarIds.contains(id)) {
-            continue;
-        }
-        const int idx = barIndex(id);
-        if (idx < 0) {
-            continue;
-        }
-        applyBarColor(idx, m_selectedBarColor);
+    m_selectedBars = bars;
+    m_selectedBarSet = std::move(selected);
+    if (!m_barColors) {
+        return;
     }
-
-    m_selectedBarIds = barIds;
     m_barColors->Modified();
     m_barData->Modified();
     requestRender();
@@ -1458,11 +1438,13 @@ void SceneController::setSelectedBars(const QSet<QUuid> &barIds)
 
 void SceneController::setBarExternalId(const QUuid &barId, int externalId)
 {
-    Bar *bar = findBar(barId);
-    if (!bar) {
+    const Bar *current = m_model.findBarPtr(barId);
+    if (!current) {
         return;
     }
-    bar->setExternalId(externalId);
+    Bar bar = *current;
+    bar.setExternalId(externalId);
+    m_model.updateBar(bar);
 }
 
 void SceneController::clearAll()
@@ -1481,22 +1463,12 @@ void SceneController::clearAll()
     requestRender();
 }
 
-void SceneController::applyNodeColor(const QUuid &id, const unsigned char color[3])
+void SceneController::applyNodeColor(Structura::Model::NodeHandle node, const unsigned char color[3])
 {
     if (!m_pointColors) {
         return;
     }
-    if (id.isNull()) {
-        return;
-    }
-    const int idx = nodeIndex(id);
-    if (idx < 0) {
-        return;
-    }
-    if (static_cast<std::size_t>(idx) >= m_nodePointIds.size()) {
-        return;
-    }
-    const vtkIdType pointId = m_nodePointIds[static_cast<std::size_t>(idx)];
+    const vtkIdType pointId = nodePointId(node);
     if (pointId < 0) {
         return;
     }
@@ -1507,19 +1479,32 @@ void SceneController::applyNodeColor(const QUuid &id, const unsigned char color[
     m_pointColors->SetTypedTuple(pointId, color);
 }
 
-void SceneController::applyBarColor(int barIndex, const unsigned char color[3])
+void SceneController::applyBarColor(vtkIdType cellId, const unsigned char color[3])
 {
     if (!m_barColors) {
         return;
     }
-    if (barIndex < 0) {
+    if (cellId < 0) {
         return;
     }
     const vtkIdType tupleCount = m_barColors->GetNumberOfTuples();
-    if (barIndex >= tupleCount) {
+    if (cellId >= tupleCount) {
         return;
     }
-    m_barColors->SetTypedTuple(barIndex, color);
+    m_barColors->SetTypedTuple(cellId, color);
+}
+
+bool SceneController::setNodeRestraints(const QUuid &nodeId, const std::array<bool, 6> &restraints)
+{
+    const Node *current = m_model.findNodePtr(nodeId);
+    if (!current) {
+        return false;
+    }
+    Node node = *current;
+    for (int i = 0; i < 6; ++i) {
+        node.setRestraint(i, restraints[static_cast<std::size_t>(i)]);
+    }
+    return m_model.updateNode(node);
 }
 
 void SceneController::setSupportVisuals(const QVector<SupportVisual> &visuals)
@@ -1677,28 +1662,44 @@ void SceneController::updateSupportVisuals()
     m_supportData->Modified();
 }
 
-int SceneController::nodeIndex(const QUuid &id) const
+vtkIdType SceneController::nodePointId(const QUuid &id) const
 {
     if (id.isNull()) {
         return -1;
     }
-    const auto it = m_nodeIndexById.constFind(id);
-    if (it == m_nodeIndexById.constEnd()) {
+    return nodePointId(m_model.nodeHandle(id));
+}
+
+vtkIdType SceneController::nodePointId(Structura::Model::NodeHandle handle) const
+{
+    // A stale handle (its node removed, the slot maybe reused) draws nothing
+    if (!m_model.node(handle) || handle.index() >= m_nodePointIds.size()) {
         return -1;
     }
-    return it.value();
+    return m_nodePointIds[handle.index()];
 }
 
-int SceneController::barIndex(const QUuid &id) const
+vtkIdType SceneController::barCellId(const QUuid &id) const
 {
     if (id.isNull()) {
         return -1;
     }
-    const auto it = m_barIndexById.constFind(id);
-    if (it == m_barIndexById.constEnd()) {
+    return barCellId(m_model.barHandle(id));
+}
+
+vtkIdType SceneController::barCellId(Structura::Model::BarHandle handle) const
+{
+    if (!m_model.bar(handle) || handle.index() >= m_barCellIds.size()) {
         return -1;
     }
-    return it.value();
+    return m_barCellIds[handle.index()];
+}
+
+void SceneController::resetLoadCase()
+{
+    m_model.clearLoadCases();
+    m_loadCaseId = QUuid::createUuid();
+    m_model.addLoadCase(Structura::Model::LoadCase(m_loadCaseId, 1, tr("Caso 1")));
 }
 
 int SceneController::gridLineIndex(const QUuid &id) const
@@ -1723,6 +1724,106 @@ void SceneController::setShowBarLCS(bool show)
     requestRender();
 }
 
+void SceneController::setModel(Structura::App::InMemoryModelRepository &&model)
+{
+    clearAll();
+    m_model = std::move(model);
+    const auto loadCases = m_model.loadCases();
+    if (loadCases.empty()) {
+        resetLoadCase();
+    } else {
+        m_loadCaseId = loadCases.begin()->id();
+    }
+    m_nextNodeExternalId = std::max(m_model.maxNodeExternalId(), 0) + 1;
+
+    const std::size_t nodeCount = m_model.nodeCount();
+    m_points->Allocate(static_cast<vtkIdType>(nodeCount));
+    m_nodePointIds.reserve(nodeCount);
+    m_pointIdToNode.reserve(nodeCount);
+    for (std::size_t i = 0; i < nodeCount; ++i) {
+        insertNodePoint(i);
+    }
+    const std::size_t barCount = m_model.barCount();
+    m_barCellIds.reserve(barCount);
+    m_cellIdToBar.reserve(barCount);
+    for (std::size_t i = 0; i < barCount; ++i) {
+        insertBarCell(i);
+    }
+
+    if (m_pointColors) {
+        m_pointColors->Modified();
+        m_pointCloud->GetPointData()->SetScalars(m_pointColors);
+    }
+    if (m_barColors) {
+        m_barColors->Modified();
+        m_barData->GetCellData()->SetScalars(m_barColors);
+    }
+    m_points->Modified();
+    m_vertices->Modified();
+    m_pointCloud->Modified();
+    m_barLines->Modified();
+    m_barData->SetLines(m_barLines);
+    m_barData->Modified();
+
+    updateBounds();
+    updateBarLCSVisuals();
+    requestRender();
+}
+
+vtkIdType SceneController::insertNodePoint(std::size_t index)
+{
+    const Node &node = m_model.nodes()[index];
+    const vtkIdType pointId = m_points->InsertNextPoint(node.x(), node.y(), node.z());
+    m_vertices->InsertNextCell(1);
+    m_vertices->InsertCellPoint(pointId);
+
+    const auto slot = static_cast<std::size_t>(m_model.nodeHandleAt(index).index());
+    if (slot >= m_nodePointIds.size()) {
+        m_nodePointIds.resize(slot + 1, -1);
+    }
+    m_nodePointIds[slot] = pointId;
+    if (static_cast<std::size_t>(pointId + 1) > m_pointIdToNode.size()) {
+        m_pointIdToNode.resize(static_cast<std::size_t>(pointId) + 1);
+    }
+    m_pointIdToNode[static_cast<std::size_t>(pointId)] = m_model.nodeHandleAt(index);
+
+    if (m_pointColors) {
+        m_pointColors->InsertNextTypedTuple(m_defaultNodeColor);
+    }
+    return pointId;
+}
+
+vtkIdType SceneController::insertBarCell(std::size_t index)
+{
+    const Structura::Model::BarHandle handle = m_model.barHandleAt(index);
+    const auto ends = m_model.barEndNodes(handle);
+    vtkIdType ids[2] = {-1, -1};
+    for (std::size_t end = 0; end < 2; ++end) {
+        if (ends[end].isValid() && ends[end].index() < m_nodePointIds.size()) {
+            ids[end] = m_nodePointIds[ends[end].index()];
+        }
+    }
+    if (ids[0] < 0 || ids[1] < 0) {
+        return -1;
+    }
+
+    const vtkIdType cellId = m_barLines->InsertNextCell(2, ids);
+    const auto slot = static_cast<std::size_t>(handle.index());
+    if (slot >= m_barCellIds.size()) {
+        m_barCellIds.resize(slot + 1, -1);
+    }
+    m_barCellIds[slot] = cellId;
+    if (static_cast<std::size_t>(cellId + 1) > m_cellIdToBar.size()) {
+        m_cellIdToBar.resize(static_cast<std::size_t>(cellId) + 1);
+    }
+    m_cellIdToBar[static_cast<std::size_t>(cellId)] = handle;
+
+    if (m_barColors) {
+        m_barColors->InsertNextTypedTuple(m_defaultBarColor);
+    }
+    return cellId;
+}
+
 void SceneController::updateBarLCSVisuals()
 {
     if (m_showBarLCS) {
@@ -1737,7 +1838,8 @@ void SceneController::rebuildBarLCSVisuals()
     m_lcsCells->Reset();
     m_lcsColors->Reset();
     
-    if (m_bars.empty()) {
+    const auto bars = m_model.bars();
+    if (bars.empty()) {
         m_lcsData->Modified();
         return;
     }
@@ -1754,7 +1856,8 @@ void SceneController::rebuildBarLCSVisuals()
     constexpr double arrowHeadLength = 0.04;    // Length of arrow head
     constexpr double arrowHeadWidth = 0.02;     // Half-width of arrow head
     
-    for (const auto &bar : m_bars) {
+    for (size_t i = 0; i < bars.size(); ++i) {
+        const Bar &bar = bars[i];
         // Get start and end node positions
         const Node *startNode = findNode(bar.startNodeId());
         const Node *endNode = findNode(bar.endNodeId());
@@ -1778,9 +1881,8 @@ void SceneController::rebuildBarLCSVisuals()
         
         // Compute LCS - convert Vector3 kPoint to array format if present
         std::optional<std::array<double, 3>> kPointArray;
-        if (bar.kPoint().has_value()) {
-            const auto &kp = bar.kPoint().value();
-            kPointArray = std::array<double, 3>{{kp.x(), kp.y(), kp.z()}};
+        if (const auto *kp = m_model.barKPoint(m_model.barHandleAt(i))) {
+            kPointArray = std::array<double, 3>{{kp->x(), kp->y(), kp->z()}};
         }
         
         try {
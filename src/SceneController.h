@@ -3,7 +3,6 @@
 #include <QObject>
 #include <QUuid>
 #include <QHash>
-#include <QSet>
 #include <QVector>
 #include <QVector3D>
 
@@ -16,6 +15,7 @@
 
 #include "ModelEntities.h"
 #include "LoadVisualization.h"
+#include "app/InMemoryModelRepository.h"
 
 class QVTKOpenGLNativeWidget;
 class vtkGenericOpenGLRenderWindow;
@@ -46,6 +46,8 @@ public:
     using Node = Structura::Model::Node;
     using Bar = Structura::Model::Bar;
     using GridLine = Structura::Model::GridLine;
+    using NodalLoad = Structura::Model::NodalLoad;
+    using MemberLoad = Structura::Model::MemberLoad;
 
     struct NodalLoadVisual {
         QVector3D position;
@@ -120,11 +122,22 @@ public:
     void hideGridGhostLine();
     std::optional<QUuid> nearestGridLineId(GridLine::Axis axis, double coordinate1, double coordinate2) const;
 
-    // Loads
+    // Model: nodes, bars, supports (node restraints) and loads. It is read
+    // here and changed only through SceneController, which keeps the
+    // rendering in step.
+    const Structura::App::IModelRepository &model() const { return m_model; }
+
+    // Loads, all in the model's single load case (.dat files have no cases)
+    const QUuid &loadCaseId() const { return m_loadCaseId; }
+    bool addNodalLoad(const NodalLoad &load);
+    bool removeNodalLoad(const QUuid &loadId);
+    bool addMemberLoad(const MemberLoad &load);
+    bool removeMemberLoad(const QUuid &loadId);
     void setNodalLoadVisuals(const QVector<NodalLoadVisual> &visuals);
     void setMemberLoadVisuals(const QVector<MemberLoadVisual> &visuals);
 
     // Supports (restraints)
+    bool setNodeRestraints(const QUuid &nodeId, const std::array<bool, 6> &restraints);
     void setSupportVisuals(const QVector<SupportVisual> &visuals);
     
     // Bar Local Coordinate Systems (LCS)
@@ -136,12 +149,11 @@ public:
     int nodeCount() const;
     std::vector<NodeInfo> nodeInfos() const;
     const Node *findNode(const QUuid &id) const;
-    Node *findNode(const QUuid &id);
-    QUuid pickNode(int displayX, int displayY) const;
-    QUuid pickBar(int displayX, int displayY) const;
-    void setHighlightedNode(const QUuid &nodeId);
+    Structura::Model::NodeHandle pickNode(int displayX, int displayY) const;
+    Structura::Model::BarHandle pickBar(int displayX, int displayY) const;
+    void setHighlightedNode(Structura::Model::NodeHandle node);
     void clearHighlightedNode();
-    void setSelectedNodes(const QSet<QUuid> &nodeIds);
+    void setSelectedNodes(const std::vector<Structura::Model::NodeHandle> &nodes);
     bool updateNodePosition(const QUuid &nodeId, double x, double y, double z);
     bool updateNodePositions(const QVector<QUuid> &nodeIds, const QVector<QVector3D> &positions);
 
@@ -156,16 +168,25 @@ public:
     void setBarExternalId(const QUuid &barId, int externalId);
     std::vector<BarInfo> bars() const;
     const Bar *findBar(const QUuid &id) const;
-    Bar *findBar(const QUuid &id);
-    void setSelectedBars(const QSet<QUuid> &barIds);
+    void setSelectedBars(const std::vector<Structura::Model::BarHandle> &bars);
+
+    // Replace the whole model (file loading). Built off-scene, e.g. by
+    // readDatModel(), and drawn in one pass; its first load case becomes
+    // the current one.
+    void setModel(Structura::App::InMemoryModelRepository &&model);
 
 private:
     void updateBounds();
-    int nodeIndex(const QUuid &id) const;
-    int barIndex(const QUuid &id) const;
+    vtkIdType nodePointId(const QUuid &id) const;
+    vtkIdType nodePointId(Structura::Model::NodeHandle handle) const;
+    vtkIdType barCellId(const QUuid &id) const;
+    vtkIdType barCellId(Structura::Model::BarHandle handle) const;
+    void resetLoadCase();
+    vtkIdType insertNodePoint(std::size_t index);
+    vtkIdType insertBarCell(std::size_t index);
     int gridLineIndex(const QUuid &id) const;
-    void applyNodeColor(const QUuid &id, const unsigned char color[3]);
-    void applyBarColor(int barIndex, const unsigned char color[3]);
+    void applyNodeColor(Structura::Model::NodeHandle node, const unsigned char color[3]);
+    void applyBarColor(vtkIdType cellId, const unsigned char color[3]);
     void updateGridColors();
     void initializePointRendering();
     void initializeBarRendering();
@@ -265,17 +286,19 @@ private:
     vtkSmartPointer<vtkPointPicker> m_nodePicker;
     vtkSmartPointer<vtkCellPicker> m_barPicker;
 
-    std::vector<Node> m_nodes;
-    std::vector<vtkIdType> m_nodePointIds;
-    std::vector<QUuid> m_pointIdToNodeId;
-    QHash<QUuid, int> m_nodeIndexById;
+    Structura::App::InMemoryModelRepository m_model;
+    QUuid m_loadCaseId;
 
-    std::vector<Bar> m_bars;
-    QHash<QUuid, int> m_barIndexById;
+    std::vector<vtkIdType> m_nodePointIds;   // VTK point of each node, by handle slot
+    std::vector<Structura::Model::NodeHandle> m_pointIdToNode;
+    std::vector<vtkIdType> m_barCellIds;     // VTK line cell of each bar, by handle slot
+    std::vector<Structura::Model::BarHandle> m_cellIdToBar;
 
-    QUuid m_highlightNodeId;
-    QSet<QUuid> m_selectedNodeIds;
-    QSet<QUuid> m_selectedBarIds;
+    Structura::Model::NodeHandle m_highlightNode;
+    std::vector<Structura::Model::NodeHandle> m_selectedNodes;
+    Structura::Model::EntityHandleSet<Structura::Model::Node> m_selectedNodeSet;
+    std::vector<Structura::Model::BarHandle> m_selectedBars;
+    Structura::Model::EntityHandleSet<Structura::Model::Bar> m_selectedBarSet;
     unsigned char m_defaultNodeColor[3] {228, 74, 25};
     unsigned char m_selectedNodeColor[3] {30, 126, 255};
     unsigned char m_hoverNodeColor[3] {255, 198, 30};
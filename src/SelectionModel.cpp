@@ -1,5 +1,7 @@
 #include "SelectionModel.h"
 
+#include <algorithm>
+
 using namespace Structura;
 
 SelectionModel::SelectionModel(QObject *parent)
@@ -7,111 +9,136 @@ SelectionModel::SelectionModel(QObject *parent)
 {
 }
 
-void SelectionModel::selectNode(const QUuid &id, Mode mode)
+void SelectionModel::selectNode(NodeHandle handle, Mode mode)
 {
-    QVector<QUuid> ids;
-    ids.reserve(1);
-    ids.append(id);
-    selectNodes(ids, mode);
+    selectNodes(std::vector<NodeHandle>{handle}, mode);
 }
 
-void SelectionModel::selectNodes(const QVector<QUuid> &ids, Mode mode)
+void SelectionModel::selectNodes(const std::vector<NodeHandle> &handles, Mode mode)
 {
-    if (applySelection(m_selectedNodes, ids, mode)) {
-        emit selectionChanged(m_selectedNodes, m_selectedBars);
-    } else if (mode == Mode::Replace && ids.isEmpty()) {
-        if (!m_selectedNodes.isEmpty()) {
-            m_selectedNodes.clear();
-            emit selectionChanged(m_selectedNodes, m_selectedBars);
-        }
+    if (applySelection(m_selectedNodes, handles, mode)) {
+        emit selectionChanged();
     }
 }
 
-void SelectionModel::selectBar(const QUuid &id, Mode mode)
+void SelectionModel::selectBar(BarHandle handle, Mode mode)
 {
-    QVector<QUuid> ids;
-    ids.reserve(1);
-    ids.append(id);
-    selectBars(ids, mode);
+    selectBars(std::vector<BarHandle>{handle}, mode);
 }
 
-void SelectionModel::selectBars(const QVector<QUuid> &ids, Mode mode)
+void SelectionModel::selectBars(const std::vector<BarHandle> &handles, Mode mode)
 {
-    if (applySelection(m_selectedBars, ids, mode)) {
-        emit selectionChanged(m_selectedNodes, m_selectedBars);
-    } else if (mode == Mode::Replace && ids.isEmpty()) {
-        if (!m_selectedBars.isEmpty()) {
-            m_selectedBars.clear();
-            emit selectionChanged(m_selectedNodes, m_selectedBars);
-        }
+    if (applySelection(m_selectedBars, handles, mode)) {
+        emit selectionChanged();
     }
 }
 
 void SelectionModel::clear()
 {
-    if (m_selectedNodes.isEmpty() && m_selectedBars.isEmpty()) {
+    if (m_selectedNodes.handles.empty() && m_selectedBars.handles.empty()) {
         return;
     }
-    m_selectedNodes.clear();
-    m_selectedBars.clear();
-    emit selectionChanged(m_selectedNodes, m_selectedBars);
+    m_selectedNodes = {};
+    m_selectedBars = {};
+    emit selectionChanged();
+}
+
+const std::vector<SelectionModel::NodeHandle> &SelectionModel::selectedNodes() const noexcept
+{
+    return m_selectedNodes.handles;
+}
+
+const std::vector<SelectionModel::BarHandle> &SelectionModel::selectedBars() const noexcept
+{
+    return m_selectedBars.handles;
+}
+
+bool SelectionModel::isNodeSelected(NodeHandle handle) const noexcept
+{
+    return m_selectedNodes.contains(handle);
 }
 
-const QSet<QUuid> &SelectionModel::selectedNodes() const noexcept
+bool SelectionModel::isBarSelected(BarHandle handle) const noexcept
 {
-    return m_selectedNodes;
+    return m_selectedBars.contains(handle);
 }
 
-const QSet<QUuid> &SelectionModel::selectedBars() const noexcept
+template <typename Entity>
+bool SelectionModel::Selection<Entity>::contains(Handle handle) const noexcept
 {
-    return m_selectedBars;
+    if (!handle.isValid() || handle.index() >= positions.size()) {
+        return false;
+    }
+    const int position = positions[handle.index()];
+    return position >= 0 && handles[static_cast<std::size_t>(position)] == handle;
 }
 
-bool SelectionModel::isNodeSelected(const QUuid &id) const noexcept
+template <typename Entity>
+bool SelectionModel::Selection<Entity>::insert(Handle handle)
 {
-    return m_selectedNodes.contains(id);
+    if (!handle.isValid()) {
+        return false;
+    }
+    if (handle.index() >= positions.size()) {
+        positions.resize(static_cast<std::size_t>(handle.index()) + 1, -1);
+    }
+    const int position = positions[handle.index()];
+    if (position < 0) {
+        positions[handle.index()] = static_cast<int>(handles.size());
+        handles.push_back(handle);
+        return true;
+    }
+    // The slot was reused: the newer generation replaces the stale handle
+    Handle &current = handles[static_cast<std::size_t>(position)];
+    if (handle.generation() <= current.generation()) {
+        return false;
+    }
+    current = handle;
+    return true;
 }
 
-bool SelectionModel::isBarSelected(const QUuid &id) const noexcept
+template <typename Entity>
+bool SelectionModel::Selection<Entity>::remove(Handle handle)
 {
-    return m_selectedBars.contains(id);
+    if (!contains(handle)) {
+        return false;
+    }
+    const int position = positions[handle.index()];
+    const Handle last = handles.back();
+    handles[static_cast<std::size_t>(position)] = last;
+    positions[last.index()] = position;
+    handles.pop_back();
+    positions[handle.index()] = -1;
+    return true;
 }
 
-bool SelectionModel::applySelection(QSet<QUuid> &set, const QVector<QUuid> &ids, Mode mode)
+template <typename Entity>
+bool SelectionModel::applySelection(Selection<Entity> &selection,
+                                    const std::vector<Structura::Model::EntityHandle<Entity>> &handles,
+                                    Mode mode)
 {
     if (mode == Mode::Replace) {
-        QSet<QUuid> newSet;
-        newSet.reserve(ids.size());
-        for (const QUuid &id : ids) {
-            if (!id.isNull()) {
-                newSet.insert(id);
-            }
+        Selection<Entity> next;
+        next.handles.reserve(handles.size());
+        for (const auto &handle : handles) {
+            next.insert(handle);
         }
-        if (newSet == set) {
+        const bool same = next.handles.size() == selection.handles.size()
+            && std::all_of(next.handles.begin(), next.handles.end(),
+                           [&selection](const auto &handle) { return selection.contains(handle); });
+        if (same) {
             return false;
         }
-        set = std::move(newSet);
+        selection = std::move(next);
         return true;
     }
 
     bool changed = false;
-    for (const QUuid &id : ids) {
-        if (id.isNull()) {
-            continue;
-        }
-        if (mode == Mode::Add) {
-            if (!set.contains(id)) {
-                set.insert(id);
-                changed = true;
-            }
-        } else if (mode == Mode::Toggle) {
-            if (set.contains(id)) {
-                set.remove(id);
-                changed = true;
-            } else {
-                set.insert(id);
-                changed = true;
-            }
+    for (const auto &handle : handles) {
+        if (mode == Mode::Toggle && selection.remove(handle)) {
+            changed = true;
+        } else if (selection.insert(handle)) {
+            changed = true;
         }
     }
     return changed;
@@ -1,17 +1,30 @@
 #pragma once
 
+#include "core/model/EntityHandle.h"
+
 #include <QObject>
-#include <QSet>
-#include <QUuid>
-#include <QVector>
+#include <vector>
 
 namespace Structura {
 
+/**
+ * @brief Current node and bar selection, by repository handle.
+ *
+ * Membership tests, additions and removals are array indexing. Each slot
+ * holds at most one handle: selecting a newer generation of a slot drops the
+ * stale handle, and an older one is ignored. Handles of removed entities
+ * that were not replaced stay listed; resolve them through the repository
+ * (which returns nullptr for a stale handle) when turning the selection into
+ * UUIDs for commands or dialogs.
+ */
 class SelectionModel : public QObject
 {
     Q_OBJECT
 
 public:
+    using NodeHandle = Structura::Model::NodeHandle;
+    using BarHandle = Structura::Model::BarHandle;
+
     enum class Mode {
         Replace,
         Add,
@@ -20,28 +33,48 @@ public:
 
     explicit SelectionModel(QObject *parent = nullptr);
 
-    void selectNode(const QUuid &id, Mode mode = Mode::Replace);
-    void selectNodes(const QVector<QUuid> &ids, Mode mode = Mode::Replace);
+    void selectNode(NodeHandle handle, Mode mode = Mode::Replace);
+    void selectNodes(const std::vector<NodeHandle> &handles, Mode mode = Mode::Replace);
 
-    void selectBar(const QUuid &id, Mode mode = Mode::Replace);
-    void selectBars(const QVector<QUuid> &ids, Mode mode = Mode::Replace);
+    void selectBar(BarHandle handle, Mode mode = Mode::Replace);
+    void selectBars(const std::vector<BarHandle> &handles, Mode mode = Mode::Replace);
 
     void clear();
 
-    const QSet<QUuid> &selectedNodes() const noexcept;
-    const QSet<QUuid> &selectedBars() const noexcept;
+    /// Selected nodes in selection order, except that a deselection moves
+    /// the last one into the gap
+    const std::vector<NodeHandle> &selectedNodes() const noexcept;
+    /// Selected bars, ordered as selectedNodes()
+    const std::vector<BarHandle> &selectedBars() const noexcept;
 
-    bool isNodeSelected(const QUuid &id) const noexcept;
-    bool isBarSelected(const QUuid &id) const noexcept;
+    bool isNodeSelected(NodeHandle handle) const noexcept;
+    bool isBarSelected(BarHandle handle) const noexcept;
 
 signals:
-    void selectionChanged(const QSet<QUuid> &nodes, const QSet<QUuid> &bars);
+    void selectionChanged();
 
 private:
-    bool applySelection(QSet<QUuid> &set, const QVector<QUuid> &ids, Mode mode);
+    template <typename Entity>
+    struct Selection
+    {
+        using Handle = Structura::Model::EntityHandle<Entity>;
+
+        bool contains(Handle handle) const noexcept;
+        /// False if @p handle is invalid, already selected, or older than the slot's entry
+        bool insert(Handle handle);
+        bool remove(Handle handle);
+
+        std::vector<Handle> handles;
+        std::vector<int> positions;  ///< Index into handles by slot, -1 if unselected
+    };
+
+    template <typename Entity>
+    static bool applySelection(Selection<Entity> &selection,
+                               const std::vector<Structura::Model::EntityHandle<Entity>> &handles,
+                               Mode mode);
 
-    QSet<QUuid> m_selectedNodes;
-    QSet<QUuid> m_selectedBars;
+    Selection<Structura::Model::Node> m_selectedNodes;
+    Selection<Structura::Model::Bar> m_selectedBars;
 };
 
 } // namespace Structura
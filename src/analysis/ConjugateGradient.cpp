@@ -0,0 +1,163 @@
+#include "ConjugateGradient.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+namespace Structura::Analysis {
+
+namespace {
+
+constexpr size_t kChunk = 4096; ///< Entries per partial sum of a dot product
+
+/**
+ * @brief Vector operations of one solve, split over the pool.
+ */
+class VectorKernels
+{
+public:
+    VectorKernels(ThreadPool *pool, size_t size)
+        : m_pool(pool != nullptr && pool->threadCount() > 1 ? pool : nullptr)
+        , m_size(size)
+        , m_partial((size + kChunk - 1) / kChunk)
+    {
+    }
+
+    /// Run @p body(begin, end) over [0, size)
+    void forEach(const std::function<void(size_t, size_t)> &body) const
+    {
+        run(m_size, body);
+    }
+
+    double dot(const double *x, const double *y)
+    {
+        run(m_partial.size(), [&](size_t first, size_t last) {
+            for (size_t c = first; c < last; ++c) {
+                const size_t end = std::min(m_size, (c + 1) * kChunk);
+                double sum = 0.0;
+                for (size_t i = c * kChunk; i < end; ++i) {
+                    sum += x[i] * y[i];
+                }
+                m_partial[c] = sum;
+            }
+        });
+        double sum = 0.0;
+        for (double partial : m_partial) {
+            sum += partial;
+        }
+        return sum;
+    }
+
+private:
+    void run(size_t count, const std::function<void(size_t, size_t)> &body) const
+    {
+        if (m_pool != nullptr) {
+            m_pool->parallelFor(count, body);
+        } else if (count > 0) {
+            body(0, count);
+        }
+    }
+
+    ThreadPool *m_pool;
+    size_t m_size;
+    std::vector<double> m_partial;
+};
+
+} // namespace
+
+CsrOperator::CsrOperator(const CsrMatrix &matrix, ThreadPool *pool)
+    : m_matrix(matrix)
+    , m_pool(pool != nullptr && pool->threadCount() > 1 ? pool : nullptr)
+{
+    const int workers = m_pool != nullptr ? m_pool->threadCount() : 1;
+    m_rowSplit.assign(static_cast<size_t>(workers) + 1, matrix.size);
+    m_rowSplit[0] = 0;
+    for (int w = 1; w < workers; ++w) {
+        const size_t target = matrix.nonZeros() * static_cast<size_t>(w) / static_cast<size_t>(workers);
+        const auto row = std::lower_bound(matrix.rowStart.begin(), matrix.rowStart.end() - 1, target);
+        m_rowSplit[static_cast<size_t>(w)] = std::max(m_rowSplit[static_cast<size_t>(w) - 1],
+                                                      static_cast<int>(row - matrix.rowStart.begin()));
+    }
+}
+
+void CsrOperator::apply(const double *x, double *y) const
+{
+    auto rows = [&](int first, int last) {
+        for (int row = first; row < last; ++row) {
+            double sum = 0.0;
+            for (size_t p = m_matrix.rowStart[static_cast<size_t>(row)]; p < m_matrix.rowStart[static_cast<size_t>(row) + 1]; ++p) {
+                sum += m_matrix.values[p] * x[m_matrix.columns[p]];
+            }
+            y[row] = sum;
+        }
+    };
+    if (m_pool == nullptr) {
+        rows(0, m_matrix.size);
+        return;
+    }
+    m_pool->runOnAll([&](int worker) {
+        rows(m_rowSplit[static_cast<size_t>(worker)], m_rowSplit[static_cast<size_t>(worker) + 1]);
+    });
+}
+
+ConvergenceReport ConjugateGradient::solve(const LinearOperator &a, const Preconditioner &preconditioner,
+                                           const double *b, double *x) const
+{
+    const auto n = static_cast<size_t>(a.size());
+    const int maxIterations = m_maxIterations > 0 ? m_maxIterations : std::max(100, a.size());
+    VectorKernels kernels(m_pool, n);
+    ConvergenceReport report;
+
+    std::vector<double> r(b, b + n);
+    std::vector<double> z(n);
+    std::vector<double> p(n);
+    std::vector<double> q(n);
+    std::fill(x, x + n, 0.0);
+
+    const double bNorm = std::sqrt(kernels.dot(b, b));
+    report.residualHistory.push_back(1.0);
+    if (bNorm == 0.0) {
+        report.converged = true;
+        report.relativeResidual = 0.0;
+        report.residualHistory.back() = 0.0;
+        return report;
+    }
+
+    preconditioner.apply(r.data(), z.data());
+    p = z;
+    double rz = kernels.dot(r.data(), z.data());
+    while (report.iterations < maxIterations) {
+        a.apply(p.data(), q.data());
+        const double pq = kernels.dot(p.data(), q.data());
+        if (!(pq > 0.0)) {
+            break; // not positive definite, or a NaN from the preconditioner
+        }
+        const double alpha = rz / pq;
+        kernels.forEach([&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                x[i] += alpha * p[i];
+                r[i] -= alpha * q[i];
+            }
+        });
+        ++report.iterations;
+        report.relativeResidual = std::sqrt(kernels.dot(r.data(), r.data())) / bNorm;
+        report.residualHistory.push_back(report.relativeResidual);
+        if (report.relativeResidual <= m_tolerance) {
+            report.converged = true;
+            break;
+        }
+
+        preconditioner.apply(r.data(), z.data());
+        const double rzNext = kernels.dot(r.data(), z.data());
+        const double beta = rzNext / rz;
+        rz = rzNext;
+        kernels.forEach([&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                p[i] = z[i] + beta * p[i];
+            }
+        });
+    }
+    return report;
+}
+
+} // namespace Structura::Analysis
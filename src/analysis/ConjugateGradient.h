@@ -0,0 +1,111 @@
+#pragma once
+
+#include "SparseMatrix.h"
+#include <cstddef>
+#include <vector>
+
+namespace Structura::Analysis {
+
+class ThreadPool;
+
+/**
+ * @brief Symmetric positive definite operator y = A x of an iterative solve.
+ */
+class LinearOperator
+{
+public:
+    virtual ~LinearOperator() = default;
+
+    virtual int size() const = 0;
+
+    /// y = A x; x and y do not overlap
+    virtual void apply(const double *x, double *y) const = 0;
+};
+
+/**
+ * @brief LinearOperator of an assembled CSR matrix.
+ *
+ * Rows are split among the workers of the pool in ranges of equal nonzero
+ * count. Each row is summed by one thread in column order, so the product
+ * does not depend on the number of threads.
+ */
+class CsrOperator : public LinearOperator
+{
+public:
+    /// @param pool Threads for the product, or nullptr for serial
+    explicit CsrOperator(const CsrMatrix &matrix, ThreadPool *pool = nullptr);
+
+    int size() const override { return m_matrix.size; }
+    void apply(const double *x, double *y) const override;
+
+private:
+    const CsrMatrix &m_matrix;
+    ThreadPool *m_pool;
+    std::vector<int> m_rowSplit; ///< Worker w multiplies rows [m_rowSplit[w], m_rowSplit[w + 1])
+};
+
+/**
+ * @brief Approximate inverse z = M^-1 r applied at every CG iteration.
+ */
+class Preconditioner
+{
+public:
+    virtual ~Preconditioner() = default;
+
+    /// z = M^-1 r; r and z do not overlap
+    virtual void apply(const double *r, double *z) const = 0;
+
+    /// Equation that made the setup fail (matrix not positive definite), or -1
+    virtual int failedEquation() const { return -1; }
+};
+
+/**
+ * @brief Convergence record of one iterative solve.
+ */
+struct ConvergenceReport
+{
+    bool converged{false};
+    int iterations{0};
+    double relativeResidual{1.0};         ///< |b - A x| / |b| at the end
+    std::vector<double> residualHistory;  ///< Relative residual after 0, 1, ... iterations
+};
+
+/**
+ * @brief Preconditioned conjugate gradient method.
+ *
+ * Solves A x = b for symmetric positive definite A from x = 0 and stops
+ * when |r| <= tolerance * |b|. Vector operations run on the thread pool;
+ * dot products add fixed-size chunk sums in chunk order, so iterates are
+ * identical for any thread count.
+ */
+class ConjugateGradient
+{
+public:
+    /**
+     * @param tolerance Relative residual to reach
+     * @param maxIterations Iteration limit; 0 allows max(100, size) iterations
+     * @param pool Threads for the vector operations, or nullptr for serial
+     */
+    explicit ConjugateGradient(double tolerance = 1e-8, int maxIterations = 0, ThreadPool *pool = nullptr)
+        : m_tolerance(tolerance)
+        , m_maxIterations(maxIterations)
+        , m_pool(pool)
+    {
+    }
+
+    /**
+     * @brief Solve A x = b.
+     * @param x Receives the solution (size A.size())
+     * @return Convergence record; not converged also when p^T A p <= 0,
+     *         which means A is not positive definite
+     */
+    ConvergenceReport solve(const LinearOperator &a, const Preconditioner &preconditioner,
+                            const double *b, double *x) const;
+
+private:
+    double m_tolerance;
+    int m_maxIterations;
+    ThreadPool *m_pool;
+};
+
+} // namespace Structura::Analysis
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "SparseMatrix.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace Structura::Analysis {
+
+/**
+ * @brief Direct LDL^T solver of a symmetric sparse system, A = L D L^T.
+ *
+ * Solvers pivot only on the diagonal in the given equation order (static
+ * pivoting), so the caller supplies a fill-reducing numbering. D may have
+ * negative entries (indefinite systems) as long as no pivot vanishes.
+ */
+class DirectSolver
+{
+public:
+    virtual ~DirectSolver() = default;
+
+    /**
+     * @brief Symbolic factorization from the structure of @p matrix.
+     *
+     * Afterwards factorNonZeros() tells the size of the factor, before any
+     * numeric work.
+     * @param matrix Full symmetric CSR (only the lower triangle is read)
+     */
+    virtual void analyse(const CsrMatrix &matrix) = 0;
+
+    /**
+     * @brief Numeric factorization of a matrix with the structure given to
+     *        the last analyse().
+     * @param pivotTolerance Relative pivot size below which the matrix is
+     *        reported singular (see pivotThresholds())
+     * @return false if singular; failedEquation() then tells where
+     */
+    virtual bool factorizeNumeric(const CsrMatrix &matrix, double pivotTolerance) = 0;
+
+    /// analyse() followed by factorizeNumeric()
+    bool factorize(const CsrMatrix &matrix, double pivotTolerance)
+    {
+        analyse(matrix);
+        return factorizeNumeric(matrix, pivotTolerance);
+    }
+
+    /// Solve A x = b in place (b in, x out)
+    virtual void solve(double *x) const = 0;
+
+    /// Equation whose pivot vanished in the last failed factorization, or -1
+    virtual int failedEquation() const = 0;
+
+    /// Stored strictly lower entries of L (valid after analyse())
+    virtual size_t factorNonZeros() const = 0;
+
+    /// Memory the factorization holds once numeric, values and index arrays (valid after analyse())
+    virtual size_t factorBytes() const = 0;
+};
+
+/// Bytes of @p count elements of type T
+template <typename T>
+constexpr size_t bytesOf(size_t count)
+{
+    return count * sizeof(T);
+}
+
+/**
+ * @brief Per-equation singularity thresholds: pivot k fails when
+ *        |d_k| <= threshold[k].
+ *
+ * The threshold is tolerance * |a_kk|. Rows with a zero diagonal (Lagrange
+ * multipliers of constraints) have pivots of the size of a_k^T K^-1 a_k, so
+ * they use tolerance * |a_k|^2 / max |a_ii| instead.
+ */
+inline std::vector<double> pivotThresholds(const CsrMatrix &matrix, double pivotTolerance)
+{
+    const auto n = static_cast<size_t>(matrix.size);
+    std::vector<double> threshold(n, 0.0);
+    std::vector<double> rowNorm(n, 0.0);
+    double largestDiagonal = 0.0;
+    for (size_t k = 0; k < n; ++k) {
+        for (size_t p = matrix.rowStart[k]; p < matrix.rowStart[k + 1]; ++p) {
+            rowNorm[k] += matrix.values[p] * matrix.values[p];
+            if (static_cast<size_t>(matrix.columns[p]) == k) {
+                threshold[k] = pivotTolerance * std::abs(matrix.values[p]);
+                largestDiagonal = std::max(largestDiagonal, std::abs(matrix.values[p]));
+            }
+        }
+    }
+    for (size_t k = 0; k < n; ++k) {
+        if (threshold[k] == 0.0 && largestDiagonal > 0.0) {
+            threshold[k] = pivotTolerance * rowNorm[k] / largestDiagonal;
+        }
+    }
+    return threshold;
+}
+
+} // namespace Structura::Analysis
@@ -0,0 +1,67 @@
+#include "ElementColouring.h"
+#include <cstdint>
+
+namespace Structura::Analysis {
+
+ElementColouring colourElements(const FrameModel &model)
+{
+    const size_t nodeCount = model.nodeCount();
+    const size_t elementCount = model.elements.size();
+
+    // Elements incident to each node
+    std::vector<size_t> incidenceStart(nodeCount + 1, 0);
+    for (const FrameElement &element : model.elements) {
+        for (int node : element.nodes) {
+            ++incidenceStart[static_cast<size_t>(node) + 1];
+        }
+    }
+    for (size_t node = 0; node < nodeCount; ++node) {
+        incidenceStart[node + 1] += incidenceStart[node];
+    }
+    std::vector<int> incident(incidenceStart[nodeCount]);
+    std::vector<size_t> fill(incidenceStart.begin(), incidenceStart.end() - 1);
+    for (size_t e = 0; e < elementCount; ++e) {
+        for (int node : model.elements[e].nodes) {
+            incident[fill[static_cast<size_t>(node)]++] = static_cast<int>(e);
+        }
+    }
+
+    // forbidden[c] == e marks colour c as taken around element e
+    std::vector<int> colour(elementCount, -1);
+    std::vector<size_t> forbidden;
+    std::vector<int> colourSize;
+    for (size_t e = 0; e < elementCount; ++e) {
+        for (int node : model.elements[e].nodes) {
+            for (size_t p = incidenceStart[static_cast<size_t>(node)]; p < incidenceStart[static_cast<size_t>(node) + 1]; ++p) {
+                const int other = colour[static_cast<size_t>(incident[p])];
+                if (other >= 0) {
+                    forbidden[static_cast<size_t>(other)] = e;
+                }
+            }
+        }
+        size_t c = 0;
+        while (c < forbidden.size() && forbidden[c] == e) {
+            ++c;
+        }
+        if (c == forbidden.size()) {
+            forbidden.push_back(SIZE_MAX);
+            colourSize.push_back(0);
+        }
+        colour[e] = static_cast<int>(c);
+        ++colourSize[c];
+    }
+
+    ElementColouring colouring;
+    colouring.colourStart.resize(colourSize.size() + 1, 0);
+    for (size_t c = 0; c < colourSize.size(); ++c) {
+        colouring.colourStart[c + 1] = colouring.colourStart[c] + colourSize[c];
+    }
+    colouring.elements.resize(elementCount);
+    std::vector<int> next(colouring.colourStart.begin(), colouring.colourStart.end() - 1);
+    for (size_t e = 0; e < elementCount; ++e) {
+        colouring.elements[static_cast<size_t>(next[static_cast<size_t>(colour[e])]++)] = static_cast<int>(e);
+    }
+    return colouring;
+}
+
+} // namespace Structura::Analysis
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "FrameModel.h"
+#include <vector>
+
+namespace Structura::Analysis {
+
+/**
+ * @brief Partition of the elements into colours with no shared node.
+ *
+ * Two elements of the same colour never touch the same node, so the
+ * elements of one colour can add into nodal quantities (K x, assembled
+ * rows) from several threads without conflicts. Colours are processed one
+ * after the other, which also fixes the order in which the contributions
+ * to every node are summed.
+ */
+struct ElementColouring
+{
+    /// Elements of colour c are elements[colourStart[c] .. colourStart[c + 1]),
+    /// in increasing element index
+    std::vector<int> colourStart{0};
+    std::vector<int> elements;
+
+    int colourCount() const { return static_cast<int>(colourStart.size()) - 1; }
+};
+
+/**
+ * @brief Greedy colouring in element order.
+ *
+ * Each element takes the lowest colour not used by an element already
+ * coloured at either of its nodes, so at most 2 * (max node degree) - 1
+ * colours are needed. Deterministic for a given model.
+ */
+ElementColouring colourElements(const FrameModel &model);
+
+} // namespace Structura::Analysis
@@ -0,0 +1,180 @@
+#include "ElementStiffness.h"
+#include "../LocalCoordinateSystem.h"
+#include <cmath>
+
+namespace Structura::Analysis {
+
+namespace {
+    constexpr double kMinElementLength = 1e-9;
+
+    inline double &at(ElementMatrix &m, int row, int col)
+    {
+        return m[static_cast<size_t>(row * kElementDofs + col)];
+    }
+
+    /// Set a symmetric pair of entries
+    inline void setSym(ElementMatrix &m, int row, int col, double value)
+    {
+        at(m, row, col) = value;
+        at(m, col, row) = value;
+    }
+}
+
+bool computeElementAxes(const FrameModel &model,
+                        const FrameElement &element,
+                        const Structura::Geometry::DefaultLocalAxisProvider &provider,
+                        ElementAxes &axes)
+{
+    const int count = static_cast<int>(model.nodeCount());
+    const int a = element.nodes[0];
+    const int b = element.nodes[1];
+    if (a < 0 || b < 0 || a >= count || b >= count || a == b) {
+        return false;
+    }
+    const double *pa = model.coordinates.data() + 3 * static_cast<size_t>(a);
+    const double *pb = model.coordinates.data() + 3 * static_cast<size_t>(b);
+    const double dx = pb[0] - pa[0];
+    const double dy = pb[1] - pa[1];
+    const double dz = pb[2] - pa[2];
+    axes.length = std::sqrt(dx * dx + dy * dy + dz * dz);
+    if (axes.length < kMinElementLength) {
+        return false;
+    }
+
+    const Structura::Geometry::LCS lcs = provider.computeLCS({{pa[0], pa[1], pa[2]}},
+                                                             {{pb[0], pb[1], pb[2]}},
+                                                             element.kPoint);
+    for (int i = 0; i < 3; ++i) {
+        axes.rotation[static_cast<size_t>(i)] = lcs.xPrime[static_cast<size_t>(i)];
+        axes.rotation[static_cast<size_t>(3 + i)] = lcs.yPrime[static_cast<size_t>(i)];
+        axes.rotation[static_cast<size_t>(6 + i)] = lcs.zPrime[static_cast<size_t>(i)];
+    }
+    return true;
+}
+
+void localStiffness(const FrameElement &element, double length, ElementMatrix &k)
+{
+    k.fill(0.0);
+    const double L = length;
+    const double L2 = L * L;
+    const double L3 = L2 * L;
+    const double E = element.youngModulus;
+
+    // Axial (UX) and torsion (RX)
+    const double axial = E * element.area / L;
+    const double torsion = element.shearModulus * element.torsionalConstant / L;
+    setSym(k, 0, 0, axial);
+    setSym(k, 6, 6, axial);
+    setSym(k, 0, 6, -axial);
+    setSym(k, 3, 3, torsion);
+    setSym(k, 9, 9, torsion);
+    setSym(k, 3, 9, -torsion);
+
+    // Bending in the x'-y' plane (UY, RZ) about local z
+    const double EIz = E * element.iz;
+    setSym(k, 1, 1, 12.0 * EIz / L3);
+    setSym(k, 7, 7, 12.0 * EIz / L3);
+    setSym(k, 1, 7, -12.0 * EIz / L3);
+    setSym(k, 1, 5, 6.0 * EIz / L2);
+    setSym(k, 1, 11, 6.0 * EIz / L2);
+    setSym(k, 5, 7, -6.0 * EIz / L2);
+    setSym(k, 7, 11, -6.0 * EIz / L2);
+    setSym(k, 5, 5, 4.0 * EIz / L);
+    setSym(k, 11, 11, 4.0 * EIz / L);
+    setSym(k, 5, 11, 2.0 * EIz / L);
+
+    // Bending in the x'-z' plane (UZ, RY) about local y
+    const double EIy = E * element.iy;
+    setSym(k, 2, 2, 12.0 * EIy / L3);
+    setSym(k, 8, 8, 12.0 * EIy / L3);
+    setSym(k, 2, 8, -12.0 * EIy / L3);
+    setSym(k, 2, 4, -6.0 * EIy / L2);
+    setSym(k, 2, 10, -6.0 * EIy / L2);
+    setSym(k, 4, 8, 6.0 * EIy / L2);
+    setSym(k, 8, 10, 6.0 * EIy / L2);
+    setSym(k, 4, 4, 4.0 * EIy / L);
+    setSym(k, 10, 10, 4.0 * EIy / L);
+    setSym(k, 4, 10, 2.0 * EIy / L);
+}
+
+void globalStiffness(const FrameElement &element, const ElementAxes &axes, ElementMatrix &ke)
+{
+    ElementMatrix k;
+    localStiffness(element, axes.length, k);
+    const std::array<double, 9> &R = axes.rotation;
+
+    // K_ab = R^T k_ab R for each of the 4x4 blocks of 3x3
+    for (int bi = 0; bi < 4; ++bi) {
+        for (int bj = 0; bj < 4; ++bj) {
+            double kr[9]; // k_ab * R
+            for (int r = 0; r < 3; ++r) {
+                for (int c = 0; c < 3; ++c) {
+                    double sum = 0.0;
+                    for (int m = 0; m < 3; ++m) {
+                        sum += at(k, 3 * bi + r, 3 * bj + m) * R[static_cast<size_t>(3 * m + c)];
+                    }
+                    kr[3 * r + c] = sum;
+                }
+            }
+            for (int r = 0; r < 3; ++r) {
+                for (int c = 0; c < 3; ++c) {
+                    double sum = 0.0;
+                    for (int m = 0; m < 3; ++m) {
+                        sum += R[static_cast<size_t>(3 * m + r)] * kr[3 * m + c];
+                    }
+                    at(ke, 3 * bi + r, 3 * bj + c) = sum;
+                }
+            }
+        }
+    }
+}
+
+void toLocal(const ElementAxes &axes, const ElementVector &global, ElementVector &local)
+{
+    const std::array<double, 9> &R = axes.rotation;
+    for (size_t block = 0; block < 4; ++block) {
+        const double *g = global.data() + 3 * block;
+        for (size_t r = 0; r < 3; ++r) {
+            local[3 * block + r] = R[3 * r] * g[0] + R[3 * r + 1] * g[1] + R[3 * r + 2] * g[2];
+        }
+    }
+}
+
+void toGlobal(const ElementAxes &axes, const ElementVector &local, ElementVector &global)
+{
+    const std::array<double, 9> &R = axes.rotation;
+    for (size_t block = 0; block < 4; ++block) {
+        const double *l = local.data() + 3 * block;
+        for (size_t c = 0; c < 3; ++c) {
+            global[3 * block + c] = R[c] * l[0] + R[3 + c] * l[1] + R[6 + c] * l[2];
+        }
+    }
+}
+
+void uniformLoadVector(const ElementAxes &axes, const UniformElementLoad &load, ElementVector &local)
+{
+    std::array<double, 3> q = load.intensity;
+    if (!load.local) {
+        const std::array<double, 9> &R = axes.rotation;
+        q = {{R[0] * load.intensity[0] + R[1] * load.intensity[1] + R[2] * load.intensity[2],
+              R[3] * load.intensity[0] + R[4] * load.intensity[1] + R[5] * load.intensity[2],
+              R[6] * load.intensity[0] + R[7] * load.intensity[1] + R[8] * load.intensity[2]}};
+    }
+    const double L = axes.length;
+    const double half = 0.5 * L;
+    const double moment = L * L / 12.0;
+
+    local.fill(0.0);
+    local[0] = q[0] * half;
+    local[6] = q[0] * half;
+    local[1] = q[1] * half;
+    local[7] = q[1] * half;
+    local[5] = q[1] * moment;
+    local[11] = -q[1] * moment;
+    local[2] = q[2] * half;
+    local[8] = q[2] * half;
+    local[4] = -q[2] * moment;
+    local[10] = q[2] * moment;
+}
+
+} // namespace Structura::Analysis
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "FrameModel.h"
+#include <array>
+
+namespace Structura::Geometry {
+class DefaultLocalAxisProvider;
+}
+
+namespace Structura::Analysis {
+
+/**
+ * @brief Length and orientation of one frame element.
+ *
+ * rotation holds the local unit axes x', y', z' as rows, so that
+ * v_local = rotation * v_global.
+ */
+struct ElementAxes
+{
+    double length{0.0};
+    std::array<double, 9> rotation{};
+};
+
+/// Dense 12x12 element matrix, row-major, DOFs (node i UX..RZ, node j UX..RZ)
+using ElementMatrix = std::array<double, kElementDofs * kElementDofs>;
+
+/// 12-entry element vector in the same DOF order
+using ElementVector = std::array<double, kElementDofs>;
+
+/**
+ * @brief Compute the local axes of @p element.
+ * @param model Model holding the node coordinates
+ * @param element Element whose axes to compute
+ * @param provider Axis provider (handles the k-point and its fallbacks)
+ * @param axes Receives the length and rotation
+ * @return false if the element is degenerate (zero length or unknown nodes)
+ */
+bool computeElementAxes(const FrameModel &model,
+                        const FrameElement &element,
+                        const Structura::Geometry::DefaultLocalAxisProvider &provider,
+                        ElementAxes &axes);
+
+/**
+ * @brief Euler-Bernoulli space-frame stiffness in local axes.
+ */
+void localStiffness(const FrameElement &element, double length, ElementMatrix &k);
+
+/**
+ * @brief Element stiffness in global axes, T^T k T.
+ *
+ * T is block diagonal with the 3x3 rotation repeated four times, so the
+ * product is formed block by block (R^T k_ab R) instead of with 12x12 GEMMs.
+ */
+void globalStiffness(const FrameElement &element, const ElementAxes &axes, ElementMatrix &ke);
+
+/// Rotate a 12-vector from global to local axes (T v)
+void toLocal(const ElementAxes &axes, const ElementVector &global, ElementVector &local);
+
+/// Rotate a 12-vector from local to global axes (T^T v)
+void toGlobal(const ElementAxes &axes, const ElementVector &local, ElementVector &global);
+
+/**
+ * @brief Equivalent nodal loads of a uniform load, in local axes.
+ *
+ * These are the fixed-end reactions with their sign reversed: wL/2 at each
+ * end plus the end moments wL^2/12 of the bending components.
+ */
+void uniformLoadVector(const ElementAxes &axes, const UniformElementLoad &load, ElementVector &local);
+
+} // namespace Structura::Analysis
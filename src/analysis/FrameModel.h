@@ -0,0 +1,82 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace Structura::Analysis {
+
+/// Degrees of freedom per node, in the order UX, UY, UZ, RX, RY, RZ
+constexpr int kNodeDofs = 6;
+
+/// Degrees of freedom per two-node frame element
+constexpr int kElementDofs = 2 * kNodeDofs;
+
+/**
+ * @brief Two-node 3D frame (beam-column) element with resolved properties.
+ *
+ * Bending about local z uses iz (deflection along local y); bending about
+ * local y uses iy (deflection along local z). Local axes come from
+ * Structura::Geometry::DefaultLocalAxisProvider, oriented by the k-point.
+ */
+struct FrameElement
+{
+    std::array<int, 2> nodes{{-1, -1}}; ///< Node indices (start, end)
+    double youngModulus{0.0};           ///< E
+    double shearModulus{0.0};           ///< G
+    double area{0.0};                   ///< A
+    double iy{0.0};                     ///< Second moment about local y
+    double iz{0.0};                     ///< Second moment about local z
+    double torsionalConstant{0.0};      ///< J
+    std::optional<std::array<double, 3>> kPoint; ///< Orientation point, global
+};
+
+/**
+ * @brief Uniformly distributed force along a whole element.
+ */
+struct UniformElementLoad
+{
+    int element{-1};
+    std::array<double, 3> intensity{{0.0, 0.0, 0.0}}; ///< Force per unit length
+    bool local{false}; ///< intensity in element axes (x', y', z') instead of global
+};
+
+/**
+ * @brief Headless description of a linear frame model for one load case.
+ *
+ * Plain arrays indexed by dense node / element numbers, with no Qt or
+ * repository types, so the analysis can run on any thread and be tested in
+ * isolation. AnalysisService builds it from the model repository.
+ */
+struct FrameModel
+{
+    std::vector<double> coordinates;        ///< x, y, z per node
+    std::vector<std::uint8_t> restraints;   ///< Per node, bit i set when DOF i is fixed
+    std::vector<FrameElement> elements;
+    std::vector<double> nodalLoads;         ///< Fx, Fy, Fz, Mx, My, Mz per node (global); may be empty
+    std::vector<UniformElementLoad> elementLoads;
+
+    size_t nodeCount() const { return restraints.size(); }
+    size_t elementCount() const { return elements.size(); }
+
+    /// Append a node and return its index
+    int addNode(double x, double y, double z, std::uint8_t restraintMask = 0)
+    {
+        coordinates.insert(coordinates.end(), {x, y, z});
+        restraints.push_back(restraintMask);
+        return static_cast<int>(restraints.size() - 1);
+    }
+
+    /// Add a global force/moment to node @p node (DOF order UX..RZ)
+    void addNodalLoad(int node, const std::array<double, kNodeDofs> &load)
+    {
+        nodalLoads.resize(kNodeDofs * nodeCount(), 0.0);
+        for (int d = 0; d < kNodeDofs; ++d) {
+            nodalLoads[static_cast<size_t>(kNodeDofs * node + d)] += load[static_cast<size_t>(d)];
+        }
+    }
+};
+
+} // namespace Structura::Analysis
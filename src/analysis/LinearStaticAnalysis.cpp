@@ -0,0 +1,597 @@
+#include "LinearStaticAnalysis.h"
+#include "ConjugateGradient.h"
+#include "ElementStiffness.h"
+#include "MatrixFreeOperator.h"
+#include "NodeOrdering.h"
+#include "Preconditioners.h"
+#include "SparseLdlt.h"
+#include "SkylineLdlt.h"
+#include "SmoothedAggregation.h"
+#include "SparseMatrix.h"
+#include "StiffnessAssembly.h"
+#include "SupernodalLdlt.h"
+#include "ThreadPool.h"
+#include "../LocalCoordinateSystem.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <numeric>
+#include <utility>
+
+namespace Structura::Analysis {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double millisecondsSince(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+bool hasValidProperties(const FrameElement &element)
+{
+    return element.youngModulus > 0.0 && element.shearModulus > 0.0 && element.area > 0.0
+        && element.iy > 0.0 && element.iz > 0.0 && element.torsionalConstant > 0.0;
+}
+
+/**
+ * @brief Ordering, equation numbering and CSR structure, unless
+ *        @p assembly already fits the model; fills the size figures.
+ */
+void prepareStructure(const FrameModel &model,
+                      OrderingMethod ordering,
+                      StiffnessAssembly &assembly,
+                      AnalysisStatistics &statistics)
+{
+    statistics.ordering = ordering;
+    statistics.symbolicReused = assembly.fits(model);
+    if (!statistics.symbolicReused) {
+        auto start = Clock::now();
+        const NodeGraph graph = NodeGraph::fromModel(model);
+        const std::vector<int> order = nodeOrder(ordering, model, graph);
+        statistics.orderingMs = millisecondsSince(start);
+        start = Clock::now();
+        assembly.analyse(model, graph, order);
+        statistics.symbolicMs = millisecondsSince(start);
+    }
+    statistics.equations = assembly.equationCount();
+    statistics.matrixNonZeros = assembly.matrix().nonZeros();
+    statistics.bandwidth = assembly.matrix().bandwidth();
+    statistics.profile = assembly.matrix().profile();
+    const CsrMatrix &matrix = assembly.matrix();
+    statistics.stiffnessBytes = matrix.rowStart.size() * sizeof(size_t)
+                              + matrix.nonZeros() * (sizeof(int) + sizeof(double));
+}
+
+/**
+ * @brief Ordering and equation numbering alone, for the matrix-free solver;
+ *        fills the equation count.
+ */
+void numberStructure(const FrameModel &model,
+                     OrderingMethod ordering,
+                     std::vector<int> &equations,
+                     std::vector<int> &dofOfEquation,
+                     AnalysisStatistics &statistics)
+{
+    statistics.ordering = ordering;
+    auto start = Clock::now();
+    const NodeGraph graph = NodeGraph::fromModel(model);
+    const std::vector<int> order = nodeOrder(ordering, model, graph);
+    statistics.orderingMs = millisecondsSince(start);
+    start = Clock::now();
+    numberEquations(model, graph, order, equations, dofOfEquation);
+    statistics.symbolicMs = millisecondsSince(start);
+    statistics.equations = static_cast<int>(dofOfEquation.size());
+}
+
+/**
+ * @brief Direct solver selected by @p options (SupernodalLdlt for
+ *        Automatic); @p pool (may be null) runs the factorization of the
+ *        solvers that use threads.
+ */
+std::unique_ptr<DirectSolver> makeSolver(const AnalysisOptions &options, ThreadPool *pool)
+{
+    if (options.solver == SolverMethod::UpLookingLdlt) {
+        return std::make_unique<SparseLdlt>();
+    }
+    if (options.solver == SolverMethod::SkylineLdlt) {
+        return std::make_unique<SkylineLdlt>();
+    }
+    auto solver = std::make_unique<SupernodalLdlt>();
+    solver->setThreadPool(pool);
+    return solver;
+}
+
+bool isIterative(SolverMethod solver)
+{
+    return solver == SolverMethod::ConjugateGradient || solver == SolverMethod::MatrixFreeConjugateGradient;
+}
+
+void reportUnstable(const std::vector<int> &dofOfEquation, int equation, AnalysisResult &result)
+{
+    const int dof = dofOfEquation[static_cast<size_t>(equation)];
+    result.status = AnalysisStatus::Unstable;
+    result.failedNode = dof / kNodeDofs;
+    result.failedDof = dof % kNodeDofs;
+}
+
+/// Smallest pivot of the rigid motion Gram matrix, relative to its largest diagonal, still taken as restrained
+constexpr double kRigidMotionTolerance = 1e-12;
+
+/**
+ * @brief Equation of a free DOF moved by a rigid body motion that the
+ *        restraints leave unopposed, or -1.
+ *
+ * Elements are rigid-jointed beams whose stiffness vanishes only for rigid
+ * motions of their two ends, so K of a connected group of elements is
+ * singular exactly for the six rigid body motions of the group. With the
+ * restrained DOFs removed it is singular when a combination of them moves
+ * no restrained DOF, which is what this checks per group: G holds the
+ * motion of every restrained DOF under each unit rigid motion (about the
+ * group centre, lengths over the group size), and G^T G is factorized with
+ * diagonal pivoting. On a zero pivot the motion it leaves free is
+ * recovered, and the free DOF it moves most is reported.
+ *
+ * Direct solvers find such mechanisms as zero pivots; conjugate gradients
+ * converge on a singular K whenever the load has no part along the
+ * mechanism, so the iterative solvers check first.
+ */
+int unrestrainedRigidMotion(const FrameModel &model, const std::vector<int> &equations)
+{
+    const size_t nodeCount = model.nodeCount();
+    std::vector<int> group(nodeCount);
+    std::iota(group.begin(), group.end(), 0);
+    const auto root = [&group](int node) {
+        while (group[static_cast<size_t>(node)] != node) {
+            node = group[static_cast<size_t>(node)] = group[static_cast<size_t>(group[static_cast<size_t>(node)])];
+        }
+        return node;
+    };
+    std::vector<bool> connected(nodeCount, false);
+    for (const FrameElement &element : model.elements) {
+        connected[static_cast<size_t>(element.nodes[0])] = true;
+        connected[static_cast<size_t>(element.nodes[1])] = true;
+        group[static_cast<size_t>(root(element.nodes[0]))] = root(element.nodes[1]);
+    }
+
+    // Nodes of each group, groups in order of their lowest node
+    std::vector<int> groupOfRoot(nodeCount, -1);
+    std::vector<std::vector<int>> members;
+    for (size_t node = 0; node < nodeCount; ++node) {
+        if (!connected[node]) {
+            continue;
+        }
+        int &index = groupOfRoot[static_cast<size_t>(root(static_cast<int>(node)))];
+        if (index < 0) {
+            index = static_cast<int>(members.size());
+            members.emplace_back();
+        }
+        members[static_cast<size_t>(index)].push_back(static_cast<int>(node));
+    }
+
+    for (const std::vector<int> &nodes : members) {
+        std::array<double, 3> low{};
+        std::array<double, 3> high{};
+        for (size_t axis = 0; axis < 3; ++axis) {
+            low[axis] = high[axis] = model.coordinates[3 * static_cast<size_t>(nodes.front()) + axis];
+        }
+        for (int node : nodes) {
+            for (size_t axis = 0; axis < 3; ++axis) {
+                const double x = model.coordinates[3 * static_cast<size_t>(node) + axis];
+                low[axis] = std::min(low[axis], x);
+                high[axis] = std::max(high[axis], x);
+            }
+        }
+        const double size = std::max({high[0] - low[0], high[1] - low[1], high[2] - low[2]});
+
+        // Motion of DOF d of @p node under unit rigid motion m: translations
+        // t, then rotations w, u = t + w x r
+        const auto motion = [&](int node, size_t d, std::array<double, 6> &row) {
+            std::array<double, 3> r{};
+            for (size_t axis = 0; axis < 3; ++axis) {
+                r[axis] = (model.coordinates[3 * static_cast<size_t>(node) + axis] - 0.5 * (low[axis] + high[axis]))
+                        / size;
+            }
+            row.fill(0.0);
+            row[d] = 1.0;
+            if (d == 0) {
+                row[4] = r[2];
+                row[5] = -r[1];
+            } else if (d == 1) {
+                row[3] = -r[2];
+                row[5] = r[0];
+            } else if (d == 2) {
+                row[3] = r[1];
+                row[4] = -r[0];
+            }
+        };
+
+        double gram[6][6] = {};
+        std::array<double, 6> row{};
+        for (int node : nodes) {
+            for (size_t d = 0; d < kNodeDofs; ++d) {
+                if (((model.restraints[static_cast<size_t>(node)] >> d) & 1u) == 0) {
+                    continue;
+                }
+                motion(node, d, row);
+                for (size_t i = 0; i < 6; ++i) {
+                    for (size_t j = 0; j < 6; ++j) {
+                        gram[i][j] += row[i] * row[j];
+                    }
+                }
+            }
+        }
+
+        // LDL^T of G^T G with diagonal pivoting, in place
+        std::array<size_t, 6> order{{0, 1, 2, 3, 4, 5}};
+        const double largest = std::max({gram[0][0], gram[1][1], gram[2][2], gram[3][3], gram[4][4], gram[5][5]});
+        size_t rank = 0;
+        for (; rank < 6; ++rank) {
+            size_t pivot = rank;
+            for (size_t k = rank + 1; k < 6; ++k) {
+                if (gram[order[k]][order[k]] > gram[order[pivot]][order[pivot]]) {
+                    pivot = k;
+                }
+            }
+            std::swap(order[rank], order[pivot]);
+            const size_t p = order[rank];
+            if (!(gram[p][p] > kRigidMotionTolerance * largest)) {
+                break;
+            }
+            for (size_t k = rank + 1; k < 6; ++k) {
+                const size_t i = order[k];
+                const double factor = gram[i][p] / gram[p][p];
+                for (size_t l = rank + 1; l < 6; ++l) {
+                    gram[i][order[l]] -= factor * gram[p][order[l]];
+                }
+                gram[i][p] = factor;
+            }
+        }
+        if (rank == 6) {
+            continue;
+        }
+
+        // Free motion: unit amount of the first unpivoted one, the pivoted
+        // ones solved from the eliminated rows (back substitution)
+        std::array<double, 6> free{};
+        free[order[rank]] = 1.0;
+        for (size_t k = rank; k-- > 0;) {
+            const size_t p = order[k];
+            double sum = gram[p][order[rank]];
+            for (size_t l = k + 1; l < rank; ++l) {
+                sum += gram[p][order[l]] * free[order[l]];
+            }
+            free[p] = -sum / gram[p][p];
+        }
+
+        int worst = -1;
+        double worstMotion = 0.0;
+        for (int node : nodes) {
+            for (size_t d = 0; d < kNodeDofs; ++d) {
+                const int eq = equations[kNodeDofs * static_cast<size_t>(node) + d];
+                if (eq < 0) {
+                    continue;
+                }
+                motion(node, d, row);
+                const double amount = std::abs(std::inner_product(row.begin(), row.end(), free.begin(), 0.0));
+                if (amount > worstMotion) {
+                    worstMotion = amount;
+                    worst = eq;
+                }
+            }
+        }
+        return worst;
+    }
+    return -1;
+}
+
+/// Equations of each node as blocks: the free DOFs of a node are consecutive
+std::vector<int> nodeBlocks(const std::vector<int> &dofOfEquation)
+{
+    std::vector<int> blockStart{0};
+    for (size_t eq = 1; eq < dofOfEquation.size(); ++eq) {
+        if (dofOfEquation[eq] / kNodeDofs != dofOfEquation[eq - 1] / kNodeDofs) {
+            blockStart.push_back(static_cast<int>(eq));
+        }
+    }
+    blockStart.push_back(static_cast<int>(dofOfEquation.size()));
+    return blockStart;
+}
+
+std::unique_ptr<Preconditioner> makePreconditioner(PreconditionerMethod method, const CsrMatrix &stiffness,
+                                                   const std::vector<int> &dofOfEquation,
+                                                   const std::vector<double> &coordinates)
+{
+    switch (method) {
+    case PreconditionerMethod::Jacobi:
+        return std::make_unique<JacobiPreconditioner>(stiffness);
+    case PreconditionerMethod::BlockJacobi:
+        return std::make_unique<BlockJacobiPreconditioner>(stiffness, nodeBlocks(dofOfEquation));
+    case PreconditionerMethod::IncompleteCholesky:
+        return std::make_unique<IncompleteCholeskyPreconditioner>(stiffness);
+    case PreconditionerMethod::SmoothedAggregation:
+        break;
+    }
+    return std::make_unique<SmoothedAggregationPreconditioner>(stiffness, dofOfEquation, coordinates);
+}
+
+/**
+ * @brief K x = f by preconditioned conjugate gradients, x holding f on entry.
+ * @param preconditionerMethod Method to use
+ * @param preconditionerMatrix K, or the part of it the preconditioner is
+ *        built from
+ * @return false with the status of @p result set on failure
+ */
+bool solveIterative(const AnalysisOptions &options, PreconditionerMethod preconditionerMethod,
+                    const LinearOperator &stiffness, const CsrMatrix &preconditionerMatrix,
+                    const std::vector<int> &dofOfEquation, const std::vector<double> &coordinates,
+                    ThreadPool *pool, std::vector<double> &x, AnalysisResult &result)
+{
+    AnalysisStatistics &statistics = result.statistics;
+    auto start = Clock::now();
+    const std::unique_ptr<Preconditioner> preconditioner =
+        makePreconditioner(preconditionerMethod, preconditionerMatrix, dofOfEquation, coordinates);
+    statistics.preconditionerMs = millisecondsSince(start);
+    if (preconditioner->failedEquation() >= 0) {
+        reportUnstable(dofOfEquation, preconditioner->failedEquation(), result);
+        return false;
+    }
+
+    start = Clock::now();
+    const std::vector<double> loads = x;
+    const ConjugateGradient solver(options.iterativeTolerance, options.maxIterations, pool);
+    ConvergenceReport report = solver.solve(stiffness, *preconditioner, loads.data(), x.data());
+    statistics.solveMs = millisecondsSince(start);
+    statistics.iterations = report.iterations;
+    statistics.relativeResidual = report.relativeResidual;
+    statistics.residualHistory = std::move(report.residualHistory);
+    if (!report.converged) {
+        result.status = AnalysisStatus::NotConverged;
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+AnalysisStatistics LinearStaticAnalysis::estimate(const FrameModel &model) const
+{
+    AnalysisStatistics statistics;
+    statistics.solver = m_options.solver;
+    if (m_options.solver == SolverMethod::MatrixFreeConjugateGradient) {
+        std::vector<int> equations;
+        std::vector<int> dofOfEquation;
+        numberStructure(model, m_options.ordering, equations, dofOfEquation, statistics);
+        statistics.stiffnessBytes = model.elements.size() * MatrixFreeOperator::bytesPerElement(m_options.elementStorage);
+        return statistics;
+    }
+    StiffnessAssembly assembly;
+    prepareStructure(model, m_options.ordering, assembly, statistics);
+    if (statistics.equations > 0 && m_options.solver != SolverMethod::ConjugateGradient) {
+        const std::unique_ptr<DirectSolver> factor = makeSolver(m_options, nullptr);
+        factor->analyse(assembly.matrix());
+        statistics.predictedFactorNonZeros = factor->factorNonZeros();
+        statistics.factorBytes = factor->factorBytes();
+    }
+    if (statistics.solver == SolverMethod::Automatic) {
+        statistics.solver = statistics.predictedFactorNonZeros > m_options.directFactorLimit
+                                ? SolverMethod::ConjugateGradient
+                                : SolverMethod::SupernodalLdlt;
+    }
+    return statistics;
+}
+
+AnalysisResult LinearStaticAnalysis::run(const FrameModel &model, StiffnessAssembly *reusableAssembly) const
+{
+    AnalysisResult result;
+    const size_t nodeCount = model.nodeCount();
+    if (model.elements.empty()) {
+        return result;
+    }
+
+    // Element geometry; rejects degenerate elements up front
+    Structura::Geometry::DefaultLocalAxisProvider axisProvider;
+    std::vector<ElementAxes> axes(model.elements.size());
+    for (size_t e = 0; e < model.elements.size(); ++e) {
+        if (!hasValidProperties(model.elements[e])
+            || !computeElementAxes(model, model.elements[e], axisProvider, axes[e])) {
+            result.status = AnalysisStatus::InvalidElement;
+            result.failedElement = static_cast<int>(e);
+            return result;
+        }
+    }
+
+    // Symbolic phase, skipped when the caller hands in a structure that
+    // still fits. The matrix-free solver only needs the equation numbering.
+    const bool matrixFree = m_options.solver == SolverMethod::MatrixFreeConjugateGradient;
+    StiffnessAssembly localAssembly;
+    StiffnessAssembly &assembly = reusableAssembly && !matrixFree ? *reusableAssembly : localAssembly;
+    std::vector<int> freeEquations;
+    std::vector<int> freeDofs;
+    if (matrixFree) {
+        numberStructure(model, m_options.ordering, freeEquations, freeDofs, result.statistics);
+    } else {
+        prepareStructure(model, m_options.ordering, assembly, result.statistics);
+    }
+    const std::vector<int> &equations = matrixFree ? freeEquations : assembly.equations();
+    const std::vector<int> &dofOfEquation = matrixFree ? freeDofs : assembly.dofOfEquation();
+    const int equationCount = static_cast<int>(dofOfEquation.size());
+    if (equationCount == 0) {
+        return result;
+    }
+
+    std::unique_ptr<ThreadPool> pool;
+    if (m_options.threads != 1) {
+        pool = std::make_unique<ThreadPool>(m_options.threads);
+    }
+    result.statistics.threads = pool ? pool->threadCount() : 1;
+
+    auto start = Clock::now();
+    const CsrMatrix *stiffness = nullptr;
+    if (!matrixFree) {
+        stiffness = &assembly.assemble(model, axes, m_options.assembly, pool.get());
+        result.statistics.assemblyMs = millisecondsSince(start);
+    }
+
+    // Load vector: nodal loads plus equivalent loads of element loads
+    const auto dofCount = kNodeDofs * nodeCount;
+    std::vector<double> loads(dofCount, 0.0);
+    if (model.nodalLoads.size() == dofCount) {
+        loads = model.nodalLoads;
+    }
+    std::vector<ElementVector> fixedEnd(model.elements.size(), ElementVector{});
+    std::vector<bool> loaded(model.elements.size(), false);
+    for (const UniformElementLoad &load : model.elementLoads) {
+        if (load.element < 0 || static_cast<size_t>(load.element) >= model.elements.size()) {
+            continue;
+        }
+        const auto e = static_cast<size_t>(load.element);
+        ElementVector local;
+        uniformLoadVector(axes[e], load, local);
+        for (size_t i = 0; i < kElementDofs; ++i) {
+            fixedEnd[e][i] += local[i];
+        }
+        loaded[e] = true;
+    }
+    for (size_t e = 0; e < model.elements.size(); ++e) {
+        if (!loaded[e]) {
+            continue;
+        }
+        ElementVector global;
+        toGlobal(axes[e], fixedEnd[e], global);
+        for (size_t end = 0; end < 2; ++end) {
+            const size_t base = kNodeDofs * static_cast<size_t>(model.elements[e].nodes[end]);
+            for (size_t d = 0; d < kNodeDofs; ++d) {
+                loads[base + d] += global[kNodeDofs * end + d];
+            }
+        }
+    }
+
+    std::vector<double> x(static_cast<size_t>(equationCount));
+    for (int eq = 0; eq < equationCount; ++eq) {
+        x[static_cast<size_t>(eq)] = loads[static_cast<size_t>(dofOfEquation[static_cast<size_t>(eq)])];
+    }
+
+    // The symbolic factorization predicts the fill, which decides the
+    // automatic choice between factorizing and iterating
+    SolverMethod solver = m_options.solver;
+    std::unique_ptr<DirectSolver> factor;
+    if (!isIterative(solver)) {
+        start = Clock::now();
+        factor = makeSolver(m_options, pool.get());
+        factor->analyse(*stiffness);
+        result.statistics.predictedFactorNonZeros = factor->factorNonZeros();
+        result.statistics.factorBytes = factor->factorBytes();
+        result.statistics.symbolicMs += millisecondsSince(start);
+        if (solver == SolverMethod::Automatic) {
+            solver = factor->factorNonZeros() > m_options.directFactorLimit ? SolverMethod::ConjugateGradient
+                                                                            : SolverMethod::SupernodalLdlt;
+        }
+    }
+    result.statistics.solver = solver;
+
+    if (isIterative(solver)) {
+        const int equation = unrestrainedRigidMotion(model, equations);
+        if (equation >= 0) {
+            reportUnstable(dofOfEquation, equation, result);
+            return result;
+        }
+    }
+
+    if (solver == SolverMethod::ConjugateGradient) {
+        factor.reset();
+        const CsrOperator stiffnessOperator(*stiffness, pool.get());
+        if (!solveIterative(m_options, m_options.preconditioner, stiffnessOperator, *stiffness, dofOfEquation,
+                            model.coordinates, pool.get(), x, result)) {
+            return result;
+        }
+    } else if (matrixFree) {
+        // The preconditioners only see the nodal diagonal blocks of K, too
+        // little for multigrid, which falls back to block-Jacobi
+        start = Clock::now();
+        const MatrixFreeOperator stiffnessOperator(model, axes, equations, equationCount, m_options.elementStorage,
+                                                   pool.get());
+        const CsrMatrix blockDiagonal = nodalBlockDiagonal(model, axes, equations, dofOfEquation);
+        result.statistics.assemblyMs = millisecondsSince(start);
+        result.statistics.stiffnessBytes = stiffnessOperator.bytes();
+        const PreconditionerMethod preconditioner = m_options.preconditioner == PreconditionerMethod::SmoothedAggregation
+                                                        ? PreconditionerMethod::BlockJacobi
+                                                        : m_options.preconditioner;
+        if (!solveIterative(m_options, preconditioner, stiffnessOperator, blockDiagonal, dofOfEquation,
+                            model.coordinates, pool.get(), x, result)) {
+            return result;
+        }
+    } else {
+        start = Clock::now();
+        if (!factor->factorizeNumeric(*stiffness, m_options.pivotTolerance)) {
+            reportUnstable(dofOfEquation, factor->failedEquation(), result);
+            return result;
+        }
+        result.statistics.factorMs = millisecondsSince(start);
+        result.statistics.factorNonZeros = factor->factorNonZeros();
+
+        start = Clock::now();
+        factor->solve(x.data());
+        result.statistics.solveMs = millisecondsSince(start);
+    }
+
+    result.displacements.assign(dofCount, 0.0);
+    for (int eq = 0; eq < equationCount; ++eq) {
+        result.displacements[static_cast<size_t>(dofOfEquation[static_cast<size_t>(eq)])] = x[static_cast<size_t>(eq)];
+    }
+
+    // Member end actions, f = k T u - f_fixed, and reactions at the supports
+    // from the element actions on each restrained DOF minus the applied load
+    result.elementForces.assign(kElementDofs * model.elements.size(), 0.0);
+    std::vector<double> nodeActions(dofCount, 0.0);
+    ElementMatrix k;
+    for (size_t e = 0; e < model.elements.size(); ++e) {
+        const FrameElement &element = model.elements[e];
+        ElementVector globalDisplacement;
+        for (size_t end = 0; end < 2; ++end) {
+            const size_t base = kNodeDofs * static_cast<size_t>(element.nodes[end]);
+            for (size_t d = 0; d < kNodeDofs; ++d) {
+                globalDisplacement[kNodeDofs * end + d] = result.displacements[base + d];
+            }
+        }
+        ElementVector localDisplacement;
+        toLocal(axes[e], globalDisplacement, localDisplacement);
+        localStiffness(element, axes[e].length, k);
+        ElementVector local;
+        for (size_t i = 0; i < kElementDofs; ++i) {
+            double sum = -fixedEnd[e][i];
+            for (size_t j = 0; j < kElementDofs; ++j) {
+                sum += k[i * kElementDofs + j] * localDisplacement[j];
+            }
+            local[i] = sum;
+            result.elementForces[kElementDofs * e + i] = sum;
+        }
+        ElementVector global;
+        toGlobal(axes[e], local, global);
+        for (size_t end = 0; end < 2; ++end) {
+            const size_t base = kNodeDofs * static_cast<size_t>(element.nodes[end]);
+            for (size_t d = 0; d < kNodeDofs; ++d) {
+                nodeActions[base + d] += global[kNodeDofs * end + d];
+            }
+        }
+    }
+    result.reactions.assign(dofCount, 0.0);
+    for (size_t node = 0; node < nodeCount; ++node) {
+        const std::uint8_t mask = model.restraints[node];
+        for (size_t d = 0; d < kNodeDofs; ++d) {
+            if ((mask >> d) & 1u) {
+                const size_t dof = kNodeDofs * node + d;
+                const double applied = model.nodalLoads.size() == dofCount ? model.nodalLoads[dof] : 0.0;
+                result.reactions[dof] = nodeActions[dof] - applied;
+            }
+        }
+    }
+
+    result.status = AnalysisStatus::Success;
+    return result;
+}
+
+} // namespace Structura::Analysis
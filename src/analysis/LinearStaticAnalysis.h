@@ -0,0 +1,177 @@
+#pragma once
+
+#include "FrameModel.h"
+#include "MatrixFreeOperator.h"
+#include "NodeOrdering.h"
+#include "Preconditioners.h"
+#include "StiffnessAssembly.h"
+#include <cstddef>
+#include <vector>
+
+namespace Structura::Analysis {
+
+/**
+ * @brief Linear solvers the analysis can use for K u = f.
+ */
+enum class SolverMethod
+{
+    UpLookingLdlt,  ///< SparseLdlt: serial, row by row
+    SupernodalLdlt, ///< SupernodalLdlt: dense supernode kernels, multithreaded
+    SkylineLdlt,    ///< SkylineLdlt: envelope storage, least memory with ReverseCuthillMcKee
+    ConjugateGradient, ///< Preconditioned CG on the assembled matrix, no factorization
+    MatrixFreeConjugateGradient, ///< Preconditioned CG on MatrixFreeOperator: K is never assembled
+    Automatic       ///< SupernodalLdlt, or ConjugateGradient when the factor would be too large
+};
+
+/**
+ * @brief Tuning knobs of a linear static run.
+ */
+struct AnalysisOptions
+{
+    /// Relative pivot size below which the structure is reported unstable
+    double pivotTolerance{1e-10};
+
+    /// Node elimination order used to number the equations
+    OrderingMethod ordering{OrderingMethod::ApproximateMinimumDegree};
+
+    SolverMethod solver{SolverMethod::Automatic};
+
+    /// Threads of the assembly, the factorization and the iterative solver;
+    /// 0 uses all hardware threads
+    int threads{0};
+
+    /// Sharing of the element matrices among the threads; K does not depend
+    /// on the thread count with either
+    AssemblyMethod assembly{AssemblyMethod::Coloured};
+
+    /// Automatic solver: largest predicted nnz(L) still factorized (about 1.2 GB of values)
+    size_t directFactorLimit{150000000};
+
+    /// Preconditioner of the iterative solver. IncompleteCholesky needs fewer
+    /// iterations with a banded numbering (ReverseCuthillMcKee or Natural)
+    /// than with minimum degree, which leaves it much weaker on plane grids.
+    /// SmoothedAggregation needs the assembled matrix; the matrix-free
+    /// solver uses BlockJacobi instead
+    PreconditionerMethod preconditioner{PreconditionerMethod::BlockJacobi};
+
+    /// Relative residual |f - K u| / |f| at which the iterative solver stops
+    double iterativeTolerance{1e-10};
+
+    /// Iteration limit of the iterative solver; 0 allows as many as equations
+    int maxIterations{0};
+
+    /// MatrixFreeConjugateGradient: element data kept by the operator
+    ElementStorage elementStorage{ElementStorage::LocalCoefficients};
+};
+
+enum class AnalysisStatus
+{
+    Success,
+    EmptyModel,      ///< No elements, or no free degree of freedom
+    InvalidElement,  ///< Zero length, unknown node or non-positive property
+    Unstable,        ///< Singular stiffness: mechanism or missing supports
+    NotConverged     ///< Iterative solver stopped before reaching its tolerance
+};
+
+/**
+ * @brief Size and timing figures of one run.
+ */
+struct AnalysisStatistics
+{
+    OrderingMethod ordering{OrderingMethod::ApproximateMinimumDegree};
+    SolverMethod solver{SolverMethod::SupernodalLdlt}; ///< Solver that ran, never Automatic
+    int threads{1};            ///< Threads the assembly and the solver ran on
+    int equations{0};
+    size_t matrixNonZeros{0};  ///< Both triangles of K
+    int bandwidth{0};          ///< Of K in the chosen numbering
+    size_t profile{0};         ///< Envelope of the lower triangle of K
+    size_t stiffnessBytes{0};  ///< Memory of K: CSR arrays, or the element data of the matrix-free operator
+    size_t predictedFactorNonZeros{0}; ///< nnz(L) from the symbolic factorization
+    size_t factorNonZeros{0};  ///< Strictly lower part of L
+    size_t factorBytes{0};     ///< Memory of the factorization (DirectSolver::factorBytes())
+    bool symbolicReused{false}; ///< Ordering and CSR structure came from an earlier run
+    double orderingMs{0.0};
+    double symbolicMs{0.0};    ///< Equation numbering, CSR structure and elimination tree
+    double assemblyMs{0.0};    ///< Numeric assembly only, or setup of the matrix-free operator
+    double factorMs{0.0};
+    double solveMs{0.0};
+
+    // Iterative solver only
+    int iterations{0};
+    double relativeResidual{0.0};
+    std::vector<double> residualHistory; ///< Relative residual after 0, 1, ... iterations
+    double preconditionerMs{0.0};        ///< Preconditioner setup; the iterations count as solveMs
+};
+
+/**
+ * @brief Outcome of a linear static analysis.
+ *
+ * Node arrays hold 6 values per node (UX, UY, UZ, RX, RY, RZ). Element
+ * forces hold 12 values per element: the member end actions (forces and
+ * moments acting on the element at its start and end) in local axes.
+ */
+struct AnalysisResult
+{
+    AnalysisStatus status{AnalysisStatus::EmptyModel};
+    int failedNode{-1};      ///< Node of the unstable DOF (Unstable)
+    int failedDof{-1};       ///< 0-5, UX..RZ (Unstable)
+    int failedElement{-1};   ///< Offending element (InvalidElement)
+
+    std::vector<double> displacements;
+    std::vector<double> reactions;     ///< Nonzero only at restrained DOFs
+    std::vector<double> elementForces;
+    AnalysisStatistics statistics;
+
+    bool succeeded() const { return status == AnalysisStatus::Success; }
+};
+
+/**
+ * @brief Linear static analysis of 3D frames (Euler-Bernoulli elements).
+ *
+ * Steps: node ordering (AnalysisOptions::ordering), equation numbering of
+ * the free DOFs and CSR structure of the global stiffness (symbolic phase),
+ * numeric assembly, sparse LDL^T factorization or preconditioned conjugate
+ * gradients (AnalysisOptions::solver), then displacements, support reactions
+ * and member end forces. MatrixFreeConjugateGradient only numbers the
+ * equations and iterates on MatrixFreeOperator, so neither the CSR
+ * structure nor the matrix is ever built. Restrained
+ * DOFs are eliminated (zero prescribed displacement). Nodes not connected to any element get no equations.
+ *
+ * Thread safety: run() only reads the model and may be called concurrently
+ * on different models, each with its own StiffnessAssembly.
+ */
+class LinearStaticAnalysis
+{
+public:
+    explicit LinearStaticAnalysis(AnalysisOptions options = AnalysisOptions())
+        : m_options(options)
+    {
+    }
+
+    const AnalysisOptions &options() const { return m_options; }
+
+    /**
+     * @brief Analyse @p model.
+     * @param model Model to analyse
+     * @param assembly Optional symbolic structure kept by the caller between
+     *        runs. If it fits the model (same restraints and element
+     *        connectivity) it is reused as is, otherwise it is rebuilt in
+     *        place. Not used by MatrixFreeConjugateGradient.
+     */
+    AnalysisResult run(const FrameModel &model, StiffnessAssembly *assembly = nullptr) const;
+
+    /**
+     * @brief Size of the problem in the configured ordering, without
+     *        assembling or factorizing: equations, bandwidth, profile,
+     *        predicted nnz(L) and factor memory from the symbolic
+     *        factorization of the configured solver. For
+     *        MatrixFreeConjugateGradient only the equations and the
+     *        operator memory.
+     */
+    AnalysisStatistics estimate(const FrameModel &model) const;
+
+private:
+    AnalysisOptions m_options;
+};
+
+} // namespace Structura::Analysis
@@ -0,0 +1,263 @@
+#include "MatrixFreeOperator.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <array>
+
+namespace Structura::Analysis {
+
+namespace {
+
+constexpr size_t kLanes = MatrixFreeOperator::kLanes;
+
+// LocalCoefficients layout: stiffness terms of k, then the rotation R
+constexpr size_t kAxial = 0;    ///< EA / L
+constexpr size_t kTorsion = 1;  ///< GJ / L
+constexpr size_t kZ12 = 2;      ///< 12 EIz / L^3, bending about local z (UY, RZ)
+constexpr size_t kZ6 = 3;
+constexpr size_t kZ4 = 4;
+constexpr size_t kZ2 = 5;
+constexpr size_t kY12 = 6;      ///< 12 EIy / L^3, bending about local y (UZ, RY)
+constexpr size_t kY6 = 7;
+constexpr size_t kY4 = 8;
+constexpr size_t kY2 = 9;
+constexpr size_t kRotation = 10;
+constexpr size_t kLocalValues = kRotation + 9;
+constexpr size_t kGlobalValues = kElementDofs * kElementDofs;
+
+/// One 12-vector per lane, lane index fastest
+using LaneVector = double[kElementDofs][kLanes];
+
+void gather(const int *equations, const double *x, LaneVector u)
+{
+    for (size_t i = 0; i < kElementDofs; ++i) {
+        for (size_t l = 0; l < kLanes; ++l) {
+            const int eq = equations[i * kLanes + l];
+            u[i][l] = eq >= 0 ? x[eq] : 0.0;
+        }
+    }
+}
+
+void scatter(const int *equations, const LaneVector f, double *y)
+{
+    for (size_t i = 0; i < kElementDofs; ++i) {
+        for (size_t l = 0; l < kLanes; ++l) {
+            const int eq = equations[i * kLanes + l];
+            if (eq >= 0) {
+                y[eq] += f[i][l];
+            }
+        }
+    }
+}
+
+/// f = T^T k T u from the local coefficients @p c
+void localKernel(const double *c, const LaneVector u, LaneVector f)
+{
+    const double *R = c + kRotation * kLanes;
+    LaneVector v; // T u
+    for (size_t b = 0; b < 4; ++b) {
+        for (size_t r = 0; r < 3; ++r) {
+            for (size_t l = 0; l < kLanes; ++l) {
+                v[3 * b + r][l] = R[(3 * r) * kLanes + l] * u[3 * b][l] + R[(3 * r + 1) * kLanes + l] * u[3 * b + 1][l]
+                                + R[(3 * r + 2) * kLanes + l] * u[3 * b + 2][l];
+            }
+        }
+    }
+
+    // k v, term by term as in localStiffness()
+    LaneVector w;
+    for (size_t l = 0; l < kLanes; ++l) {
+        const double axial = c[kAxial * kLanes + l] * (v[0][l] - v[6][l]);
+        w[0][l] = axial;
+        w[6][l] = -axial;
+        const double torsion = c[kTorsion * kLanes + l] * (v[3][l] - v[9][l]);
+        w[3][l] = torsion;
+        w[9][l] = -torsion;
+
+        const double dy = v[1][l] - v[7][l];
+        const double shearY = c[kZ12 * kLanes + l] * dy + c[kZ6 * kLanes + l] * (v[5][l] + v[11][l]);
+        w[1][l] = shearY;
+        w[7][l] = -shearY;
+        w[5][l] = c[kZ6 * kLanes + l] * dy + c[kZ4 * kLanes + l] * v[5][l] + c[kZ2 * kLanes + l] * v[11][l];
+        w[11][l] = c[kZ6 * kLanes + l] * dy + c[kZ2 * kLanes + l] * v[5][l] + c[kZ4 * kLanes + l] * v[11][l];
+
+        const double dz = v[2][l] - v[8][l];
+        const double shearZ = c[kY12 * kLanes + l] * dz - c[kY6 * kLanes + l] * (v[4][l] + v[10][l]);
+        w[2][l] = shearZ;
+        w[8][l] = -shearZ;
+        w[4][l] = -c[kY6 * kLanes + l] * dz + c[kY4 * kLanes + l] * v[4][l] + c[kY2 * kLanes + l] * v[10][l];
+        w[10][l] = -c[kY6 * kLanes + l] * dz + c[kY2 * kLanes + l] * v[4][l] + c[kY4 * kLanes + l] * v[10][l];
+    }
+
+    for (size_t b = 0; b < 4; ++b) {
+        for (size_t col = 0; col < 3; ++col) {
+            for (size_t l = 0; l < kLanes; ++l) {
+                f[3 * b + col][l] = R[col * kLanes + l] * w[3 * b][l] + R[(3 + col) * kLanes + l] * w[3 * b + 1][l]
+                                  + R[(6 + col) * kLanes + l] * w[3 * b + 2][l];
+            }
+        }
+    }
+}
+
+/// f = K_e u from the stored global element matrices @p k
+void globalKernel(const double *k, const LaneVector u, LaneVector f)
+{
+    for (size_t i = 0; i < kElementDofs; ++i) {
+        double sum[kLanes] = {};
+        for (size_t j = 0; j < kElementDofs; ++j) {
+            const double *kij = k + (i * kElementDofs + j) * kLanes;
+            for (size_t l = 0; l < kLanes; ++l) {
+                sum[l] += kij[l] * u[j][l];
+            }
+        }
+        for (size_t l = 0; l < kLanes; ++l) {
+            f[i][l] = sum[l];
+        }
+    }
+}
+
+} // namespace
+
+MatrixFreeOperator::MatrixFreeOperator(const FrameModel &model, const std::vector<ElementAxes> &axes,
+                                       const std::vector<int> &equations, int equationCount,
+                                       ElementStorage storage, ThreadPool *pool)
+    : m_size(equationCount)
+    , m_storage(storage)
+    , m_pool(pool != nullptr && pool->threadCount() > 1 ? pool : nullptr)
+    , m_stride((storage == ElementStorage::GlobalMatrices ? kGlobalValues : kLocalValues) * kLanes)
+{
+    const ElementColouring colouring = colourElements(model);
+    m_colourBatchStart.assign(1, 0);
+    for (int c = 0; c < colouring.colourCount(); ++c) {
+        const auto count = static_cast<size_t>(colouring.colourStart[static_cast<size_t>(c) + 1]
+                                               - colouring.colourStart[static_cast<size_t>(c)]);
+        m_colourBatchStart.push_back(m_colourBatchStart.back() + (count + kLanes - 1) / kLanes);
+    }
+    const size_t batchCount = m_colourBatchStart.back();
+    m_equations.assign(batchCount * kElementDofs * kLanes, -1);
+    m_values.assign(batchCount * m_stride, 0.0);
+
+    ElementMatrix k;
+    for (int c = 0; c < colouring.colourCount(); ++c) {
+        const auto first = static_cast<size_t>(colouring.colourStart[static_cast<size_t>(c)]);
+        const auto last = static_cast<size_t>(colouring.colourStart[static_cast<size_t>(c) + 1]);
+        for (size_t p = first; p < last; ++p) {
+            const size_t batch = m_colourBatchStart[static_cast<size_t>(c)] + (p - first) / kLanes;
+            const size_t lane = (p - first) % kLanes;
+            const auto e = static_cast<size_t>(colouring.elements[p]);
+            const FrameElement &element = model.elements[e];
+            int *elementEquations = m_equations.data() + batch * kElementDofs * kLanes;
+            for (size_t end = 0; end < 2; ++end) {
+                const size_t base = kNodeDofs * static_cast<size_t>(element.nodes[end]);
+                for (size_t d = 0; d < kNodeDofs; ++d) {
+                    elementEquations[(kNodeDofs * end + d) * kLanes + lane] = equations[base + d];
+                }
+            }
+
+            double *values = m_values.data() + batch * m_stride;
+            if (storage == ElementStorage::GlobalMatrices) {
+                globalStiffness(element, axes[e], k);
+                for (size_t i = 0; i < kGlobalValues; ++i) {
+                    values[i * kLanes + lane] = k[i];
+                }
+                continue;
+            }
+            localStiffness(element, axes[e].length, k);
+            const auto at = [&k](size_t i, size_t j) { return k[i * kElementDofs + j]; };
+            const std::array<double, kRotation> terms{{at(0, 0), at(3, 3), at(1, 1), at(1, 5), at(5, 5), at(5, 11),
+                                                       at(2, 2), -at(2, 4), at(4, 4), at(4, 10)}};
+            for (size_t i = 0; i < kRotation; ++i) {
+                values[i * kLanes + lane] = terms[i];
+            }
+            for (size_t i = 0; i < 9; ++i) {
+                values[(kRotation + i) * kLanes + lane] = axes[e].rotation[i];
+            }
+        }
+    }
+}
+
+void MatrixFreeOperator::applyBatch(size_t batch, const double *x, double *y) const
+{
+    const int *equations = m_equations.data() + batch * kElementDofs * kLanes;
+    const double *values = m_values.data() + batch * m_stride;
+    LaneVector u;
+    LaneVector f;
+    gather(equations, x, u);
+    if (m_storage == ElementStorage::GlobalMatrices) {
+        globalKernel(values, u, f);
+    } else {
+        localKernel(values, u, f);
+    }
+    scatter(equations, f, y);
+}
+
+void MatrixFreeOperator::apply(const double *x, double *y) const
+{
+    std::fill(y, y + m_size, 0.0);
+    for (size_t c = 0; c + 1 < m_colourBatchStart.size(); ++c) {
+        const size_t first = m_colourBatchStart[c];
+        const size_t count = m_colourBatchStart[c + 1] - first;
+        if (m_pool == nullptr) {
+            for (size_t b = first; b < first + count; ++b) {
+                applyBatch(b, x, y);
+            }
+            continue;
+        }
+        m_pool->parallelFor(count, [&](size_t begin, size_t end) {
+            for (size_t b = first + begin; b < first + end; ++b) {
+                applyBatch(b, x, y);
+            }
+        });
+    }
+}
+
+size_t MatrixFreeOperator::bytes() const
+{
+    return m_equations.size() * sizeof(int) + m_values.size() * sizeof(double)
+         + m_colourBatchStart.size() * sizeof(size_t);
+}
+
+size_t MatrixFreeOperator::bytesPerElement(ElementStorage storage)
+{
+    const size_t values = storage == ElementStorage::GlobalMatrices ? kGlobalValues : kLocalValues;
+    return kElementDofs * sizeof(int) + values * sizeof(double);
+}
+
+CsrMatrix nodalBlockDiagonal(const FrameModel &model, const std::vector<ElementAxes> &axes,
+                             const std::vector<int> &equations, const std::vector<int> &dofOfEquation)
+{
+    std::vector<std::array<double, kNodeDofs * kNodeDofs>> blocks(model.nodeCount());
+    for (auto &block : blocks) {
+        block.fill(0.0);
+    }
+    ElementMatrix ke;
+    for (size_t e = 0; e < model.elements.size(); ++e) {
+        globalStiffness(model.elements[e], axes[e], ke);
+        for (size_t end = 0; end < 2; ++end) {
+            auto &block = blocks[static_cast<size_t>(model.elements[e].nodes[end])];
+            for (size_t i = 0; i < kNodeDofs; ++i) {
+                for (size_t j = 0; j < kNodeDofs; ++j) {
+                    block[i * kNodeDofs + j] += ke[(kNodeDofs * end + i) * kElementDofs + kNodeDofs * end + j];
+                }
+            }
+        }
+    }
+
+    CsrMatrix diagonal;
+    diagonal.size = static_cast<int>(dofOfEquation.size());
+    diagonal.rowStart.assign(dofOfEquation.size() + 1, 0);
+    for (size_t eq = 0; eq < dofOfEquation.size(); ++eq) {
+        const auto node = static_cast<size_t>(dofOfEquation[eq] / kNodeDofs);
+        const auto row = static_cast<size_t>(dofOfEquation[eq] % kNodeDofs);
+        for (size_t d = 0; d < kNodeDofs; ++d) {
+            const int column = equations[kNodeDofs * node + d];
+            if (column >= 0) {
+                diagonal.columns.push_back(column);
+                diagonal.values.push_back(blocks[node][row * kNodeDofs + d]);
+            }
+        }
+        diagonal.rowStart[eq + 1] = diagonal.columns.size();
+    }
+    return diagonal;
+}
+
+} // namespace Structura::Analysis
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "ConjugateGradient.h"
+#include "ElementColouring.h"
+#include "ElementStiffness.h"
+#include "FrameModel.h"
+#include "SparseMatrix.h"
+#include <cstddef>
+#include <vector>
+
+namespace Structura::Analysis {
+
+class ThreadPool;
+
+/**
+ * @brief What MatrixFreeOperator keeps per element.
+ */
+enum class ElementStorage
+{
+    GlobalMatrices,   ///< T^T k T, 144 values: fewest operations per product
+    LocalCoefficients ///< The 10 distinct terms of k and the rotation: 19 values, k applied on the fly
+};
+
+/**
+ * @brief K x computed element by element, without assembling K.
+ *
+ * Each product gathers the 12 end displacements of every element, applies
+ * its stiffness and adds the 12 end forces back, so the memory is a fixed
+ * amount per element instead of the 36 (1 + node degree) entries per node
+ * row of the assembled matrix.
+ *
+ * Elements are grouped by colour (colourElements()) and packed in batches
+ * of kLanes elements of the same colour, stored lane-interleaved so that the
+ * element kernels run the kLanes elements side by side in SIMD registers.
+ * The batches of one colour are split over the pool; elements of a colour
+ * share no node, so their scatters never collide, and the contributions to
+ * each equation are added colour by colour. The product therefore does not
+ * depend on the number of threads.
+ */
+class MatrixFreeOperator : public LinearOperator
+{
+public:
+    /// Elements processed together by the kernels
+    static constexpr size_t kLanes = 4;
+
+    /**
+     * @param axes Element axes of @p model
+     * @param equations Equation of every DOF, -1 where restrained
+     * @param equationCount Number of equations
+     * @param pool Threads for the product, or nullptr for serial
+     */
+    MatrixFreeOperator(const FrameModel &model, const std::vector<ElementAxes> &axes,
+                       const std::vector<int> &equations, int equationCount,
+                       ElementStorage storage = ElementStorage::LocalCoefficients, ThreadPool *pool = nullptr);
+
+    int size() const override { return m_size; }
+    void apply(const double *x, double *y) const override;
+
+    int colourCount() const { return static_cast<int>(m_colourBatchStart.size()) - 1; }
+
+    /// Memory held for the products
+    size_t bytes() const;
+
+    /// Memory per element of @p storage, as used by bytes()
+    static size_t bytesPerElement(ElementStorage storage);
+
+private:
+    void applyBatch(size_t batch, const double *x, double *y) const;
+
+    int m_size{0};
+    ElementStorage m_storage;
+    ThreadPool *m_pool;
+    size_t m_stride; ///< Values per batch
+    /// Batches of colour c: [m_colourBatchStart[c], m_colourBatchStart[c + 1])
+    std::vector<size_t> m_colourBatchStart;
+    std::vector<int> m_equations;  ///< Per batch [12][kLanes], -1 for restrained DOFs and empty lanes
+    std::vector<double> m_values;  ///< Per batch [m_stride / kLanes][kLanes]
+};
+
+/**
+ * @brief The nodal diagonal blocks of K as a CSR matrix.
+ *
+ * Only the 6 x 6 (or smaller) blocks coupling the free DOFs of a node with
+ * themselves are kept, so the Jacobi and block-Jacobi preconditioners can be
+ * set up for a matrix-free solve exactly as for the assembled matrix.
+ * @param dofOfEquation DOF of every equation; the free DOFs of a node must
+ *        have consecutive equations
+ */
+CsrMatrix nodalBlockDiagonal(const FrameModel &model, const std::vector<ElementAxes> &axes,
+                             const std::vector<int> &equations, const std::vector<int> &dofOfEquation);
+
+} // namespace Structura::Analysis
@@ -0,0 +1,502 @@
+#include "NodeOrdering.h"
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+
+namespace Structura::Analysis {
+
+NodeGraph NodeGraph::fromModel(const FrameModel &model)
+{
+    const int count = static_cast<int>(model.nodeCount());
+    NodeGraph graph;
+    graph.start.assign(static_cast<size_t>(count) + 1, 0);
+
+    auto valid = [count](const FrameElement &element) {
+        const int a = element.nodes[0];
+        const int b = element.nodes[1];
+        return a >= 0 && b >= 0 && a < count && b < count && a != b;
+    };
+
+    for (const FrameElement &element : model.elements) {
+        if (valid(element)) {
+            ++graph.start[static_cast<size_t>(element.nodes[0]) + 1];
+            ++graph.start[static_cast<size_t>(element.nodes[1]) + 1];
+        }
+    }
+    for (size_t i = 0; i < static_cast<size_t>(count); ++i) {
+        graph.start[i + 1] += graph.start[i];
+    }
+    graph.neighbours.resize(static_cast<size_t>(graph.start.back()));
+    std::vector<int> fill(graph.start.begin(), graph.start.end() - 1);
+    for (const FrameElement &element : model.elements) {
+        if (valid(element)) {
+            graph.neighbours[static_cast<size_t>(fill[static_cast<size_t>(element.nodes[0])]++)] = element.nodes[1];
+            graph.neighbours[static_cast<size_t>(fill[static_cast<size_t>(element.nodes[1])]++)] = element.nodes[0];
+        }
+    }
+
+    // Sort and drop parallel elements' duplicate edges, compacting in place
+    int write = 0;
+    for (int node = 0; node < count; ++node) {
+        auto first = graph.neighbours.begin() + graph.start[static_cast<size_t>(node)];
+        auto last = graph.neighbours.begin() + graph.start[static_cast<size_t>(node) + 1];
+        std::sort(first, last);
+        last = std::unique(first, last);
+        graph.start[static_cast<size_t>(node)] = write;
+        for (auto it = first; it != last; ++it) {
+            graph.neighbours[static_cast<size_t>(write++)] = *it;
+        }
+    }
+    graph.start[static_cast<size_t>(count)] = write;
+    graph.neighbours.resize(static_cast<size_t>(write));
+    return graph;
+}
+
+namespace {
+
+constexpr size_t kLeafSize = 32;
+
+class GeometricDissection
+{
+public:
+    GeometricDissection(const FrameModel &model, const NodeGraph &graph)
+        : m_model(model)
+        , m_graph(graph)
+        , m_region(model.nodeCount(), 0)
+    {
+        m_order.reserve(model.nodeCount());
+    }
+
+    std::vector<int> run()
+    {
+        std::vector<int> all(m_model.nodeCount());
+        for (size_t i = 0; i < all.size(); ++i) {
+            all[i] = static_cast<int>(i);
+        }
+        dissect(all);
+        return std::move(m_order);
+    }
+
+private:
+    double coordinate(int node, int axis) const
+    {
+        return m_model.coordinates[3 * static_cast<size_t>(node) + static_cast<size_t>(axis)];
+    }
+
+    void dissect(std::vector<int> &nodes)
+    {
+        if (nodes.size() <= kLeafSize) {
+            m_order.insert(m_order.end(), nodes.begin(), nodes.end());
+            return;
+        }
+
+        // Cut across the longest extent
+        double lo[3] = {coordinate(nodes[0], 0), coordinate(nodes[0], 1), coordinate(nodes[0], 2)};
+        double hi[3] = {lo[0], lo[1], lo[2]};
+        for (int node : nodes) {
+            for (int axis = 0; axis < 3; ++axis) {
+                lo[axis] = std::min(lo[axis], coordinate(node, axis));
+                hi[axis] = std::max(hi[axis], coordinate(node, axis));
+            }
+        }
+        int axis = 0;
+        for (int candidate = 1; candidate < 3; ++candidate) {
+            if (hi[candidate] - lo[candidate] > hi[axis] - lo[axis]) {
+                axis = candidate;
+            }
+        }
+
+        // Split between coordinate values, so that nodes on one grid plane
+        // stay together and the boundary is a clean layer
+        const auto middle = nodes.begin() + static_cast<std::ptrdiff_t>(nodes.size() / 2);
+        std::nth_element(nodes.begin(), middle, nodes.end(), [this, axis](int a, int b) {
+            return coordinate(a, axis) < coordinate(b, axis);
+        });
+        const double median = coordinate(*middle, axis);
+        auto split = std::partition(nodes.begin(), nodes.end(), [this, axis, median](int node) {
+            return coordinate(node, axis) < median;
+        });
+        if (split == nodes.begin()) {
+            split = std::partition(nodes.begin(), nodes.end(), [this, axis, median](int node) {
+                return coordinate(node, axis) <= median;
+            });
+        }
+        if (split == nodes.begin() || split == nodes.end()) {
+            split = middle; // all coincident along every axis
+        }
+
+        const int leftTag = ++m_nextTag;
+        const int rightTag = ++m_nextTag;
+        for (auto it = nodes.begin(); it != nodes.end(); ++it) {
+            m_region[static_cast<size_t>(*it)] = it < split ? leftTag : rightTag;
+        }
+
+        // Vertex separator: the smaller of the two boundary layers
+        std::vector<int> leftBoundary;
+        std::vector<int> rightBoundary;
+        for (int node : nodes) {
+            const int own = m_region[static_cast<size_t>(node)];
+            const int other = own == leftTag ? rightTag : leftTag;
+            for (int p = m_graph.start[static_cast<size_t>(node)]; p < m_graph.start[static_cast<size_t>(node) + 1]; ++p) {
+                if (m_region[static_cast<size_t>(m_graph.neighbours[static_cast<size_t>(p)])] == other) {
+                    (own == leftTag ? leftBoundary : rightBoundary).push_back(node);
+                    break;
+                }
+            }
+        }
+        std::vector<int> &separator = leftBoundary.size() <= rightBoundary.size() ? leftBoundary : rightBoundary;
+        const int separatorTag = ++m_nextTag;
+        for (int node : separator) {
+            m_region[static_cast<size_t>(node)] = separatorTag;
+        }
+
+        std::vector<int> left;
+        std::vector<int> right;
+        left.reserve(static_cast<size_t>(split - nodes.begin()));
+        right.reserve(static_cast<size_t>(nodes.end() - split));
+        for (int node : nodes) {
+            const int region = m_region[static_cast<size_t>(node)];
+            if (region == leftTag) {
+                left.push_back(node);
+            } else if (region == rightTag) {
+                right.push_back(node);
+            }
+        }
+        std::vector<int>().swap(nodes); // release before recursing
+
+        dissect(left);
+        dissect(right);
+        m_order.insert(m_order.end(), separator.begin(), separator.end());
+    }
+
+    const FrameModel &m_model;
+    const NodeGraph &m_graph;
+    std::vector<int> m_region; ///< Tag of the part each node currently belongs to
+    std::vector<int> m_order;
+    int m_nextTag{0};
+};
+
+} // namespace
+
+std::vector<int> nestedDissectionOrder(const FrameModel &model, const NodeGraph &graph)
+{
+    return GeometricDissection(model, graph).run();
+}
+
+namespace {
+
+/**
+ * @brief Breadth-first level structure of the component containing @p root.
+ *
+ * Levels are contiguous in visiting order, so the last level is the tail of
+ * @p visited starting at @p lastLevelStart.
+ * @param level Per node scratch, -1 for every node on entry and on return
+ * @param visited Receives the component's nodes in visiting order
+ * @return Number of levels
+ */
+int levelStructure(const NodeGraph &graph, int root, std::vector<int> &level,
+                   std::vector<int> &visited, size_t &lastLevelStart)
+{
+    visited.clear();
+    visited.push_back(root);
+    level[static_cast<size_t>(root)] = 0;
+    lastLevelStart = 0;
+    for (size_t head = 0; head < visited.size(); ++head) {
+        const int node = visited[head];
+        const int next = level[static_cast<size_t>(node)] + 1;
+        for (int p = graph.start[static_cast<size_t>(node)]; p < graph.start[static_cast<size_t>(node) + 1]; ++p) {
+            const int neighbour = graph.neighbours[static_cast<size_t>(p)];
+            if (level[static_cast<size_t>(neighbour)] < 0) {
+                if (level[static_cast<size_t>(visited.back())] < next) {
+                    lastLevelStart = visited.size();
+                }
+                level[static_cast<size_t>(neighbour)] = next;
+                visited.push_back(neighbour);
+            }
+        }
+    }
+    const int depth = level[static_cast<size_t>(visited.back())] + 1;
+    for (int node : visited) {
+        level[static_cast<size_t>(node)] = -1;
+    }
+    return depth;
+}
+
+/// Pseudo-peripheral node of @p start's component (George and Liu)
+int pseudoPeripheralNode(const NodeGraph &graph, int start, std::vector<int> &level, std::vector<int> &visited)
+{
+    int root = start;
+    size_t lastLevelStart = 0;
+    int depth = levelStructure(graph, root, level, visited, lastLevelStart);
+    for (;;) {
+        int candidate = visited[lastLevelStart];
+        for (size_t i = lastLevelStart; i < visited.size(); ++i) {
+            if (graph.degree(visited[i]) < graph.degree(candidate)) {
+                candidate = visited[i];
+            }
+        }
+        size_t candidateLastLevel = 0;
+        const int candidateDepth = levelStructure(graph, candidate, level, visited, candidateLastLevel);
+        if (candidateDepth <= depth) {
+            return root;
+        }
+        root = candidate;
+        depth = candidateDepth;
+        lastLevelStart = candidateLastLevel;
+    }
+}
+
+/**
+ * @brief Approximate minimum degree on the quotient graph.
+ *
+ * Each node is either a variable (not yet eliminated) or an element (an
+ * eliminated node standing for the clique it created). A variable keeps the
+ * variables and elements it is adjacent to; an element keeps its variables.
+ * Eliminating a pivot merges its elements into a new one, and the degree of
+ * each affected variable is bounded by |A_i| + |L_p \ i| + sum |L_e \ L_p|
+ * instead of being computed exactly.
+ */
+class MinimumDegree
+{
+public:
+    explicit MinimumDegree(const NodeGraph &graph)
+        : m_count(graph.nodeCount())
+        , m_variables(static_cast<size_t>(m_count))
+        , m_elements(static_cast<size_t>(m_count))
+        , m_members(static_cast<size_t>(m_count))
+        , m_state(static_cast<size_t>(m_count), State::Variable)
+        , m_degree(static_cast<size_t>(m_count), 0)
+        , m_head(static_cast<size_t>(m_count) + 1, -1)
+        , m_next(static_cast<size_t>(m_count), -1)
+        , m_previous(static_cast<size_t>(m_count), -1)
+        , m_inPivot(static_cast<size_t>(m_count), 0)
+        , m_external(static_cast<size_t>(m_count), -1)
+    {
+        for (int node = 0; node < m_count; ++node) {
+            const auto un = static_cast<size_t>(node);
+            m_variables[un].assign(graph.neighbours.begin() + graph.start[un],
+                                   graph.neighbours.begin() + graph.start[un + 1]);
+            m_degree[un] = graph.degree(node);
+            insert(node);
+        }
+    }
+
+    std::vector<int> run()
+    {
+        std::vector<int> order;
+        order.reserve(static_cast<size_t>(m_count));
+        std::vector<int> pivotMembers;
+        for (int eliminated = 0; eliminated < m_count; ++eliminated) {
+            while (m_head[static_cast<size_t>(m_minimum)] < 0) {
+                ++m_minimum;
+            }
+            const int pivot = m_head[static_cast<size_t>(m_minimum)];
+            remove(pivot);
+            order.push_back(pivot);
+            const auto up = static_cast<size_t>(pivot);
+
+            // L_p: variables of the pivot's elements and its own variables.
+            // The pivot's elements are absorbed into the new element.
+            ++m_tag;
+            m_inPivot[up] = m_tag;
+            pivotMembers.clear();
+            for (int element : m_elements[up]) {
+                const auto ue = static_cast<size_t>(element);
+                if (m_state[ue] != State::Element) {
+                    continue;
+                }
+                for (int member : m_members[ue]) {
+                    addPivotMember(member, pivotMembers);
+                }
+                m_state[ue] = State::Absorbed;
+                std::vector<int>().swap(m_members[ue]);
+            }
+            for (int variable : m_variables[up]) {
+                addPivotMember(variable, pivotMembers);
+            }
+            m_state[up] = State::Element;
+            std::vector<int>().swap(m_variables[up]);
+            std::vector<int>().swap(m_elements[up]);
+            m_members[up] = pivotMembers;
+
+            // |L_e \ L_p| for every element next to L_p
+            for (int member : pivotMembers) {
+                remove(member);
+                for (int element : m_elements[static_cast<size_t>(member)]) {
+                    const auto ue = static_cast<size_t>(element);
+                    if (m_state[ue] != State::Element) {
+                        continue;
+                    }
+                    if (m_external[ue] < m_externalBase) {
+                        m_external[ue] = m_externalBase + static_cast<std::int64_t>(m_members[ue].size());
+                    }
+                    --m_external[ue];
+                }
+            }
+
+            // Prune adjacency lists and bound the degrees of L_p
+            const int remaining = m_count - eliminated - 1; // variables left, including the member
+            const int pivotDegree = static_cast<int>(pivotMembers.size()) - 1;
+            for (int member : pivotMembers) {
+                const auto um = static_cast<size_t>(member);
+                std::vector<int> &elements = m_elements[um];
+                int elementDegree = 0;
+                size_t kept = 0;
+                for (int element : elements) {
+                    const auto ue = static_cast<size_t>(element);
+                    if (m_state[ue] != State::Element) {
+                        continue;
+                    }
+                    const auto external = static_cast<int>(m_external[ue] - m_externalBase);
+                    if (external == 0) {
+                        // L_e inside L_p: aggressive absorption
+                        m_state[ue] = State::Absorbed;
+                        std::vector<int>().swap(m_members[ue]);
+                        continue;
+                    }
+                    elementDegree += external;
+                    elements[kept++] = element;
+                }
+                elements.resize(kept);
+                elements.push_back(pivot);
+
+                std::vector<int> &variables = m_variables[um];
+                kept = 0;
+                for (int variable : variables) {
+                    const auto uv = static_cast<size_t>(variable);
+                    if (m_state[uv] == State::Variable && m_inPivot[uv] != m_tag) {
+                        variables[kept++] = variable;
+                    }
+                }
+                variables.resize(kept);
+
+                const int bound = static_cast<int>(kept) + pivotDegree + elementDegree;
+                m_degree[um] = std::min({remaining - 1, m_degree[um] + pivotDegree, bound});
+                insert(member);
+                m_minimum = std::min(m_minimum, m_degree[um]);
+            }
+            m_externalBase += static_cast<std::int64_t>(m_count) + 1;
+        }
+        return order;
+    }
+
+private:
+    enum class State : std::uint8_t
+    {
+        Variable,
+        Element,
+        Absorbed
+    };
+
+    void addPivotMember(int node, std::vector<int> &members)
+    {
+        const auto un = static_cast<size_t>(node);
+        if (m_state[un] == State::Variable && m_inPivot[un] != m_tag) {
+            m_inPivot[un] = m_tag;
+            members.push_back(node);
+        }
+    }
+
+    void insert(int node)
+    {
+        const auto un = static_cast<size_t>(node);
+        const auto degree = static_cast<size_t>(m_degree[un]);
+        m_previous[un] = -1;
+        m_next[un] = m_head[degree];
+        if (m_head[degree] >= 0) {
+            m_previous[static_cast<size_t>(m_head[degree])] = node;
+        }
+        m_head[degree] = node;
+    }
+
+    void remove(int node)
+    {
+        const auto un = static_cast<size_t>(node);
+        if (m_previous[un] >= 0) {
+            m_next[static_cast<size_t>(m_previous[un])] = m_next[un];
+        } else {
+            m_head[static_cast<size_t>(m_degree[un])] = m_next[un];
+        }
+        if (m_next[un] >= 0) {
+            m_previous[static_cast<size_t>(m_next[un])] = m_previous[un];
+        }
+    }
+
+    int m_count;
+    std::vector<std::vector<int>> m_variables; ///< A_i: adjacent variables
+    std::vector<std::vector<int>> m_elements;  ///< E_i: adjacent elements
+    std::vector<std::vector<int>> m_members;   ///< L_e: variables of element e
+    std::vector<State> m_state;
+    std::vector<int> m_degree;
+    std::vector<int> m_head; ///< Degree buckets (doubly linked lists)
+    std::vector<int> m_next;
+    std::vector<int> m_previous;
+    std::vector<int> m_inPivot;
+    std::vector<std::int64_t> m_external; ///< m_externalBase + |L_e \ L_p|
+    std::int64_t m_externalBase{0};
+    int m_tag{0};
+    int m_minimum{0};
+};
+
+} // namespace
+
+std::vector<int> reverseCuthillMcKeeOrder(const NodeGraph &graph)
+{
+    const int count = graph.nodeCount();
+    std::vector<int> order;
+    order.reserve(static_cast<size_t>(count));
+    std::vector<char> numbered(static_cast<size_t>(count), 0);
+    std::vector<int> level(static_cast<size_t>(count), -1);
+    std::vector<int> visited;
+    std::vector<int> children;
+    for (int start = 0; start < count; ++start) {
+        if (numbered[static_cast<size_t>(start)]) {
+            continue;
+        }
+        const int root = graph.degree(start) == 0 ? start : pseudoPeripheralNode(graph, start, level, visited);
+        size_t head = order.size();
+        order.push_back(root);
+        numbered[static_cast<size_t>(root)] = 1;
+        for (; head < order.size(); ++head) {
+            const int node = order[head];
+            children.clear();
+            for (int p = graph.start[static_cast<size_t>(node)]; p < graph.start[static_cast<size_t>(node) + 1]; ++p) {
+                const int neighbour = graph.neighbours[static_cast<size_t>(p)];
+                if (!numbered[static_cast<size_t>(neighbour)]) {
+                    numbered[static_cast<size_t>(neighbour)] = 1;
+                    children.push_back(neighbour);
+                }
+            }
+            std::stable_sort(children.begin(), children.end(), [&graph](int a, int b) {
+                return graph.degree(a) < graph.degree(b);
+            });
+            order.insert(order.end(), children.begin(), children.end());
+        }
+    }
+    std::reverse(order.begin(), order.end());
+    return order;
+}
+
+std::vector<int> approximateMinimumDegreeOrder(const NodeGraph &graph)
+{
+    return MinimumDegree(graph).run();
+}
+
+std::vector<int> nodeOrder(OrderingMethod method, const FrameModel &model, const NodeGraph &graph)
+{
+    switch (method) {
+    case OrderingMethod::ReverseCuthillMcKee:
+        return reverseCuthillMcKeeOrder(graph);
+    case OrderingMethod::ApproximateMinimumDegree:
+        return approximateMinimumDegreeOrder(graph);
+    case OrderingMethod::NestedDissection:
+        return nestedDissectionOrder(model, graph);
+    case OrderingMethod::Natural:
+        break;
+    }
+    std::vector<int> order(model.nodeCount());
+    std::iota(order.begin(), order.end(), 0);
+    return order;
+}
+
+} // namespace Structura::Analysis
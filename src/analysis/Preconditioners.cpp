@@ -0,0 +1,214 @@
+#include "Preconditioners.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace Structura::Analysis {
+
+namespace {
+
+constexpr int kMaxBlock = 6;
+constexpr double kMinimumPivot = 1e-8;  ///< IC(0) pivot relative to a_ii that counts as breakdown
+constexpr double kFirstShift = 1e-3;
+constexpr int kShiftAttempts = 10;
+
+} // namespace
+
+JacobiPreconditioner::JacobiPreconditioner(const CsrMatrix &matrix)
+    : m_inverse(static_cast<size_t>(matrix.size), 0.0)
+{
+    for (int row = 0; row < matrix.size; ++row) {
+        double diagonal = 0.0;
+        for (size_t p = matrix.rowStart[static_cast<size_t>(row)]; p < matrix.rowStart[static_cast<size_t>(row) + 1]; ++p) {
+            if (matrix.columns[p] == row) {
+                diagonal = matrix.values[p];
+            }
+        }
+        if (!(diagonal > 0.0) && m_failedEquation < 0) {
+            m_failedEquation = row;
+        }
+        m_inverse[static_cast<size_t>(row)] = diagonal > 0.0 ? 1.0 / diagonal : 0.0;
+    }
+}
+
+void JacobiPreconditioner::apply(const double *r, double *z) const
+{
+    for (size_t i = 0; i < m_inverse.size(); ++i) {
+        z[i] = m_inverse[i] * r[i];
+    }
+}
+
+BlockJacobiPreconditioner::BlockJacobiPreconditioner(const CsrMatrix &matrix, const std::vector<int> &blockStart)
+    : m_blockStart(blockStart)
+    , m_inverse(blockStart.empty() ? 0 : blockStart.size() - 1)
+{
+    for (size_t b = 0; b < m_inverse.size(); ++b) {
+        const int first = m_blockStart[b];
+        const int m = m_blockStart[b + 1] - first;
+        std::array<double, 36> a{};
+        for (int i = 0; i < m; ++i) {
+            const auto row = static_cast<size_t>(first + i);
+            for (size_t p = matrix.rowStart[row]; p < matrix.rowStart[row + 1]; ++p) {
+                const int j = matrix.columns[p] - first;
+                if (j >= 0 && j < m) {
+                    a[static_cast<size_t>(i * kMaxBlock + j)] = matrix.values[p];
+                }
+            }
+        }
+
+        // Gauss-Jordan without pivoting: the block is a principal submatrix
+        // of a positive definite matrix
+        std::array<double, 36> &inverse = m_inverse[b];
+        inverse.fill(0.0);
+        for (int i = 0; i < m; ++i) {
+            inverse[static_cast<size_t>(i * kMaxBlock + i)] = 1.0;
+        }
+        for (int k = 0; k < m; ++k) {
+            const double pivot = a[static_cast<size_t>(k * kMaxBlock + k)];
+            if (!(pivot > 0.0)) {
+                if (m_failedEquation < 0) {
+                    m_failedEquation = first + k;
+                }
+                inverse.fill(0.0);
+                break;
+            }
+            for (int j = 0; j < m; ++j) {
+                a[static_cast<size_t>(k * kMaxBlock + j)] /= pivot;
+                inverse[static_cast<size_t>(k * kMaxBlock + j)] /= pivot;
+            }
+            for (int i = 0; i < m; ++i) {
+                const double factor = a[static_cast<size_t>(i * kMaxBlock + k)];
+                if (i == k || factor == 0.0) {
+                    continue;
+                }
+                for (int j = 0; j < m; ++j) {
+                    a[static_cast<size_t>(i * kMaxBlock + j)] -= factor * a[static_cast<size_t>(k * kMaxBlock + j)];
+                    inverse[static_cast<size_t>(i * kMaxBlock + j)] -= factor * inverse[static_cast<size_t>(k * kMaxBlock + j)];
+                }
+            }
+        }
+    }
+}
+
+void BlockJacobiPreconditioner::apply(const double *r, double *z) const
+{
+    for (size_t b = 0; b < m_inverse.size(); ++b) {
+        const auto first = static_cast<size_t>(m_blockStart[b]);
+        applyBlock(b, r + first, z + first);
+    }
+}
+
+void BlockJacobiPreconditioner::applyBlock(size_t block, const double *r, double *z) const
+{
+    const auto m = static_cast<size_t>(m_blockStart[block + 1] - m_blockStart[block]);
+    const std::array<double, 36> &inverse = m_inverse[block];
+    for (size_t i = 0; i < m; ++i) {
+        double sum = 0.0;
+        for (size_t j = 0; j < m; ++j) {
+            sum += inverse[i * kMaxBlock + j] * r[j];
+        }
+        z[i] = sum;
+    }
+}
+
+IncompleteCholeskyPreconditioner::IncompleteCholeskyPreconditioner(const CsrMatrix &matrix)
+{
+    const auto n = static_cast<size_t>(matrix.size);
+    m_rowStart.assign(n + 1, 0);
+    for (size_t i = 0; i < n; ++i) {
+        size_t count = 0;
+        for (size_t p = matrix.rowStart[i]; p < matrix.rowStart[i + 1] && static_cast<size_t>(matrix.columns[p]) < i; ++p) {
+            ++count;
+        }
+        m_rowStart[i + 1] = m_rowStart[i] + count;
+    }
+    m_columns.resize(m_rowStart[n]);
+    for (size_t i = 0; i < n; ++i) {
+        std::copy_n(matrix.columns.begin() + static_cast<std::ptrdiff_t>(matrix.rowStart[i]),
+                    m_rowStart[i + 1] - m_rowStart[i], m_columns.begin() + static_cast<std::ptrdiff_t>(m_rowStart[i]));
+    }
+
+    double shift = 0.0;
+    for (int attempt = 0; attempt <= kShiftAttempts; ++attempt) {
+        if (factorize(matrix, shift)) {
+            m_shift = shift;
+            m_failedEquation = -1;
+            return;
+        }
+        shift = shift == 0.0 ? kFirstShift : 2.0 * shift;
+    }
+}
+
+bool IncompleteCholeskyPreconditioner::factorize(const CsrMatrix &matrix, double shift)
+{
+    const auto n = static_cast<size_t>(matrix.size);
+    m_values.assign(m_rowStart[n], 0.0);
+    m_diagonal.assign(n, 0.0);
+    std::vector<double> g(n, 0.0); // g_ij = l_ij d_j of the current row
+    std::vector<size_t> mark(n, SIZE_MAX);
+    for (size_t i = 0; i < n; ++i) {
+        double diagonal = 0.0;
+        for (size_t p = matrix.rowStart[i]; p < matrix.rowStart[i + 1]; ++p) {
+            const auto column = static_cast<size_t>(matrix.columns[p]);
+            if (column < i) {
+                mark[column] = i;
+                g[column] = matrix.values[p];
+            } else if (column == i) {
+                diagonal = matrix.values[p];
+            }
+        }
+        if (!(diagonal > 0.0)) {
+            m_failedEquation = static_cast<int>(i);
+            return false;
+        }
+
+        // g_ik = a_ik - sum_j g_ij l_kj over the common pattern, k ascending
+        for (size_t p = m_rowStart[i]; p < m_rowStart[i + 1]; ++p) {
+            const auto k = static_cast<size_t>(m_columns[p]);
+            double sum = g[k];
+            for (size_t q = m_rowStart[k]; q < m_rowStart[k + 1]; ++q) {
+                const auto j = static_cast<size_t>(m_columns[q]);
+                if (mark[j] == i) {
+                    sum -= g[j] * m_values[q];
+                }
+            }
+            g[k] = sum;
+        }
+        double d = diagonal * (1.0 + shift);
+        for (size_t p = m_rowStart[i]; p < m_rowStart[i + 1]; ++p) {
+            const auto k = static_cast<size_t>(m_columns[p]);
+            const double l = g[k] / m_diagonal[k];
+            d -= l * g[k];
+            m_values[p] = l;
+        }
+        if (!(d > kMinimumPivot * diagonal)) {
+            m_failedEquation = static_cast<int>(i);
+            return false;
+        }
+        m_diagonal[i] = d;
+    }
+    return true;
+}
+
+void IncompleteCholeskyPreconditioner::apply(const double *r, double *z) const
+{
+    const size_t n = m_diagonal.size();
+    for (size_t i = 0; i < n; ++i) {
+        double sum = r[i];
+        for (size_t p = m_rowStart[i]; p < m_rowStart[i + 1]; ++p) {
+            sum -= m_values[p] * z[m_columns[p]];
+        }
+        z[i] = sum;
+    }
+    for (size_t i = 0; i < n; ++i) {
+        z[i] /= m_diagonal[i];
+    }
+    for (size_t i = n; i-- > 0;) {
+        const double zi = z[i];
+        for (size_t p = m_rowStart[i]; p < m_rowStart[i + 1]; ++p) {
+            z[m_columns[p]] -= m_values[p] * zi;
+        }
+    }
+}
+
+} // namespace Structura::Analysis
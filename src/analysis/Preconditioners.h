@@ -0,0 +1,95 @@
+#pragma once
+
+#include "ConjugateGradient.h"
+#include "SparseMatrix.h"
+#include <array>
+#include <vector>
+
+namespace Structura::Analysis {
+
+/**
+ * @brief Preconditioners the iterative solver can use.
+ */
+enum class PreconditionerMethod
+{
+    Jacobi,             ///< Inverse of the diagonal
+    BlockJacobi,        ///< Inverse of the nodal 6 x 6 diagonal blocks
+    IncompleteCholesky, ///< IC(0): L D L^T on the pattern of K
+    SmoothedAggregation ///< Algebraic multigrid V-cycle (SmoothedAggregationPreconditioner)
+};
+
+/**
+ * @brief Diagonal scaling, M = diag(A).
+ */
+class JacobiPreconditioner : public Preconditioner
+{
+public:
+    explicit JacobiPreconditioner(const CsrMatrix &matrix);
+
+    void apply(const double *r, double *z) const override;
+    int failedEquation() const override { return m_failedEquation; }
+
+private:
+    std::vector<double> m_inverse;
+    int m_failedEquation{-1};
+};
+
+/**
+ * @brief Block diagonal scaling with the node blocks of A.
+ *
+ * The free DOFs of a node couple strongly (axial, bending and torsion of
+ * the same bars), so inverting each nodal block captures much more of A
+ * than its diagonal at the same cost per iteration.
+ */
+class BlockJacobiPreconditioner : public Preconditioner
+{
+public:
+    /**
+     * @param blockStart Equations of block b: [blockStart[b], blockStart[b + 1]),
+     *        at most 6 per block
+     */
+    BlockJacobiPreconditioner(const CsrMatrix &matrix, const std::vector<int> &blockStart);
+
+    void apply(const double *r, double *z) const override;
+    int failedEquation() const override { return m_failedEquation; }
+
+    /// z = D_b^-1 r for block @p block alone; r and z hold its equations only
+    void applyBlock(size_t block, const double *r, double *z) const;
+
+private:
+    std::vector<int> m_blockStart;
+    std::vector<std::array<double, 36>> m_inverse; ///< Row-major, leading dimension 6
+    int m_failedEquation{-1};
+};
+
+/**
+ * @brief Incomplete LDL^T factorization without fill, IC(0).
+ *
+ * L keeps exactly the lower pattern of A. Stiffness matrices are not
+ * M-matrices, so the incomplete factorization can meet a non-positive pivot;
+ * it is then retried on A + alpha diag(A) with a growing shift alpha.
+ * Applying it is a pair of sparse triangular solves, done serially.
+ */
+class IncompleteCholeskyPreconditioner : public Preconditioner
+{
+public:
+    explicit IncompleteCholeskyPreconditioner(const CsrMatrix &matrix);
+
+    void apply(const double *r, double *z) const override;
+    int failedEquation() const override { return m_failedEquation; }
+
+    /// Diagonal shift the factorization needed (0 if none)
+    double shift() const { return m_shift; }
+
+private:
+    bool factorize(const CsrMatrix &matrix, double shift);
+
+    std::vector<size_t> m_rowStart; ///< Strictly lower part of row i
+    std::vector<int> m_columns;
+    std::vector<double> m_values;
+    std::vector<double> m_diagonal;
+    double m_shift{0.0};
+    int m_failedEquation{-1};
+};
+
+} // namespace Structura::Analysis
@@ -0,0 +1,117 @@
+#include "SkylineLdlt.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Structura::Analysis {
+
+namespace {
+
+/**
+ * @brief Dot product of two contiguous segments.
+ *
+ * Four independent partial sums break the dependency chain of the
+ * additions so the compiler can keep several multiply-adds in flight and
+ * vectorize the loop without reassociating it.
+ */
+double dot(const double *x, const double *y, size_t count)
+{
+    double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        s0 += x[i] * y[i];
+        s1 += x[i + 1] * y[i + 1];
+        s2 += x[i + 2] * y[i + 2];
+        s3 += x[i + 3] * y[i + 3];
+    }
+    for (; i < count; ++i) {
+        s0 += x[i] * y[i];
+    }
+    return (s0 + s1) + (s2 + s3);
+}
+
+} // namespace
+
+void SkylineLdlt::analyse(const CsrMatrix &matrix)
+{
+    const auto n = static_cast<size_t>(matrix.size);
+    m_size = matrix.size;
+    m_failedEquation = -1;
+    m_firstColumn.assign(n, 0);
+    m_rowStart.assign(n + 1, 0);
+    for (size_t i = 0; i < n; ++i) {
+        int first = static_cast<int>(i);
+        if (matrix.rowStart[i] < matrix.rowStart[i + 1]) {
+            first = std::min(first, matrix.columns[matrix.rowStart[i]]); // columns are sorted
+        }
+        m_firstColumn[i] = first;
+        m_rowStart[i + 1] = m_rowStart[i] + (i - static_cast<size_t>(first)) + 1;
+    }
+}
+
+bool SkylineLdlt::factorizeNumeric(const CsrMatrix &matrix, double pivotTolerance)
+{
+    const auto n = static_cast<size_t>(m_size);
+    m_failedEquation = -1;
+    const std::vector<double> threshold = pivotThresholds(matrix, pivotTolerance);
+
+    m_values.assign(m_rowStart[n], 0.0);
+    for (size_t i = 0; i < n; ++i) {
+        const auto first = static_cast<size_t>(m_firstColumn[i]);
+        for (size_t p = matrix.rowStart[i]; p < matrix.rowStart[i + 1]; ++p) {
+            const auto column = static_cast<size_t>(matrix.columns[p]);
+            if (column > i) {
+                break;
+            }
+            m_values[m_rowStart[i] + (column - first)] = matrix.values[p];
+        }
+    }
+
+    // Row i in place: first g_ij = l_ij d_j = a_ij - sum_k g_ik l_jk over
+    // the overlap of rows i and j, then l_ij = g_ij / d_j and
+    // d_i = a_ii - sum_j l_ij g_ij
+    for (size_t i = 0; i < n; ++i) {
+        const auto first = static_cast<size_t>(m_firstColumn[i]);
+        double *row = m_values.data() + m_rowStart[i];
+        for (size_t j = first; j < i; ++j) {
+            const auto firstOfJ = static_cast<size_t>(m_firstColumn[j]);
+            const size_t overlap = std::max(first, firstOfJ);
+            const double *rowOfJ = m_values.data() + m_rowStart[j];
+            row[j - first] -= dot(row + (overlap - first), rowOfJ + (overlap - firstOfJ), j - overlap);
+        }
+        double d = row[i - first];
+        for (size_t j = first; j < i; ++j) {
+            const double g = row[j - first];
+            const double l = g / m_values[m_rowStart[j + 1] - 1];
+            d -= l * g;
+            row[j - first] = l;
+        }
+        if (!(std::abs(d) > threshold[i])) {
+            m_failedEquation = static_cast<int>(i);
+            return false;
+        }
+        row[i - first] = d;
+    }
+    return true;
+}
+
+void SkylineLdlt::solve(double *x) const
+{
+    const auto n = static_cast<size_t>(m_size);
+    for (size_t i = 0; i < n; ++i) {
+        const auto first = static_cast<size_t>(m_firstColumn[i]);
+        x[i] -= dot(m_values.data() + m_rowStart[i], x + first, i - first);
+    }
+    for (size_t i = 0; i < n; ++i) {
+        x[i] /= m_values[m_rowStart[i + 1] - 1];
+    }
+    for (size_t i = n; i-- > 0;) {
+        const auto first = static_cast<size_t>(m_firstColumn[i]);
+        const double *row = m_values.data() + m_rowStart[i];
+        const double xi = x[i];
+        for (size_t k = first; k < i; ++k) {
+            x[k] -= row[k - first] * xi;
+        }
+    }
+}
+
+} // namespace Structura::Analysis
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "DirectSolver.h"
+#include "SparseMatrix.h"
+#include <cstddef>
+#include <vector>
+
+namespace Structura::Analysis {
+
+/**
+ * @brief Skyline (variable band) LDL^T factorization, A = L D L^T.
+ *
+ * Row i of the lower triangle is stored densely from its first nonzero
+ * column to the diagonal; fill in L never leaves this envelope, so the
+ * factorization overwrites A in place and needs no symbolic phase beyond
+ * the row starts. Memory is the profile of A (CsrMatrix::profile()) plus
+ * the diagonal, with one offset per row and no index per entry, which makes
+ * it the leanest direct solver when the numbering keeps the profile small
+ * (OrderingMethod::ReverseCuthillMcKee). With fill-reducing orderings the
+ * envelope is much larger than the sparse factor; use SupernodalLdlt there.
+ *
+ * Crout form, row by row: every entry is a dot product of two contiguous
+ * row segments. Serial.
+ */
+class SkylineLdlt : public DirectSolver
+{
+public:
+    /// Row starts of the envelope; factorNonZeros() is the profile of @p matrix
+    void analyse(const CsrMatrix &matrix) override;
+    bool factorizeNumeric(const CsrMatrix &matrix, double pivotTolerance) override;
+    void solve(double *x) const override;
+
+    int failedEquation() const override { return m_failedEquation; }
+
+    /// Envelope entries left of the diagonal
+    size_t factorNonZeros() const override { return m_rowStart.back() - m_rowStart.size() + 1; }
+
+    size_t factorBytes() const override
+    {
+        return bytesOf<double>(m_rowStart.back()) + bytesOf<int>(m_firstColumn.size())
+               + bytesOf<size_t>(m_rowStart.size());
+    }
+
+    int size() const { return m_size; }
+
+private:
+    int m_size{0};
+    int m_failedEquation{-1};
+    std::vector<int> m_firstColumn;     ///< First column of the envelope of row i
+    std::vector<size_t> m_rowStart{0};  ///< Row i: m_values[m_rowStart[i] .. m_rowStart[i + 1]), diagonal last
+    std::vector<double> m_values;       ///< L left of the diagonal, D on it
+};
+
+} // namespace Structura::Analysis
@@ -0,0 +1,577 @@
+#include "SmoothedAggregation.h"
+#include "FrameModel.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace Structura::Analysis {
+
+namespace {
+
+constexpr size_t kModes = 6;             ///< Rigid body modes: 3 translations, 3 rotations
+constexpr double kStrength = 0.08;       ///< Strong coupling: |A_ij| >= kStrength sqrt(|A_ii| |A_jj|)
+constexpr double kDependentMode = 1e-8;  ///< Mode dropped in an aggregate when this much of it is left
+constexpr double kMinimumCoarsening = 0.85; ///< Stop when a level keeps more of its equations
+constexpr size_t kMaxLevels = 12;
+constexpr int kPowerIterations = 15;
+constexpr double kCoarsestPivotTolerance = 1e-10;
+
+/**
+ * @brief C = A B for row-compressed matrices (Gustavson), columns sorted.
+ * @param rows Rows of A
+ * @param columns Columns of B
+ */
+template <class Result, class Left, class Right>
+Result sparseProduct(const Left &a, int rows, const Right &b, int columns)
+{
+    Result c;
+    c.rows = rows;
+    c.columnCount = columns;
+    c.rowStart.assign(static_cast<size_t>(rows) + 1, 0);
+    std::vector<double> accumulator(static_cast<size_t>(columns), 0.0);
+    std::vector<int> marker(static_cast<size_t>(columns), -1);
+    std::vector<int> pattern;
+    for (int i = 0; i < rows; ++i) {
+        pattern.clear();
+        for (size_t p = a.rowStart[static_cast<size_t>(i)]; p < a.rowStart[static_cast<size_t>(i) + 1]; ++p) {
+            const auto k = static_cast<size_t>(a.columns[p]);
+            const double value = a.values[p];
+            for (size_t q = b.rowStart[k]; q < b.rowStart[k + 1]; ++q) {
+                const auto j = static_cast<size_t>(b.columns[q]);
+                if (marker[j] != i) {
+                    marker[j] = i;
+                    accumulator[j] = 0.0;
+                    pattern.push_back(static_cast<int>(j));
+                }
+                accumulator[j] += value * b.values[q];
+            }
+        }
+        std::sort(pattern.begin(), pattern.end());
+        for (int j : pattern) {
+            c.columns.push_back(j);
+            c.values.push_back(accumulator[static_cast<size_t>(j)]);
+        }
+        c.rowStart[static_cast<size_t>(i) + 1] = c.columns.size();
+    }
+    return c;
+}
+
+/// Transpose of a row-compressed rows x columns matrix; columns stay sorted
+template <class Matrix>
+Matrix transposed(const Matrix &a, int rows, int columns)
+{
+    Matrix t;
+    t.rowStart.assign(static_cast<size_t>(columns) + 1, 0);
+    for (int j : a.columns) {
+        ++t.rowStart[static_cast<size_t>(j) + 1];
+    }
+    for (size_t j = 0; j < static_cast<size_t>(columns); ++j) {
+        t.rowStart[j + 1] += t.rowStart[j];
+    }
+    t.columns.resize(a.columns.size());
+    t.values.resize(a.values.size());
+    std::vector<size_t> next(t.rowStart.begin(), t.rowStart.end() - 1);
+    for (int i = 0; i < rows; ++i) {
+        for (size_t p = a.rowStart[static_cast<size_t>(i)]; p < a.rowStart[static_cast<size_t>(i) + 1]; ++p) {
+            const size_t slot = next[static_cast<size_t>(a.columns[p])]++;
+            t.columns[slot] = i;
+            t.values[slot] = a.values[p];
+        }
+    }
+    return t;
+}
+
+/// Rigid body modes on the equations, kModes per equation, about the centroid
+std::vector<double> rigidBodyModes(const std::vector<int> &dofOfEquation, const std::vector<double> &coordinates)
+{
+    std::array<double, 3> centroid{};
+    size_t nodes = 0;
+    for (size_t eq = 0; eq < dofOfEquation.size(); ++eq) {
+        if (eq == 0 || dofOfEquation[eq] / kNodeDofs != dofOfEquation[eq - 1] / kNodeDofs) {
+            const auto node = static_cast<size_t>(dofOfEquation[eq] / kNodeDofs);
+            for (size_t c = 0; c < 3; ++c) {
+                centroid[c] += coordinates[3 * node + c];
+            }
+            ++nodes;
+        }
+    }
+    for (double &c : centroid) {
+        c /= static_cast<double>(std::max<size_t>(nodes, 1));
+    }
+
+    std::vector<double> modes(kModes * dofOfEquation.size(), 0.0);
+    for (size_t eq = 0; eq < dofOfEquation.size(); ++eq) {
+        const auto node = static_cast<size_t>(dofOfEquation[eq] / kNodeDofs);
+        const double dx = coordinates[3 * node] - centroid[0];
+        const double dy = coordinates[3 * node + 1] - centroid[1];
+        const double dz = coordinates[3 * node + 2] - centroid[2];
+        double *row = modes.data() + kModes * eq;
+        // Rotation theta about axis a moves the node by theta (a x r)
+        switch (dofOfEquation[eq] % kNodeDofs) {
+        case 0:
+            row[0] = 1.0;
+            row[4] = dz;
+            row[5] = -dy;
+            break;
+        case 1:
+            row[1] = 1.0;
+            row[3] = -dz;
+            row[5] = dx;
+            break;
+        case 2:
+            row[2] = 1.0;
+            row[3] = dy;
+            row[4] = -dx;
+            break;
+        default:
+            row[dofOfEquation[eq] % kNodeDofs] = 1.0;
+            break;
+        }
+    }
+    return modes;
+}
+
+} // namespace
+
+SmoothedAggregationPreconditioner::SmoothedAggregationPreconditioner(const CsrMatrix &matrix,
+                                                                     const std::vector<int> &dofOfEquation,
+                                                                     const std::vector<double> &coordinates)
+    : m_fine(matrix)
+{
+    Level finest;
+    finest.blockStart.push_back(0);
+    for (size_t eq = 1; eq < dofOfEquation.size(); ++eq) {
+        if (dofOfEquation[eq] / kNodeDofs != dofOfEquation[eq - 1] / kNodeDofs) {
+            finest.blockStart.push_back(static_cast<int>(eq));
+        }
+    }
+    finest.blockStart.push_back(static_cast<int>(dofOfEquation.size()));
+    finest.representative.resize(dofOfEquation.size());
+    for (size_t eq = 0; eq < dofOfEquation.size(); ++eq) {
+        finest.representative[eq] = static_cast<int>(eq);
+    }
+    m_levels.push_back(std::move(finest));
+
+    std::vector<double> modes = rigidBodyModes(dofOfEquation, coordinates);
+    while (matrixOf(m_levels.size() - 1).size > kCoarsestEquations && m_levels.size() < kMaxLevels) {
+        const size_t level = m_levels.size() - 1;
+        Level &fine = m_levels[level];
+        fine.blocks = std::make_unique<BlockJacobiPreconditioner>(matrixOf(level), fine.blockStart);
+        if (fine.blocks->failedEquation() >= 0) {
+            m_failedEquation = fine.representative[static_cast<size_t>(fine.blocks->failedEquation())];
+            return;
+        }
+        Level coarse;
+        std::vector<double> coarseModes;
+        if (!coarsen(level, modes, coarse, coarseModes)) {
+            break;
+        }
+        m_levels.push_back(std::move(coarse));
+        modes = std::move(coarseModes);
+    }
+
+    for (size_t level = 0; level < m_levels.size(); ++level) {
+        const auto n = static_cast<size_t>(matrixOf(level).size);
+        m_levels[level].x.resize(n);
+        m_levels[level].b.resize(n);
+        m_levels[level].r.resize(n);
+    }
+    const CsrMatrix &coarsest = matrixOf(m_levels.size() - 1);
+    m_coarsest.analyse(coarsest);
+    if (!m_coarsest.factorizeNumeric(coarsest, kCoarsestPivotTolerance)) {
+        m_failedEquation = m_levels.back().representative[static_cast<size_t>(m_coarsest.failedEquation())];
+    }
+}
+
+SmoothedAggregationPreconditioner::~SmoothedAggregationPreconditioner() = default;
+
+bool SmoothedAggregationPreconditioner::coarsen(size_t level, const std::vector<double> &modes, Level &coarse,
+                                                std::vector<double> &coarseModes)
+{
+    Level &fine = m_levels[level];
+    const CsrMatrix &a = matrixOf(level);
+    const auto n = static_cast<size_t>(a.size);
+    const size_t blockCount = fine.blockStart.size() - 1;
+    std::vector<int> blockOf(n);
+    for (size_t b = 0; b < blockCount; ++b) {
+        std::fill(blockOf.begin() + fine.blockStart[b], blockOf.begin() + fine.blockStart[b + 1], static_cast<int>(b));
+    }
+
+    // Squared Frobenius norms of the blocks of each block row
+    std::vector<double> blockNorm(blockCount, 0.0);
+    std::vector<int> marker(blockCount, -1);
+    std::vector<double> rowNorm(blockCount, 0.0);
+    std::vector<int> touched;
+    std::vector<size_t> neighbourStart(blockCount + 1, 0);
+    std::vector<int> neighbours;
+    std::vector<double> neighbourNorm;
+    for (size_t b = 0; b < blockCount; ++b) {
+        touched.clear();
+        for (auto row = static_cast<size_t>(fine.blockStart[b]); row < static_cast<size_t>(fine.blockStart[b + 1]); ++row) {
+            for (size_t p = a.rowStart[row]; p < a.rowStart[row + 1]; ++p) {
+                const auto other = static_cast<size_t>(blockOf[static_cast<size_t>(a.columns[p])]);
+                if (marker[other] != static_cast<int>(b)) {
+                    marker[other] = static_cast<int>(b);
+                    rowNorm[other] = 0.0;
+                    touched.push_back(static_cast<int>(other));
+                }
+                rowNorm[other] += a.values[p] * a.values[p];
+            }
+        }
+        std::sort(touched.begin(), touched.end());
+        for (int other : touched) {
+            if (other == static_cast<int>(b)) {
+                blockNorm[b] = rowNorm[b];
+            } else {
+                neighbours.push_back(other);
+                neighbourNorm.push_back(rowNorm[static_cast<size_t>(other)]);
+            }
+        }
+        neighbourStart[b + 1] = neighbours.size();
+    }
+
+    // Strong couplings; the strength of a block pair is symmetric
+    std::vector<size_t> strongStart(blockCount + 1, 0);
+    std::vector<int> strong;
+    std::vector<double> strength;
+    for (size_t b = 0; b < blockCount; ++b) {
+        for (size_t p = neighbourStart[b]; p < neighbourStart[b + 1]; ++p) {
+            const auto other = static_cast<size_t>(neighbours[p]);
+            const double scale = std::sqrt(std::sqrt(blockNorm[b] * blockNorm[other]));
+            const double ratio = scale > 0.0 ? std::sqrt(neighbourNorm[p]) / scale : 0.0;
+            if (ratio >= kStrength) {
+                strong.push_back(static_cast<int>(other));
+                strength.push_back(ratio);
+            }
+        }
+        strongStart[b + 1] = strong.size();
+    }
+
+    // Aggregation: 1) roots whose strong neighbours are all free take them;
+    // 2) the rest join the aggregate they couple to most strongly;
+    // 3) whatever is left groups with its free strong neighbours
+    std::vector<int> aggregateOf(blockCount, -1);
+    int aggregateCount = 0;
+    for (size_t b = 0; b < blockCount; ++b) {
+        if (aggregateOf[b] >= 0 || strongStart[b] == strongStart[b + 1]) {
+            continue;
+        }
+        bool free = true;
+        for (size_t p = strongStart[b]; p < strongStart[b + 1] && free; ++p) {
+            free = aggregateOf[static_cast<size_t>(strong[p])] < 0;
+        }
+        if (!free) {
+            continue;
+        }
+        aggregateOf[b] = aggregateCount;
+        for (size_t p = strongStart[b]; p < strongStart[b + 1]; ++p) {
+            aggregateOf[static_cast<size_t>(strong[p])] = aggregateCount;
+        }
+        ++aggregateCount;
+    }
+    const std::vector<int> rooted = aggregateOf;
+    for (size_t b = 0; b < blockCount; ++b) {
+        if (rooted[b] >= 0) {
+            continue;
+        }
+        double best = 0.0;
+        for (size_t p = strongStart[b]; p < strongStart[b + 1]; ++p) {
+            const int aggregate = rooted[static_cast<size_t>(strong[p])];
+            if (aggregate >= 0 && strength[p] > best) {
+                best = strength[p];
+                aggregateOf[b] = aggregate;
+            }
+        }
+    }
+    for (size_t b = 0; b < blockCount; ++b) {
+        if (aggregateOf[b] >= 0) {
+            continue;
+        }
+        aggregateOf[b] = aggregateCount;
+        for (size_t p = strongStart[b]; p < strongStart[b + 1]; ++p) {
+            if (aggregateOf[static_cast<size_t>(strong[p])] < 0) {
+                aggregateOf[static_cast<size_t>(strong[p])] = aggregateCount;
+            }
+        }
+        ++aggregateCount;
+    }
+    if (static_cast<double>(aggregateCount) * kModes >= kMinimumCoarsening * static_cast<double>(n)) {
+        return false;
+    }
+
+    // Tentative prolongator: per aggregate, orthonormalize the modes on its
+    // equations (modified Gram-Schmidt, twice); Q is the prolongator block
+    // and R the coarse modes
+    std::vector<size_t> memberStart(static_cast<size_t>(aggregateCount) + 1, 0);
+    for (size_t b = 0; b < blockCount; ++b) {
+        ++memberStart[static_cast<size_t>(aggregateOf[b]) + 1];
+    }
+    for (size_t g = 0; g < static_cast<size_t>(aggregateCount); ++g) {
+        memberStart[g + 1] += memberStart[g];
+    }
+    std::vector<int> members(blockCount);
+    std::vector<size_t> next(memberStart.begin(), memberStart.end() - 1);
+    for (size_t b = 0; b < blockCount; ++b) {
+        members[next[static_cast<size_t>(aggregateOf[b])]++] = static_cast<int>(b);
+    }
+
+    std::vector<double> q(kModes * n, 0.0); // row eq: its entries in the aggregate's columns
+    std::vector<int> coarseStart(static_cast<size_t>(aggregateCount) + 1, 0);
+    coarseModes.clear();
+    std::vector<int> rows;
+    std::vector<double> column;
+    for (size_t g = 0; g < static_cast<size_t>(aggregateCount); ++g) {
+        rows.clear();
+        for (size_t m = memberStart[g]; m < memberStart[g + 1]; ++m) {
+            const auto b = static_cast<size_t>(members[m]);
+            for (int eq = fine.blockStart[b]; eq < fine.blockStart[b + 1]; ++eq) {
+                rows.push_back(eq);
+            }
+        }
+        std::array<double, kModes * kModes> r{};
+        size_t rank = 0;
+        column.resize(rows.size());
+        for (size_t j = 0; j < kModes; ++j) {
+            double original = 0.0;
+            for (size_t t = 0; t < rows.size(); ++t) {
+                column[t] = modes[kModes * static_cast<size_t>(rows[t]) + j];
+                original += column[t] * column[t];
+            }
+            for (int pass = 0; pass < 2; ++pass) {
+                for (size_t i = 0; i < rank; ++i) {
+                    double dot = 0.0;
+                    for (size_t t = 0; t < rows.size(); ++t) {
+                        dot += q[kModes * static_cast<size_t>(rows[t]) + i] * column[t];
+                    }
+                    r[kModes * i + j] += dot;
+                    for (size_t t = 0; t < rows.size(); ++t) {
+                        column[t] -= dot * q[kModes * static_cast<size_t>(rows[t]) + i];
+                    }
+                }
+            }
+            double norm = 0.0;
+            for (double value : column) {
+                norm += value * value;
+            }
+            norm = std::sqrt(norm);
+            if (original > 0.0 && norm > kDependentMode * std::sqrt(original)) {
+                for (size_t t = 0; t < rows.size(); ++t) {
+                    q[kModes * static_cast<size_t>(rows[t]) + rank] = column[t] / norm;
+                }
+                r[kModes * rank + j] = norm;
+                ++rank;
+            }
+        }
+        coarseStart[g + 1] = coarseStart[g] + static_cast<int>(rank);
+        coarseModes.insert(coarseModes.end(), r.begin(), r.begin() + static_cast<std::ptrdiff_t>(kModes * rank));
+        coarse.representative.insert(coarse.representative.end(), rank,
+                                     fine.representative[static_cast<size_t>(rows.front())]);
+    }
+    const int coarseSize = coarseStart.back();
+    coarse.blockStart = coarseStart;
+
+    Transfer tentative;
+    tentative.rows = a.size;
+    tentative.columnCount = coarseSize;
+    tentative.rowStart.assign(n + 1, 0);
+    for (size_t eq = 0; eq < n; ++eq) {
+        const auto g = static_cast<size_t>(aggregateOf[static_cast<size_t>(blockOf[eq])]);
+        for (int i = 0; i < coarseStart[g + 1] - coarseStart[g]; ++i) {
+            tentative.columns.push_back(coarseStart[g] + i);
+            tentative.values.push_back(q[kModes * eq + static_cast<size_t>(i)]);
+        }
+        tentative.rowStart[eq + 1] = tentative.columns.size();
+    }
+
+    // omega = 4 / (3 rho(D^-1 A)), rho by power iteration
+    std::vector<double> v(n);
+    std::vector<double> w(n);
+    std::vector<double> z(n);
+    for (size_t i = 0; i < n; ++i) {
+        v[i] = 1.0 + static_cast<double>(i % 7) / 7.0;
+    }
+    double rho = 1.0;
+    for (int iteration = 0; iteration < kPowerIterations; ++iteration) {
+        a.multiply(v.data(), w.data());
+        fine.blocks->apply(w.data(), z.data());
+        double zNorm = 0.0;
+        double vNorm = 0.0;
+        for (size_t i = 0; i < n; ++i) {
+            zNorm += z[i] * z[i];
+            vNorm += v[i] * v[i];
+        }
+        if (zNorm == 0.0) {
+            break;
+        }
+        rho = std::sqrt(zNorm / vNorm);
+        const double scale = 1.0 / std::sqrt(zNorm);
+        for (size_t i = 0; i < n; ++i) {
+            v[i] = z[i] * scale;
+        }
+    }
+    const double omega = 4.0 / (3.0 * rho);
+
+    // P = P_tent - omega D^-1 A P_tent, block row by block row
+    const Transfer product = sparseProduct<Transfer>(a, a.size, tentative, coarseSize);
+    Transfer &prolongation = fine.prolongation;
+    prolongation = Transfer();
+    prolongation.rows = a.size;
+    prolongation.columnCount = coarseSize;
+    prolongation.rowStart.assign(n + 1, 0);
+    std::vector<int> columnMarker(static_cast<size_t>(coarseSize), -1);
+    std::vector<int> pattern;
+    std::vector<double> tile;
+    std::array<double, kNodeDofs> in{};
+    std::array<double, kNodeDofs> out{};
+    for (size_t b = 0; b < blockCount; ++b) {
+        const auto first = static_cast<size_t>(fine.blockStart[b]);
+        const auto m = static_cast<size_t>(fine.blockStart[b + 1]) - first;
+        pattern.clear();
+        for (size_t row = first; row < first + m; ++row) {
+            for (size_t p = product.rowStart[row]; p < product.rowStart[row + 1]; ++p) {
+                const auto c = static_cast<size_t>(product.columns[p]);
+                if (columnMarker[c] != static_cast<int>(b)) {
+                    columnMarker[c] = static_cast<int>(b);
+                    pattern.push_back(static_cast<int>(c));
+                }
+            }
+        }
+        std::sort(pattern.begin(), pattern.end());
+        for (size_t k = 0; k < pattern.size(); ++k) {
+            columnMarker[static_cast<size_t>(pattern[k])] = static_cast<int>(k); // now the tile column
+        }
+        tile.assign(m * pattern.size(), 0.0);
+        for (size_t row = first; row < first + m; ++row) {
+            for (size_t p = product.rowStart[row]; p < product.rowStart[row + 1]; ++p) {
+                tile[(row - first) * pattern.size() + static_cast<size_t>(columnMarker[static_cast<size_t>(product.columns[p])])] =
+                    product.values[p];
+            }
+        }
+        for (size_t k = 0; k < pattern.size(); ++k) {
+            for (size_t t = 0; t < m; ++t) {
+                in[t] = tile[t * pattern.size() + k];
+            }
+            fine.blocks->applyBlock(b, in.data(), out.data());
+            for (size_t t = 0; t < m; ++t) {
+                tile[t * pattern.size() + k] = -omega * out[t];
+            }
+        }
+        for (size_t row = first; row < first + m; ++row) {
+            for (size_t p = tentative.rowStart[row]; p < tentative.rowStart[row + 1]; ++p) {
+                // A has its diagonal blocks, so A P_tent covers P_tent
+                tile[(row - first) * pattern.size() + static_cast<size_t>(columnMarker[static_cast<size_t>(tentative.columns[p])])] +=
+                    tentative.values[p];
+            }
+            for (size_t k = 0; k < pattern.size(); ++k) {
+                prolongation.columns.push_back(pattern[k]);
+                prolongation.values.push_back(tile[(row - first) * pattern.size() + k]);
+            }
+            prolongation.rowStart[row + 1] = prolongation.columns.size();
+        }
+        for (int c : pattern) {
+            columnMarker[static_cast<size_t>(c)] = -1;
+        }
+    }
+    fine.restriction = transposed(prolongation, a.size, coarseSize);
+    fine.restriction.rows = coarseSize;
+    fine.restriction.columnCount = a.size;
+
+    // A_c = P^T (A P), symmetrized against round-off; the pattern is
+    // symmetric and sorted, so A_c and its transpose line up entry by entry
+    const Transfer galerkin = sparseProduct<Transfer>(
+        fine.restriction, coarseSize, sparseProduct<Transfer>(a, a.size, prolongation, coarseSize), coarseSize);
+    const Transfer galerkinTransposed = transposed(galerkin, coarseSize, coarseSize);
+    coarse.matrix.size = coarseSize;
+    coarse.matrix.rowStart = galerkin.rowStart;
+    coarse.matrix.columns = galerkin.columns;
+    coarse.matrix.values.resize(galerkin.values.size());
+    for (size_t p = 0; p < galerkin.values.size(); ++p) {
+        coarse.matrix.values[p] = 0.5 * (galerkin.values[p] + galerkinTransposed.values[p]);
+    }
+    return true;
+}
+
+void SmoothedAggregationPreconditioner::smooth(size_t level, const double *b, double *x, bool forward) const
+{
+    const Level &current = m_levels[level];
+    const CsrMatrix &a = matrixOf(level);
+    const size_t blockCount = current.blockStart.size() - 1;
+    std::array<double, kNodeDofs> residual{};
+    for (size_t k = 0; k < blockCount; ++k) {
+        const size_t block = forward ? k : blockCount - 1 - k;
+        const auto first = static_cast<size_t>(current.blockStart[block]);
+        const auto last = static_cast<size_t>(current.blockStart[block + 1]);
+        for (size_t row = first; row < last; ++row) {
+            double sum = b[row];
+            for (size_t p = a.rowStart[row]; p < a.rowStart[row + 1]; ++p) {
+                const auto column = static_cast<size_t>(a.columns[p]);
+                if (column < first || column >= last) {
+                    sum -= a.values[p] * x[column];
+                }
+            }
+            residual[row - first] = sum;
+        }
+        current.blocks->applyBlock(block, residual.data(), x + first);
+    }
+}
+
+void SmoothedAggregationPreconditioner::cycle(size_t level, const double *b, double *x) const
+{
+    const CsrMatrix &a = matrixOf(level);
+    const auto n = static_cast<size_t>(a.size);
+    if (level + 1 == m_levels.size()) {
+        std::copy(b, b + n, x);
+        m_coarsest.solve(x);
+        return;
+    }
+
+    const Level &current = m_levels[level];
+    const Level &coarse = m_levels[level + 1];
+    std::fill(x, x + n, 0.0);
+    smooth(level, b, x, true);
+
+    a.multiply(x, current.r.data());
+    for (size_t i = 0; i < n; ++i) {
+        current.r[i] = b[i] - current.r[i];
+    }
+    const Transfer &restriction = current.restriction;
+    for (size_t i = 0; i < static_cast<size_t>(restriction.rows); ++i) {
+        double sum = 0.0;
+        for (size_t p = restriction.rowStart[i]; p < restriction.rowStart[i + 1]; ++p) {
+            sum += restriction.values[p] * current.r[static_cast<size_t>(restriction.columns[p])];
+        }
+        coarse.b[i] = sum;
+    }
+    cycle(level + 1, coarse.b.data(), coarse.x.data());
+    const Transfer &prolongation = current.prolongation;
+    for (size_t i = 0; i < n; ++i) {
+        double sum = 0.0;
+        for (size_t p = prolongation.rowStart[i]; p < prolongation.rowStart[i + 1]; ++p) {
+            sum += prolongation.values[p] * coarse.x[static_cast<size_t>(prolongation.columns[p])];
+        }
+        x[i] += sum;
+    }
+
+    smooth(level, b, x, false);
+}
+
+void SmoothedAggregationPreconditioner::apply(const double *r, double *z) const
+{
+    cycle(0, r, z);
+}
+
+int SmoothedAggregationPreconditioner::levelSize(int level) const
+{
+    return matrixOf(static_cast<size_t>(level)).size;
+}
+
+double SmoothedAggregationPreconditioner::operatorComplexity() const
+{
+    size_t total = 0;
+    for (size_t level = 0; level < m_levels.size(); ++level) {
+        total += matrixOf(level).nonZeros();
+    }
+    return m_fine.nonZeros() > 0 ? static_cast<double>(total) / static_cast<double>(m_fine.nonZeros()) : 1.0;
+}
+
+} // namespace Structura::Analysis
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "ConjugateGradient.h"
+#include "Preconditioners.h"
+#include "SparseLdlt.h"
+#include "SparseMatrix.h"
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace Structura::Analysis {
+
+/**
+ * @brief Smoothed aggregation algebraic multigrid, one V-cycle per apply().
+ *
+ * Setup builds a hierarchy of coarser stiffness matrices A_c = P^T A P:
+ * - nodes (the 6 x 6 diagonal blocks of K, later the aggregates) are
+ *   grouped into aggregates of strongly coupled neighbours, comparing the
+ *   Frobenius norm of each off-diagonal block with those of the diagonal
+ *   blocks, so a very stiff member does not share an aggregate with the
+ *   slender ones around it;
+ * - the tentative prolongator interpolates the six rigid body modes of
+ *   each aggregate exactly (translations and rotations about the centroid
+ *   of the model, orthonormalized per aggregate), which are the near
+ *   nullspace of a frame's stiffness;
+ * - one damped block-Jacobi step, P = (I - omega D^-1 A) P_tent, smooths
+ *   it, with omega = 4 / (3 rho(D^-1 A)) from a power iteration.
+ * Coarsening stops below kCoarsestEquations, where SparseLdlt solves
+ * directly.
+ *
+ * The V-cycle smooths with nodal block Gauss-Seidel, forward before and
+ * backward after the coarse correction, so the preconditioner is symmetric
+ * as conjugate gradients requires. Setup and cycles run serially.
+ */
+class SmoothedAggregationPreconditioner : public Preconditioner
+{
+public:
+    /// Equations below which a level is solved directly
+    static constexpr int kCoarsestEquations = 600;
+
+    /**
+     * @param matrix K, full symmetric; referenced, must outlive the
+     *        preconditioner
+     * @param dofOfEquation DOF (6 * node + d) of every equation; the free
+     *        DOFs of a node must have consecutive equations
+     * @param coordinates Node coordinates, x, y, z per node
+     */
+    SmoothedAggregationPreconditioner(const CsrMatrix &matrix, const std::vector<int> &dofOfEquation,
+                                      const std::vector<double> &coordinates);
+    ~SmoothedAggregationPreconditioner() override;
+
+    void apply(const double *r, double *z) const override;
+    int failedEquation() const override { return m_failedEquation; }
+
+    /// Levels including the finest and the directly solved coarsest
+    int levelCount() const { return static_cast<int>(m_levels.size()); }
+
+    /// Equations of level @p level
+    int levelSize(int level) const;
+
+    /// Nonzeros of all level matrices over those of K
+    double operatorComplexity() const;
+
+private:
+    /// Rectangular CSR matrix: a prolongator or its transpose
+    struct Transfer
+    {
+        int rows{0};
+        int columnCount{0};
+        std::vector<size_t> rowStart{0};
+        std::vector<int> columns;
+        std::vector<double> values;
+    };
+
+    struct Level
+    {
+        CsrMatrix matrix;                ///< A_c; empty on the finest level, which uses K
+        std::vector<int> blockStart;     ///< Nodal blocks (nodes, then aggregates)
+        std::vector<int> representative; ///< A fine equation of every equation, for failure reports
+        std::unique_ptr<BlockJacobiPreconditioner> blocks; ///< D^-1 of the smoother
+        Transfer prolongation;           ///< From the next coarser level to this one
+        Transfer restriction;            ///< Its transpose
+        mutable std::vector<double> x;   ///< Scratch of the V-cycle
+        mutable std::vector<double> b;
+        mutable std::vector<double> r;
+    };
+
+    const CsrMatrix &matrixOf(size_t level) const { return level == 0 ? m_fine : m_levels[level].matrix; }
+
+    /// Next level below @p level, whose near nullspace is @p modes; false if it would not be smaller
+    bool coarsen(size_t level, const std::vector<double> &modes, Level &coarse, std::vector<double> &coarseModes);
+    void cycle(size_t level, const double *b, double *x) const;
+    void smooth(size_t level, const double *b, double *x, bool forward) const;
+
+    const CsrMatrix &m_fine;
+    std::vector<Level> m_levels;
+    SparseLdlt m_coarsest;
+    int m_failedEquation{-1};
+};
+
+} // namespace Structura::Analysis
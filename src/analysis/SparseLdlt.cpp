@@ -0,0 +1,127 @@
+#include "SparseLdlt.h"
+#include <cmath>
+
+namespace Structura::Analysis {
+
+void SparseLdlt::analyse(const CsrMatrix &matrix)
+{
+    const int n = matrix.size;
+    const auto un = static_cast<size_t>(n);
+    m_size = n;
+
+    // Elimination tree and nonzeros per column of L. Row k of the symmetric
+    // matrix lists the entries a_ik, i < k, of its upper column k.
+    std::vector<int> &parent = m_parent;
+    parent.assign(un, -1);
+    std::vector<int> flag(un, -1);
+    std::vector<size_t> count(un, 0);
+    for (int k = 0; k < n; ++k) {
+        flag[static_cast<size_t>(k)] = k;
+        for (size_t p = matrix.rowStart[static_cast<size_t>(k)]; p < matrix.rowStart[static_cast<size_t>(k) + 1]; ++p) {
+            int i = matrix.columns[p];
+            if (i >= k) {
+                break; // columns are sorted
+            }
+            for (; flag[static_cast<size_t>(i)] != k; i = parent[static_cast<size_t>(i)]) {
+                if (parent[static_cast<size_t>(i)] == -1) {
+                    parent[static_cast<size_t>(i)] = k;
+                }
+                ++count[static_cast<size_t>(i)];
+                flag[static_cast<size_t>(i)] = k;
+            }
+        }
+    }
+    m_columnStart.assign(un + 1, 0);
+    for (size_t k = 0; k < un; ++k) {
+        m_columnStart[k + 1] = m_columnStart[k] + count[k];
+    }
+}
+
+bool SparseLdlt::factorizeNumeric(const CsrMatrix &matrix, double pivotTolerance)
+{
+    const int n = m_size;
+    const auto un = static_cast<size_t>(n);
+    const std::vector<int> &parent = m_parent;
+    m_failedEquation = -1;
+    m_rowIndex.resize(m_columnStart[un]);
+    m_values.resize(m_columnStart[un]);
+    m_diagonal.assign(un, 0.0);
+
+    const std::vector<double> threshold = pivotThresholds(matrix, pivotTolerance);
+
+    // Row k of L by a sparse triangular solve over the reach of row k in the
+    // elimination tree
+    std::vector<double> y(un, 0.0);
+    std::vector<int> pattern(un);
+    std::vector<int> flag(un, -1);
+    std::vector<size_t> count(un, 0);
+    for (int k = 0; k < n; ++k) {
+        const auto uk = static_cast<size_t>(k);
+        size_t top = un;
+        flag[uk] = k;
+        for (size_t p = matrix.rowStart[uk]; p < matrix.rowStart[uk + 1]; ++p) {
+            int i = matrix.columns[p];
+            if (i > k) {
+                break;
+            }
+            y[static_cast<size_t>(i)] += matrix.values[p];
+            if (i == k) {
+                continue;
+            }
+            size_t length = 0;
+            for (; flag[static_cast<size_t>(i)] != k; i = parent[static_cast<size_t>(i)]) {
+                pattern[length++] = i;
+                flag[static_cast<size_t>(i)] = k;
+            }
+            while (length > 0) {
+                pattern[--top] = pattern[--length];
+            }
+        }
+
+        double d = y[uk];
+        y[uk] = 0.0;
+        for (; top < un; ++top) {
+            const auto i = static_cast<size_t>(pattern[top]);
+            const double yi = y[i];
+            y[i] = 0.0;
+            const size_t end = m_columnStart[i] + count[i];
+            for (size_t p = m_columnStart[i]; p < end; ++p) {
+                y[static_cast<size_t>(m_rowIndex[p])] -= m_values[p] * yi;
+            }
+            const double lki = yi / m_diagonal[i];
+            d -= lki * yi;
+            m_rowIndex[end] = k;
+            m_values[end] = lki;
+            ++count[i];
+        }
+        if (!(std::abs(d) > threshold[uk])) {
+            m_failedEquation = k;
+            return false;
+        }
+        m_diagonal[uk] = d;
+    }
+    return true;
+}
+
+void SparseLdlt::solve(double *x) const
+{
+    const auto n = static_cast<size_t>(m_size);
+    for (size_t j = 0; j < n; ++j) {
+        const double xj = x[j];
+        for (size_t p = m_columnStart[j]; p < m_columnStart[j + 1]; ++p) {
+            x[m_rowIndex[p]] -= m_values[p] * xj;
+        }
+    }
+    for (size_t j = 0; j < n; ++j) {
+        x[j] /= m_diagonal[j];
+    }
+    for (size_t j = n; j-- > 0;) {
+        double xj = x[j];
+        for (size_t p = m_columnStart[j]; p < m_columnStart[j + 1]; ++p) {
+            xj -= m_values[p] * x[m_rowIndex[p]];
+        }
+        x[j] = xj;
+    }
+}
+
+} // namespace Structura::Analysis
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "DirectSolver.h"
+#include "SparseMatrix.h"
+#include <vector>
+
+namespace Structura::Analysis {
+
+/**
+ * @brief Sparse LDL^T factorization of a symmetric matrix, A = L D L^T.
+ *
+ * Up-looking algorithm: the elimination tree and the column counts of L are
+ * computed first, then row k of L is obtained by a sparse triangular solve
+ * restricted to the tree reach of row k of A. No pivoting is done, so the
+ * caller supplies a fill-reducing numbering (see NodeOrdering.h). Serial;
+ * SupernodalLdlt is the faster choice on large models.
+ */
+class SparseLdlt : public DirectSolver
+{
+public:
+    /**
+     * @brief Symbolic factorization: elimination tree and column counts.
+     *
+     * Only the structure of @p matrix is read. Afterwards factorNonZeros()
+     * is the exact size of L, known before any numeric work.
+     */
+    void analyse(const CsrMatrix &matrix) override;
+
+    bool factorizeNumeric(const CsrMatrix &matrix, double pivotTolerance) override;
+
+    void solve(double *x) const override;
+
+    int failedEquation() const override { return m_failedEquation; }
+
+    /// Strictly lower nonzeros of L (valid after analyse())
+    size_t factorNonZeros() const override { return m_columnStart.back(); }
+
+    size_t factorBytes() const override
+    {
+        return bytesOf<int>(m_parent.size()) + bytesOf<size_t>(m_columnStart.size())
+               + bytesOf<int>(factorNonZeros()) + bytesOf<double>(factorNonZeros() + m_parent.size());
+    }
+
+    int size() const { return m_size; }
+
+private:
+    int m_size{0};
+    int m_failedEquation{-1};
+    std::vector<int> m_parent;         ///< Elimination tree
+    std::vector<size_t> m_columnStart{0}; ///< L in CSC, diagonal not stored
+    std::vector<int> m_rowIndex;
+    std::vector<double> m_values;
+    std::vector<double> m_diagonal;
+};
+
+} // namespace Structura::Analysis
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace Structura::Analysis {
+
+/**
+ * @brief Square sparse matrix in compressed sparse row form.
+ *
+ * Symmetric matrices (the global stiffness) are stored with both triangles,
+ * columns sorted within each row, so row i also lists column i.
+ */
+struct CsrMatrix
+{
+    int size{0};
+    std::vector<size_t> rowStart{0}; ///< size + 1 offsets into columns/values
+    std::vector<int> columns;
+    std::vector<double> values;
+
+    size_t nonZeros() const { return columns.size(); }
+
+    /// Largest distance of an entry from the diagonal
+    int bandwidth() const
+    {
+        int result = 0;
+        for (int row = 0; row < size; ++row) {
+            if (rowStart[static_cast<size_t>(row)] < rowStart[static_cast<size_t>(row) + 1]) {
+                result = std::max(result, row - columns[rowStart[static_cast<size_t>(row)]]);
+            }
+        }
+        return result;
+    }
+
+    /// Envelope size of the lower triangle: sum over rows of the distance
+    /// from the first entry to the diagonal (what a skyline solver stores)
+    size_t profile() const
+    {
+        size_t result = 0;
+        for (int row = 0; row < size; ++row) {
+            if (rowStart[static_cast<size_t>(row)] < rowStart[static_cast<size_t>(row) + 1]) {
+                result += static_cast<size_t>(std::max(0, row - columns[rowStart[static_cast<size_t>(row)]]));
+            }
+        }
+        return result;
+    }
+
+    /// y = A x
+    void multiply(const double *x, double *y) const
+    {
+        for (int row = 0; row < size; ++row) {
+            double sum = 0.0;
+            for (size_t p = rowStart[static_cast<size_t>(row)]; p < rowStart[static_cast<size_t>(row) + 1]; ++p) {
+                sum += values[p] * x[columns[p]];
+            }
+            y[row] = sum;
+        }
+    }
+};
+
+} // namespace Structura::Analysis
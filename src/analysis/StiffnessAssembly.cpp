@@ -0,0 +1,244 @@
+#include "StiffnessAssembly.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <functional>
+
+namespace Structura::Analysis {
+
+namespace {
+
+/// @p body over [0, count), split over @p pool when there is one
+void forRange(ThreadPool *pool, size_t count, const std::function<void(size_t begin, size_t end)> &body)
+{
+    if (pool == nullptr) {
+        body(0, count);
+    } else {
+        pool->parallelFor(count, body);
+    }
+}
+
+} // namespace
+
+void numberEquations(const FrameModel &model, const NodeGraph &graph, const std::vector<int> &order,
+                     std::vector<int> &equations, std::vector<int> &dofOfEquation)
+{
+    const size_t nodeCount = model.nodeCount();
+    equations.assign(kNodeDofs * nodeCount, -1);
+    dofOfEquation.clear();
+    dofOfEquation.reserve(kNodeDofs * nodeCount);
+    for (int node : order) {
+        const auto un = static_cast<size_t>(node);
+        if (graph.degree(node) == 0) {
+            continue;
+        }
+        for (int d = 0; d < kNodeDofs; ++d) {
+            if (((model.restraints[un] >> d) & 1u) == 0) {
+                const int dof = kNodeDofs * node + d;
+                equations[static_cast<size_t>(dof)] = static_cast<int>(dofOfEquation.size());
+                dofOfEquation.push_back(dof);
+            }
+        }
+    }
+}
+
+void StiffnessAssembly::analyse(const FrameModel &model, const NodeGraph &graph, const std::vector<int> &order)
+{
+    const size_t nodeCount = model.nodeCount();
+    m_restraints = model.restraints;
+    numberEquations(model, graph, order, m_equations, m_dofOfEquation);
+
+    // Free DOFs of each connected node have consecutive equations
+    std::vector<int> firstEquation(nodeCount, -1);
+    std::vector<int> freeCount(nodeCount, 0);
+    for (size_t node = 0; node < nodeCount; ++node) {
+        for (size_t d = kNodeDofs; d-- > 0;) {
+            const int eq = m_equations[kNodeDofs * node + d];
+            if (eq >= 0) {
+                firstEquation[node] = eq;
+                ++freeCount[node];
+            }
+        }
+    }
+    const int equationCount = static_cast<int>(m_dofOfEquation.size());
+
+    // Row layout of each node: its own block and its neighbours' blocks, in
+    // equation order. blockStart holds the offset of each block in the row.
+    std::vector<int> blockNode;
+    std::vector<int> blockStart;
+    std::vector<size_t> layoutStart(nodeCount + 1, 0);
+    blockNode.reserve(graph.neighbours.size() + nodeCount);
+    blockStart.reserve(graph.neighbours.size() + nodeCount);
+    std::vector<size_t> rowLength(nodeCount, 0);
+    for (size_t node = 0; node < nodeCount; ++node) {
+        const size_t first = blockNode.size();
+        layoutStart[node] = first;
+        if (freeCount[node] > 0) {
+            blockNode.push_back(static_cast<int>(node));
+            for (int p = graph.start[node]; p < graph.start[node + 1]; ++p) {
+                const int neighbour = graph.neighbours[static_cast<size_t>(p)];
+                if (freeCount[static_cast<size_t>(neighbour)] > 0) {
+                    blockNode.push_back(neighbour);
+                }
+            }
+            std::sort(blockNode.begin() + static_cast<std::ptrdiff_t>(first), blockNode.end(),
+                      [&firstEquation](int a, int b) {
+                          return firstEquation[static_cast<size_t>(a)] < firstEquation[static_cast<size_t>(b)];
+                      });
+            int offset = 0;
+            for (size_t b = first; b < blockNode.size(); ++b) {
+                blockStart.push_back(offset);
+                offset += freeCount[static_cast<size_t>(blockNode[b])];
+            }
+            rowLength[node] = static_cast<size_t>(offset);
+        }
+    }
+    layoutStart[nodeCount] = blockNode.size();
+
+    // CSR structure: every row of a node shares the node's column list
+    m_matrix = CsrMatrix();
+    m_matrix.size = equationCount;
+    m_matrix.rowStart.assign(static_cast<size_t>(equationCount) + 1, 0);
+    for (int eq = 0; eq < equationCount; ++eq) {
+        const auto node = static_cast<size_t>(m_dofOfEquation[static_cast<size_t>(eq)] / kNodeDofs);
+        m_matrix.rowStart[static_cast<size_t>(eq) + 1] = m_matrix.rowStart[static_cast<size_t>(eq)] + rowLength[node];
+    }
+    m_matrix.columns.resize(m_matrix.rowStart.back());
+    m_matrix.values.assign(m_matrix.rowStart.back(), 0.0);
+    for (int eq = 0; eq < equationCount; ++eq) {
+        const auto node = static_cast<size_t>(m_dofOfEquation[static_cast<size_t>(eq)] / kNodeDofs);
+        size_t slot = m_matrix.rowStart[static_cast<size_t>(eq)];
+        for (size_t b = layoutStart[node]; b < layoutStart[node + 1]; ++b) {
+            const int column = blockNode[b];
+            for (int c = 0; c < freeCount[static_cast<size_t>(column)]; ++c) {
+                m_matrix.columns[slot++] = firstEquation[static_cast<size_t>(column)] + c;
+            }
+        }
+    }
+
+    // Element block offsets, found once by binary search in the row layout
+    auto blockOffset = [&](int rowNode, int columnNode) {
+        if (freeCount[static_cast<size_t>(rowNode)] == 0 || freeCount[static_cast<size_t>(columnNode)] == 0) {
+            return 0;
+        }
+        const auto first = blockNode.begin() + static_cast<std::ptrdiff_t>(layoutStart[static_cast<size_t>(rowNode)]);
+        const auto last = blockNode.begin() + static_cast<std::ptrdiff_t>(layoutStart[static_cast<size_t>(rowNode) + 1]);
+        const auto it = std::lower_bound(first, last, columnNode, [&firstEquation](int a, int node) {
+            return firstEquation[static_cast<size_t>(a)] < firstEquation[static_cast<size_t>(node)];
+        });
+        return blockStart[static_cast<size_t>(it - blockNode.begin())];
+    };
+    m_elementOffsets.resize(model.elements.size());
+    m_elementNodes.resize(model.elements.size());
+    for (size_t e = 0; e < model.elements.size(); ++e) {
+        const int a = model.elements[e].nodes[0];
+        const int b = model.elements[e].nodes[1];
+        m_elementOffsets[e] = {{blockOffset(a, a), blockOffset(a, b), blockOffset(b, a), blockOffset(b, b)}};
+        m_elementNodes[e] = model.elements[e].nodes;
+    }
+    m_colouring = colourElements(model);
+    m_analysed = true;
+}
+
+bool StiffnessAssembly::fits(const FrameModel &model) const
+{
+    if (!m_analysed || model.restraints != m_restraints || model.elements.size() != m_elementNodes.size()) {
+        return false;
+    }
+    for (size_t e = 0; e < m_elementNodes.size(); ++e) {
+        if (model.elements[e].nodes != m_elementNodes[e]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+const CsrMatrix &StiffnessAssembly::assemble(const FrameModel &model, const std::vector<ElementAxes> &axes,
+                                             AssemblyMethod method, ThreadPool *pool)
+{
+    if (pool != nullptr && pool->threadCount() == 1) {
+        pool = nullptr;
+    }
+
+    if (method == AssemblyMethod::PartialMatrices) {
+        const size_t slots = m_matrix.values.size();
+        m_partialValues.resize((kPartialMatrices - 1) * slots);
+        // Range 0 goes straight into K; each range zeroes its own values
+        forRange(pool, kPartialMatrices, [&](size_t begin, size_t end) {
+            for (size_t part = begin; part < end; ++part) {
+                double *values = part == 0 ? m_matrix.values.data() : m_partialValues.data() + (part - 1) * slots;
+                std::fill(values, values + slots, 0.0);
+                size_t first = 0;
+                size_t last = 0;
+                ThreadPool::range(model.elements.size(), kPartialMatrices, static_cast<int>(part), first, last);
+                for (size_t e = first; e < last; ++e) {
+                    addElement(model, axes, e, values);
+                }
+            }
+        });
+        // Every entry sums the ranges in the same order
+        forRange(pool, slots, [&](size_t begin, size_t end) {
+            for (size_t part = 1; part < static_cast<size_t>(kPartialMatrices); ++part) {
+                const double *partial = m_partialValues.data() + (part - 1) * slots;
+                for (size_t slot = begin; slot < end; ++slot) {
+                    m_matrix.values[slot] += partial[slot];
+                }
+            }
+        });
+        return m_matrix;
+    }
+
+    std::fill(m_matrix.values.begin(), m_matrix.values.end(), 0.0);
+    for (int c = 0; c < m_colouring.colourCount(); ++c) {
+        const auto first = static_cast<size_t>(m_colouring.colourStart[static_cast<size_t>(c)]);
+        const auto last = static_cast<size_t>(m_colouring.colourStart[static_cast<size_t>(c) + 1]);
+        forRange(pool, last - first, [&](size_t begin, size_t end) {
+            for (size_t p = first + begin; p < first + end; ++p) {
+                addElement(model, axes, static_cast<size_t>(m_colouring.elements[p]), m_matrix.values.data());
+            }
+        });
+    }
+    return m_matrix;
+}
+
+void StiffnessAssembly::addElement(const FrameModel &model, const std::vector<ElementAxes> &axes, size_t e,
+                                   double *values) const
+{
+    const FrameElement &element = model.elements[e];
+    ElementMatrix ke;
+    globalStiffness(element, axes[e], ke);
+    for (size_t rowEnd = 0; rowEnd < 2; ++rowEnd) {
+        const size_t rowBase = kNodeDofs * static_cast<size_t>(element.nodes[rowEnd]);
+        for (size_t i = 0; i < kNodeDofs; ++i) {
+            const int row = m_equations[rowBase + i];
+            if (row < 0) {
+                continue;
+            }
+            const double *source = &ke[(kNodeDofs * rowEnd + i) * kElementDofs];
+            for (size_t columnEnd = 0; columnEnd < 2; ++columnEnd) {
+                const size_t columnBase = kNodeDofs * static_cast<size_t>(element.nodes[columnEnd]);
+                double *target = values + m_matrix.rowStart[static_cast<size_t>(row)]
+                               + static_cast<size_t>(m_elementOffsets[e][2 * rowEnd + columnEnd]);
+                for (size_t j = 0; j < kNodeDofs; ++j) {
+                    if (m_equations[columnBase + j] >= 0) {
+                        *target++ += source[kNodeDofs * columnEnd + j];
+                    }
+                }
+            }
+        }
+    }
+}
+
+void StiffnessAssembly::reset()
+{
+    m_analysed = false;
+    m_restraints.clear();
+    m_elementNodes.clear();
+    m_equations.clear();
+    m_dofOfEquation.clear();
+    m_matrix = CsrMatrix();
+    m_elementOffsets.clear();
+    m_colouring = ElementColouring();
+    m_partialValues = std::vector<double>();
+}
+
+} // namespace Structura::Analysis
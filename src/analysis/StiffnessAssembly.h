@@ -0,0 +1,133 @@
+#pragma once
+
+#include "ElementColouring.h"
+#include "ElementStiffness.h"
+#include "FrameModel.h"
+#include "NodeOrdering.h"
+#include "SparseMatrix.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace Structura::Analysis {
+
+class ThreadPool;
+
+/**
+ * @brief How StiffnessAssembly::assemble() shares the elements among threads.
+ *
+ * Both sum the contributions to every entry of K in an order fixed by the
+ * model alone, so K is bitwise the same for any number of threads. The two
+ * orders differ, so the methods agree only to rounding with each other.
+ */
+enum class AssemblyMethod
+{
+    /// Colour by colour (colourElements()); the elements of a colour share no
+    /// node and are formed and added in parallel straight into K
+    Coloured,
+    /// kPartialMatrices contiguous element ranges, each added into its own
+    /// copy of the values, then summed range by range; independent of the
+    /// colouring but holds kPartialMatrices - 1 extra copies of the values
+    PartialMatrices
+};
+
+/**
+ * @brief Equation numbering of the free DOFs, without any matrix structure.
+ *
+ * Nodes are taken in @p order and the free DOFs of each get consecutive
+ * equations; nodes not connected to any element get none.
+ * @param equations Receives the equation of every DOF (6 per node), -1 where
+ *        restrained or unconnected
+ * @param dofOfEquation Receives the DOF (6 * node + d) of every equation
+ */
+void numberEquations(const FrameModel &model, const NodeGraph &graph, const std::vector<int> &order,
+                     std::vector<int> &equations, std::vector<int> &dofOfEquation);
+
+/**
+ * @brief Global stiffness assembly split into a symbolic and a numeric phase.
+ *
+ * analyse() numbers the free DOFs in a given node order and derives the CSR
+ * structure of K from the node adjacency: every free DOF of a node couples
+ * with all free DOFs of the node itself and of its neighbours, and the DOFs
+ * of a node get consecutive equations, so each row is a sequence of node
+ * blocks. For every element it records where its node blocks start within
+ * the rows of its end nodes.
+ *
+ * assemble() then zeroes the values and adds each element matrix straight
+ * into those slots, with no triplets, sorting or lookups. The structure only
+ * depends on connectivity and restraints, so it can be kept across analyses
+ * in which just coordinates, k-points, properties or loads changed. analyse()
+ * records the restraint mask of every node and the end nodes of every
+ * element, and fits() tells whether a model still has them.
+ *
+ * Forming the element matrices is independent per element, and
+ * assemble() can share it among the threads of a pool (AssemblyMethod).
+ */
+class StiffnessAssembly
+{
+public:
+    /// Element ranges of AssemblyMethod::PartialMatrices, whatever the thread count
+    static constexpr int kPartialMatrices = 8;
+
+    /**
+     * @brief Symbolic phase: equation numbering and CSR structure.
+     * @param model Model whose connectivity and restraints are used
+     * @param graph Node adjacency of @p model
+     * @param order Node elimination order; nodes without elements get no
+     *        equations
+     */
+    void analyse(const FrameModel &model, const NodeGraph &graph, const std::vector<int> &order);
+
+    /**
+     * @brief Numeric phase: fill the matrix values from the element matrices.
+     * @param model Same topology as given to analyse()
+     * @param axes Element axes of @p model
+     * @param pool Threads that form and add the elements, or nullptr for serial
+     * @return Assembled stiffness, full symmetric CSR
+     */
+    const CsrMatrix &assemble(const FrameModel &model, const std::vector<ElementAxes> &axes,
+                              AssemblyMethod method = AssemblyMethod::Coloured, ThreadPool *pool = nullptr);
+
+    /// Forget the structure
+    void reset();
+
+    bool isAnalysed() const { return m_analysed; }
+
+    /**
+     * @brief Whether the structure from analyse() is valid for @p model: same
+     *        restraint masks per node and end nodes per element.
+     *
+     * Linear in the model size, far below the cost of a new analyse().
+     */
+    bool fits(const FrameModel &model) const;
+
+    int equationCount() const { return m_matrix.size; }
+
+    /// Equation of every DOF (6 per node), -1 where restrained or unconnected
+    const std::vector<int> &equations() const { return m_equations; }
+
+    /// DOF (6 * node + d) of every equation
+    const std::vector<int> &dofOfEquation() const { return m_dofOfEquation; }
+
+    const CsrMatrix &matrix() const { return m_matrix; }
+
+private:
+    /// Form element @p e and add it into @p values, laid out as m_matrix
+    void addElement(const FrameModel &model, const std::vector<ElementAxes> &axes, size_t e, double *values) const;
+
+    bool m_analysed{false};
+    /// Topology the structure was built for, compared by fits()
+    std::vector<std::uint8_t> m_restraints;
+    std::vector<std::array<int, 2>> m_elementNodes;
+    std::vector<int> m_equations;
+    std::vector<int> m_dofOfEquation;
+    CsrMatrix m_matrix;
+    /// Per element, offset within a row of node block (row end, column end):
+    /// [start-start, start-end, end-start, end-end]
+    std::vector<std::array<int, 4>> m_elementOffsets;
+    ElementColouring m_colouring;
+    /// Values of the element ranges 1 .. kPartialMatrices - 1 (PartialMatrices)
+    std::vector<double> m_partialValues;
+};
+
+} // namespace Structura::Analysis
@@ -0,0 +1,550 @@
+#include "SupernodalLdlt.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <condition_variable>
+#include <mutex>
+
+namespace Structura::Analysis {
+
+namespace {
+
+constexpr size_t kBlockColumns = 48; ///< Columns of L per blocked update
+constexpr size_t kTileRows = 256;    ///< Rows per tile, so a block tile stays in L2
+
+constexpr size_t kKernelColumns = 4; ///< Target columns updated together
+constexpr size_t kKernelRows = 8;    ///< Rows accumulated in registers
+
+/// y[0 .. count) -= a * x[0 .. count)
+inline void subtractScaled(double *y, const double *x, double a, size_t count)
+{
+    for (size_t i = 0; i < count; ++i) {
+        y[i] -= x[i] * a;
+    }
+}
+
+/**
+ * @brief Rank-depth update of up to kKernelColumns target columns over the
+ *        rows [begin, end): T(i, q) -= sum_k S(i, k) * c(q, k).
+ *
+ * Each source value is loaded once for all target columns and the sums are
+ * kept in registers, instead of one pass over the target per source column.
+ * @param coefficients kKernelColumns x depth, row-major; unused rows zero
+ */
+void subtractProducts(double *target, size_t targetStride, size_t columns,
+                      const double *source, size_t sourceStride, const double *coefficients,
+                      size_t depth, size_t begin, size_t end)
+{
+    size_t i = begin;
+    for (; i + kKernelRows <= end; i += kKernelRows) {
+        double sum[kKernelColumns][kKernelRows] = {};
+        for (size_t k = 0; k < depth; ++k) {
+            const double *sk = source + k * sourceStride + i;
+            for (size_t q = 0; q < kKernelColumns; ++q) {
+                const double c = coefficients[q * depth + k];
+                for (size_t r = 0; r < kKernelRows; ++r) {
+                    sum[q][r] += sk[r] * c;
+                }
+            }
+        }
+        for (size_t q = 0; q < columns; ++q) {
+            double *tq = target + q * targetStride + i;
+            for (size_t r = 0; r < kKernelRows; ++r) {
+                tq[r] -= sum[q][r];
+            }
+        }
+    }
+    for (; i < end; ++i) {
+        for (size_t q = 0; q < columns; ++q) {
+            double sum = 0.0;
+            for (size_t k = 0; k < depth; ++k) {
+                sum += source[k * sourceStride + i] * coefficients[q * depth + k];
+            }
+            target[q * targetStride + i] -= sum;
+        }
+    }
+}
+
+/**
+ * @brief T -= S D S(first .. first + count)^T on the rows [begin, rows) of
+ *        the columns first .. first + count of T, tiled by kTileRows.
+ *
+ * S has @p depth columns of stride @p sourceStride; row j of S is also the
+ * coefficient row of target column j. Rows of T above the diagonal inside
+ * a group of kKernelColumns columns are updated too; callers only read the
+ * lower triangle.
+ */
+void subtractSymmetricProducts(double *target, size_t targetStride, size_t first, size_t count, size_t rows,
+                               const double *source, size_t sourceStride, const double *diagonal, size_t depth)
+{
+    double coefficients[kKernelColumns * kBlockColumns];
+    for (size_t t0 = first; t0 < rows; t0 += kTileRows) {
+        const size_t t1 = std::min(rows, t0 + kTileRows);
+        for (size_t j = first; j < std::min(first + count, t1); j += kKernelColumns) {
+            const size_t columns = std::min(kKernelColumns, first + count - j);
+            for (size_t q = 0; q < kKernelColumns; ++q) {
+                for (size_t k = 0; k < depth; ++k) {
+                    coefficients[q * depth + k] = q < columns ? source[k * sourceStride + j + q] * diagonal[k] : 0.0;
+                }
+            }
+            subtractProducts(target + j * targetStride, targetStride, columns, source, sourceStride, coefficients,
+                             depth, std::max(j, t0), t1);
+        }
+    }
+}
+
+/**
+ * @brief Relaxed amalgamation rule: merge when the supernode stays small
+ *        or the explicit zeros remain a small fraction of its panel.
+ */
+bool acceptMerge(size_t width, size_t stored, size_t below)
+{
+    const size_t dense = width * (width + 1) / 2 + width * below;
+    const double zeros = static_cast<double>(dense - stored) / static_cast<double>(dense);
+    return width <= 4 || (width <= 16 && zeros < 0.8) || (width <= 48 && zeros < 0.1) || zeros < 0.05;
+}
+
+} // namespace
+
+void SupernodalLdlt::analyse(const CsrMatrix &matrix)
+{
+    const int n = matrix.size;
+    const auto un = static_cast<size_t>(n);
+    m_size = n;
+    m_failedEquation = -1;
+
+    // Elimination tree and strictly lower column counts (input numbering)
+    std::vector<int> treeParent(un, -1);
+    std::vector<int> flag(un, -1);
+    std::vector<size_t> count(un, 0);
+    for (int k = 0; k < n; ++k) {
+        flag[static_cast<size_t>(k)] = k;
+        for (size_t p = matrix.rowStart[static_cast<size_t>(k)]; p < matrix.rowStart[static_cast<size_t>(k) + 1]; ++p) {
+            int i = matrix.columns[p];
+            if (i >= k) {
+                break;
+            }
+            for (; flag[static_cast<size_t>(i)] != k; i = treeParent[static_cast<size_t>(i)]) {
+                if (treeParent[static_cast<size_t>(i)] == -1) {
+                    treeParent[static_cast<size_t>(i)] = k;
+                }
+                ++count[static_cast<size_t>(i)];
+                flag[static_cast<size_t>(i)] = k;
+            }
+        }
+    }
+
+    // Postorder, children visited by increasing index
+    std::vector<int> head(un, -1);
+    std::vector<int> next(un, -1);
+    for (int j = n - 1; j >= 0; --j) {
+        const int p = treeParent[static_cast<size_t>(j)];
+        if (p != -1) {
+            next[static_cast<size_t>(j)] = head[static_cast<size_t>(p)];
+            head[static_cast<size_t>(p)] = j;
+        }
+    }
+    m_permutation.assign(un, 0);
+    std::vector<int> inverse(un, 0);
+    std::vector<int> stack;
+    int numbered = 0;
+    for (int root = 0; root < n; ++root) {
+        if (treeParent[static_cast<size_t>(root)] != -1) {
+            continue;
+        }
+        stack.push_back(root);
+        while (!stack.empty()) {
+            const int top = stack.back();
+            const int child = head[static_cast<size_t>(top)];
+            if (child == -1) {
+                stack.pop_back();
+                inverse[static_cast<size_t>(top)] = numbered;
+                m_permutation[static_cast<size_t>(numbered++)] = top;
+            } else {
+                head[static_cast<size_t>(top)] = next[static_cast<size_t>(child)];
+                stack.push_back(child);
+            }
+        }
+    }
+    std::vector<int> parent(un, -1);
+    std::vector<size_t> below(un, 0);
+    for (size_t j = 0; j < un; ++j) {
+        const auto old = static_cast<size_t>(m_permutation[j]);
+        below[j] = count[old];
+        if (treeParent[old] != -1) {
+            parent[j] = inverse[static_cast<size_t>(treeParent[old])];
+        }
+    }
+
+    // Relaxed supernodes. A postordered subtree whose root is the last
+    // column of a contiguous range can share one panel: the rows below the
+    // range are exactly those of its last column. Children are merged into
+    // their parent bottom-up while acceptMerge() holds.
+    struct Range
+    {
+        int first;
+        int last;
+        size_t stored; ///< True nonzeros of L in the range, diagonal included
+    };
+    std::vector<Range> ranges;
+    for (int j = 0; j < n; ++j) {
+        Range range{j, j, below[static_cast<size_t>(j)] + 1};
+        while (!ranges.empty()) {
+            const Range &child = ranges.back();
+            const int p = parent[static_cast<size_t>(child.last)];
+            if (p < range.first || p > range.last) {
+                break;
+            }
+            const auto width = static_cast<size_t>(range.last - child.first + 1);
+            const size_t stored = child.stored + range.stored;
+            if (!acceptMerge(width, stored, below[static_cast<size_t>(range.last)])) {
+                break;
+            }
+            range = Range{child.first, range.last, stored};
+            ranges.pop_back();
+        }
+        ranges.push_back(range);
+    }
+
+    const size_t supernodes = ranges.size();
+    std::vector<int> supernodeOf(un, 0);
+    m_firstColumn.assign(supernodes + 1, n);
+    m_parent.assign(supernodes, -1);
+    m_rowStart.assign(supernodes + 1, 0);
+    m_relativeStart.assign(supernodes + 1, 0);
+    m_valueStart.assign(supernodes + 1, 0);
+    m_factorNonZeros = 0;
+    for (size_t s = 0; s < supernodes; ++s) {
+        m_firstColumn[s] = ranges[s].first;
+        std::fill(supernodeOf.begin() + ranges[s].first, supernodeOf.begin() + ranges[s].last + 1, static_cast<int>(s));
+        const auto width = static_cast<size_t>(ranges[s].last - ranges[s].first + 1);
+        const size_t lower = below[static_cast<size_t>(ranges[s].last)];
+        m_rowStart[s + 1] = m_rowStart[s] + width + lower;
+        m_relativeStart[s + 1] = m_relativeStart[s] + lower;
+        m_valueStart[s + 1] = m_valueStart[s] + (width + lower) * width;
+        m_factorNonZeros += width * (width - 1) / 2 + width * lower;
+    }
+    std::vector<int> childCount(supernodes, 0);
+    for (size_t s = 0; s < supernodes; ++s) {
+        const int p = parent[static_cast<size_t>(ranges[s].last)];
+        if (p != -1) {
+            m_parent[s] = supernodeOf[static_cast<size_t>(p)];
+            ++childCount[static_cast<size_t>(m_parent[s])];
+        }
+    }
+    m_childStart.assign(supernodes + 1, 0);
+    for (size_t s = 0; s < supernodes; ++s) {
+        m_childStart[s + 1] = m_childStart[s] + childCount[s];
+    }
+    m_children.assign(static_cast<size_t>(m_childStart[supernodes]), 0);
+    std::vector<int> cursor(m_childStart.begin(), m_childStart.end() - 1);
+    for (size_t s = 0; s < supernodes; ++s) {
+        if (m_parent[s] != -1) {
+            m_children[static_cast<size_t>(cursor[static_cast<size_t>(m_parent[s])]++)] = static_cast<int>(s);
+        }
+    }
+
+    // Lower triangle of A by column in the new numbering
+    m_scatterStart.assign(un + 1, 0);
+    for (int k = 0; k < n; ++k) {
+        const int row = inverse[static_cast<size_t>(k)];
+        for (size_t p = matrix.rowStart[static_cast<size_t>(k)]; p < matrix.rowStart[static_cast<size_t>(k) + 1]; ++p) {
+            const int column = inverse[static_cast<size_t>(matrix.columns[p])];
+            if (row >= column) {
+                ++m_scatterStart[static_cast<size_t>(column) + 1];
+            }
+        }
+    }
+    for (size_t j = 0; j < un; ++j) {
+        m_scatterStart[j + 1] += m_scatterStart[j];
+    }
+    m_scatterSource.resize(m_scatterStart[un]);
+    m_scatterTarget.resize(m_scatterStart[un]);
+    std::vector<int> scatterRow(m_scatterStart[un]);
+    std::vector<size_t> fill(m_scatterStart.begin(), m_scatterStart.end() - 1);
+    for (int k = 0; k < n; ++k) {
+        const int row = inverse[static_cast<size_t>(k)];
+        for (size_t p = matrix.rowStart[static_cast<size_t>(k)]; p < matrix.rowStart[static_cast<size_t>(k) + 1]; ++p) {
+            const int column = inverse[static_cast<size_t>(matrix.columns[p])];
+            if (row >= column) {
+                const size_t e = fill[static_cast<size_t>(column)]++;
+                m_scatterSource[e] = p;
+                scatterRow[e] = row;
+            }
+        }
+    }
+
+    // Row structure of each supernode: its columns, then the union of the
+    // rows of A and of the children's update matrices below its last column
+    m_rows.assign(m_rowStart[supernodes], 0);
+    m_relative.assign(m_relativeStart[supernodes], 0);
+    std::vector<int> position(un, -1);
+    std::vector<int> mark(un, -1);
+    for (size_t s = 0; s < supernodes; ++s) {
+        const int first = m_firstColumn[s];
+        const int last = m_firstColumn[s + 1] - 1;
+        const auto width = static_cast<size_t>(last - first + 1);
+        int *rows = m_rows.data() + m_rowStart[s];
+        for (int j = first; j <= last; ++j) {
+            rows[j - first] = j;
+        }
+        size_t lower = width;
+        auto addRow = [&](int row) {
+            if (row > last && mark[static_cast<size_t>(row)] != static_cast<int>(s)) {
+                mark[static_cast<size_t>(row)] = static_cast<int>(s);
+                rows[lower++] = row;
+            }
+        };
+        for (int j = first; j <= last; ++j) {
+            for (size_t e = m_scatterStart[static_cast<size_t>(j)]; e < m_scatterStart[static_cast<size_t>(j) + 1]; ++e) {
+                addRow(scatterRow[e]);
+            }
+        }
+        for (int c = m_childStart[s]; c < m_childStart[s + 1]; ++c) {
+            const auto child = static_cast<size_t>(m_children[static_cast<size_t>(c)]);
+            const size_t childWidth = static_cast<size_t>(m_firstColumn[child + 1] - m_firstColumn[child]);
+            for (size_t r = m_rowStart[child] + childWidth; r < m_rowStart[child + 1]; ++r) {
+                addRow(m_rows[r]);
+            }
+        }
+        std::sort(rows + width, rows + lower);
+
+        const size_t rowCount = m_rowStart[s + 1] - m_rowStart[s];
+        for (size_t r = 0; r < rowCount; ++r) {
+            position[static_cast<size_t>(rows[r])] = static_cast<int>(r);
+        }
+        for (int c = m_childStart[s]; c < m_childStart[s + 1]; ++c) {
+            const auto child = static_cast<size_t>(m_children[static_cast<size_t>(c)]);
+            const size_t childWidth = static_cast<size_t>(m_firstColumn[child + 1] - m_firstColumn[child]);
+            size_t out = m_relativeStart[child];
+            for (size_t r = m_rowStart[child] + childWidth; r < m_rowStart[child + 1]; ++r) {
+                m_relative[out++] = position[static_cast<size_t>(m_rows[r])];
+            }
+        }
+        for (int j = first; j <= last; ++j) {
+            for (size_t e = m_scatterStart[static_cast<size_t>(j)]; e < m_scatterStart[static_cast<size_t>(j) + 1]; ++e) {
+                m_scatterTarget[e] = static_cast<size_t>(position[static_cast<size_t>(scatterRow[e])])
+                                     + static_cast<size_t>(j - first) * rowCount;
+            }
+        }
+    }
+}
+
+int SupernodalLdlt::factorSupernode(int supernode, const CsrMatrix &matrix, const std::vector<double> &threshold)
+{
+    const auto s = static_cast<size_t>(supernode);
+    const int first = m_firstColumn[s];
+    const auto width = static_cast<size_t>(m_firstColumn[s + 1] - first);
+    const size_t rows = m_rowStart[s + 1] - m_rowStart[s];
+    const size_t lower = rows - width;
+    double *panel = m_values.data() + m_valueStart[s];
+    double *diagonal = m_diagonal.data() + first;
+
+    // Assemble: entries of A, then extend-add of the children's updates
+    std::fill(panel, panel + rows * width, 0.0);
+    for (size_t e = m_scatterStart[static_cast<size_t>(first)]; e < m_scatterStart[static_cast<size_t>(first) + width]; ++e) {
+        panel[m_scatterTarget[e]] += matrix.values[m_scatterSource[e]];
+    }
+    std::vector<double> update(lower * lower, 0.0);
+    for (int c = m_childStart[s]; c < m_childStart[s + 1]; ++c) {
+        const auto child = static_cast<size_t>(m_children[static_cast<size_t>(c)]);
+        std::vector<double> &childUpdate = m_update[child];
+        const size_t childLower = m_relativeStart[child + 1] - m_relativeStart[child];
+        const int *relative = m_relative.data() + m_relativeStart[child];
+        for (size_t jj = 0; jj < childLower; ++jj) {
+            const auto target = static_cast<size_t>(relative[jj]);
+            const double *source = childUpdate.data() + jj * childLower;
+            if (target < width) {
+                double *column = panel + target * rows;
+                for (size_t ii = jj; ii < childLower; ++ii) {
+                    column[relative[ii]] += source[ii];
+                }
+            } else {
+                double *column = update.data() + (target - width) * lower;
+                for (size_t ii = jj; ii < childLower; ++ii) {
+                    column[static_cast<size_t>(relative[ii]) - width] += source[ii];
+                }
+            }
+        }
+        std::vector<double>().swap(childUpdate);
+    }
+
+    // Blocked LDL^T of the panel: factor a block of columns, then update
+    // the trailing columns tile by tile
+    for (size_t k0 = 0; k0 < width; k0 += kBlockColumns) {
+        const size_t k1 = std::min(width, k0 + kBlockColumns);
+        for (size_t j = k0; j < k1; ++j) {
+            double *cj = panel + j * rows;
+            for (size_t k = k0; k < j; ++k) {
+                const double *ck = panel + k * rows;
+                subtractScaled(cj + j, ck + j, ck[j] * diagonal[k], rows - j);
+            }
+            const double d = cj[j];
+            if (!(std::abs(d) > threshold[static_cast<size_t>(m_permutation[static_cast<size_t>(first) + j])])) {
+                return static_cast<int>(j);
+            }
+            diagonal[j] = d;
+            const double inverse = 1.0 / d;
+            for (size_t i = j + 1; i < rows; ++i) {
+                cj[i] *= inverse;
+            }
+        }
+        subtractSymmetricProducts(panel, rows, k1, width - k1, rows, panel + k0 * rows, rows, diagonal + k0, k1 - k0);
+    }
+
+    // Schur complement of the rows below: U -= L21 D L21^T (lower triangle)
+    for (size_t k0 = 0; k0 < width; k0 += kBlockColumns) {
+        const size_t k1 = std::min(width, k0 + kBlockColumns);
+        subtractSymmetricProducts(update.data(), lower, 0, lower, lower, panel + k0 * rows + width, rows,
+                                  diagonal + k0, k1 - k0);
+    }
+    m_update[s] = std::move(update);
+    return -1;
+}
+
+bool SupernodalLdlt::factorizeNumeric(const CsrMatrix &matrix, double pivotTolerance)
+{
+    const auto un = static_cast<size_t>(m_size);
+    const size_t supernodes = m_firstColumn.size() - 1;
+    m_failedEquation = -1;
+    m_values.resize(m_valueStart.back());
+    m_diagonal.assign(un, 0.0);
+    m_update.assign(supernodes, std::vector<double>());
+
+    const std::vector<double> threshold = pivotThresholds(matrix, pivotTolerance);
+
+    int failedColumn = INT_MAX;
+    if (m_pool == nullptr || m_pool->threadCount() == 1) {
+        for (size_t s = 0; s < supernodes; ++s) {
+            const int local = factorSupernode(static_cast<int>(s), matrix, threshold);
+            if (local >= 0) {
+                failedColumn = m_firstColumn[s] + local;
+                break;
+            }
+        }
+    } else {
+        // Task scheduler: a supernode becomes ready when its last child is
+        // done. Ancestors of a failed supernode are skipped, so the failure
+        // reported is the first one in sequential order.
+        std::mutex mutex;
+        std::condition_variable readyChanged;
+        std::vector<int> ready;
+        std::vector<int> pending(supernodes, 0);
+        std::vector<char> skip(supernodes, 0);
+        size_t remaining = supernodes;
+        for (size_t s = supernodes; s-- > 0;) {
+            pending[s] = m_childStart[s + 1] - m_childStart[s];
+            if (pending[s] == 0) {
+                ready.push_back(static_cast<int>(s));
+            }
+        }
+        m_pool->runOnAll([&](int) {
+            std::unique_lock<std::mutex> lock(mutex);
+            for (;;) {
+                readyChanged.wait(lock, [&] { return !ready.empty() || remaining == 0; });
+                if (ready.empty()) {
+                    return;
+                }
+                const int s = ready.back();
+                ready.pop_back();
+                const bool skipped = skip[static_cast<size_t>(s)] != 0;
+                lock.unlock();
+                int local = -1;
+                if (skipped) {
+                    for (int c = m_childStart[static_cast<size_t>(s)]; c < m_childStart[static_cast<size_t>(s) + 1]; ++c) {
+                        std::vector<double>().swap(m_update[static_cast<size_t>(m_children[static_cast<size_t>(c)])]);
+                    }
+                } else {
+                    local = factorSupernode(s, matrix, threshold);
+                }
+                lock.lock();
+                if (local >= 0) {
+                    failedColumn = std::min(failedColumn, m_firstColumn[static_cast<size_t>(s)] + local);
+                }
+                const int p = m_parent[static_cast<size_t>(s)];
+                if (p != -1) {
+                    if (skipped || local >= 0) {
+                        skip[static_cast<size_t>(p)] = 1;
+                    }
+                    if (--pending[static_cast<size_t>(p)] == 0) {
+                        ready.push_back(p);
+                        readyChanged.notify_one();
+                    }
+                }
+                if (--remaining == 0) {
+                    readyChanged.notify_all();
+                }
+            }
+        });
+    }
+    m_update.clear();
+    m_update.shrink_to_fit();
+    if (failedColumn != INT_MAX) {
+        m_failedEquation = m_permutation[static_cast<size_t>(failedColumn)];
+        return false;
+    }
+    return true;
+}
+
+size_t SupernodalLdlt::factorBytes() const
+{
+    return bytesOf<double>(m_valueStart.back() + static_cast<size_t>(m_size))
+           + bytesOf<int>(m_permutation.size() + m_parent.size() + m_firstColumn.size() + m_childStart.size()
+                          + m_children.size() + m_rows.size() + m_relative.size())
+           + bytesOf<size_t>(m_rowStart.size() + m_relativeStart.size() + m_valueStart.size()
+                             + m_scatterStart.size() + m_scatterSource.size() + m_scatterTarget.size());
+}
+
+void SupernodalLdlt::solve(double *x) const
+{
+    const auto n = static_cast<size_t>(m_size);
+    const size_t supernodes = m_firstColumn.size() - 1;
+    std::vector<double> y(n);
+    for (size_t j = 0; j < n; ++j) {
+        y[j] = x[m_permutation[j]];
+    }
+    for (size_t s = 0; s < supernodes; ++s) {
+        const auto first = static_cast<size_t>(m_firstColumn[s]);
+        const size_t width = static_cast<size_t>(m_firstColumn[s + 1]) - first;
+        const size_t rows = m_rowStart[s + 1] - m_rowStart[s];
+        const int *rowIndex = m_rows.data() + m_rowStart[s];
+        const double *panel = m_values.data() + m_valueStart[s];
+        for (size_t k = 0; k < width; ++k) {
+            const double *ck = panel + k * rows;
+            const double yk = y[first + k];
+            for (size_t i = k + 1; i < width; ++i) {
+                y[first + i] -= ck[i] * yk;
+            }
+            for (size_t i = width; i < rows; ++i) {
+                y[static_cast<size_t>(rowIndex[i])] -= ck[i] * yk;
+            }
+        }
+    }
+    for (size_t j = 0; j < n; ++j) {
+        y[j] /= m_diagonal[j];
+    }
+    for (size_t s = supernodes; s-- > 0;) {
+        const auto first = static_cast<size_t>(m_firstColumn[s]);
+        const size_t width = static_cast<size_t>(m_firstColumn[s + 1]) - first;
+        const size_t rows = m_rowStart[s + 1] - m_rowStart[s];
+        const int *rowIndex = m_rows.data() + m_rowStart[s];
+        const double *panel = m_values.data() + m_valueStart[s];
+        for (size_t k = width; k-- > 0;) {
+            const double *ck = panel + k * rows;
+            double sum = y[first + k];
+            for (size_t i = k + 1; i < width; ++i) {
+                sum -= ck[i] * y[first + i];
+            }
+            for (size_t i = width; i < rows; ++i) {
+                sum -= ck[i] * y[static_cast<size_t>(rowIndex[i])];
+            }
+            y[first + k] = sum;
+        }
+    }
+    for (size_t j = 0; j < n; ++j) {
+        x[m_permutation[j]] = y[j];
+    }
+}
+
+} // namespace Structura::Analysis
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "DirectSolver.h"
+#include "SparseMatrix.h"
+#include <cstddef>
+#include <vector>
+
+namespace Structura::Analysis {
+
+class ThreadPool;
+
+/**
+ * @brief Multifrontal supernodal LDL^T factorization, A = L D L^T.
+ *
+ * Symbolic phase: elimination tree and column counts, a postorder of the
+ * tree (same fill, subtrees numbered contiguously), then supernodes: runs of
+ * columns sharing their row structure below the diagonal, relaxed so that
+ * small neighbouring columns are merged even when that stores a few explicit
+ * zeros. Each supernode keeps its columns of L as one dense column-major
+ * panel.
+ *
+ * Numeric phase: every supernode assembles its entries of A plus the update
+ * matrices of its children, factorizes its panel with blocked kernels and
+ * passes its own Schur complement up. Supernodes in disjoint subtrees are
+ * independent and run as tasks on the ThreadPool as soon as all their
+ * children are done. Each supernode is always computed the same way, so the
+ * factor does not depend on the number of threads.
+ *
+ * D may be indefinite (saddle-point systems from constraints with the
+ * multipliers numbered after the DOFs they constrain); pivots are taken on
+ * the diagonal in order, as in SparseLdlt.
+ */
+class SupernodalLdlt : public DirectSolver
+{
+public:
+    /**
+     * @brief Threads used by factorizeNumeric().
+     * @param pool Pool to run the supernode tasks on, or nullptr for serial
+     */
+    void setThreadPool(ThreadPool *pool) { m_pool = pool; }
+
+    void analyse(const CsrMatrix &matrix) override;
+    bool factorizeNumeric(const CsrMatrix &matrix, double pivotTolerance) override;
+    void solve(double *x) const override;
+
+    int failedEquation() const override { return m_failedEquation; }
+
+    /// Stored strictly lower entries of L, explicit zeros of relaxed supernodes included
+    size_t factorNonZeros() const override { return m_factorNonZeros; }
+
+    /// Panels, structure and scatter map; the update matrices alive during factorizeNumeric() come on top
+    size_t factorBytes() const override;
+
+    int size() const { return m_size; }
+    int supernodeCount() const { return static_cast<int>(m_firstColumn.size()) - 1; }
+
+private:
+    int factorSupernode(int supernode, const CsrMatrix &matrix, const std::vector<double> &threshold);
+
+    ThreadPool *m_pool{nullptr};
+    int m_size{0};
+    int m_failedEquation{-1};
+    size_t m_factorNonZeros{0};
+
+    // All indices below are in the postordered numbering unless noted
+    std::vector<int> m_permutation;          ///< New index -> equation of the input
+    std::vector<int> m_firstColumn{0};       ///< Supernode -> first column; last entry = size
+    std::vector<int> m_parent;               ///< Supernode tree
+    std::vector<int> m_childStart;           ///< Children of s: m_children[m_childStart[s] ..]
+    std::vector<int> m_children;
+    std::vector<size_t> m_rowStart;          ///< Rows of s: m_rows[m_rowStart[s] ..], its columns first
+    std::vector<int> m_rows;
+    std::vector<size_t> m_relativeStart;     ///< Rows of s below its columns, as positions in the parent's rows
+    std::vector<int> m_relative;
+    std::vector<size_t> m_valueStart;        ///< Panel of s: rows x columns, column-major
+    std::vector<double> m_values;
+    std::vector<double> m_diagonal;
+
+    // Scatter of the lower triangle of A into the panels, grouped by column
+    std::vector<size_t> m_scatterStart;
+    std::vector<size_t> m_scatterSource;     ///< Index into CsrMatrix::values
+    std::vector<size_t> m_scatterTarget;     ///< Index into the panel of the column's supernode
+
+    std::vector<std::vector<double>> m_update; ///< Schur complements waiting for the parent
+};
+
+} // namespace Structura::Analysis
@@ -0,0 +1,84 @@
+#include "ThreadPool.h"
+#include <algorithm>
+
+namespace Structura::Analysis {
+
+ThreadPool::ThreadPool(int threads)
+{
+    if (threads <= 0) {
+        threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+    m_threads.reserve(static_cast<size_t>(threads - 1));
+    for (int worker = 1; worker < threads; ++worker) {
+        m_threads.emplace_back([this, worker] { workerLoop(worker); });
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    for (std::thread &thread : m_threads) {
+        thread.join();
+    }
+}
+
+void ThreadPool::runOnAll(const std::function<void(int worker)> &job)
+{
+    if (m_threads.empty()) {
+        job(0);
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_job = &job;
+        m_running = static_cast<int>(m_threads.size());
+        ++m_generation;
+    }
+    m_wake.notify_all();
+    job(0);
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_done.wait(lock, [this] { return m_running == 0; });
+    m_job = nullptr;
+}
+
+void ThreadPool::parallelFor(size_t count, const std::function<void(size_t begin, size_t end)> &body)
+{
+    const int workers = threadCount();
+    runOnAll([&](int worker) {
+        size_t begin = 0;
+        size_t end = 0;
+        range(count, workers, worker, begin, end);
+        if (begin < end) {
+            body(begin, end);
+        }
+    });
+}
+
+void ThreadPool::workerLoop(int worker)
+{
+    size_t seen = 0;
+    for (;;) {
+        const std::function<void(int)> *job = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [this, seen] { return m_stopping || m_generation != seen; });
+            if (m_stopping) {
+                return;
+            }
+            seen = m_generation;
+            job = m_job;
+        }
+        (*job)(worker);
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            --m_running;
+        }
+        m_done.notify_one();
+    }
+}
+
+} // namespace Structura::Analysis
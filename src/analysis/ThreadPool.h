@@ -0,0 +1,72 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Structura::Analysis {
+
+/**
+ * @brief Fixed set of worker threads for the analysis kernels.
+ *
+ * Fork-join only: runOnAll() hands the same job to every worker (the calling
+ * thread acts as worker 0) and returns when all have finished, so kernels
+ * build their own scheduling (static ranges, task queues) on top of it.
+ * Work is always split by worker index, never by timing, which keeps results
+ * that depend on the split reproducible for a given thread count.
+ *
+ * Not reentrant: a job must not call runOnAll() on the same pool.
+ */
+class ThreadPool
+{
+public:
+    /**
+     * @brief Start the workers.
+     * @param threads Total number of threads including the caller;
+     *        0 uses std::thread::hardware_concurrency()
+     */
+    explicit ThreadPool(int threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    /// Number of workers, including the calling thread
+    int threadCount() const { return static_cast<int>(m_threads.size()) + 1; }
+
+    /**
+     * @brief Run @p job(worker) once on every worker and wait for all.
+     * @param job Called with worker = 0 .. threadCount() - 1
+     */
+    void runOnAll(const std::function<void(int worker)> &job);
+
+    /**
+     * @brief Split [0, count) into threadCount() contiguous ranges and run
+     *        @p body(begin, end) on each in parallel.
+     */
+    void parallelFor(size_t count, const std::function<void(size_t begin, size_t end)> &body);
+
+    /// Range of worker @p worker when [0, count) is split as in parallelFor()
+    static void range(size_t count, int workers, int worker, size_t &begin, size_t &end)
+    {
+        begin = count * static_cast<size_t>(worker) / static_cast<size_t>(workers);
+        end = count * static_cast<size_t>(worker + 1) / static_cast<size_t>(workers);
+    }
+
+private:
+    void workerLoop(int worker);
+
+    std::vector<std::thread> m_threads;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_done;
+    const std::function<void(int)> *m_job{nullptr};
+    size_t m_generation{0};
+    int m_running{0};
+    bool m_stopping{false};
+};
+
+} // namespace Structura::Analysis
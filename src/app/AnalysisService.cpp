@@ -0,0 +1,249 @@
+#include "AnalysisService.h"
+#include <algorithm>
+#include <utility>
+
+namespace Structura::App {
+
+namespace {
+
+const char *const kDofNames[Analysis::kNodeDofs] = {"UX", "UY", "UZ", "RX", "RY", "RZ"};
+
+} // namespace
+
+AnalysisService::AnalysisService(IModelRepository *repository, QObject *parent)
+    : QObject(parent)
+    , m_repository(repository)
+{
+    Q_ASSERT(repository != nullptr);
+}
+
+void AnalysisService::setOptions(const Analysis::AnalysisOptions &options)
+{
+    if (options.ordering != m_options.ordering) {
+        m_assembly.reset();
+    }
+    m_options = options;
+}
+
+bool AnalysisService::buildFrameModel(const QUuid &loadCaseId, Analysis::FrameModel &model)
+{
+    model = Analysis::FrameModel();
+    m_nodeIds.clear();
+    m_barIds.clear();
+    m_nodeIndex.clear();
+    m_barIndex.clear();
+
+    // Nodes keep their dense repository order
+    const EntityView<Node> nodes = m_repository->nodes();
+    const double *coordinates = m_repository->nodeCoordinates();
+    model.coordinates.assign(coordinates, coordinates + 3 * nodes.size());
+    model.restraints.reserve(nodes.size());
+    m_nodeIds.reserve(nodes.size());
+    m_nodeIndex.reserve(static_cast<int>(nodes.size()));
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        model.restraints.push_back(nodes[i].restraintMask());
+        m_nodeIds.push_back(nodes[i].id());
+        m_nodeIndex.insert(nodes[i].id(), static_cast<int>(i));
+    }
+
+    const EntityView<Bar> bars = m_repository->bars();
+    const EntityView<Material> materials = m_repository->materials();
+    const EntityView<Section> sections = m_repository->sections();
+    const std::int32_t *materialIndices = m_repository->barMaterialIndices();
+    const std::int32_t *sectionIndices = m_repository->barSectionIndices();
+    model.elements.reserve(bars.size());
+    m_barIds.reserve(bars.size());
+    m_barIndex.reserve(static_cast<int>(bars.size()));
+    for (size_t i = 0; i < bars.size(); ++i) {
+        const Bar &bar = bars[i];
+        if (materialIndices[i] < 0 || sectionIndices[i] < 0) {
+            return fail(tr("A barra %1 não tem material ou seção atribuídos.").arg(bar.externalId()));
+        }
+        const Node *start = m_repository->findNodePtr(bar.startNodeId());
+        const Node *end = m_repository->findNodePtr(bar.endNodeId());
+        if (!start || !end) {
+            return fail(tr("A barra %1 referencia um nó inexistente.").arg(bar.externalId()));
+        }
+
+        const Material &material = materials[static_cast<size_t>(materialIndices[i])];
+        const Section &section = sections[static_cast<size_t>(sectionIndices[i])];
+        Analysis::FrameElement element;
+        element.nodes = {{static_cast<int>(start - nodes.data()), static_cast<int>(end - nodes.data())}};
+        element.youngModulus = material.youngModulus();
+        element.shearModulus = material.shearModulus();
+        element.area = section.area();
+        element.iy = section.iy();
+        element.iz = section.iz();
+        element.torsionalConstant = section.torsionalConstant();
+        if (const Vector3 *kPoint = m_repository->barKPoint(m_repository->barHandleAt(i))) {
+            element.kPoint = std::array<double, 3>{{kPoint->x(), kPoint->y(), kPoint->z()}};
+        }
+        model.elements.push_back(element);
+        m_barIds.push_back(bar.id());
+        m_barIndex.insert(bar.id(), static_cast<int>(i));
+    }
+
+    for (const NodalLoad &load : m_repository->nodalLoadsInCase(loadCaseId)) {
+        const auto node = m_nodeIndex.constFind(load.nodeId());
+        if (node == m_nodeIndex.constEnd()) {
+            continue;
+        }
+        const Vector3 &force = load.force();
+        const Vector3 &moment = load.moment();
+        model.addNodalLoad(node.value(), {{force.x(), force.y(), force.z(), moment.x(), moment.y(), moment.z()}});
+    }
+
+    for (const MemberLoad &load : m_repository->memberLoadsInCase(loadCaseId)) {
+        const auto bar = m_barIndex.constFind(load.barId());
+        if (bar == m_barIndex.constEnd()) {
+            continue;
+        }
+        Analysis::UniformElementLoad elementLoad;
+        elementLoad.element = bar.value();
+        elementLoad.intensity = {{load.intensity().x(), load.intensity().y(), load.intensity().z()}};
+        elementLoad.local = load.system() == MemberLoad::System::Local;
+        model.elementLoads.push_back(elementLoad);
+    }
+    return true;
+}
+
+bool AnalysisService::runLinearStatic(const QUuid &loadCaseId)
+{
+    m_result = Analysis::AnalysisResult();
+    m_loadCaseId = QUuid();
+    if (!m_repository->findLoadCasePtr(loadCaseId)) {
+        return fail(tr("Caso de carregamento inexistente."));
+    }
+
+    Analysis::FrameModel model;
+    if (!buildFrameModel(loadCaseId, model)) {
+        return false;
+    }
+
+    if (!canReuseStructure()) {
+        m_assembly.reset();
+    }
+    Analysis::AnalysisResult result = Analysis::LinearStaticAnalysis(m_options).run(model, &m_assembly);
+    m_assemblyVersion = m_repository->changeVersion();
+    if (!result.succeeded()) {
+        return fail(describeFailure(result));
+    }
+
+    m_result = std::move(result);
+    m_loadCaseId = loadCaseId;
+    m_resultVersion = m_repository->changeVersion();
+    m_lastError.clear();
+    emit analysisCompleted(loadCaseId);
+    return true;
+}
+
+void AnalysisService::clearResults()
+{
+    const bool had = hasResults();
+    m_result = Analysis::AnalysisResult();
+    m_loadCaseId = QUuid();
+    if (had) {
+        emit resultsCleared();
+    }
+}
+
+bool AnalysisService::canReuseStructure() const
+{
+    return m_assembly.isAnalysed() && !topologyChangedSince(m_assemblyVersion);
+}
+
+bool AnalysisService::resultsAreCurrent() const
+{
+    return hasResults() && m_repository->changeVersion() == m_resultVersion;
+}
+
+std::optional<AnalysisService::NodeValues> AnalysisService::nodeDisplacement(const QUuid &nodeId) const
+{
+    const auto it = m_nodeIndex.constFind(nodeId);
+    if (!hasResults() || it == m_nodeIndex.constEnd()) {
+        return std::nullopt;
+    }
+    NodeValues values{};
+    const size_t base = Analysis::kNodeDofs * static_cast<size_t>(it.value());
+    std::copy_n(m_result.displacements.begin() + static_cast<std::ptrdiff_t>(base), values.size(), values.begin());
+    return values;
+}
+
+std::optional<AnalysisService::NodeValues> AnalysisService::nodeReaction(const QUuid &nodeId) const
+{
+    const auto it = m_nodeIndex.constFind(nodeId);
+    if (!hasResults() || it == m_nodeIndex.constEnd()) {
+        return std::nullopt;
+    }
+    NodeValues values{};
+    const size_t base = Analysis::kNodeDofs * static_cast<size_t>(it.value());
+    std::copy_n(m_result.reactions.begin() + static_cast<std::ptrdiff_t>(base), values.size(), values.begin());
+    return values;
+}
+
+std::optional<AnalysisService::BarEndForces> AnalysisService::barEndForces(const QUuid &barId) const
+{
+    const auto it = m_barIndex.constFind(barId);
+    if (!hasResults() || it == m_barIndex.constEnd()) {
+        return std::nullopt;
+    }
+    BarEndForces values{};
+    const size_t base = Analysis::kElementDofs * static_cast<size_t>(it.value());
+    std::copy_n(m_result.elementForces.begin() + static_cast<std::ptrdiff_t>(base), values.size(), values.begin());
+    return values;
+}
+
+QString AnalysisService::describeFailure(const Analysis::AnalysisResult &result) const
+{
+    switch (result.status) {
+    case Analysis::AnalysisStatus::EmptyModel:
+        return tr("O modelo não tem barras ou graus de liberdade livres.");
+    case Analysis::AnalysisStatus::InvalidElement: {
+        const Bar *bar = m_repository->findBarPtr(m_barIds[static_cast<size_t>(result.failedElement)]);
+        return tr("A barra %1 tem comprimento nulo ou propriedades não positivas.")
+            .arg(bar ? bar->externalId() : result.failedElement);
+    }
+    case Analysis::AnalysisStatus::Unstable: {
+        const Node *node = m_repository->findNodePtr(m_nodeIds[static_cast<size_t>(result.failedNode)]);
+        return tr("Estrutura instável: grau de liberdade %1 do nó %2.")
+            .arg(QString::fromLatin1(kDofNames[result.failedDof]))
+            .arg(node ? node->externalId() : result.failedNode);
+    }
+    case Analysis::AnalysisStatus::NotConverged:
+        return tr("O solver iterativo não convergiu em %1 iterações (resíduo relativo %2).")
+            .arg(result.statistics.iterations)
+            .arg(result.statistics.relativeResidual, 0, 'g', 3);
+    case Analysis::AnalysisStatus::Success:
+        break;
+    }
+    return QString();
+}
+
+bool AnalysisService::topologyChangedSince(std::uint64_t version) const
+{
+    std::vector<ModelChange> changes;
+    if (!m_repository->changesSince(version, changes)) {
+        return true;
+    }
+    for (const ModelChange &change : changes) {
+        std::uint32_t structural = 0;
+        if (change.kind == EntityKind::Node) {
+            structural = ChangeField::Lifecycle | ChangeField::Restraints;
+        } else if (change.kind == EntityKind::Bar) {
+            structural = ChangeField::Lifecycle | ChangeField::Connectivity;
+        }
+        if ((change.fields & structural) != 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool AnalysisService::fail(const QString &message)
+{
+    m_lastError = message;
+    emit analysisFailed(message);
+    return false;
+}
+
+} // namespace Structura::App
@@ -0,0 +1,142 @@
+#pragma once
+
+#include "IModelRepository.h"
+#include "../analysis/LinearStaticAnalysis.h"
+#include <QHash>
+#include <QObject>
+#include <QString>
+#include <QUuid>
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace Structura::App {
+
+/**
+ * @brief Service running structural analyses on the repository model.
+ *
+ * Translates the repository (nodes, restraints, bars with their material and
+ * section, and the loads of one load case) into a Structura::Analysis::FrameModel,
+ * runs the linear static engine and keeps the results keyed by entity UUID.
+ * Results describe the model as it was when the analysis ran; use
+ * resultsAreCurrent() to find out whether it has been edited since.
+ *
+ * The symbolic part of the analysis (DOF numbering and stiffness structure)
+ * is kept between runs and only rebuilt when the repository journal shows
+ * nodes or bars created or removed, restraints changed or bars reconnected,
+ * so re-running after property, load, k-point or coordinate edits (or for
+ * another load case) only repeats the numeric work.
+ */
+class AnalysisService : public QObject
+{
+    Q_OBJECT
+
+public:
+    using NodeValues = std::array<double, Analysis::kNodeDofs>;
+    using BarEndForces = std::array<double, Analysis::kElementDofs>;
+
+    /**
+     * @brief Construct AnalysisService with a repository.
+     * @param repository Pointer to model repository (must not be null)
+     * @param parent Qt parent object
+     */
+    explicit AnalysisService(IModelRepository *repository, QObject *parent = nullptr);
+    ~AnalysisService() override = default;
+
+    /**
+     * @brief Set the options of later runs.
+     * @param options Options; a different ordering discards the kept structure
+     */
+    void setOptions(const Analysis::AnalysisOptions &options);
+    const Analysis::AnalysisOptions &options() const { return m_options; }
+
+    /**
+     * @brief Run a linear static analysis for one load case.
+     *
+     * Every bar must have a material and a section. On failure the previous
+     * results are discarded and lastError() describes the problem.
+     * @param loadCaseId UUID of an existing load case
+     * @return true if the analysis succeeded
+     */
+    bool runLinearStatic(const QUuid &loadCaseId);
+
+    /**
+     * @brief Build the analysis model of a load case without solving it.
+     * @param loadCaseId UUID of the load case whose loads are applied
+     * @param model Receives the frame model
+     * @return false (with lastError() set) if a bar lacks properties or nodes
+     */
+    bool buildFrameModel(const QUuid &loadCaseId, Analysis::FrameModel &model);
+
+    /// Discard the current results
+    void clearResults();
+
+    /// true if the next run can reuse the symbolic structure of the last one
+    bool canReuseStructure() const;
+
+    bool hasResults() const { return m_result.succeeded(); }
+    const QUuid &resultLoadCase() const { return m_loadCaseId; }
+    const Analysis::AnalysisResult &lastResult() const { return m_result; }
+    const QString &lastError() const { return m_lastError; }
+
+    /// true if the repository has not changed since the results were computed
+    bool resultsAreCurrent() const;
+
+    /**
+     * @brief Displacements of a node (UX, UY, UZ, RX, RY, RZ), global axes.
+     * @return Values, or nullopt without results or for an unknown node
+     */
+    std::optional<NodeValues> nodeDisplacement(const QUuid &nodeId) const;
+
+    /**
+     * @brief Support reaction at a node, global axes (zero on free DOFs).
+     * @return Values, or nullopt without results or for an unknown node
+     */
+    std::optional<NodeValues> nodeReaction(const QUuid &nodeId) const;
+
+    /**
+     * @brief Member end actions of a bar in local axes: N, Vy, Vz, T, My, Mz
+     *        at the start, then the same at the end.
+     * @return Values, or nullopt without results or for an unknown bar
+     */
+    std::optional<BarEndForces> barEndForces(const QUuid &barId) const;
+
+signals:
+    /**
+     * @brief Emitted when an analysis finished successfully.
+     * @param loadCaseId UUID of the analysed load case
+     */
+    void analysisCompleted(const QUuid &loadCaseId);
+
+    /**
+     * @brief Emitted when an analysis could not be completed.
+     * @param message Description of the problem, for the user
+     */
+    void analysisFailed(const QString &message);
+
+    /**
+     * @brief Emitted when the stored results are discarded.
+     */
+    void resultsCleared();
+
+private:
+    QString describeFailure(const Analysis::AnalysisResult &result) const;
+    bool topologyChangedSince(std::uint64_t version) const;
+    bool fail(const QString &message);
+
+    IModelRepository *m_repository;
+    Analysis::AnalysisOptions m_options;
+    Analysis::AnalysisResult m_result;
+    QUuid m_loadCaseId;
+    std::uint64_t m_resultVersion{0};
+    Analysis::StiffnessAssembly m_assembly;
+    std::uint64_t m_assemblyVersion{0}; ///< Repository version m_assembly was built for
+    std::vector<QUuid> m_nodeIds; ///< Dense node index of the analysed model -> UUID
+    std::vector<QUuid> m_barIds;  ///< Element index -> bar UUID
+    QHash<QUuid, int> m_nodeIndex;
+    QHash<QUuid, int> m_barIndex;
+    QString m_lastError;
+};
+
+} // namespace Structura::App
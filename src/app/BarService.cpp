@@ -1,5 +1,6 @@
 #include "BarService.h"
 #include <algorithm>
+#include <utility>
 
 namespace Structura::App {
 
@@ -16,8 +17,8 @@ QUuid BarService::createBar(const QUuid &startNodeId,
                             const QUuid &sectionId)
 {
     // Validate that nodes exist
-    if (!m_repository->findNode(startNodeId).has_value() ||
-        !m_repository->findNode(endNodeId).has_value()) {
+    if (!m_repository->findNodePtr(startNodeId) ||
+        !m_repository->findNodePtr(endNodeId)) {
         return QUuid(); // Invalid nodes
     }
     
@@ -33,7 +34,7 @@ QUuid BarService::createBar(const QUuid &startNodeId,
     bar.setExternalId(externalId);
     
     if (m_repository->addBar(bar)) {
-        emit barCreated(id);
+        notifyBarCreated(id);
         return id;
     }
     
@@ -43,17 +44,38 @@ QUuid BarService::createBar(const QUuid &startNodeId,
 bool BarService::deleteBar(const QUuid &id)
 {
     if (m_repository->removeBar(id)) {
-        emit barDeleted(id);
+        notifyBarDeleted(id);
         return true;
     }
     return false;
 }
 
+size_t BarService::deleteBars(const std::vector<QUuid> &ids)
+{
+    std::vector<QUuid> existing;
+    existing.reserve(ids.size());
+    for (const auto &id : ids) {
+        if (m_repository->findBarPtr(id)) {
+            existing.push_back(id);
+        }
+    }
+    
+    const size_t removed = m_repository->removeBars(existing);
+    
+    beginBatch();
+    for (const auto &id : existing) {
+        notifyBarDeleted(id);
+    }
+    endBatch();
+    
+    return removed;
+}
+
 bool BarService::updateBarConnectivity(const QUuid &id, const QUuid &startNodeId, const QUuid &endNodeId)
 {
     // Validate that nodes exist
-    if (!m_repository->findNode(startNodeId).has_value() ||
-        !m_repository->findNode(endNodeId).has_value()) {
+    if (!m_repository->findNodePtr(startNodeId) ||
+        !m_repository->findNodePtr(endNodeId)) {
         return false;
     }
     
@@ -73,7 +95,7 @@ bool BarService::updateBarConnectivity(const QUuid &id, const QUuid &startNodeId
     bar.setLCSDirty(true);
     
     if (m_repository->updateBar(bar)) {
-        emit barUpdated(id);
+        notifyBarUpdated(id);
         return true;
     }
     
@@ -91,8 +113,8 @@ bool BarService::assignMaterial(const QUuid &barId, const QUuid &materialId)
     bar.setMaterialId(materialId);
     
     if (m_repository->updateBar(bar)) {
-        emit barPropertiesAssigned(barId);
-        emit barUpdated(barId);
+        notifyBarPropertiesAssigned(barId);
+        notifyBarUpdated(barId);
         return true;
     }
     
@@ -110,8 +132,8 @@ bool BarService::assignSection(const QUuid &barId, const QUuid &sectionId)
     bar.setSectionId(sectionId);
     
     if (m_repository->updateBar(bar)) {
-        emit barPropertiesAssigned(barId);
-        emit barUpdated(barId);
+        notifyBarPropertiesAssigned(barId);
+        notifyBarUpdated(barId);
         return true;
     }
     
@@ -130,8 +152,8 @@ bool BarService::assignProperties(const QUuid &barId, const QUuid &materialId, c
     bar.setSectionId(sectionId);
     
     if (m_repository->updateBar(bar)) {
-        emit barPropertiesAssigned(barId);
-        emit barUpdated(barId);
+        notifyBarPropertiesAssigned(barId);
+        notifyBarUpdated(barId);
         return true;
     }
     
@@ -143,26 +165,20 @@ int BarService::assignPropertiesToMultipleBars(const std::vector<QUuid> &barIds,
                                                const QUuid &sectionId)
 {
     int count = 0;
+    beginBatch();
     for (const auto &barId : barIds) {
         if (assignProperties(barId, materialId, sectionId)) {
             ++count;
         }
     }
+    endBatch();
     return count;
 }
 
 bool BarService::setKPoint(const QUuid &barId, const Vector3 &kPoint)
 {
-    auto barOpt = m_repository->findBar(barId);
-    if (!barOpt.has_value()) {
-        return false;
-    }
-    
-    Bar bar = barOpt.value();
-    bar.setKPoint(kPoint);
-    
-    if (m_repository->updateBar(bar)) {
-        emit barUpdated(barId);
+    if (m_repository->setBarKPoint(barId, kPoint)) {
+        notifyBarUpdated(barId);
         return true;
     }
     
@@ -171,16 +187,8 @@ bool BarService::setKPoint(const QUuid &barId, const Vector3 &kPoint)
 
 bool BarService::clearKPoint(const QUuid &barId)
 {
-    auto barOpt = m_repository->findBar(barId);
-    if (!barOpt.has_value()) {
-        return false;
-    }
-    
-    Bar bar = barOpt.value();
-    bar.clearKPoint();
-    
-    if (m_repository->updateBar(bar)) {
-        emit barUpdated(barId);
+    if (m_repository->setBarKPoint(barId, std::nullopt)) {
+        notifyBarUpdated(barId);
         return true;
     }
     
@@ -189,21 +197,19 @@ bool BarService::clearKPoint(const QUuid &barId)
 
 double BarService::calculateBarLength(const QUuid &barId) const
 {
-    auto barOpt = m_repository->findBar(barId);
-    if (!barOpt.has_value()) {
+    const Bar *bar = m_repository->findBarPtr(barId);
+    if (!bar) {
         return 0.0;
     }
     
-    const Bar &bar = barOpt.value();
+    const Node *startNode = m_repository->findNodePtr(bar->startNodeId());
+    const Node *endNode = m_repository->findNodePtr(bar->endNodeId());
     
-    auto startNodeOpt = m_repository->findNode(bar.startNodeId());
-    auto endNodeOpt = m_repository->findNode(bar.endNodeId());
-    
-    if (!startNodeOpt.has_value() || !endNodeOpt.has_value()) {
+    if (!startNode || !endNode) {
         return 0.0;
     }
     
-    return Bar::calculateLength(startNodeOpt->position(), endNodeOpt->position());
+    return Bar::calculateLength(startNode->position(), endNode->position());
 }
 
 std::optional<Bar> BarService::findBar(const QUuid &id) const
@@ -233,36 +239,85 @@ std::vector<Bar> BarService::findBarsConnectedToNode(const QUuid &nodeId) const
 
 int BarService::nextExternalId() const
 {
-    auto bars = m_repository->allBars();
-    if (bars.empty()) {
-        return 1;
-    }
-    
-    int maxId = 0;
-    for (const auto &bar : bars) {
-        if (bar.externalId() > maxId) {
-            maxId = bar.externalId();
-        }
-    }
-    
-    return maxId + 1;
+    return m_repository->maxBarExternalId() + 1;
 }
 
 bool BarService::barExists(const QUuid &id) const
 {
-    return m_repository->findBar(id).has_value();
+    return m_repository->findBarPtr(id) != nullptr;
 }
 
 bool BarService::validateBarConnectivity(const QUuid &barId) const
 {
-    auto barOpt = m_repository->findBar(barId);
-    if (!barOpt.has_value()) {
+    const Bar *bar = m_repository->findBarPtr(barId);
+    if (!bar) {
         return false;
     }
     
-    const Bar &bar = barOpt.value();
-    return m_repository->findNode(bar.startNodeId()).has_value() &&
-           m_repository->findNode(bar.endNodeId()).has_value();
+    return m_repository->findNodePtr(bar->startNodeId()) &&
+           m_repository->findNodePtr(bar->endNodeId());
+}
+
+void BarService::beginBatch()
+{
+    ++m_batchDepth;
+}
+
+void BarService::endBatch()
+{
+    ModelChangeSet changes = takeBatchChanges();
+    if (!changes.isEmpty()) {
+        publishBatchChanges(changes);
+    }
+}
+
+ModelChangeSet BarService::takeBatchChanges()
+{
+    Q_ASSERT(m_batchDepth > 0);
+    if (--m_batchDepth > 0) {
+        return ModelChangeSet();
+    }
+    return std::exchange(m_batchChanges, ModelChangeSet());
+}
+
+void BarService::publishBatchChanges(const ModelChangeSet &changes)
+{
+    emit modelBatchChanged(changes);
+}
+
+void BarService::notifyBarCreated(const QUuid &id)
+{
+    if (isBatching()) {
+        m_batchChanges.noteBarCreated(id);
+    } else {
+        emit barCreated(id);
+    }
+}
+
+void BarService::notifyBarDeleted(const QUuid &id)
+{
+    if (isBatching()) {
+        m_batchChanges.noteBarDeleted(id);
+    } else {
+        emit barDeleted(id);
+    }
+}
+
+void BarService::notifyBarUpdated(const QUuid &id)
+{
+    if (isBatching()) {
+        m_batchChanges.noteBarUpdated(id);
+    } else {
+        emit barUpdated(id);
+    }
+}
+
+void BarService::notifyBarPropertiesAssigned(const QUuid &id)
+{
+    // Covered by the bar's entry in updatedBars when batching
+    if (!isBatching()) {
+        emit barPropertiesAssigned(id);
+    }
 }
 
 } // namespace Structura::App
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "IModelRepository.h"
+#include "ModelChangeSet.h"
 #include "../core/model/Vector3.h"
 #include <QObject>
 #include <QUuid>
@@ -52,6 +53,13 @@ public:
      */
     bool deleteBar(const QUuid &id);
     
+    /**
+     * @brief Delete several bars in one repository pass, as one batch.
+     * @param ids UUIDs of the bars to delete (unknown IDs are ignored)
+     * @return Number of bars deleted
+     */
+    size_t deleteBars(const std::vector<QUuid> &ids);
+    
     /**
      * @brief Update bar connectivity (change connected nodes).
      * @param id UUID of the bar
@@ -154,6 +162,9 @@ public:
     
     /**
      * @brief Generate the next available external ID for bars.
+     * 
+     * O(1): derived from the repository's external ID high-water mark, so IDs
+     * of deleted bars are not handed out again.
      * @return Next external ID
      */
     int nextExternalId() const;
@@ -171,6 +182,37 @@ public:
      * @return true if both connected nodes exist
      */
     bool validateBarConnectivity(const QUuid &barId) const;
+    
+    // ===== Batching (see ModelTransaction) =====
+    
+    /**
+     * @brief Start (or nest) a batch.
+     * 
+     * Until the matching endBatch()/takeBatchChanges(), mutations still reach
+     * the repository immediately but per-entity signals are held back and
+     * recorded in a ModelChangeSet instead.
+     */
+    void beginBatch();
+    
+    /**
+     * @brief End one batch level; the outermost one emits modelBatchChanged.
+     */
+    void endBatch();
+    
+    /**
+     * @brief End one batch level and hand over the recorded changes unpublished.
+     * @return Changes recorded since the outermost beginBatch(), or an empty
+     *         set while an outer batch is still open
+     */
+    ModelChangeSet takeBatchChanges();
+    
+    /**
+     * @brief Emit modelBatchChanged for changes collected elsewhere.
+     * @param changes Change set to publish
+     */
+    void publishBatchChanges(const ModelChangeSet &changes);
+    
+    bool isBatching() const { return m_batchDepth > 0; }
 
 signals:
     /**
@@ -196,9 +238,22 @@ signals:
      * @param barId UUID of the bar
      */
     void barPropertiesAssigned(const QUuid &barId);
+    
+    /**
+     * @brief Emitted once per batch instead of the per-entity signals.
+     * @param changes IDs of everything created, updated or deleted in the batch
+     */
+    void modelBatchChanged(const Structura::App::ModelChangeSet &changes);
 
 private:
+    void notifyBarCreated(const QUuid &id);
+    void notifyBarDeleted(const QUuid &id);
+    void notifyBarUpdated(const QUuid &id);
+    void notifyBarPropertiesAssigned(const QUuid &id);
+    
     IModelRepository *m_repository;
+    int m_batchDepth{0};
+    ModelChangeSet m_batchChanges;
 };
 
 } // namespace Structura::App
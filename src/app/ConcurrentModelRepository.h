@@ -0,0 +1,700 @@
+#pragma once
+
+#include "IModelRepository.h"
+#include <QtGlobal>
+#include <mutex>
+#include <shared_mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Structura::App {
+
+/**
+ * @brief Thread-safe decorator over another IModelRepository.
+ *
+ * Reads take a shared lock and run concurrently; mutations take an exclusive
+ * lock. This lets analysis, export and validation jobs read the model from
+ * worker threads while the UI thread keeps editing it.
+ *
+ * Value-returning calls (findNode(), allBars(), nodeCount(), changesSince(),
+ * ...) are safe from any thread as they are. Pointers, views and ranges
+ * (findNodePtr(), nodes(), barsAtNode(), nodeCoordinates(), ...) borrow the
+ * wrapped repository's storage, which the next write invalidates, so they
+ * are only handed out while the calling thread holds the lock: inside
+ * read() or write(). Called anywhere else they assert, and return nullptr or
+ * an empty view in release builds, rather than a pointer that a concurrent
+ * writer could free. Long-lived readers can work from a snapshot() instead:
+ * a published ModelVersion is immutable and stays valid however the model
+ * changes afterwards.
+ *
+ * snapshot() may be called from any thread. The wrapped repository builds
+ * versions lazily, so snapshot() also takes a private mutex. Concurrent
+ * snapshot() calls are serialised; they do not block other readers.
+ *
+ * A waiting writer stops new readers from entering until it has run. A
+ * steady stream of overlapping readers therefore cannot starve the UI
+ * thread's edits. (std::shared_mutex often prefers readers, e.g. on glibc.)
+ *
+ * Inside read() or write(), the decorator itself (and services built on it)
+ * can be used as well as the repository passed to the callback: calls from
+ * the thread holding the lock run without locking again. Mutations are not
+ * allowed inside read(), as the shared lock cannot be upgraded. Do not call
+ * snapshot() on the wrapped repository; call it on the decorator.
+ *
+ * Usage:
+ * @code
+ * InMemoryModelRepository model;
+ * ConcurrentModelRepository shared(&model);
+ * // worker thread
+ * shared.read([](const IModelRepository &repo) {
+ *     for (const Bar &bar : repo.bars()) { ... }
+ * });
+ * // UI thread
+ * shared.write([&](IModelRepository &repo) {
+ *     repo.addNode(a);
+ *     repo.addNode(b);
+ *     repo.addBar(Bar(QUuid::createUuid(), a.id(), b.id()));
+ * });
+ * @endcode
+ */
+class ConcurrentModelRepository : public IModelRepository
+{
+public:
+    /**
+     * @param repository Repository to guard (not owned). All access to it
+     *        must go through this decorator from now on.
+     */
+    explicit ConcurrentModelRepository(IModelRepository *repository)
+        : m_repository(repository)
+    {
+    }
+    ~ConcurrentModelRepository() override = default;
+
+    ConcurrentModelRepository(const ConcurrentModelRepository&) = delete;
+    ConcurrentModelRepository& operator=(const ConcurrentModelRepository&) = delete;
+
+    /**
+     * @brief Run @p visit under the shared lock.
+     *
+     * Pointers and views taken from the repository, or from this decorator,
+     * stay valid until @p visit returns. Several calls made in @p visit see
+     * one consistent state.
+     * @param visit Callable taking `const IModelRepository &`
+     * @return Whatever @p visit returns
+     */
+    template <typename Visit>
+    auto read(Visit &&visit) const
+    {
+        if (heldAccess() != Access::None) {
+            return std::forward<Visit>(visit)(static_cast<const IModelRepository &>(*m_repository));
+        }
+        {
+            std::lock_guard<std::mutex> turn(m_turnstile);
+        }
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+        const Holding holding(this, Access::Shared);
+        return std::forward<Visit>(visit)(static_cast<const IModelRepository &>(*m_repository));
+    }
+
+    /**
+     * @brief Run @p mutate under the exclusive lock.
+     *
+     * Readers see either none or all of the changes @p mutate makes.
+     * @param mutate Callable taking `IModelRepository &`
+     * @return Whatever @p mutate returns
+     */
+    template <typename Mutate>
+    auto write(Mutate &&mutate)
+    {
+        const Access held = heldAccess();
+        Q_ASSERT_X(held != Access::Shared, "ConcurrentModelRepository::write", "called inside read()");
+        if (held == Access::Exclusive) {
+            return std::forward<Mutate>(mutate)(*m_repository);
+        }
+        std::unique_lock<std::mutex> turn(m_turnstile);
+        std::unique_lock<std::shared_mutex> lock(m_mutex);
+        turn.unlock();
+        const Holding holding(this, Access::Exclusive);
+        return std::forward<Mutate>(mutate)(*m_repository);
+    }
+
+    // ===== Node Operations =====
+
+    bool addNode(const Node &node) override
+    {
+        return write([&](IModelRepository &repo) { return repo.addNode(node); });
+    }
+
+    void reserveNodes(size_t count) override
+    {
+        write([&](IModelRepository &repo) { repo.reserveNodes(count); });
+    }
+
+    bool removeNode(const QUuid &id) override
+    {
+        return write([&](IModelRepository &repo) { return repo.removeNode(id); });
+    }
+
+    size_t removeNodes(const std::vector<QUuid> &ids) override
+    {
+        return write([&](IModelRepository &repo) { return repo.removeNodes(ids); });
+    }
+
+    bool updateNode(const Node &node) override
+    {
+        return write([&](IModelRepository &repo) { return repo.updateNode(node); });
+    }
+
+    std::optional<Node> findNode(const QUuid &id) const override
+    {
+        return read([&](const IModelRepository &repo) { return repo.findNode(id); });
+    }
+
+    const Node *findNodePtr(const QUuid &id) const override
+    {
+        return borrow([&](const IModelRepository &repo) { return repo.findNodePtr(id); });
+    }
+
+    std::optional<Node> findNodeByExternalId(int externalId) const override
+    {
+        return read([&](const IModelRepository &repo) { return repo.findNodeByExternalId(externalId); });
+    }
+
+    int maxNodeExternalId() const override
+    {
+        return read([](const IModelRepository &repo) { return repo.maxNodeExternalId(); });
+    }
+
+    std::vector<size_t> nodesWithinRadius(const Vector3 &center, double radius) const override
+    {
+        return read([&](const IModelRepository &repo) { return repo.nodesWithinRadius(center, radius); });
+    }
+
+    std::vector<size_t> nodesInBox(const Vector3 &minCorner, const Vector3 &maxCorner) const override
+    {
+        return read([&](const IModelRepository &repo) { return repo.nodesInBox(minCorner, maxCorner); });
+    }
+
+    const Node *nearestNode(const Vector3 &point,
+                            double maxDistance = std::numeric_limits<double>::infinity()) const override
+    {
+        return borrow([&](const IModelRepository &repo) { return repo.nearestNode(point, maxDistance); });
+    }
+
+    std::vector<Node> allNodes() const override
+    {
+        return read([](const IModelRepository &repo) { return repo.allNodes(); });
+    }
+
+    EntityView<Node> nodes() const override
+    {
+        return borrow([](const IModelRepository &repo) { return repo.nodes(); });
+    }
+
+    size_t nodeCount() const override
+    {
+        return read([](const IModelRepository &repo) { return repo.nodeCount(); });
+    }
+
+    const double *nodeCoordinates() const override
+    {
+        return borrow([](const IModelRepository &repo) { return repo.nodeCoordinates(); });
+    }
+
+    NodeHandle nodeHandle(const QUuid &id) const override
+    {
+        return read([&](const IModelRepository &repo) { return repo.nodeHandle(id); });
+    }
+
+    NodeHandle nodeHandleAt(size_t index) const override
+    {
+        return read([&](const IModelRepository &repo) { return repo.nodeHandleAt(index); });
+    }
+
+    const Node *node(NodeHandle handle) const override
+    {
+        return borrow([&](const IModelRepository &repo) { return repo.node(handle); });
+    }
+
+    IndexedRange<Node> supportedNodes() const override
+    {
+        return borrow([](const IModelRepository &repo) { return repo.supportedNodes(); });
+    }
+
+    void clearNodes() override
+    {
+        write([](IModelRepository &repo) { repo.clearNodes(); });
+    }
+
+    // ===== Bar Operations =====
+
+    bool addBar(const Bar &bar) override
+    {
+        return write([&](IModelRepository &repo) { return repo.addBar(bar); });
+    }
+
+    void reserveBars(size_t count) override
+    {
+        write([&](IModelRepository &repo) { repo.reserveBars(count); });
+    }
+
+    bool removeBar(const QUuid &id) override
+    {
+        return write([&](IModelRepository &repo) { return repo.removeBar(id); });
+    }
+
+    size_t removeBars(const std::vector<QUuid> &ids) override
+    {
+        return write([&](IModelRepository &repo) { return repo.removeBars(ids); });
+    }
+
+    bool updateBar(const Bar &bar) override
+    {
+        return write([&](IModelRepository &repo) { return repo.updateBar(bar); });
+    }
+
+    std::optional<Bar> findBar(const QUuid &id) const override
+    {
+        return read([&](const IModelRepository &repo) { return repo.findBar(id); });
+    }
+
+    const Bar *findBarPtr(const QUuid &id) const override
+    {
+        return borrow([&](const IModelRepository &repo) { return repo.findBarPtr(id); });
+    }
+
+    std::optional<Bar> findBarByExternalId(int externalId) const override
+    {
+        return read([&](const IModelRepository &repo) { return repo.findBarByExternalId(externalId); });
+    }
+
+    int maxBarExternalId() const override
+    {
+        return read([](const IModelRepository &repo) { return repo.maxBarExternalId(); });
+    }
+
+    std::vector<Bar> allBars() const override
+    {
+        return read([](const IModelRepository &repo) { return repo.allBars(); });
+    }
+
+    EntityView<Bar> bars() const override
+    {
+        return borrow([](const IModelRepository &repo) { return repo.bars(); });
+    }
+
+    size_t barCount() const override
+    {
+        return read([](const IModelRepository &repo) { return repo.barCount(); });
+    }
+
+    BarHandle barHandle(const QUuid &id) const override
+    {
+        return read([&](const IModelRepository &repo) { return repo.barHandle(id); });
+    }
+
+    BarHandle barHandleAt(size_t index) const override
+    {
+        return read([&](const IModelRepository &repo) { return repo.barHandleAt(index); });
+    }
+
+    const Bar *bar(BarHandle handle) const override
+    {
+        return borrow([&](const IModelRepository &repo) { return repo.bar(handle); });
+    }
+
+    std::array<NodeHandle, 2> barEndNodes(BarHandle handle) const override
+    {
+        return read([&](const IModelRepository &repo) { return repo.barEndNodes(handle); });
+    }
+
+    const Vector3 *barKPoint(BarHandle handle) const override
+    {
+        return borrow([&](const IModelRepository &repo) { return repo.barKPoint(handle); });
+    }
+
+    bool setBarKPoint(const QUuid &id, const std::optional<Vector3> &kPoint) override
+    {
+        return write([&](IModelRepository &repo) { return repo.setBarKPoint(id, kPoint); });
+    }
+
+    const std::int32_t *barMaterialIndices() const override
+    {
+        return borrow([](const IModelRepository &repo) { return repo.barMaterialIndices(); });
+    }
+
+    const std::int32_t *barSectionIndices() const override
+    {
+        return borrow([](const IModelRepository &repo) { return repo.barSectionIndices(); });
+    }
+
+    void clearBars() override
+    {
+        write([](IModelRepository &repo) { repo.clearBars(); });
+    }
+
+    std::vector<Bar> findBarsConnectedToNode(const QUuid &nodeId) const override
+    {
+        return read([&](const IModelRepository &repo) { return repo.findBarsConnectedToNode(nodeId); });
+    }
+
+    IndexedRange<Bar> barsAtNode(const QUuid &nodeId) const override
+    {
+        return borrow([&](const IModelRepository &repo) { return repo.barsAtNode(nodeId); });
+    }
+
+    // ===== Material Operations =====
+
+    bool addMaterial(const Material &material) override
+    {
+        return write([&](IModelRepository &repo) { return repo.addMaterial(material); });
+    }
+
+    bool removeMaterial(const QUuid &id) override
+    {
+        return write([&](IModelRepository &repo) { return repo.removeMaterial(id); });
+    }
+
+    bool updateMaterial(const Material &material) override
+    {
+        return write([&](IModelRepository &repo) { return repo.updateMaterial(material); });
+    }
+
+    std::optional<Material> findMaterial(const QUuid &id) const override
+    {
+        return read([&](const IModelRepository &repo) { return repo.findMaterial(id); });
+    }
+
+    const Material *findMaterialPtr(const QUuid &id) const override
+    {
+        return borrow([&](const IModelRepository &repo) { return repo.findMaterialPtr(id); });
+    }
+
+    int materialIndex(const QUuid &id) const override
+    {
+        return read([&](const IModelRepository &repo) { return repo.materialIndex(id); });
+    }
+
+    std::vector<Material> allMaterials() const override
+    {
+        return read([](const IModelRepository &repo) { return repo.allMaterials(); });
+    }
+
+    EntityView<Material> materials() const override
+    {
+        return borrow([](const IModelRepository &repo) { return repo.materials(); });
+    }
+
+    size_t materialCount() const override
+    {
+        return read([](const IModelRepository &repo) { return repo.materialCount(); });
+    }
+
+    void clearMaterials() override
+    {
+        write([](IModelRepository &repo) { repo.clearMaterials(); });
+    }
+
+    // ===== Section Operations =====
+
+    bool addSection(const Section &section) override
+    {
+        return write([&](IModelRepository &repo) { return repo.addSection(section); });
+    }
+
+    bool removeSection(const QUuid &id) override
+    {
+        return write([&](IModelRepository &repo) { return repo.removeSection(id); });
+    }
+
+    bool updateSection(const Section &section) override
+    {
+        return write([&](IModelRepository &repo) { return repo.updateSection(section); });
+    }
+
+    std::optional<Section> findSection(const QUuid &id) const override
+    {
+        return read([&](const IModelRepository &repo) { return repo.findSection(id); });
+    }
+
+    const Section *findSectionPtr(const QUuid &id) const override
+    {
+        return borrow([&](const IModelRepository &repo) { return repo.findSectionPtr(id); });
+    }
+
+    int sectionIndex(const QUuid &id) const override
+    {
+        return read([&](const IModelRepository &repo) { return repo.sectionIndex(id); });
+    }
+
+    std::vector<Section> allSections() const override
+    {
+        return read([](const IModelRepository &repo) { return repo.allSections(); });
+    }
+
+    EntityView<Section> sections() const override
+    {
+        return borrow([](const IModelRepository &repo) { return repo.sections(); });
+    }
+
+    size_t sectionCount() const override
+    {
+        return read([](const IModelRepository &repo) { return repo.sectionCount(); });
+    }
+
+    void clearSections() override
+    {
+        write([](IModelRepository &repo) { repo.clearSections(); });
+    }
+
+    // ===== GridLine Operations =====
+
+    bool addGridLine(const GridLine &gridLine) override
+    {
+        return write([&](IModelRepository &repo) { return repo.addGridLine(gridLine); });
+    }
+
+    bool removeGridLine(const QUuid &id) override
+    {
+        return write([&](IModelRepository &repo) { return repo.removeGridLine(id); });
+    }
+
+    bool updateGridLine(const GridLine &gridLine) override
+    {
+        return write([&](IModelRepository &repo) { return repo.updateGridLine(gridLine); });
+    }
+
+    std::optional<GridLine> findGridLine(const QUuid &id) const override
+    {
+        return read([&](const IModelRepository &repo) { return repo.findGridLine(id); });
+    }
+
+    const GridLine *findGridLinePtr(const QUuid &id) const override
+    {
+        return borrow([&](const IModelRepository &repo) { return repo.findGridLinePtr(id); });
+    }
+
+    std::vector<GridLine> allGridLines() const override
+    {
+        return read([](const IModelRepository &repo) { return repo.allGridLines(); });
+    }
+
+    EntityView<GridLine> gridLines() const override
+    {
+        return borrow([](const IModelRepository &repo) { return repo.gridLines(); });
+    }
+
+    size_t gridLineCount() const override
+    {
+        return read([](const IModelRepository &repo) { return repo.gridLineCount(); });
+    }
+
+    void clearGridLines() override
+    {
+        write([](IModelRepository &repo) { repo.clearGridLines(); });
+    }
+
+    // ===== Load Case Operations =====
+
+    bool addLoadCase(const LoadCase &loadCase) override
+    {
+        return write([&](IModelRepository &repo) { return repo.addLoadCase(loadCase); });
+    }
+
+    bool removeLoadCase(const QUuid &id) override
+    {
+        return write([&](IModelRepository &repo) { return repo.removeLoadCase(id); });
+    }
+
+    bool updateLoadCase(const LoadCase &loadCase) override
+    {
+        return write([&](IModelRepository &repo) { return repo.updateLoadCase(loadCase); });
+    }
+
+    const LoadCase *findLoadCasePtr(const QUuid &id) const override
+    {
+        return borrow([&](const IModelRepository &repo) { return repo.findLoadCasePtr(id); });
+    }
+
+    EntityView<LoadCase> loadCases() const override
+    {
+        return borrow([](const IModelRepository &repo) { return repo.loadCases(); });
+    }
+
+    size_t loadCaseCount() const override
+    {
+        return read([](const IModelRepository &repo) { return repo.loadCaseCount(); });
+    }
+
+    void clearLoadCases() override
+    {
+        write([](IModelRepository &repo) { repo.clearLoadCases(); });
+    }
+
+    // ===== Load Operations =====
+
+    bool addNodalLoad(const NodalLoad &load) override
+    {
+        return write([&](IModelRepository &repo) { return repo.addNodalLoad(load); });
+    }
+
+    bool removeNodalLoad(const QUuid &id) override
+    {
+        return write([&](IModelRepository &repo) { return repo.removeNodalLoad(id); });
+    }
+
+    bool updateNodalLoad(const NodalLoad &load) override
+    {
+        return write([&](IModelRepository &repo) { return repo.updateNodalLoad(load); });
+    }
+
+    const NodalLoad *findNodalLoadPtr(const QUuid &id) const override
+    {
+        return borrow([&](const IModelRepository &repo) { return repo.findNodalLoadPtr(id); });
+    }
+
+    EntityView<NodalLoad> nodalLoads() const override
+    {
+        return borrow([](const IModelRepository &repo) { return repo.nodalLoads(); });
+    }
+
+    IndexedRange<NodalLoad> nodalLoadsInCase(const QUuid &loadCaseId) const override
+    {
+        return borrow([&](const IModelRepository &repo) { return repo.nodalLoadsInCase(loadCaseId); });
+    }
+
+    IndexedRange<NodalLoad> nodalLoadsAtNode(const QUuid &nodeId) const override
+    {
+        return borrow([&](const IModelRepository &repo) { return repo.nodalLoadsAtNode(nodeId); });
+    }
+
+    bool addMemberLoad(const MemberLoad &load) override
+    {
+        return write([&](IModelRepository &repo) { return repo.addMemberLoad(load); });
+    }
+
+    bool removeMemberLoad(const QUuid &id) override
+    {
+        return write([&](IModelRepository &repo) { return repo.removeMemberLoad(id); });
+    }
+
+    bool updateMemberLoad(const MemberLoad &load) override
+    {
+        return write([&](IModelRepository &repo) { return repo.updateMemberLoad(load); });
+    }
+
+    const MemberLoad *findMemberLoadPtr(const QUuid &id) const override
+    {
+        return borrow([&](const IModelRepository &repo) { return repo.findMemberLoadPtr(id); });
+    }
+
+    EntityView<MemberLoad> memberLoads() const override
+    {
+        return borrow([](const IModelRepository &repo) { return repo.memberLoads(); });
+    }
+
+    IndexedRange<MemberLoad> memberLoadsInCase(const QUuid &loadCaseId) const override
+    {
+        return borrow([&](const IModelRepository &repo) { return repo.memberLoadsInCase(loadCaseId); });
+    }
+
+    IndexedRange<MemberLoad> memberLoadsOnBar(const QUuid &barId) const override
+    {
+        return borrow([&](const IModelRepository &repo) { return repo.memberLoadsOnBar(barId); });
+    }
+
+    // ===== Utility Operations =====
+
+    void clearAll() override
+    {
+        write([](IModelRepository &repo) { repo.clearAll(); });
+    }
+
+    bool isEmpty() const override
+    {
+        return read([](const IModelRepository &repo) { return repo.isEmpty(); });
+    }
+
+    std::shared_ptr<const ModelVersion> snapshot() const override
+    {
+        return read([this](const IModelRepository &repo) {
+            std::lock_guard<std::mutex> publish(m_snapshotMutex);
+            return repo.snapshot();
+        });
+    }
+
+    // ===== Change Tracking =====
+
+    std::uint64_t changeVersion() const override
+    {
+        return read([](const IModelRepository &repo) { return repo.changeVersion(); });
+    }
+
+    bool changesSince(std::uint64_t version, std::vector<ModelChange> &changes) const override
+    {
+        return read([&](const IModelRepository &repo) { return repo.changesSince(version, changes); });
+    }
+
+private:
+    enum class Access
+    {
+        None,
+        Shared,
+        Exclusive
+    };
+
+    /// Decorators whose lock the current thread holds, innermost last
+    static std::vector<std::pair<const ConcurrentModelRepository *, Access>> &heldLocks()
+    {
+        static thread_local std::vector<std::pair<const ConcurrentModelRepository *, Access>> locks;
+        return locks;
+    }
+
+    /// Records the lock as held by this thread for its lifetime
+    class Holding
+    {
+    public:
+        Holding(const ConcurrentModelRepository *repository, Access access)
+        {
+            heldLocks().emplace_back(repository, access);
+        }
+        ~Holding() { heldLocks().pop_back(); }
+
+        Holding(const Holding&) = delete;
+        Holding& operator=(const Holding&) = delete;
+    };
+
+    Access heldAccess() const
+    {
+        for (const auto &held : heldLocks()) {
+            if (held.first == this) {
+                return held.second;
+            }
+        }
+        return Access::None;
+    }
+
+    /**
+     * @brief Run @p visit for a pointer or view into the wrapped storage,
+     *        which is only valid while this thread holds the lock.
+     * @return What @p visit returns, or an empty result outside read()/write()
+     */
+    template <typename Visit, typename Result = std::invoke_result_t<Visit, const IModelRepository &>>
+    Result borrow(Visit &&visit) const
+    {
+        const bool held = heldAccess() != Access::None;
+        Q_ASSERT_X(held, "ConcurrentModelRepository", "pointers and views need read() or write()");
+        if (!held) {
+            return Result{};
+        }
+        return std::forward<Visit>(visit)(static_cast<const IModelRepository &>(*m_repository));
+    }
+
+    IModelRepository *m_repository;
+    mutable std::shared_mutex m_mutex;
+    mutable std::mutex m_turnstile;      ///< Held by a waiting writer to hold back new readers
+    mutable std::mutex m_snapshotMutex; ///< Serialises lazy version publishing
+};
+
+} // namespace Structura::App
@@ -0,0 +1,390 @@
+#include "DatModelReader.h"
+#include <QHash>
+#include <array>
+#include <cctype>
+#include <cstring>
+#include <memory_resource>
+
+namespace Structura::App {
+
+namespace {
+
+/// Data lines per .dat section (an upper bound on the records it holds)
+struct DatSectionCounts
+{
+    size_t materials{0};
+    size_t sections{0};
+    size_t nodes{0};
+    size_t members{0};
+    size_t nodalLoads{0};
+    size_t memberLoads{0};
+};
+
+/// Bracketed section header of a .dat file
+enum class DatBlock { None, Materials, Sections, Nodes, Members, NodalLoads, MemberLoads };
+
+/// Whitespace-trimmed text of one line
+struct Line
+{
+    const char *begin{nullptr};
+    const char *end{nullptr};
+
+    bool isEmpty() const { return begin == end; }
+    bool isComment() const { return *begin == '#'; }
+    bool isHeader() const { return *begin == '['; }
+};
+
+/// Fields of a data line; only the first kMaxFields are kept
+struct Fields
+{
+    static constexpr int kMaxFields = 10;
+
+    std::array<QByteArray, kMaxFields> text;
+    int count{0};
+
+    int toInt(int index, bool *ok) const { return text[static_cast<size_t>(index)].toInt(ok); }
+    double toDouble(int index, bool *ok) const { return text[static_cast<size_t>(index)].toDouble(ok); }
+};
+
+bool isSpace(char c)
+{
+    return std::isspace(static_cast<unsigned char>(c)) != 0;
+}
+
+/// Next line of [@p cursor, @p end), trimmed; advances @p cursor past it
+Line nextLine(const char *&cursor, const char *end)
+{
+    const char *lineEnd = static_cast<const char *>(std::memchr(cursor, '\n', static_cast<size_t>(end - cursor)));
+    if (lineEnd == nullptr) {
+        lineEnd = end;
+    }
+    Line line{cursor, lineEnd};
+    cursor = lineEnd == end ? end : lineEnd + 1;
+    while (line.begin < line.end && isSpace(*line.begin)) {
+        ++line.begin;
+    }
+    while (line.end > line.begin && isSpace(*(line.end - 1))) {
+        --line.end;
+    }
+    return line;
+}
+
+bool equalsIgnoreCase(const char *begin, const char *end, const char *text)
+{
+    const size_t length = std::strlen(text);
+    if (static_cast<size_t>(end - begin) != length) {
+        return false;
+    }
+    for (size_t i = 0; i < length; ++i) {
+        if (std::toupper(static_cast<unsigned char>(begin[i])) != static_cast<unsigned char>(text[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+DatBlock blockOf(const Line &header)
+{
+    if (equalsIgnoreCase(header.begin, header.end, "[MATERIALS]")) {
+        return DatBlock::Materials;
+    }
+    if (equalsIgnoreCase(header.begin, header.end, "[SECTIONS]")) {
+        return DatBlock::Sections;
+    }
+    if (equalsIgnoreCase(header.begin, header.end, "[NODES]")) {
+        return DatBlock::Nodes;
+    }
+    if (equalsIgnoreCase(header.begin, header.end, "[MEMBERS]")) {
+        return DatBlock::Members;
+    }
+    if (equalsIgnoreCase(header.begin, header.end, "[NODAL_LOADS]")) {
+        return DatBlock::NodalLoads;
+    }
+    if (equalsIgnoreCase(header.begin, header.end, "[MEMBER_LOADS]")) {
+        return DatBlock::MemberLoads;
+    }
+    return DatBlock::None;
+}
+
+/// Split @p line at whitespace; the fields borrow the file's bytes
+void split(const Line &line, Fields &fields)
+{
+    fields.count = 0;
+    const char *cursor = line.begin;
+    while (cursor < line.end) {
+        while (cursor < line.end && isSpace(*cursor)) {
+            ++cursor;
+        }
+        const char *first = cursor;
+        while (cursor < line.end && !isSpace(*cursor)) {
+            ++cursor;
+        }
+        if (first == cursor) {
+            break;
+        }
+        if (fields.count < Fields::kMaxFields) {
+            fields.text[static_cast<size_t>(fields.count)] =
+                QByteArray::fromRawData(first, static_cast<int>(cursor - first));
+        }
+        ++fields.count;
+    }
+}
+
+/// Cheap pre-pass over the raw file so the reader can size everything once
+DatSectionCounts countDatSections(const char *cursor, const char *end)
+{
+    DatSectionCounts counts;
+    size_t *current = nullptr;
+    while (cursor < end) {
+        const Line line = nextLine(cursor, end);
+        if (line.isEmpty() || line.isComment()) {
+            continue;
+        }
+        if (line.isHeader()) {
+            switch (blockOf(line)) {
+            case DatBlock::Materials: current = &counts.materials; break;
+            case DatBlock::Sections: current = &counts.sections; break;
+            case DatBlock::Nodes: current = &counts.nodes; break;
+            case DatBlock::Members: current = &counts.members; break;
+            case DatBlock::NodalLoads: current = &counts.nodalLoads; break;
+            case DatBlock::MemberLoads: current = &counts.memberLoads; break;
+            case DatBlock::None: current = nullptr; break;
+            }
+        } else if (current) {
+            ++*current;
+        }
+    }
+    return counts;
+}
+
+struct StagedMember
+{
+    int id;
+    int nodeI;
+    int nodeJ;
+    int materialId;
+    int sectionId;
+};
+
+struct StagedNodalLoad
+{
+    int nodeId;
+    double force[3];
+    double moment[3];
+};
+
+struct StagedMemberLoad
+{
+    int memberId;
+    bool local;
+    double intensity[3];
+};
+
+} // namespace
+
+DatReadResult readDatModel(const QByteArray &contents, IModelRepository &repository, const QUuid &loadCaseId)
+{
+    DatReadResult result;
+    const char *const begin = contents.constData();
+    const char *const end = begin + contents.size();
+    const DatSectionCounts counts = countDatSections(begin, end);
+
+    repository.reserveNodes(repository.nodeCount() + counts.nodes);
+    repository.reserveBars(repository.barCount() + counts.members);
+
+    // Members and loads may name nodes defined further down, so they wait
+    // for the end of the file in one arena sized by the pre-pass
+    std::pmr::monotonic_buffer_resource arena(
+        sizeof(StagedMember) * counts.members + sizeof(StagedNodalLoad) * counts.nodalLoads
+        + sizeof(StagedMemberLoad) * counts.memberLoads + 64);
+    std::pmr::vector<StagedMember> members(&arena);
+    std::pmr::vector<StagedNodalLoad> nodalLoads(&arena);
+    std::pmr::vector<StagedMemberLoad> memberLoads(&arena);
+    members.reserve(counts.members);
+    nodalLoads.reserve(counts.nodalLoads);
+    memberLoads.reserve(counts.memberLoads);
+    QHash<int, QUuid> materialIds;
+    QHash<int, QUuid> sectionIds;
+
+    auto fail = [&result](DatReadError error, int line) {
+        result.error = error;
+        result.line = line;
+        return result;
+    };
+
+    DatBlock current = DatBlock::None;
+    Fields fields;
+    int lineNumber = 0;
+    const char *cursor = begin;
+    while (cursor < end) {
+        const Line line = nextLine(cursor, end);
+        ++lineNumber;
+        if (line.isEmpty() || line.isComment()) {
+            continue;
+        }
+        if (line.isHeader()) {
+            current = blockOf(line);
+            continue;
+        }
+
+        split(line, fields);
+        bool ok = false;
+        switch (current) {
+        case DatBlock::Materials: {
+            if (fields.count < 3) {
+                return fail(DatReadError::InvalidMaterialLine, lineNumber);
+            }
+            const int id = fields.toInt(0, &ok);
+            if (!ok) {
+                return fail(DatReadError::InvalidMaterialId, lineNumber);
+            }
+            const double youngModulus = fields.toDouble(1, &ok);
+            if (!ok) {
+                return fail(DatReadError::InvalidYoungModulus, lineNumber);
+            }
+            const double shearModulus = fields.toDouble(2, &ok);
+            if (!ok) {
+                return fail(DatReadError::InvalidShearModulus, lineNumber);
+            }
+            const Material material(QUuid::createUuid(), id, QString(), youngModulus, shearModulus);
+            materialIds.insert(id, material.id());
+            repository.addMaterial(material);
+            break;
+        }
+        case DatBlock::Sections: {
+            if (fields.count < 5) {
+                return fail(DatReadError::InvalidSectionLine, lineNumber);
+            }
+            const int id = fields.toInt(0, &ok);
+            if (!ok) {
+                return fail(DatReadError::InvalidSectionId, lineNumber);
+            }
+            double values[4];
+            for (int i = 0; i < 4; ++i) {
+                values[i] = fields.toDouble(1 + i, &ok);
+                if (!ok) {
+                    return fail(DatReadError::InvalidSectionValues, lineNumber);
+                }
+            }
+            const Section section(QUuid::createUuid(), id, QString(),
+                                  values[0], values[1], values[2], values[3]);
+            sectionIds.insert(id, section.id());
+            repository.addSection(section);
+            break;
+        }
+        case DatBlock::Nodes: {
+            if (fields.count < 10) {
+                return fail(DatReadError::InvalidNodeLine, lineNumber);
+            }
+            const int id = fields.toInt(0, &ok);
+            if (!ok) {
+                return fail(DatReadError::InvalidNodeId, lineNumber);
+            }
+            double xyz[3];
+            for (int i = 0; i < 3; ++i) {
+                xyz[i] = fields.toDouble(1 + i, &ok);
+                if (!ok) {
+                    return fail(DatReadError::InvalidCoordinates, lineNumber);
+                }
+            }
+            Node node(QUuid::createUuid(), id, xyz[0], xyz[1], xyz[2]);
+            std::uint8_t restraints = 0;
+            for (int i = 0; i < 6; ++i) {
+                // Anything but a nonzero integer leaves the DOF free
+                if (fields.toInt(4 + i, &ok) != 0 && ok) {
+                    restraints |= static_cast<std::uint8_t>(1u << i);
+                }
+            }
+            node.setRestraintMask(restraints);
+            repository.addNode(node);
+            break;
+        }
+        case DatBlock::Members: {
+            if (fields.count < 5) {
+                return fail(DatReadError::InvalidMemberLine, lineNumber);
+            }
+            int values[5];
+            for (int i = 0; i < 5; ++i) {
+                values[i] = fields.toInt(i, &ok);
+                if (!ok) {
+                    return fail(DatReadError::InvalidMemberLine, lineNumber);
+                }
+            }
+            members.push_back(StagedMember{values[0], values[1], values[2], values[3], values[4]});
+            break;
+        }
+        case DatBlock::NodalLoads: {
+            if (fields.count < 7) {
+                break;
+            }
+            StagedNodalLoad load{};
+            load.nodeId = fields.toInt(0, &ok);
+            if (!ok) {
+                break;
+            }
+            for (int i = 0; i < 3; ++i) {
+                load.force[i] = fields.toDouble(1 + i, nullptr);
+                load.moment[i] = fields.toDouble(4 + i, nullptr);
+            }
+            nodalLoads.push_back(load);
+            break;
+        }
+        case DatBlock::MemberLoads: {
+            if (fields.count < 5) {
+                break;
+            }
+            StagedMemberLoad load{};
+            load.memberId = fields.toInt(0, &ok);
+            if (!ok) {
+                break;
+            }
+            const QByteArray &system = fields.text[1];
+            load.local = equalsIgnoreCase(system.constData(), system.constData() + system.size(), "LOCAL")
+                || equalsIgnoreCase(system.constData(), system.constData() + system.size(), "L");
+            for (int i = 0; i < 3; ++i) {
+                load.intensity[i] = fields.toDouble(2 + i, nullptr);
+            }
+            memberLoads.push_back(load);
+            break;
+        }
+        case DatBlock::None:
+            break;
+        }
+    }
+
+    for (const StagedMember &member : members) {
+        const std::optional<Node> start = repository.findNodeByExternalId(member.nodeI);
+        const std::optional<Node> finish = repository.findNodeByExternalId(member.nodeJ);
+        if (!start || !finish) {
+            result.danglingMembers.push_back(member.id);
+            continue;
+        }
+        if (start->id() == finish->id()) {
+            continue;
+        }
+        Bar bar(QUuid::createUuid(), start->id(), finish->id(),
+                materialIds.value(member.materialId), sectionIds.value(member.sectionId));
+        bar.setExternalId(member.id);
+        repository.addBar(bar);
+    }
+
+    for (const StagedNodalLoad &load : nodalLoads) {
+        const std::optional<Node> node = repository.findNodeByExternalId(load.nodeId);
+        if (node) {
+            repository.addNodalLoad(NodalLoad(QUuid::createUuid(), loadCaseId, node->id(),
+                                              Vector3(load.force[0], load.force[1], load.force[2]),
+                                              Vector3(load.moment[0], load.moment[1], load.moment[2])));
+        }
+    }
+    for (const StagedMemberLoad &load : memberLoads) {
+        const std::optional<Bar> bar = repository.findBarByExternalId(load.memberId);
+        if (bar) {
+            repository.addMemberLoad(MemberLoad(QUuid::createUuid(), loadCaseId, bar->id(),
+                                                Vector3(load.intensity[0], load.intensity[1], load.intensity[2]),
+                                                load.local ? MemberLoad::System::Local : MemberLoad::System::Global));
+        }
+    }
+    return result;
+}
+
+} // namespace Structura::App
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "IModelRepository.h"
+#include <QByteArray>
+#include <QUuid>
+#include <vector>
+
+namespace Structura::App {
+
+/**
+ * @brief Why a .dat file was rejected.
+ */
+enum class DatReadError
+{
+    None,
+    InvalidMaterialLine,  ///< Fewer than 3 fields
+    InvalidMaterialId,
+    InvalidYoungModulus,
+    InvalidShearModulus,
+    InvalidSectionLine,   ///< Fewer than 5 fields
+    InvalidSectionId,
+    InvalidSectionValues,
+    InvalidNodeLine,      ///< Fewer than 10 fields
+    InvalidNodeId,
+    InvalidCoordinates,
+    InvalidMemberLine     ///< Fewer than 5 fields, or a field that is not an integer
+};
+
+/**
+ * @brief Outcome of readDatModel().
+ */
+struct DatReadResult
+{
+    DatReadError error{DatReadError::None};
+    int line{0};                       ///< 1-based line of the error
+    std::vector<int> danglingMembers;  ///< Members skipped because a node they name is missing
+
+    bool ok() const { return error == DatReadError::None; }
+};
+
+/**
+ * @brief Read a .dat model into a repository.
+ *
+ * The file has [MATERIALS], [SECTIONS], [NODES], [MEMBERS], [NODAL_LOADS]
+ * and [MEMBER_LOADS] sections; '#' starts a comment line. Entities get new
+ * UUIDs and keep the file's IDs as external IDs. Materials and sections are
+ * left unnamed. Restraints are stored on the nodes, and all loads go into
+ * the load case @p loadCaseId, which must already be in @p repository.
+ * Members and loads referring to missing nodes or members are skipped, as
+ * are members that start and end at the same node; malformed load lines
+ * are ignored.
+ *
+ * Built for large files: a pre-pass counts the records of each section so
+ * the repository is reserved once, nodes go straight into the repository,
+ * and members and loads (which may name nodes defined further down) are
+ * staged in one monotonic arena until the end of the file.
+ *
+ * On error the repository holds what was read before the failing line, so
+ * read into a fresh repository and discard it if the result is not ok().
+ * @param contents Raw file contents
+ * @param repository Repository to fill
+ * @param loadCaseId Load case receiving the nodal and member loads
+ * @return Error and line, or ok() with the members that were skipped
+ */
+DatReadResult readDatModel(const QByteArray &contents, IModelRepository &repository, const QUuid &loadCaseId);
+
+} // namespace Structura::App
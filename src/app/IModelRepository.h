@@ -1,11 +1,19 @@
 #pragma once
 
 #include "../core/model/ModelEntities.h"
+#include "../core/model/EntityHandle.h"
+#include "ModelVersion.h"
+#include "ModelChangeJournal.h"
 #include <QUuid>
 #include <QString>
 #include <vector>
 #include <optional>
 #include <functional>
+#include <iterator>
+#include <cstddef>
+#include <array>
+#include <memory>
+#include <limits>
 
 namespace Structura::App {
 
@@ -14,12 +22,108 @@ using Bar = Structura::Model::Bar;
 using Material = Structura::Model::Material;
 using Section = Structura::Model::Section;
 using GridLine = Structura::Model::GridLine;
+using LoadCase = Structura::Model::LoadCase;
+using NodalLoad = Structura::Model::NodalLoad;
+using MemberLoad = Structura::Model::MemberLoad;
+using NodeHandle = Structura::Model::NodeHandle;
+using BarHandle = Structura::Model::BarHandle;
+using Vector3 = Structura::Model::Vector3;
+
+/**
+ * @brief Non-owning view over a contiguous block of repository entities.
+ * 
+ * Lets callers read the model without copying entities (and their QUuid /
+ * QString members). The view is invalidated by any mutation of the repository.
+ */
+template <typename Entity>
+class EntityView
+{
+public:
+    using const_iterator = const Entity *;
+
+    EntityView() = default;
+    EntityView(const Entity *data, size_t size)
+        : m_data(data)
+        , m_size(size)
+    {
+    }
+
+    const_iterator begin() const { return m_data; }
+    const_iterator end() const { return m_data + m_size; }
+    const Entity &operator[](size_t index) const { return m_data[index]; }
+    const Entity *data() const { return m_data; }
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+private:
+    const Entity *m_data{nullptr};
+    size_t m_size{0};
+};
+
+/**
+ * @brief Non-owning, non-allocating view over repository entities selected
+ * by dense index.
+ * 
+ * The view borrows the repository's internal storage and is invalidated by
+ * any mutation of the repository.
+ */
+template <typename Entity>
+class IndexedRange
+{
+public:
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Entity;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Entity *;
+        using reference = const Entity &;
+
+        const_iterator() = default;
+        const_iterator(const Entity *items, const int *index)
+            : m_items(items)
+            , m_index(index)
+        {
+        }
+
+        reference operator*() const { return m_items[*m_index]; }
+        pointer operator->() const { return &m_items[*m_index]; }
+        const_iterator &operator++() { ++m_index; return *this; }
+        const_iterator operator++(int) { const_iterator tmp = *this; ++m_index; return tmp; }
+        bool operator==(const const_iterator &other) const { return m_index == other.m_index; }
+        bool operator!=(const const_iterator &other) const { return m_index != other.m_index; }
+
+    private:
+        const Entity *m_items{nullptr};
+        const int *m_index{nullptr};
+    };
+
+    IndexedRange() = default;
+    IndexedRange(const Entity *items, const int *first, const int *last)
+        : m_items(items)
+        , m_first(first)
+        , m_last(last)
+    {
+    }
+
+    const_iterator begin() const { return const_iterator(m_items, m_first); }
+    const_iterator end() const { return const_iterator(m_items, m_last); }
+    size_t size() const { return static_cast<size_t>(m_last - m_first); }
+    bool empty() const { return m_first == m_last; }
+
+private:
+    const Entity *m_items{nullptr};
+    const int *m_first{nullptr};
+    const int *m_last{nullptr};
+};
 
 /**
  * @brief Interface for managing structural model entities.
  * 
  * This interface provides CRUD operations for all model entities:
- * Nodes, Bars, Materials, Sections, and GridLines.
+ * Nodes, Bars, Materials, Sections, GridLines, LoadCases and their
+ * NodalLoads and MemberLoads. Supports are the nodes' restraints.
  * 
  * The repository pattern abstracts data storage and allows for
  * easy testing and future implementation changes (e.g., database backend).
@@ -38,13 +142,35 @@ public:
      */
     virtual bool addNode(const Node &node) = 0;
     
+    /**
+     * @brief Pre-size node storage before a bulk load.
+     * 
+     * Reserves the node array and every per-node index for @p count nodes in
+     * total, so the following addNode() calls do not reallocate or rehash.
+     * Never shrinks and never changes the contents.
+     * @param count Expected total number of nodes
+     */
+    virtual void reserveNodes(size_t count) = 0;
+    
     /**
      * @brief Remove a node by ID.
+     * 
+     * Runs in O(1); the iteration order of the remaining nodes may change.
      * @param id The UUID of the node to remove
      * @return true if node was found and removed
      */
     virtual bool removeNode(const QUuid &id) = 0;
     
+    /**
+     * @brief Remove several nodes in a single pass.
+     * 
+     * Runs in O(n) regardless of how many IDs are given and preserves the
+     * relative order of the remaining nodes. Unknown IDs are ignored.
+     * @param ids UUIDs of the nodes to remove
+     * @return Number of nodes removed
+     */
+    virtual size_t removeNodes(const std::vector<QUuid> &ids) = 0;
+    
     /**
      * @brief Update an existing node.
      * @param node The node with updated data (ID must match existing node)
@@ -59,25 +185,133 @@ public:
      */
     virtual std::optional<Node> findNode(const QUuid &id) const = 0;
     
+    /**
+     * @brief Find a node by its UUID without copying it.
+     * @param id The UUID to search for
+     * @return Pointer to the stored node, or nullptr if not found. Invalidated
+     *         by any repository mutation.
+     */
+    virtual const Node *findNodePtr(const QUuid &id) const = 0;
+    
     /**
      * @brief Find a node by its external ID.
+     * 
+     * Backed by a hash index; if several nodes share the ID any one of them
+     * may be returned.
      * @param externalId The external ID to search for
      * @return Optional containing the node if found
      */
     virtual std::optional<Node> findNodeByExternalId(int externalId) const = 0;
     
+    /**
+     * @brief Highest node external ID stored since the last clear.
+     * 
+     * This is a high-water mark: it does not decrease when nodes are removed,
+     * so IDs handed out from it are never reused within a session.
+     * @return Highest external ID seen, or 0 if none
+     */
+    virtual int maxNodeExternalId() const = 0;
+    
+    // ===== Spatial Queries =====
+    // Backed by a spatial hash kept up to date on every node mutation.
+    // Results are dense indices into nodes() / nodeCoordinates(), valid
+    // until the next node mutation.
+    
+    /**
+     * @brief Find all nodes within a distance of a point.
+     * @param center Query point
+     * @param radius Search radius (inclusive)
+     * @return Dense indices of the matching nodes, in no particular order
+     */
+    virtual std::vector<size_t> nodesWithinRadius(const Vector3 &center, double radius) const = 0;
+    
+    /**
+     * @brief Find all nodes inside an axis-aligned box.
+     * @param minCorner Lower corner (inclusive)
+     * @param maxCorner Upper corner (inclusive)
+     * @return Dense indices of the matching nodes, in no particular order
+     */
+    virtual std::vector<size_t> nodesInBox(const Vector3 &minCorner, const Vector3 &maxCorner) const = 0;
+    
+    /**
+     * @brief Find the node closest to a point.
+     * @param point Query point
+     * @param maxDistance Ignore nodes farther away than this
+     * @return The nearest node, or nullptr if there is none within @p maxDistance
+     */
+    virtual const Node *nearestNode(const Vector3 &point,
+                                    double maxDistance = std::numeric_limits<double>::infinity()) const = 0;
+    
     /**
      * @brief Get all nodes in the repository.
      * @return Vector of all nodes
      */
     virtual std::vector<Node> allNodes() const = 0;
     
+    /**
+     * @brief View of all nodes without copying.
+     * @return Contiguous view, invalidated by any repository mutation
+     */
+    virtual EntityView<Node> nodes() const = 0;
+    
+    /**
+     * @brief Visit every node in storage order without copying.
+     * @param visit Callback invoked once per node
+     */
+    void forEachNode(const std::function<void(const Node &)> &visit) const
+    {
+        for (const Node &item : nodes()) {
+            visit(item);
+        }
+    }
+    
     /**
      * @brief Get the count of nodes.
      * @return Number of nodes
      */
     virtual size_t nodeCount() const = 0;
     
+    /**
+     * @brief Node coordinates as one contiguous, interleaved block.
+     * 
+     * Holds x,y,z for every node in the same dense order as nodes(), i.e. the
+     * coordinates of nodes()[i] are at [3*i, 3*i+3). Lets geometry passes,
+     * renderer uploads and solver kernels read positions without touching
+     * the full Node records.
+     * @return Pointer to 3 * nodeCount() doubles, invalidated by any mutation
+     */
+    virtual const double *nodeCoordinates() const = 0;
+    
+    /**
+     * @brief Resolve a node UUID to its runtime handle.
+     * @param id The persistent UUID
+     * @return Handle of the node, or an invalid handle if not found
+     */
+    virtual NodeHandle nodeHandle(const QUuid &id) const = 0;
+    
+    /**
+     * @brief Handle of the node stored at a dense position.
+     * @param index Position in nodes(), must be < nodeCount()
+     */
+    virtual NodeHandle nodeHandleAt(size_t index) const = 0;
+    
+    /**
+     * @brief Resolve a node handle (array indexing, no hashing).
+     * @param handle Handle previously obtained from this repository
+     * @return Pointer to the node, or nullptr if the handle is stale.
+     *         Invalidated by any repository mutation.
+     */
+    virtual const Node *node(NodeHandle handle) const = 0;
+    
+    /**
+     * @brief View of the supported nodes (those with any restraint).
+     * 
+     * Maintained as nodes are added, updated and removed, so the cost is
+     * proportional to the number of supports, not to the node count.
+     * @return Range over the supported nodes, invalidated by any mutation
+     */
+    virtual IndexedRange<Node> supportedNodes() const = 0;
+    
     /**
      * @brief Clear all nodes from the repository.
      */
@@ -92,13 +326,30 @@ public:
      */
     virtual bool addBar(const Bar &bar) = 0;
     
+    /**
+     * @brief Pre-size bar storage before a bulk load.
+     * @param count Expected total number of bars
+     * @see reserveNodes
+     */
+    virtual void reserveBars(size_t count) = 0;
+    
     /**
      * @brief Remove a bar by ID.
+     * 
+     * Runs in O(1); the iteration order of the remaining bars may change.
      * @param id The UUID of the bar to remove
      * @return true if bar was found and removed
      */
     virtual bool removeBar(const QUuid &id) = 0;
     
+    /**
+     * @brief Remove several bars in a single pass.
+     * @param ids UUIDs of the bars to remove
+     * @return Number of bars removed
+     * @see removeNodes
+     */
+    virtual size_t removeBars(const std::vector<QUuid> &ids) = 0;
+    
     /**
      * @brief Update an existing bar.
      * @param bar The bar with updated data (ID must match existing bar)
@@ -113,25 +364,130 @@ public:
      */
     virtual std::optional<Bar> findBar(const QUuid &id) const = 0;
     
+    /**
+     * @brief Find a bar by its UUID without copying it.
+     * @param id The UUID to search for
+     * @return Pointer to the stored bar, or nullptr if not found. Invalidated
+     *         by any repository mutation.
+     */
+    virtual const Bar *findBarPtr(const QUuid &id) const = 0;
+    
     /**
      * @brief Find a bar by its external ID.
+     * 
+     * Backed by a hash index; if several bars share the ID any one of them
+     * may be returned.
      * @param externalId The external ID to search for
      * @return Optional containing the bar if found
      */
     virtual std::optional<Bar> findBarByExternalId(int externalId) const = 0;
     
+    /**
+     * @brief Highest bar external ID stored since the last clear.
+     * @return Highest external ID seen, or 0 if none
+     * @see maxNodeExternalId
+     */
+    virtual int maxBarExternalId() const = 0;
+    
     /**
      * @brief Get all bars in the repository.
      * @return Vector of all bars
      */
     virtual std::vector<Bar> allBars() const = 0;
     
+    /**
+     * @brief View of all bars without copying.
+     * @return Contiguous view, invalidated by any repository mutation
+     */
+    virtual EntityView<Bar> bars() const = 0;
+    
+    /**
+     * @brief Visit every bar in storage order without copying.
+     * @param visit Callback invoked once per bar
+     */
+    void forEachBar(const std::function<void(const Bar &)> &visit) const
+    {
+        for (const Bar &item : bars()) {
+            visit(item);
+        }
+    }
+    
     /**
      * @brief Get the count of bars.
      * @return Number of bars
      */
     virtual size_t barCount() const = 0;
     
+    /**
+     * @brief Resolve a bar UUID to its runtime handle.
+     * @param id The persistent UUID
+     * @return Handle of the bar, or an invalid handle if not found
+     */
+    virtual BarHandle barHandle(const QUuid &id) const = 0;
+    
+    /**
+     * @brief Handle of the bar stored at a dense position.
+     * @param index Position in bars(), must be < barCount()
+     */
+    virtual BarHandle barHandleAt(size_t index) const = 0;
+    
+    /**
+     * @brief Resolve a bar handle (array indexing, no hashing).
+     * @param handle Handle previously obtained from this repository
+     * @return Pointer to the bar, or nullptr if the handle is stale.
+     *         Invalidated by any repository mutation.
+     */
+    virtual const Bar *bar(BarHandle handle) const = 0;
+    
+    /**
+     * @brief Handles of a bar's start and end nodes.
+     * 
+     * Kept resolved as nodes come and go, so following a bar to its nodes
+     * needs no UUID lookups. An end whose node is not in the repository has
+     * an invalid or stale handle (node() returns nullptr for it).
+     * @param handle The bar
+     * @return {start, end}; both invalid if @p handle is stale
+     */
+    virtual std::array<NodeHandle, 2> barEndNodes(BarHandle handle) const = 0;
+
+    /**
+     * @brief K-point orienting a bar's local axes.
+     *
+     * Few bars have one, so K-points are kept in a sparse table beside the
+     * bars rather than in Bar itself.
+     * @param handle The bar
+     * @return Pointer to the K-point, or nullptr if the bar has none or
+     *         @p handle is stale. Invalidated by any repository mutation.
+     */
+    virtual const Vector3 *barKPoint(BarHandle handle) const = 0;
+
+    /**
+     * @brief Set or clear a bar's K-point and mark its local axes dirty.
+     * @param id UUID of the bar
+     * @param kPoint New K-point, or std::nullopt to clear it
+     * @return true if the bar was found
+     */
+    virtual bool setBarKPoint(const QUuid &id, const std::optional<Vector3> &kPoint) = 0;
+
+    /**
+     * @brief Material of every bar as a dense index into materials().
+     *
+     * Parallel to bars(): entry i is the position of bars()[i]'s material in
+     * materials(), or -1 if the bar has none or it is not in the repository.
+     * Kept resolved as bars and materials come and go, so per-bar property
+     * access (stiffness assembly, colouring by material) is an array load
+     * instead of a UUID lookup.
+     * @return Pointer to barCount() indices, invalidated by any mutation
+     */
+    virtual const std::int32_t *barMaterialIndices() const = 0;
+
+    /**
+     * @brief Section of every bar as a dense index into sections().
+     * @return Pointer to barCount() indices, invalidated by any mutation
+     * @see barMaterialIndices
+     */
+    virtual const std::int32_t *barSectionIndices() const = 0;
+
     /**
      * @brief Clear all bars from the repository.
      */
@@ -143,6 +499,17 @@ public:
      * @return Vector of bars connected to the node
      */
     virtual std::vector<Bar> findBarsConnectedToNode(const QUuid &nodeId) const = 0;
+    
+    /**
+     * @brief View of the bars connected to a node, without copying.
+     * 
+     * Served from an incrementally maintained adjacency index, so the cost
+     * is proportional to the node's valence, not to the total bar count.
+     * The view is invalidated by any repository mutation.
+     * @param nodeId The UUID of the node
+     * @return Range over the connected bars (empty if none)
+     */
+    virtual IndexedRange<Bar> barsAtNode(const QUuid &nodeId) const = 0;
 
     // ===== Material Operations =====
     
@@ -174,12 +541,45 @@ public:
      */
     virtual std::optional<Material> findMaterial(const QUuid &id) const = 0;
     
+    /**
+     * @brief Find a material by its UUID without copying it.
+     * @param id The UUID to search for
+     * @return Pointer to the stored material, or nullptr if not found. Invalidated
+     *         by any repository mutation.
+     */
+    virtual const Material *findMaterialPtr(const QUuid &id) const = 0;
+
+    /**
+     * @brief Dense position of a material in materials().
+     * @param id The UUID to search for
+     * @return Index into materials(), or -1 if not found. Invalidated by
+     *         material removals.
+     */
+    virtual int materialIndex(const QUuid &id) const = 0;
+
     /**
      * @brief Get all materials in the repository.
      * @return Vector of all materials
      */
     virtual std::vector<Material> allMaterials() const = 0;
     
+    /**
+     * @brief View of all materials without copying.
+     * @return Contiguous view, invalidated by any repository mutation
+     */
+    virtual EntityView<Material> materials() const = 0;
+    
+    /**
+     * @brief Visit every material in storage order without copying.
+     * @param visit Callback invoked once per material
+     */
+    void forEachMaterial(const std::function<void(const Material &)> &visit) const
+    {
+        for (const Material &item : materials()) {
+            visit(item);
+        }
+    }
+    
     /**
      * @brief Get the count of materials.
      * @return Number of materials
@@ -221,12 +621,45 @@ public:
      */
     virtual std::optional<Section> findSection(const QUuid &id) const = 0;
     
+    /**
+     * @brief Find a section by its UUID without copying it.
+     * @param id The UUID to search for
+     * @return Pointer to the stored section, or nullptr if not found. Invalidated
+     *         by any repository mutation.
+     */
+    virtual const Section *findSectionPtr(const QUuid &id) const = 0;
+
+    /**
+     * @brief Dense position of a section in sections().
+     * @param id The UUID to search for
+     * @return Index into sections(), or -1 if not found. Invalidated by
+     *         section removals.
+     */
+    virtual int sectionIndex(const QUuid &id) const = 0;
+
     /**
      * @brief Get all sections in the repository.
      * @return Vector of all sections
      */
     virtual std::vector<Section> allSections() const = 0;
     
+    /**
+     * @brief View of all sections without copying.
+     * @return Contiguous view, invalidated by any repository mutation
+     */
+    virtual EntityView<Section> sections() const = 0;
+    
+    /**
+     * @brief Visit every section in storage order without copying.
+     * @param visit Callback invoked once per section
+     */
+    void forEachSection(const std::function<void(const Section &)> &visit) const
+    {
+        for (const Section &item : sections()) {
+            visit(item);
+        }
+    }
+    
     /**
      * @brief Get the count of sections.
      * @return Number of sections
@@ -268,12 +701,37 @@ public:
      */
     virtual std::optional<GridLine> findGridLine(const QUuid &id) const = 0;
     
+    /**
+     * @brief Find a grid line by its UUID without copying it.
+     * @param id The UUID to search for
+     * @return Pointer to the stored grid line, or nullptr if not found. Invalidated
+     *         by any repository mutation.
+     */
+    virtual const GridLine *findGridLinePtr(const QUuid &id) const = 0;
+    
     /**
      * @brief Get all grid lines in the repository.
      * @return Vector of all grid lines
      */
     virtual std::vector<GridLine> allGridLines() const = 0;
     
+    /**
+     * @brief View of all grid lines without copying.
+     * @return Contiguous view, invalidated by any repository mutation
+     */
+    virtual EntityView<GridLine> gridLines() const = 0;
+    
+    /**
+     * @brief Visit every grid line in storage order without copying.
+     * @param visit Callback invoked once per grid line
+     */
+    void forEachGridLine(const std::function<void(const GridLine &)> &visit) const
+    {
+        for (const GridLine &item : gridLines()) {
+            visit(item);
+        }
+    }
+    
     /**
      * @brief Get the count of grid lines.
      * @return Number of grid lines
@@ -285,6 +743,157 @@ public:
      */
     virtual void clearGridLines() = 0;
 
+    // ===== Load Case Operations =====
+    
+    /**
+     * @brief Add a new load case.
+     * @param loadCase The load case to add
+     * @return true if successful, false if a load case with same ID already exists
+     */
+    virtual bool addLoadCase(const LoadCase &loadCase) = 0;
+    
+    /**
+     * @brief Remove a load case together with all of its loads.
+     * @param id The UUID of the load case to remove
+     * @return true if the load case was found and removed
+     */
+    virtual bool removeLoadCase(const QUuid &id) = 0;
+    
+    /**
+     * @brief Update an existing load case.
+     * @param loadCase The load case with updated data
+     * @return true if the load case was found and updated
+     */
+    virtual bool updateLoadCase(const LoadCase &loadCase) = 0;
+    
+    /**
+     * @brief Find a load case by its UUID without copying it.
+     * @param id The UUID to search for
+     * @return Pointer to the stored load case, or nullptr if not found.
+     *         Invalidated by any repository mutation.
+     */
+    virtual const LoadCase *findLoadCasePtr(const QUuid &id) const = 0;
+    
+    /**
+     * @brief View of all load cases without copying.
+     * @return Contiguous view, invalidated by any repository mutation
+     */
+    virtual EntityView<LoadCase> loadCases() const = 0;
+    
+    /**
+     * @brief Get the count of load cases.
+     * @return Number of load cases
+     */
+    virtual size_t loadCaseCount() const = 0;
+    
+    /**
+     * @brief Clear all load cases and all loads.
+     */
+    virtual void clearLoadCases() = 0;
+
+    // ===== Load Operations =====
+    // Loads are stored densely per kind and indexed both by load case and by
+    // the node/bar they act on, so iterating one case costs O(loads in case)
+    // and counting the loads on one node or bar is O(1).
+    
+    /**
+     * @brief Add a nodal load.
+     * @param load The load to add; its load case must exist
+     * @return true if successful, false if the ID exists or the case does not
+     */
+    virtual bool addNodalLoad(const NodalLoad &load) = 0;
+    
+    /**
+     * @brief Remove a nodal load by ID.
+     * @param id The UUID of the load to remove
+     * @return true if the load was found and removed
+     */
+    virtual bool removeNodalLoad(const QUuid &id) = 0;
+    
+    /**
+     * @brief Update an existing nodal load (possibly moving it to another case or node).
+     * @param load The load with updated data; its load case must exist
+     * @return true if the load was found and updated
+     */
+    virtual bool updateNodalLoad(const NodalLoad &load) = 0;
+    
+    /**
+     * @brief Find a nodal load by its UUID without copying it.
+     * @param id The UUID to search for
+     * @return Pointer to the stored load, or nullptr if not found.
+     *         Invalidated by any repository mutation.
+     */
+    virtual const NodalLoad *findNodalLoadPtr(const QUuid &id) const = 0;
+    
+    /**
+     * @brief View of all nodal loads without copying.
+     * @return Contiguous view, invalidated by any repository mutation
+     */
+    virtual EntityView<NodalLoad> nodalLoads() const = 0;
+    
+    /**
+     * @brief View of the nodal loads of one load case.
+     * @param loadCaseId The UUID of the load case
+     * @return Range over the case's nodal loads (empty if none)
+     */
+    virtual IndexedRange<NodalLoad> nodalLoadsInCase(const QUuid &loadCaseId) const = 0;
+    
+    /**
+     * @brief View of the nodal loads acting on a node, across all cases.
+     * @param nodeId The UUID of the node
+     * @return Range over the node's loads (empty if none)
+     */
+    virtual IndexedRange<NodalLoad> nodalLoadsAtNode(const QUuid &nodeId) const = 0;
+    
+    /**
+     * @brief Add a member load.
+     * @param load The load to add; its load case must exist
+     * @return true if successful, false if the ID exists or the case does not
+     */
+    virtual bool addMemberLoad(const MemberLoad &load) = 0;
+    
+    /**
+     * @brief Remove a member load by ID.
+     * @param id The UUID of the load to remove
+     * @return true if the load was found and removed
+     */
+    virtual bool removeMemberLoad(const QUuid &id) = 0;
+    
+    /**
+     * @brief Update an existing member load (possibly moving it to another case or bar).
+     * @param load The load with updated data; its load case must exist
+     * @return true if the load was found and updated
+     */
+    virtual bool updateMemberLoad(const MemberLoad &load) = 0;
+    
+    /**
+     * @brief Find a member load by its UUID without copying it.
+     * @param id The UUID to search for
+     * @return Pointer to the stored load, or nullptr if not found.
+     *         Invalidated by any repository mutation.
+     */
+    virtual const MemberLoad *findMemberLoadPtr(const QUuid &id) const = 0;
+    
+    /**
+     * @brief View of all member loads without copying.
+     * @return Contiguous view, invalidated by any repository mutation
+     */
+    virtual EntityView<MemberLoad> memberLoads() const = 0;
+    
+    /**
+     * @brief View of the member loads of one load case.
+     * @param loadCaseId The UUID of the load case
+     * @return Range over the case's member loads (empty if none)
+     */
+    virtual IndexedRange<MemberLoad> memberLoadsInCase(const QUuid &loadCaseId) const = 0;
+    
+    /**
+     * @brief View of the member loads acting on a bar, across all cases.
+     * @param barId The UUID of the bar
+     * @return Range over the bar's loads (empty if none)
+     */
+    virtual IndexedRange<MemberLoad> memberLoadsOnBar(const QUuid &barId) const = 0;
+
     // ===== Bulk Operations =====
     
     /**
@@ -297,6 +906,42 @@ public:
      * @return true if no entities exist
      */
     virtual bool isEmpty() const = 0;
+    
+    /**
+     * @brief Publish an immutable version of the current model.
+     * 
+     * The returned version shares unchanged entity chunks with earlier ones,
+     * so the cost is proportional to what changed since the last call, and
+     * repeated calls without mutations return the same version. Must be
+     * called from the thread that mutates the repository (or through a
+     * ConcurrentModelRepository); the version itself may then be handed to
+     * and read from any thread.
+     * @return Shared immutable model version
+     */
+    virtual std::shared_ptr<const ModelVersion> snapshot() const = 0;
+    
+    // ===== Change Tracking =====
+    
+    /**
+     * @brief Version of the most recent mutation.
+     * 
+     * Incremental consumers (renderer, analysis cache, export) remember this
+     * after synchronising and later pass it to changesSince().
+     * @return Monotonically increasing change version
+     */
+    virtual std::uint64_t changeVersion() const = 0;
+    
+    /**
+     * @brief Collect the entities changed after @p version.
+     * 
+     * One entry per entity, with the ChangeField bits of everything that
+     * changed since then. Clears, or falling behind the retained history,
+     * make this return false; the consumer must then re-read the whole model.
+     * @param version Version previously obtained from changeVersion()
+     * @param changes Receives the coalesced changes
+     * @return false if a full re-read is required
+     */
+    virtual bool changesSince(std::uint64_t version, std::vector<ModelChange> &changes) const = 0;
 };
 
 } // namespace Structura::App
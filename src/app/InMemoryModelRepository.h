@@ -1,8 +1,11 @@
 #pragma once
 
 #include "IModelRepository.h"
+#include "NodeSpatialIndex.h"
 #include <QHash>
 #include <algorithm>
+#include <cstdint>
+#include <numeric>
 
 namespace Structura::App {
 
@@ -10,9 +13,12 @@ namespace Structura::App {
  * @brief In-memory implementation of IModelRepository.
  * 
  * This implementation stores all entities in memory using QHash for fast lookup
- * and std::vector for ordered iteration. This is suitable for desktop applications
+ * and std::vector for dense iteration. This is suitable for desktop applications
  * with models that fit in memory.
  * 
+ * Single removals swap the last entity into the freed slot (O(1)), so they do
+ * not preserve iteration order; bulk removals compact in one order-preserving pass.
+ * 
  * Thread safety: This implementation is NOT thread-safe. External synchronization
  * is required if accessed from multiple threads.
  */
@@ -38,24 +44,68 @@ public:
             return false;
         }
         m_nodes.push_back(node);
-        m_nodeById[node.id()] = static_cast<int>(m_nodes.size() - 1);
+        m_nodeCoordinates.insert(m_nodeCoordinates.end(), {node.x(), node.y(), node.z()});
+        m_nodeSlots.acquire();
+        const int index = static_cast<int>(m_nodes.size() - 1);
+        m_nodeIndex.insert(index, m_nodeCoordinates.data() + 3 * static_cast<size_t>(index));
+        markDirty(m_nodeDirtyChunks, index);
+        m_nodeById[node.id()] = index;
+        m_nodeByExternalId.insert(node.externalId(), index);
+        m_maxNodeExternalId = std::max(m_maxNodeExternalId, node.externalId());
+        m_supportSlot.push_back(-1);
+        setSupported(index, node.hasRestraints());
+        m_journal.record(EntityKind::Node, node.id(), m_nodeSlots.handleAt<Node>(static_cast<size_t>(index)),
+                         ChangeField::Created);
+        
+        // Bars added before this node referenced it by UUID only
+        const auto waiting = m_barsByNode.constFind(node.id());
+        if (waiting != m_barsByNode.constEnd()) {
+            for (int barIndex : waiting.value()) {
+                resolveBarEndNodes(barIndex);
+            }
+        }
         return true;
     }
     
+    void reserveNodes(size_t count) override
+    {
+        m_nodes.reserve(count);
+        m_nodeCoordinates.reserve(3 * count);
+        m_supportSlot.reserve(count);
+        m_nodeSlots.reserve(count);
+        m_nodeIndex.reserve(count);
+        reserveHash(m_nodeById, count);
+        reserveHash(m_nodeByExternalId, count);
+    }
+    
     bool removeNode(const QUuid &id) override
     {
         if (!m_nodeById.contains(id)) {
             return false;
         }
         
-        int index = m_nodeById[id];
-        m_nodes.erase(m_nodes.begin() + index);
-        
-        // Rebuild index map
-        rebuildNodeIndex();
+        removeAt(m_nodes, m_nodeById, m_nodeById[id], [this](const Node &node, int from, int to) {
+            relocateNode(node, from, to);
+        });
+        m_nodeCoordinates.resize(3 * m_nodes.size());
+        m_nodeSlots.truncate(m_nodes.size());
+        m_nodeIndex.truncate(m_nodes.size());
+        m_supportSlot.resize(m_nodes.size());
         return true;
     }
     
+    size_t removeNodes(const std::vector<QUuid> &ids) override
+    {
+        const size_t removed = removeMany(m_nodes, m_nodeById, ids, [this](const Node &node, int from, int to) {
+            relocateNode(node, from, to);
+        });
+        m_nodeCoordinates.resize(3 * m_nodes.size());
+        m_nodeSlots.truncate(m_nodes.size());
+        m_nodeIndex.truncate(m_nodes.size());
+        m_supportSlot.resize(m_nodes.size());
+        return removed;
+    }
+    
     bool updateNode(const Node &node) override
     {
         if (!m_nodeById.contains(node.id())) {
@@ -63,7 +113,15 @@ public:
         }
         
         int index = m_nodeById[node.id()];
+        recordUpdate(EntityKind::Node, node.id(), m_nodeSlots.handleAt<Node>(static_cast<size_t>(index)),
+                     nodeChangeFields(m_nodes[index], node));
+        relinkExternalId(m_nodeByExternalId, m_nodes[index].externalId(), node.externalId(), index);
+        m_maxNodeExternalId = std::max(m_maxNodeExternalId, node.externalId());
         m_nodes[index] = node;
+        setSupported(index, node.hasRestraints());
+        writeNodeCoordinates(index, node);
+        m_nodeIndex.update(index, m_nodeCoordinates.data() + 3 * static_cast<size_t>(index));
+        markDirty(m_nodeDirtyChunks, index);
         return true;
     }
     
@@ -79,13 +137,17 @@ public:
     
     std::optional<Node> findNodeByExternalId(int externalId) const override
     {
-        auto it = std::find_if(m_nodes.begin(), m_nodes.end(),
-            [externalId](const Node &n) { return n.externalId() == externalId; });
-        
-        if (it != m_nodes.end()) {
-            return *it;
+        const int index = m_nodeByExternalId.value(externalId, -1);
+        if (index < 0) {
+            return std::nullopt;
         }
-        return std::nullopt;
+        return m_nodes[index];
+    }
+    
+    const Node *findNodePtr(const QUuid &id) const override
+    {
+        const int index = m_nodeById.value(id, -1);
+        return index < 0 ? nullptr : &m_nodes[static_cast<size_t>(index)];
     }
     
     std::vector<Node> allNodes() const override
@@ -93,15 +155,93 @@ public:
         return m_nodes;
     }
     
+    EntityView<Node> nodes() const override
+    {
+        return EntityView<Node>(m_nodes.data(), m_nodes.size());
+    }
+    
     size_t nodeCount() const override
     {
         return m_nodes.size();
     }
     
+    const double *nodeCoordinates() const override
+    {
+        return m_nodeCoordinates.data();
+    }
+    
+    NodeHandle nodeHandle(const QUuid &id) const override
+    {
+        const int index = m_nodeById.value(id, -1);
+        return index < 0 ? NodeHandle() : m_nodeSlots.handleAt<Node>(static_cast<size_t>(index));
+    }
+    
+    NodeHandle nodeHandleAt(size_t index) const override
+    {
+        return m_nodeSlots.handleAt<Node>(index);
+    }
+    
+    const Node *node(NodeHandle handle) const override
+    {
+        const int index = m_nodeSlots.indexOf(handle);
+        return index < 0 ? nullptr : &m_nodes[static_cast<size_t>(index)];
+    }
+    
+    IndexedRange<Node> supportedNodes() const override
+    {
+        return IndexedRange<Node>(m_nodes.data(), m_supportedNodes.data(),
+                                  m_supportedNodes.data() + m_supportedNodes.size());
+    }
+    
+    int maxNodeExternalId() const override
+    {
+        return m_maxNodeExternalId;
+    }
+    
+    std::vector<size_t> nodesWithinRadius(const Vector3 &center, double radius) const override
+    {
+        std::vector<size_t> indices;
+        const double c[3] = {center.x(), center.y(), center.z()};
+        m_nodeIndex.withinRadius(c, radius, indices);
+        return indices;
+    }
+    
+    std::vector<size_t> nodesInBox(const Vector3 &minCorner, const Vector3 &maxCorner) const override
+    {
+        std::vector<size_t> indices;
+        const double lo[3] = {minCorner.x(), minCorner.y(), minCorner.z()};
+        const double hi[3] = {maxCorner.x(), maxCorner.y(), maxCorner.z()};
+        m_nodeIndex.inBox(lo, hi, indices);
+        return indices;
+    }
+    
+    const Node *nearestNode(const Vector3 &point,
+                            double maxDistance = std::numeric_limits<double>::infinity()) const override
+    {
+        const double p[3] = {point.x(), point.y(), point.z()};
+        const int index = m_nodeIndex.nearest(p, maxDistance);
+        return index < 0 ? nullptr : &m_nodes[static_cast<size_t>(index)];
+    }
+    
+    /// Edge length of the spatial hash cells (model units), best at one to two
+    /// typical node spacings; re-buckets all nodes
+    void setNodeIndexCellSize(double cellSize)
+    {
+        m_nodeIndex.rebuild(cellSize, m_nodeCoordinates.data(), m_nodes.size());
+    }
+    
     void clearNodes() override
     {
         m_nodes.clear();
+        m_nodeCoordinates.clear();
+        m_nodeSlots.clear();
+        m_nodeIndex.clear();
+        m_supportedNodes.clear();
+        m_supportSlot.clear();
         m_nodeById.clear();
+        m_nodeByExternalId.clear();
+        m_maxNodeExternalId = 0;
+        m_journal.reset();
     }
 
     // ===== Bar Operations =====
@@ -112,32 +252,86 @@ public:
             return false;
         }
         m_bars.push_back(bar);
-        m_barById[bar.id()] = static_cast<int>(m_bars.size() - 1);
+        m_barEndNodes.emplace_back();
+        m_barMaterialIndices.push_back(m_materialById.value(bar.materialId(), -1));
+        m_barSectionIndices.push_back(m_sectionById.value(bar.sectionId(), -1));
+        m_barSlots.acquire();
+        const int index = static_cast<int>(m_bars.size() - 1);
+        markDirty(m_barDirtyChunks, index);
+        m_barById[bar.id()] = index;
+        m_barByExternalId.insert(bar.externalId(), index);
+        linkBarToNodes(bar, index);
+        resolveBarEndNodes(index);
+        m_maxBarExternalId = std::max(m_maxBarExternalId, bar.externalId());
+        m_journal.record(EntityKind::Bar, bar.id(), m_barSlots.handleAt<Bar>(static_cast<size_t>(index)),
+                         ChangeField::Created);
         return true;
     }
     
+    void reserveBars(size_t count) override
+    {
+        m_bars.reserve(count);
+        m_barEndNodes.reserve(count);
+        m_barMaterialIndices.reserve(count);
+        m_barSectionIndices.reserve(count);
+        m_barSlots.reserve(count);
+        reserveHash(m_barById, count);
+        reserveHash(m_barByExternalId, count);
+    }
+    
     bool removeBar(const QUuid &id) override
     {
         if (!m_barById.contains(id)) {
             return false;
         }
         
-        int index = m_barById[id];
-        m_bars.erase(m_bars.begin() + index);
-        
-        // Rebuild index map
-        rebuildBarIndex();
+        removeAt(m_bars, m_barById, m_barById[id], [this](const Bar &bar, int from, int to) {
+            relocateBar(bar, from, to);
+        });
+        m_barEndNodes.resize(m_bars.size());
+        m_barMaterialIndices.resize(m_bars.size());
+        m_barSectionIndices.resize(m_bars.size());
+        m_barSlots.truncate(m_bars.size());
         return true;
     }
     
+    size_t removeBars(const std::vector<QUuid> &ids) override
+    {
+        const size_t removed = removeMany(m_bars, m_barById, ids, [this](const Bar &bar, int from, int to) {
+            relocateBar(bar, from, to);
+        });
+        m_barEndNodes.resize(m_bars.size());
+        m_barMaterialIndices.resize(m_bars.size());
+        m_barSectionIndices.resize(m_bars.size());
+        m_barSlots.truncate(m_bars.size());
+        return removed;
+    }
+    
     bool updateBar(const Bar &bar) override
     {
-        if (!m_barById.contains(bar.id())) {
+        const int index = m_barById.value(bar.id(), -1);
+        if (index < 0) {
             return false;
         }
         
-        int index = m_barById[bar.id()];
+        const Bar &previous = m_bars[index];
+        recordUpdate(EntityKind::Bar, bar.id(), m_barSlots.handleAt<Bar>(static_cast<size_t>(index)),
+                     barChangeFields(previous, bar));
+        relinkExternalId(m_barByExternalId, previous.externalId(), bar.externalId(), index);
+        const bool reconnected = previous.startNodeId() != bar.startNodeId() ||
+                                 previous.endNodeId() != bar.endNodeId();
+        if (reconnected) {
+            unlinkBarFromNodes(previous, index);
+            linkBarToNodes(bar, index);
+        }
+        m_maxBarExternalId = std::max(m_maxBarExternalId, bar.externalId());
         m_bars[index] = bar;
+        if (reconnected) {
+            resolveBarEndNodes(index);
+        }
+        m_barMaterialIndices[static_cast<size_t>(index)] = m_materialById.value(bar.materialId(), -1);
+        m_barSectionIndices[static_cast<size_t>(index)] = m_sectionById.value(bar.sectionId(), -1);
+        markDirty(m_barDirtyChunks, index);
         return true;
     }
     
@@ -153,13 +347,17 @@ public:
     
     std::optional<Bar> findBarByExternalId(int externalId) const override
     {
-        auto it = std::find_if(m_bars.begin(), m_bars.end(),
-            [externalId](const Bar &b) { return b.externalId() == externalId; });
-        
-        if (it != m_bars.end()) {
-            return *it;
+        const int index = m_barByExternalId.value(externalId, -1);
+        if (index < 0) {
+            return std::nullopt;
         }
-        return std::nullopt;
+        return m_bars[index];
+    }
+    
+    const Bar *findBarPtr(const QUuid &id) const override
+    {
+        const int index = m_barById.value(id, -1);
+        return index < 0 ? nullptr : &m_bars[static_cast<size_t>(index)];
     }
     
     std::vector<Bar> allBars() const override
@@ -167,25 +365,117 @@ public:
         return m_bars;
     }
     
+    EntityView<Bar> bars() const override
+    {
+        return EntityView<Bar>(m_bars.data(), m_bars.size());
+    }
+    
     size_t barCount() const override
     {
         return m_bars.size();
     }
     
+    int maxBarExternalId() const override
+    {
+        return m_maxBarExternalId;
+    }
+    
     void clearBars() override
     {
         m_bars.clear();
+        m_barEndNodes.clear();
+        m_barMaterialIndices.clear();
+        m_barSectionIndices.clear();
+        m_barKPoints.clear();
+        m_barSlots.clear();
         m_barById.clear();
+        m_barByExternalId.clear();
+        m_barsByNode.clear();
+        m_maxBarExternalId = 0;
+        m_journal.reset();
+    }
+    
+    BarHandle barHandle(const QUuid &id) const override
+    {
+        const int index = m_barById.value(id, -1);
+        return index < 0 ? BarHandle() : m_barSlots.handleAt<Bar>(static_cast<size_t>(index));
+    }
+    
+    BarHandle barHandleAt(size_t index) const override
+    {
+        return m_barSlots.handleAt<Bar>(index);
+    }
+    
+    const Bar *bar(BarHandle handle) const override
+    {
+        const int index = m_barSlots.indexOf(handle);
+        return index < 0 ? nullptr : &m_bars[static_cast<size_t>(index)];
+    }
+    
+    std::array<NodeHandle, 2> barEndNodes(BarHandle handle) const override
+    {
+        const int index = m_barSlots.indexOf(handle);
+        return index < 0 ? std::array<NodeHandle, 2>{} : m_barEndNodes[static_cast<size_t>(index)];
+    }
+
+    const Vector3 *barKPoint(BarHandle handle) const override
+    {
+        const int index = m_barSlots.indexOf(handle);
+        if (index < 0) {
+            return nullptr;
+        }
+        const auto it = m_barKPoints.constFind(index);
+        return it == m_barKPoints.constEnd() ? nullptr : &it.value();
+    }
+
+    bool setBarKPoint(const QUuid &id, const std::optional<Vector3> &kPoint) override
+    {
+        const int index = m_barById.value(id, -1);
+        if (index < 0) {
+            return false;
+        }
+
+        Bar &bar = m_bars[static_cast<size_t>(index)];
+        const auto it = m_barKPoints.constFind(index);
+        const bool had = it != m_barKPoints.constEnd();
+        std::uint32_t fields = 0;
+        if (had != kPoint.has_value() || (had && !(it.value() == *kPoint))) fields |= ChangeField::Orientation;
+        if (!bar.isLCSDirty()) fields |= ChangeField::Data;
+        recordUpdate(EntityKind::Bar, id, m_barSlots.handleAt<Bar>(static_cast<size_t>(index)), fields);
+        if (kPoint) {
+            m_barKPoints.insert(index, *kPoint);
+        } else {
+            m_barKPoints.remove(index);
+        }
+        bar.setLCSDirty(true);
+        markDirty(m_barDirtyChunks, index);
+        return true;
+    }
+    
+    const std::int32_t *barMaterialIndices() const override
+    {
+        return m_barMaterialIndices.data();
+    }
+    
+    const std::int32_t *barSectionIndices() const override
+    {
+        return m_barSectionIndices.data();
     }
     
     std::vector<Bar> findBarsConnectedToNode(const QUuid &nodeId) const override
     {
-        std::vector<Bar> result;
-        std::copy_if(m_bars.begin(), m_bars.end(), std::back_inserter(result),
-            [&nodeId](const Bar &bar) {
-                return bar.startNodeId() == nodeId || bar.endNodeId() == nodeId;
-            });
-        return result;
+        const auto connected = barsAtNode(nodeId);
+        return std::vector<Bar>(connected.begin(), connected.end());
+    }
+    
+    IndexedRange<Bar> barsAtNode(const QUuid &nodeId) const override
+    {
+        const auto it = m_barsByNode.constFind(nodeId);
+        if (it == m_barsByNode.constEnd()) {
+            return {};
+        }
+        const std::vector<int> &indices = it.value();
+        return IndexedRange<Bar>(m_bars.data(), indices.data(), indices.data() + indices.size());
     }
 
     // ===== Material Operations =====
@@ -197,6 +487,9 @@ public:
         }
         m_materials.push_back(material);
         m_materialById[material.id()] = static_cast<int>(m_materials.size() - 1);
+        markDirty(m_materialDirtyChunks, static_cast<int>(m_materials.size() - 1));
+        resolveBarProperty(m_barMaterialIndices, m_materials.size() - 1, material.id(), &Bar::materialId);
+        m_journal.record(EntityKind::Material, material.id(), ChangeField::Created);
         return true;
     }
     
@@ -206,11 +499,16 @@ public:
             return false;
         }
         
-        int index = m_materialById[id];
-        m_materials.erase(m_materials.begin() + index);
-        
-        // Rebuild index map
-        rebuildMaterialIndex();
+        std::vector<std::int32_t> remap(m_materials.size());
+        std::iota(remap.begin(), remap.end(), 0);
+        removeAt(m_materials, m_materialById, m_materialById[id], [this, &remap](const Material &material, int from, int to) {
+            markDirty(m_materialDirtyChunks, to >= 0 ? to : from);
+            remap[static_cast<size_t>(from)] = to;
+            if (to < 0) {
+                m_journal.record(EntityKind::Material, material.id(), ChangeField::Removed);
+            }
+        });
+        remapBarProperty(m_barMaterialIndices, remap);
         return true;
     }
     
@@ -221,7 +519,9 @@ public:
         }
         
         int index = m_materialById[material.id()];
+        m_journal.record(EntityKind::Material, material.id(), ChangeField::Data);
         m_materials[index] = material;
+        markDirty(m_materialDirtyChunks, index);
         return true;
     }
     
@@ -235,11 +535,27 @@ public:
         return m_materials[index];
     }
     
+    const Material *findMaterialPtr(const QUuid &id) const override
+    {
+        const int index = m_materialById.value(id, -1);
+        return index < 0 ? nullptr : &m_materials[static_cast<size_t>(index)];
+    }
+    
+    int materialIndex(const QUuid &id) const override
+    {
+        return m_materialById.value(id, -1);
+    }
+    
     std::vector<Material> allMaterials() const override
     {
         return m_materials;
     }
     
+    EntityView<Material> materials() const override
+    {
+        return EntityView<Material>(m_materials.data(), m_materials.size());
+    }
+    
     size_t materialCount() const override
     {
         return m_materials.size();
@@ -249,6 +565,8 @@ public:
     {
         m_materials.clear();
         m_materialById.clear();
+        remapBarProperty(m_barMaterialIndices, {});
+        m_journal.reset();
     }
 
     // ===== Section Operations =====
@@ -260,6 +578,9 @@ public:
         }
         m_sections.push_back(section);
         m_sectionById[section.id()] = static_cast<int>(m_sections.size() - 1);
+        markDirty(m_sectionDirtyChunks, static_cast<int>(m_sections.size() - 1));
+        resolveBarProperty(m_barSectionIndices, m_sections.size() - 1, section.id(), &Bar::sectionId);
+        m_journal.record(EntityKind::Section, section.id(), ChangeField::Created);
         return true;
     }
     
@@ -269,11 +590,16 @@ public:
             return false;
         }
         
-        int index = m_sectionById[id];
-        m_sections.erase(m_sections.begin() + index);
-        
-        // Rebuild index map
-        rebuildSectionIndex();
+        std::vector<std::int32_t> remap(m_sections.size());
+        std::iota(remap.begin(), remap.end(), 0);
+        removeAt(m_sections, m_sectionById, m_sectionById[id], [this, &remap](const Section &section, int from, int to) {
+            markDirty(m_sectionDirtyChunks, to >= 0 ? to : from);
+            remap[static_cast<size_t>(from)] = to;
+            if (to < 0) {
+                m_journal.record(EntityKind::Section, section.id(), ChangeField::Removed);
+            }
+        });
+        remapBarProperty(m_barSectionIndices, remap);
         return true;
     }
     
@@ -284,7 +610,9 @@ public:
         }
         
         int index = m_sectionById[section.id()];
+        m_journal.record(EntityKind::Section, section.id(), ChangeField::Data);
         m_sections[index] = section;
+        markDirty(m_sectionDirtyChunks, index);
         return true;
     }
     
@@ -298,11 +626,27 @@ public:
         return m_sections[index];
     }
     
+    const Section *findSectionPtr(const QUuid &id) const override
+    {
+        const int index = m_sectionById.value(id, -1);
+        return index < 0 ? nullptr : &m_sections[static_cast<size_t>(index)];
+    }
+    
+    int sectionIndex(const QUuid &id) const override
+    {
+        return m_sectionById.value(id, -1);
+    }
+    
     std::vector<Section> allSections() const override
     {
         return m_sections;
     }
     
+    EntityView<Section> sections() const override
+    {
+        return EntityView<Section>(m_sections.data(), m_sections.size());
+    }
+    
     size_t sectionCount() const override
     {
         return m_sections.size();
@@ -312,6 +656,8 @@ public:
     {
         m_sections.clear();
         m_sectionById.clear();
+        remapBarProperty(m_barSectionIndices, {});
+        m_journal.reset();
     }
 
     // ===== GridLine Operations =====
@@ -323,6 +669,8 @@ public:
         }
         m_gridLines.push_back(gridLine);
         m_gridLineById[gridLine.id()] = static_cast<int>(m_gridLines.size() - 1);
+        markDirty(m_gridLineDirtyChunks, static_cast<int>(m_gridLines.size() - 1));
+        m_journal.record(EntityKind::GridLine, gridLine.id(), ChangeField::Created);
         return true;
     }
     
@@ -332,11 +680,12 @@ public:
             return false;
         }
         
-        int index = m_gridLineById[id];
-        m_gridLines.erase(m_gridLines.begin() + index);
-        
-        // Rebuild index map
-        rebuildGridLineIndex();
+        removeAt(m_gridLines, m_gridLineById, m_gridLineById[id], [this](const GridLine &gridLine, int from, int to) {
+            markDirty(m_gridLineDirtyChunks, to >= 0 ? to : from);
+            if (to < 0) {
+                m_journal.record(EntityKind::GridLine, gridLine.id(), ChangeField::Removed);
+            }
+        });
         return true;
     }
     
@@ -347,7 +696,9 @@ public:
         }
         
         int index = m_gridLineById[gridLine.id()];
+        m_journal.record(EntityKind::GridLine, gridLine.id(), ChangeField::Data);
         m_gridLines[index] = gridLine;
+        markDirty(m_gridLineDirtyChunks, index);
         return true;
     }
     
@@ -361,11 +712,22 @@ public:
         return m_gridLines[index];
     }
     
+    const GridLine *findGridLinePtr(const QUuid &id) const override
+    {
+        const int index = m_gridLineById.value(id, -1);
+        return index < 0 ? nullptr : &m_gridLines[static_cast<size_t>(index)];
+    }
+    
     std::vector<GridLine> allGridLines() const override
     {
         return m_gridLines;
     }
     
+    EntityView<GridLine> gridLines() const override
+    {
+        return EntityView<GridLine>(m_gridLines.data(), m_gridLines.size());
+    }
+    
     size_t gridLineCount() const override
     {
         return m_gridLines.size();
@@ -375,6 +737,233 @@ public:
     {
         m_gridLines.clear();
         m_gridLineById.clear();
+        m_journal.reset();
+    }
+
+    // ===== Load Case Operations =====
+    
+    bool addLoadCase(const LoadCase &loadCase) override
+    {
+        if (m_loadCaseById.contains(loadCase.id())) {
+            return false;
+        }
+        m_loadCases.push_back(loadCase);
+        m_loadCaseById[loadCase.id()] = static_cast<int>(m_loadCases.size() - 1);
+        markDirty(m_loadCaseDirtyChunks, static_cast<int>(m_loadCases.size() - 1));
+        m_journal.record(EntityKind::LoadCase, loadCase.id(), ChangeField::Created);
+        return true;
+    }
+    
+    bool removeLoadCase(const QUuid &id) override
+    {
+        if (!m_loadCaseById.contains(id)) {
+            return false;
+        }
+        
+        removeMany(m_nodalLoads, m_nodalLoadById, loadIdsInCase(m_nodalLoads, m_nodalLoadsByCase, id),
+                   [this](const NodalLoad &load, int from, int to) {
+                       relocateNodalLoad(load, from, to);
+                   });
+        truncateNodalLoadIndices();
+        removeMany(m_memberLoads, m_memberLoadById, loadIdsInCase(m_memberLoads, m_memberLoadsByCase, id),
+                   [this](const MemberLoad &load, int from, int to) {
+                       relocateMemberLoad(load, from, to);
+                   });
+        truncateMemberLoadIndices();
+        removeAt(m_loadCases, m_loadCaseById, m_loadCaseById[id], [this](const LoadCase &loadCase, int from, int to) {
+            markDirty(m_loadCaseDirtyChunks, to >= 0 ? to : from);
+            if (to < 0) {
+                m_journal.record(EntityKind::LoadCase, loadCase.id(), ChangeField::Removed);
+            }
+        });
+        return true;
+    }
+    
+    bool updateLoadCase(const LoadCase &loadCase) override
+    {
+        const int index = m_loadCaseById.value(loadCase.id(), -1);
+        if (index < 0) {
+            return false;
+        }
+        m_journal.record(EntityKind::LoadCase, loadCase.id(), ChangeField::Data);
+        m_loadCases[static_cast<size_t>(index)] = loadCase;
+        markDirty(m_loadCaseDirtyChunks, index);
+        return true;
+    }
+    
+    const LoadCase *findLoadCasePtr(const QUuid &id) const override
+    {
+        const int index = m_loadCaseById.value(id, -1);
+        return index < 0 ? nullptr : &m_loadCases[static_cast<size_t>(index)];
+    }
+    
+    EntityView<LoadCase> loadCases() const override
+    {
+        return EntityView<LoadCase>(m_loadCases.data(), m_loadCases.size());
+    }
+    
+    size_t loadCaseCount() const override
+    {
+        return m_loadCases.size();
+    }
+    
+    void clearLoadCases() override
+    {
+        m_loadCases.clear();
+        m_loadCaseById.clear();
+        m_nodalLoads.clear();
+        m_nodalLoadById.clear();
+        m_nodalLoadsByCase.clear();
+        m_nodalLoadsByNode.clear();
+        m_memberLoads.clear();
+        m_memberLoadById.clear();
+        m_memberLoadsByCase.clear();
+        m_memberLoadsByBar.clear();
+        m_journal.reset();
+    }
+
+    // ===== Load Operations =====
+    
+    bool addNodalLoad(const NodalLoad &load) override
+    {
+        if (m_nodalLoadById.contains(load.id()) || !m_loadCaseById.contains(load.loadCaseId())) {
+            return false;
+        }
+        m_nodalLoads.push_back(load);
+        const int index = static_cast<int>(m_nodalLoads.size() - 1);
+        m_nodalLoadById[load.id()] = index;
+        m_nodalLoadsByCase.insert(load.loadCaseId(), index);
+        m_nodalLoadsByNode.insert(load.nodeId(), index);
+        markDirty(m_nodalLoadDirtyChunks, index);
+        m_journal.record(EntityKind::NodalLoad, load.id(), ChangeField::Created);
+        return true;
+    }
+    
+    bool removeNodalLoad(const QUuid &id) override
+    {
+        if (!m_nodalLoadById.contains(id)) {
+            return false;
+        }
+        
+        removeAt(m_nodalLoads, m_nodalLoadById, m_nodalLoadById[id], [this](const NodalLoad &load, int from, int to) {
+            relocateNodalLoad(load, from, to);
+        });
+        truncateNodalLoadIndices();
+        return true;
+    }
+    
+    bool updateNodalLoad(const NodalLoad &load) override
+    {
+        const int index = m_nodalLoadById.value(load.id(), -1);
+        if (index < 0 || !m_loadCaseById.contains(load.loadCaseId())) {
+            return false;
+        }
+        
+        const NodalLoad &previous = m_nodalLoads[static_cast<size_t>(index)];
+        if (previous.loadCaseId() != load.loadCaseId()) {
+            m_nodalLoadsByCase.remove(previous.loadCaseId(), index);
+            m_nodalLoadsByCase.insert(load.loadCaseId(), index);
+        }
+        if (previous.nodeId() != load.nodeId()) {
+            m_nodalLoadsByNode.remove(previous.nodeId(), index);
+            m_nodalLoadsByNode.insert(load.nodeId(), index);
+        }
+        m_journal.record(EntityKind::NodalLoad, load.id(), ChangeField::Data);
+        m_nodalLoads[static_cast<size_t>(index)] = load;
+        markDirty(m_nodalLoadDirtyChunks, index);
+        return true;
+    }
+    
+    const NodalLoad *findNodalLoadPtr(const QUuid &id) const override
+    {
+        const int index = m_nodalLoadById.value(id, -1);
+        return index < 0 ? nullptr : &m_nodalLoads[static_cast<size_t>(index)];
+    }
+    
+    EntityView<NodalLoad> nodalLoads() const override
+    {
+        return EntityView<NodalLoad>(m_nodalLoads.data(), m_nodalLoads.size());
+    }
+    
+    IndexedRange<NodalLoad> nodalLoadsInCase(const QUuid &loadCaseId) const override
+    {
+        return m_nodalLoadsByCase.range(m_nodalLoads, loadCaseId);
+    }
+    
+    IndexedRange<NodalLoad> nodalLoadsAtNode(const QUuid &nodeId) const override
+    {
+        return m_nodalLoadsByNode.range(m_nodalLoads, nodeId);
+    }
+    
+    bool addMemberLoad(const MemberLoad &load) override
+    {
+        if (m_memberLoadById.contains(load.id()) || !m_loadCaseById.contains(load.loadCaseId())) {
+            return false;
+        }
+        m_memberLoads.push_back(load);
+        const int index = static_cast<int>(m_memberLoads.size() - 1);
+        m_memberLoadById[load.id()] = index;
+        m_memberLoadsByCase.insert(load.loadCaseId(), index);
+        m_memberLoadsByBar.insert(load.barId(), index);
+        markDirty(m_memberLoadDirtyChunks, index);
+        m_journal.record(EntityKind::MemberLoad, load.id(), ChangeField::Created);
+        return true;
+    }
+    
+    bool removeMemberLoad(const QUuid &id) override
+    {
+        if (!m_memberLoadById.contains(id)) {
+            return false;
+        }
+        
+        removeAt(m_memberLoads, m_memberLoadById, m_memberLoadById[id], [this](const MemberLoad &load, int from, int to) {
+            relocateMemberLoad(load, from, to);
+        });
+        truncateMemberLoadIndices();
+        return true;
+    }
+    
+    bool updateMemberLoad(const MemberLoad &load) override
+    {
+        const int index = m_memberLoadById.value(load.id(), -1);
+        if (index < 0 || !m_loadCaseById.contains(load.loadCaseId())) {
+            return false;
+        }
+        
+        const MemberLoad &previous = m_memberLoads[static_cast<size_t>(index)];
+        if (previous.loadCaseId() != load.loadCaseId()) {
+            m_memberLoadsByCase.remove(previous.loadCaseId(), index);
+            m_memberLoadsByCase.insert(load.loadCaseId(), index);
+        }
+        if (previous.barId() != load.barId()) {
+            m_memberLoadsByBar.remove(previous.barId(), index);
+            m_memberLoadsByBar.insert(load.barId(), index);
+        }
+        m_journal.record(EntityKind::MemberLoad, load.id(), ChangeField::Data);
+        m_memberLoads[static_cast<size_t>(index)] = load;
+        markDirty(m_memberLoadDirtyChunks, index);
+        return true;
+    }
+    
+    const MemberLoad *findMemberLoadPtr(const QUuid &id) const override
+    {
+        const int index = m_memberLoadById.value(id, -1);
+        return index < 0 ? nullptr : &m_memberLoads[static_cast<size_t>(index)];
+    }
+    
+    EntityView<MemberLoad> memberLoads() const override
+    {
+        return EntityView<MemberLoad>(m_memberLoads.data(), m_memberLoads.size());
+    }
+    
+    IndexedRange<MemberLoad> memberLoadsInCase(const QUuid &loadCaseId) const override
+    {
+        return m_memberLoadsByCase.range(m_memberLoads, loadCaseId);
+    }
+    
+    IndexedRange<MemberLoad> memberLoadsOnBar(const QUuid &barId) const override
+    {
+        return m_memberLoadsByBar.range(m_memberLoads, barId);
     }
 
     // ===== Bulk Operations =====
@@ -386,62 +975,688 @@ public:
         clearMaterials();
         clearSections();
         clearGridLines();
+        clearLoadCases();
     }
     
     bool isEmpty() const override
     {
         return m_nodes.empty() && m_bars.empty() && m_materials.empty() &&
-               m_sections.empty() && m_gridLines.empty();
+               m_sections.empty() && m_gridLines.empty() && m_loadCases.empty() &&
+               m_nodalLoads.empty() && m_memberLoads.empty();
+    }
+    
+    std::shared_ptr<const ModelVersion> snapshot() const override
+    {
+        const bool unchanged = m_snapshot &&
+            m_nodeDirtyChunks.empty() && m_barDirtyChunks.empty() &&
+            m_materialDirtyChunks.empty() && m_sectionDirtyChunks.empty() &&
+            m_gridLineDirtyChunks.empty() && m_loadCaseDirtyChunks.empty() &&
+            m_nodalLoadDirtyChunks.empty() && m_memberLoadDirtyChunks.empty() &&
+            m_snapshot->nodes.size() == m_nodes.size() &&
+            m_snapshot->bars.size() == m_bars.size() &&
+            m_snapshot->materials.size() == m_materials.size() &&
+            m_snapshot->sections.size() == m_sections.size() &&
+            m_snapshot->gridLines.size() == m_gridLines.size() &&
+            m_snapshot->loadCases.size() == m_loadCases.size() &&
+            m_snapshot->nodalLoads.size() == m_nodalLoads.size() &&
+            m_snapshot->memberLoads.size() == m_memberLoads.size();
+        if (unchanged) {
+            return m_snapshot;
+        }
+        
+        static const ModelVersion empty;
+        const ModelVersion &previous = m_snapshot ? *m_snapshot : empty;
+        auto next = std::make_shared<ModelVersion>();
+        next->number = previous.number + 1;
+        next->nodes = nextVersion(previous.nodes, m_nodes, m_nodeDirtyChunks);
+        next->nodeHandles = VersionedArray<NodeHandle>::build(
+            previous.nodeHandles, m_nodes.size(), m_nodeDirtyChunks,
+            [this](size_t i) { return m_nodeSlots.handleAt<Node>(i); });
+        next->bars = nextVersion(previous.bars, m_bars, m_barDirtyChunks);
+        next->barHandles = VersionedArray<BarHandle>::build(
+            previous.barHandles, m_bars.size(), m_barDirtyChunks,
+            [this](size_t i) { return m_barSlots.handleAt<Bar>(i); });
+        next->barEndNodes = nextVersion(previous.barEndNodes, m_barEndNodes, m_barDirtyChunks);
+        next->barMaterialIndices = nextVersion(previous.barMaterialIndices, m_barMaterialIndices, m_barDirtyChunks);
+        next->barSectionIndices = nextVersion(previous.barSectionIndices, m_barSectionIndices, m_barDirtyChunks);
+        next->materials = nextVersion(previous.materials, m_materials, m_materialDirtyChunks);
+        next->sections = nextVersion(previous.sections, m_sections, m_sectionDirtyChunks);
+        next->gridLines = nextVersion(previous.gridLines, m_gridLines, m_gridLineDirtyChunks);
+        next->loadCases = nextVersion(previous.loadCases, m_loadCases, m_loadCaseDirtyChunks);
+        next->nodalLoads = nextVersion(previous.nodalLoads, m_nodalLoads, m_nodalLoadDirtyChunks);
+        next->memberLoads = nextVersion(previous.memberLoads, m_memberLoads, m_memberLoadDirtyChunks);
+        
+        m_nodeDirtyChunks.clear();
+        m_barDirtyChunks.clear();
+        m_materialDirtyChunks.clear();
+        m_sectionDirtyChunks.clear();
+        m_gridLineDirtyChunks.clear();
+        m_loadCaseDirtyChunks.clear();
+        m_nodalLoadDirtyChunks.clear();
+        m_memberLoadDirtyChunks.clear();
+        m_snapshot = std::move(next);
+        return m_snapshot;
+    }
+    
+    std::uint64_t changeVersion() const override
+    {
+        return m_journal.version();
+    }
+    
+    bool changesSince(std::uint64_t version, std::vector<ModelChange> &changes) const override
+    {
+        return m_journal.changesSince(version, changes);
+    }
+    
+    /// Bound the retained change history (default ModelChangeJournal::kDefaultCapacity)
+    void setChangeJournalCapacity(size_t capacity)
+    {
+        m_journal.setCapacity(capacity);
+    }
+    
+    /**
+     * @brief Heap bytes held for nodes and bars, with all their indices.
+     *
+     * Vectors are counted by capacity; hash tables are estimated at key +
+     * value + two pointers per entry, so the figures are approximate but
+     * comparable between builds and model sizes.
+     */
+    struct MemoryFootprint
+    {
+        size_t nodeBytes{0};
+        size_t barBytes{0};
+    };
+    
+    MemoryFootprint memoryFootprint() const
+    {
+        MemoryFootprint footprint;
+        footprint.nodeBytes = vectorBytes(m_nodes) + vectorBytes(m_nodeCoordinates)
+            + m_nodeSlots.memoryUsage() + m_nodeIndex.memoryUsage()
+            + vectorBytes(m_supportedNodes) + vectorBytes(m_supportSlot)
+            + hashBytes(m_nodeById) + hashBytes(m_nodeByExternalId);
+        
+        footprint.barBytes = vectorBytes(m_bars) + vectorBytes(m_barEndNodes)
+            + vectorBytes(m_barMaterialIndices) + vectorBytes(m_barSectionIndices)
+            + m_barSlots.memoryUsage() + hashBytes(m_barById) + hashBytes(m_barByExternalId)
+            + hashBytes(m_barKPoints);
+        for (auto it = m_barsByNode.constBegin(); it != m_barsByNode.constEnd(); ++it) {
+            footprint.barBytes += sizeof(QUuid) + sizeof(std::vector<int>) + 2 * sizeof(void *)
+                                + vectorBytes(it.value());
+        }
+        return footprint;
     }
 
 private:
-    // Helper methods to rebuild index maps after removal
-    void rebuildNodeIndex()
+    // Removal helpers shared by all entity kinds. The relocation
+    // callback is invoked as (entity, from, to) before an entity moves to a
+    // new dense index, with to == -1 when the entity is dropped.
+
+    /**
+     * @brief Remove the entity at @p position in O(1) by swapping the last
+     * element into the hole. Only the hash slots of the removed and the
+     * moved entity are touched; the order of the remaining entities changes.
+     */
+    template <typename Entity, typename Relocate>
+    static void removeAt(std::vector<Entity> &items,
+                         QHash<QUuid, int> &indexById,
+                         int position,
+                         Relocate &&relocate)
     {
-        m_nodeById.clear();
-        for (size_t i = 0; i < m_nodes.size(); ++i) {
-            m_nodeById[m_nodes[i].id()] = static_cast<int>(i);
+        const int last = static_cast<int>(items.size()) - 1;
+        relocate(items[position], position, -1);
+        indexById.remove(items[position].id());
+        if (position != last) {
+            relocate(items[last], last, position);
+            items[position] = std::move(items[last]);
+            indexById[items[position].id()] = position;
         }
+        items.pop_back();
     }
-    
-    void rebuildBarIndex()
+
+    /**
+     * @brief Remove every entity listed in @p ids with a single compaction pass.
+     *
+     * Doomed entries are tombstoned first, then survivors are shifted down
+     * preserving their relative order and only their hash slots are patched.
+     * Unknown and duplicate IDs are ignored.
+     * @return Number of entities removed
+     */
+    template <typename Entity, typename Relocate>
+    static size_t removeMany(std::vector<Entity> &items,
+                             QHash<QUuid, int> &indexById,
+                             const std::vector<QUuid> &ids,
+                             Relocate &&relocate)
+    {
+        std::vector<bool> doomed(items.size(), false);
+        size_t removed = 0;
+        for (const QUuid &id : ids) {
+            const int index = indexById.value(id, -1);
+            if (index >= 0 && !doomed[static_cast<size_t>(index)]) {
+                doomed[static_cast<size_t>(index)] = true;
+                ++removed;
+            }
+        }
+        if (removed == 0) {
+            return 0;
+        }
+
+        size_t write = 0;
+        for (size_t read = 0; read < items.size(); ++read) {
+            if (doomed[read]) {
+                relocate(items[read], static_cast<int>(read), -1);
+                indexById.remove(items[read].id());
+                continue;
+            }
+            if (write != read) {
+                relocate(items[read], static_cast<int>(read), static_cast<int>(write));
+                items[write] = std::move(items[read]);
+                indexById[items[write].id()] = static_cast<int>(write);
+            }
+            ++write;
+        }
+        items.erase(items.begin() + static_cast<std::ptrdiff_t>(write), items.end());
+        return removed;
+    }
+
+    template <typename T>
+    static size_t vectorBytes(const std::vector<T> &items)
+    {
+        return items.capacity() * sizeof(T);
+    }
+
+    template <typename Hash>
+    static size_t hashBytes(const Hash &hash)
+    {
+        return static_cast<size_t>(hash.size())
+            * (sizeof(typename Hash::key_type) + sizeof(typename Hash::mapped_type) + 2 * sizeof(void *));
+    }
+
+    // Grow-only reserve: QHash::reserve() may also shrink the table
+    template <typename Hash>
+    static void reserveHash(Hash &hash, size_t count)
+    {
+        if (count > static_cast<size_t>(hash.capacity())) {
+            hash.reserve(static_cast<int>(count));
+        }
+    }
+
+    // Snapshot support: flag the chunk holding a written dense position
+    static void markDirty(std::vector<bool> &dirtyChunks, int index)
+    {
+        const size_t chunk = static_cast<size_t>(index) / VersionedArray<Node>::kChunkSize;
+        if (chunk >= dirtyChunks.size()) {
+            dirtyChunks.resize(chunk + 1, false);
+        }
+        dirtyChunks[chunk] = true;
+    }
+
+    template <typename Entity>
+    static VersionedArray<Entity> nextVersion(const VersionedArray<Entity> &previous,
+                                              const std::vector<Entity> &items,
+                                              const std::vector<bool> &dirtyChunks)
+    {
+        return VersionedArray<Entity>::build(previous, items.size(), dirtyChunks,
+                                             [&items](size_t i) { return items[i]; });
+    }
+
+    // Change journal: which fields an update actually touches
+
+    static std::uint32_t nodeChangeFields(const Node &previous, const Node &next)
+    {
+        std::uint32_t fields = 0;
+        if (previous.externalId() != next.externalId()) fields |= ChangeField::ExternalId;
+        if (!(previous.position() == next.position())) fields |= ChangeField::Position;
+        if (previous.restraintMask() != next.restraintMask()) fields |= ChangeField::Restraints;
+        return fields;
+    }
+
+    static std::uint32_t barChangeFields(const Bar &previous, const Bar &next)
+    {
+        std::uint32_t fields = 0;
+        if (previous.externalId() != next.externalId()) fields |= ChangeField::ExternalId;
+        if (previous.startNodeId() != next.startNodeId() || previous.endNodeId() != next.endNodeId()) {
+            fields |= ChangeField::Connectivity;
+        }
+        if (previous.materialId() != next.materialId() || previous.sectionId() != next.sectionId()) {
+            fields |= ChangeField::Properties;
+        }
+        if (previous.isLCSDirty() != next.isLCSDirty()) fields |= ChangeField::Data;
+        return fields;
+    }
+
+    template <typename Entity>
+    void recordUpdate(EntityKind kind, const QUuid &id,
+                      Structura::Model::EntityHandle<Entity> handle, std::uint32_t fields)
+    {
+        if (fields != 0) {
+            m_journal.record(kind, id, handle, fields);
+        }
+    }
+
+    // Relocation callbacks keeping the secondary indices in step with
+    // entities moved or dropped by removeAt/removeMany
+
+    void relocateNode(const Node &node, int from, int to)
+    {
+        relocateExternalId(m_nodeByExternalId, node.externalId(), from, to);
+        markDirty(m_nodeDirtyChunks, to >= 0 ? to : from);
+        if (to >= 0) {
+            writeNodeCoordinates(to, node);
+            m_nodeSlots.move(from, to);
+            m_nodeIndex.relocate(from, to);
+            const int supportSlot = m_supportSlot[static_cast<size_t>(from)];
+            m_supportSlot[static_cast<size_t>(to)] = supportSlot;
+            if (supportSlot >= 0) {
+                m_supportedNodes[static_cast<size_t>(supportSlot)] = to;
+            }
+        } else {
+            setSupported(from, false);
+            m_journal.record(EntityKind::Node, node.id(), m_nodeSlots.handleAt<Node>(static_cast<size_t>(from)),
+                             ChangeField::Removed);
+            m_nodeSlots.release(from);
+            m_nodeIndex.remove(from);
+        }
+    }
+
+    // Keep m_supportedNodes / m_supportSlot in step with a node's restraints
+    void setSupported(int index, bool supported)
+    {
+        int &slot = m_supportSlot[static_cast<size_t>(index)];
+        if (supported == (slot >= 0)) {
+            return;
+        }
+        if (supported) {
+            slot = static_cast<int>(m_supportedNodes.size());
+            m_supportedNodes.push_back(index);
+            return;
+        }
+        const int moved = m_supportedNodes.back();
+        m_supportedNodes[static_cast<size_t>(slot)] = moved;
+        m_supportSlot[static_cast<size_t>(moved)] = slot;
+        m_supportedNodes.pop_back();
+        slot = -1;
+    }
+
+    void writeNodeCoordinates(int index, const Node &node)
+    {
+        double *xyz = m_nodeCoordinates.data() + 3 * static_cast<size_t>(index);
+        xyz[0] = node.x();
+        xyz[1] = node.y();
+        xyz[2] = node.z();
+    }
+
+    void relocateBar(const Bar &bar, int from, int to)
+    {
+        relocateExternalId(m_barByExternalId, bar.externalId(), from, to);
+        markDirty(m_barDirtyChunks, to >= 0 ? to : from);
+        unlinkBarFromNodes(bar, from);
+        if (to >= 0) {
+            linkBarToNodes(bar, to);
+            m_barEndNodes[static_cast<size_t>(to)] = m_barEndNodes[static_cast<size_t>(from)];
+            m_barMaterialIndices[static_cast<size_t>(to)] = m_barMaterialIndices[static_cast<size_t>(from)];
+            m_barSectionIndices[static_cast<size_t>(to)] = m_barSectionIndices[static_cast<size_t>(from)];
+            if (m_barKPoints.contains(from)) {
+                m_barKPoints.insert(to, m_barKPoints.take(from));
+            }
+            m_barSlots.move(from, to);
+        } else {
+            m_barKPoints.remove(from);
+            m_journal.record(EntityKind::Bar, bar.id(), m_barSlots.handleAt<Bar>(static_cast<size_t>(from)),
+                             ChangeField::Removed);
+            m_barSlots.release(from);
+        }
+    }
+
+    void resolveBarEndNodes(int index)
+    {
+        const Bar &bar = m_bars[static_cast<size_t>(index)];
+        m_barEndNodes[static_cast<size_t>(index)] = {nodeHandle(bar.startNodeId()),
+                                                     nodeHandle(bar.endNodeId())};
+        markDirty(m_barDirtyChunks, index);
+    }
+
+    // Bar property indices. Materials and sections are few and change
+    // rarely, so a sweep over the bars on their add/remove is acceptable.
+
+    /// Point the unresolved bars that reference @p id at the newly added @p index
+    void resolveBarProperty(std::vector<std::int32_t> &indices, size_t index, const QUuid &id,
+                            const QUuid &(Bar::*propertyId)() const)
     {
-        m_barById.clear();
         for (size_t i = 0; i < m_bars.size(); ++i) {
-            m_barById[m_bars[i].id()] = static_cast<int>(i);
+            if (indices[i] < 0 && (m_bars[i].*propertyId)() == id) {
+                indices[i] = static_cast<std::int32_t>(index);
+                markDirty(m_barDirtyChunks, static_cast<int>(i));
+            }
         }
     }
-    
-    void rebuildMaterialIndex()
+
+    /// Apply old -> new property positions (-1 = gone); an empty @p remap drops all
+    void remapBarProperty(std::vector<std::int32_t> &indices, const std::vector<std::int32_t> &remap)
     {
-        m_materialById.clear();
-        for (size_t i = 0; i < m_materials.size(); ++i) {
-            m_materialById[m_materials[i].id()] = static_cast<int>(i);
+        for (size_t i = 0; i < indices.size(); ++i) {
+            const std::int32_t previous = indices[i];
+            if (previous < 0) {
+                continue;
+            }
+            const std::int32_t next = static_cast<size_t>(previous) < remap.size()
+                ? remap[static_cast<size_t>(previous)] : -1;
+            if (next != previous) {
+                indices[i] = next;
+                markDirty(m_barDirtyChunks, static_cast<int>(i));
+            }
         }
     }
-    
-    void rebuildSectionIndex()
+
+    static void relocateExternalId(QMultiHash<int, int> &indexByExternalId,
+                                   int externalId,
+                                   int from,
+                                   int to)
     {
-        m_sectionById.clear();
-        for (size_t i = 0; i < m_sections.size(); ++i) {
-            m_sectionById[m_sections[i].id()] = static_cast<int>(i);
+        indexByExternalId.remove(externalId, from);
+        if (to >= 0) {
+            indexByExternalId.insert(externalId, to);
         }
     }
-    
-    void rebuildGridLineIndex()
+
+    static void relinkExternalId(QMultiHash<int, int> &indexByExternalId,
+                                 int oldExternalId,
+                                 int newExternalId,
+                                 int index)
     {
-        m_gridLineById.clear();
-        for (size_t i = 0; i < m_gridLines.size(); ++i) {
-            m_gridLineById[m_gridLines[i].id()] = static_cast<int>(i);
+        if (oldExternalId != newExternalId) {
+            indexByExternalId.remove(oldExternalId, index);
+            indexByExternalId.insert(newExternalId, index);
+        }
+    }
+
+    void linkBarToNodes(const Bar &bar, int index)
+    {
+        m_barsByNode[bar.startNodeId()].push_back(index);
+        if (bar.endNodeId() != bar.startNodeId()) {
+            m_barsByNode[bar.endNodeId()].push_back(index);
+        }
+    }
+
+    void unlinkBarFromNodes(const Bar &bar, int index)
+    {
+        unlinkBarFromNode(bar.startNodeId(), index);
+        if (bar.endNodeId() != bar.startNodeId()) {
+            unlinkBarFromNode(bar.endNodeId(), index);
+        }
+    }
+
+    void unlinkBarFromNode(const QUuid &nodeId, int index)
+    {
+        auto it = m_barsByNode.find(nodeId);
+        if (it == m_barsByNode.end()) {
+            return;
+        }
+        std::vector<int> &indices = it.value();
+        auto pos = std::find(indices.begin(), indices.end(), index);
+        if (pos != indices.end()) {
+            *pos = indices.back();
+            indices.pop_back();
+        }
+        if (indices.empty()) {
+            m_barsByNode.erase(it);
+        }
+    }
+
+    // Loads: keep the by-case and by-node/bar indices in step with the dense arrays
+
+    void relocateNodalLoad(const NodalLoad &load, int from, int to)
+    {
+        markDirty(m_nodalLoadDirtyChunks, to >= 0 ? to : from);
+        if (to >= 0) {
+            m_nodalLoadsByCase.relocate(load.loadCaseId(), from, to);
+            m_nodalLoadsByNode.relocate(load.nodeId(), from, to);
+        } else {
+            m_nodalLoadsByCase.remove(load.loadCaseId(), from);
+            m_nodalLoadsByNode.remove(load.nodeId(), from);
+            m_journal.record(EntityKind::NodalLoad, load.id(), ChangeField::Removed);
+        }
+    }
+
+    void relocateMemberLoad(const MemberLoad &load, int from, int to)
+    {
+        markDirty(m_memberLoadDirtyChunks, to >= 0 ? to : from);
+        if (to >= 0) {
+            m_memberLoadsByCase.relocate(load.loadCaseId(), from, to);
+            m_memberLoadsByBar.relocate(load.barId(), from, to);
+        } else {
+            m_memberLoadsByCase.remove(load.loadCaseId(), from);
+            m_memberLoadsByBar.remove(load.barId(), from);
+            m_journal.record(EntityKind::MemberLoad, load.id(), ChangeField::Removed);
+        }
+    }
+
+    void truncateNodalLoadIndices()
+    {
+        m_nodalLoadsByCase.truncate(m_nodalLoads.size());
+        m_nodalLoadsByNode.truncate(m_nodalLoads.size());
+    }
+
+    void truncateMemberLoadIndices()
+    {
+        m_memberLoadsByCase.truncate(m_memberLoads.size());
+        m_memberLoadsByBar.truncate(m_memberLoads.size());
+    }
+
+    /**
+     * @brief Dense entity indices grouped by a UUID key (load case, node, bar).
+     *
+     * Every index belongs to exactly one group and remembers its position in
+     * it, so insert, remove and relocate are O(1) regardless of group size.
+     */
+    class GroupedIndex
+    {
+    public:
+        void insert(const QUuid &key, int index)
+        {
+            std::vector<int> &members = m_members[key];
+            if (static_cast<size_t>(index) >= m_position.size()) {
+                m_position.resize(static_cast<size_t>(index) + 1, -1);
+            }
+            m_position[static_cast<size_t>(index)] = static_cast<int>(members.size());
+            members.push_back(index);
+        }
+
+        void remove(const QUuid &key, int index)
+        {
+            auto it = m_members.find(key);
+            if (it == m_members.end()) {
+                return;
+            }
+            std::vector<int> &members = it.value();
+            const int position = m_position[static_cast<size_t>(index)];
+            const int moved = members.back();
+            members[static_cast<size_t>(position)] = moved;
+            m_position[static_cast<size_t>(moved)] = position;
+            members.pop_back();
+            if (members.empty()) {
+                m_members.erase(it);
+            }
+        }
+
+        /// The entity at dense index @p from now lives at @p to
+        void relocate(const QUuid &key, int from, int to)
+        {
+            const int position = m_position[static_cast<size_t>(from)];
+            m_members[key][static_cast<size_t>(position)] = to;
+            m_position[static_cast<size_t>(to)] = position;
+        }
+
+        /// Drop positions past the end of a shrunk dense array
+        void truncate(size_t size)
+        {
+            if (m_position.size() > size) {
+                m_position.resize(size);
+            }
+        }
+
+        void clear()
+        {
+            m_members.clear();
+            m_position.clear();
         }
+
+        template <typename Entity>
+        IndexedRange<Entity> range(const std::vector<Entity> &items, const QUuid &key) const
+        {
+            const auto it = m_members.constFind(key);
+            if (it == m_members.constEnd()) {
+                return {};
+            }
+            const std::vector<int> &indices = it.value();
+            return IndexedRange<Entity>(items.data(), indices.data(), indices.data() + indices.size());
+        }
+
+    private:
+        QHash<QUuid, std::vector<int>> m_members;
+        std::vector<int> m_position; ///< Position of each dense index within its group
+    };
+
+    template <typename Load>
+    static std::vector<QUuid> loadIdsInCase(const std::vector<Load> &loads,
+                                            const GroupedIndex &byCase,
+                                            const QUuid &loadCaseId)
+    {
+        std::vector<QUuid> ids;
+        for (const Load &load : byCase.range(loads, loadCaseId)) {
+            ids.push_back(load.id());
+        }
+        return ids;
     }
 
+    /**
+     * @brief Slot map issuing generational handles over one dense array.
+     *
+     * Each slot records where its entity currently sits in the dense array.
+     * Released slots are recycled through a free list with their generation
+     * bumped, so handles to removed entities go stale instead of aliasing.
+     */
+    class HandleSlots
+    {
+    public:
+        /// Issue a slot for the entity just appended to the dense array
+        void acquire()
+        {
+            std::uint32_t slot;
+            if (!m_freeSlots.empty()) {
+                slot = m_freeSlots.back();
+                m_freeSlots.pop_back();
+            } else {
+                slot = static_cast<std::uint32_t>(m_slots.size());
+                m_slots.push_back(Slot{});
+            }
+            m_slots[slot].dense = static_cast<int>(m_slotByDense.size());
+            m_slotByDense.push_back(slot);
+        }
+
+        void release(int dense)
+        {
+            const std::uint32_t slot = m_slotByDense[static_cast<size_t>(dense)];
+            Slot &entry = m_slots[slot];
+            entry.dense = -1;
+            if (++entry.generation == 0) {
+                entry.generation = 1; // 0 marks invalid handles
+            }
+            m_freeSlots.push_back(slot);
+        }
+
+        void move(int from, int to)
+        {
+            const std::uint32_t slot = m_slotByDense[static_cast<size_t>(from)];
+            m_slots[slot].dense = to;
+            m_slotByDense[static_cast<size_t>(to)] = slot;
+        }
+
+        /// Drop dense positions past @p count after removals
+        void truncate(size_t count) { m_slotByDense.resize(count); }
+
+        void reserve(size_t count)
+        {
+            m_slots.reserve(count);
+            m_slotByDense.reserve(count);
+        }
+
+        size_t memoryUsage() const
+        {
+            return vectorBytes(m_slots) + vectorBytes(m_slotByDense) + vectorBytes(m_freeSlots);
+        }
+
+        void clear()
+        {
+            for (size_t dense = 0; dense < m_slotByDense.size(); ++dense) {
+                release(static_cast<int>(dense));
+            }
+            m_slotByDense.clear();
+        }
+
+        template <typename Entity>
+        Structura::Model::EntityHandle<Entity> handleAt(size_t dense) const
+        {
+            const std::uint32_t slot = m_slotByDense[dense];
+            return Structura::Model::EntityHandle<Entity>(slot, m_slots[slot].generation);
+        }
+
+        /// Dense position of @p handle, or -1 if it is invalid or stale
+        template <typename Entity>
+        int indexOf(Structura::Model::EntityHandle<Entity> handle) const
+        {
+            if (handle.index() >= m_slots.size()) {
+                return -1;
+            }
+            const Slot &entry = m_slots[handle.index()];
+            return entry.generation == handle.generation() ? entry.dense : -1;
+        }
+
+    private:
+        struct Slot
+        {
+            int dense{-1};
+            std::uint32_t generation{1};
+        };
+
+        std::vector<Slot> m_slots;
+        std::vector<std::uint32_t> m_slotByDense;
+        std::vector<std::uint32_t> m_freeSlots;
+    };
+
     // Storage
     std::vector<Node> m_nodes;
     std::vector<Bar> m_bars;
     std::vector<Material> m_materials;
     std::vector<Section> m_sections;
     std::vector<GridLine> m_gridLines;
+    std::vector<LoadCase> m_loadCases;
+    std::vector<NodalLoad> m_nodalLoads;
+    std::vector<MemberLoad> m_memberLoads;
+    
+    // Interleaved x,y,z of m_nodes, kept in the same dense order
+    std::vector<double> m_nodeCoordinates;
+    
+    // Generational handle slots, and bar end nodes resolved to handles
+    // (parallel to m_bars)
+    HandleSlots m_nodeSlots;
+    HandleSlots m_barSlots;
+    std::vector<std::array<NodeHandle, 2>> m_barEndNodes;
+    
+    // Dense material / section index of each bar, -1 if unresolved
+    // (parallel to m_bars)
+    std::vector<std::int32_t> m_barMaterialIndices;
+    std::vector<std::int32_t> m_barSectionIndices;
+    
+    // K-points of the few bars that have one, keyed by dense bar index
+    QHash<int, Vector3> m_barKPoints;
+    
+    // Dense indices of the nodes with restraints, and each node's position
+    // in that list (-1 if free; parallel to m_nodes)
+    std::vector<int> m_supportedNodes;
+    std::vector<int> m_supportSlot;
+    
+    // Spatial hash over m_nodeCoordinates, by dense node index
+    NodeSpatialIndex m_nodeIndex;
     
     // Index maps for fast lookup by ID
     QHash<QUuid, int> m_nodeById;
@@ -449,6 +1664,42 @@ private:
     QHash<QUuid, int> m_materialById;
     QHash<QUuid, int> m_sectionById;
     QHash<QUuid, int> m_gridLineById;
+    QHash<QUuid, int> m_loadCaseById;
+    QHash<QUuid, int> m_nodalLoadById;
+    QHash<QUuid, int> m_memberLoadById;
+    
+    // Loads grouped by load case and by the node / bar they act on.
+    // Keyed by UUID so loads may reference nodes and bars not (yet) present.
+    GroupedIndex m_nodalLoadsByCase;
+    GroupedIndex m_nodalLoadsByNode;
+    GroupedIndex m_memberLoadsByCase;
+    GroupedIndex m_memberLoadsByBar;
+    
+    // Node -> dense indices of the bars that reference it (either end).
+    // Keyed by UUID so bars may reference nodes not (yet) in the repository.
+    QHash<QUuid, std::vector<int>> m_barsByNode;
+    
+    // Secondary indices by external ID (duplicates are tolerated)
+    QMultiHash<int, int> m_nodeByExternalId;
+    QMultiHash<int, int> m_barByExternalId;
+    
+    // Last published version and the chunks written since
+    mutable std::shared_ptr<const ModelVersion> m_snapshot;
+    mutable std::vector<bool> m_nodeDirtyChunks;
+    mutable std::vector<bool> m_barDirtyChunks;
+    mutable std::vector<bool> m_materialDirtyChunks;
+    mutable std::vector<bool> m_sectionDirtyChunks;
+    mutable std::vector<bool> m_gridLineDirtyChunks;
+    mutable std::vector<bool> m_loadCaseDirtyChunks;
+    mutable std::vector<bool> m_nodalLoadDirtyChunks;
+    mutable std::vector<bool> m_memberLoadDirtyChunks;
+    
+    // Versioned log of changes for incremental consumers
+    ModelChangeJournal m_journal;
+    
+    // External ID high-water marks since the last clear
+    int m_maxNodeExternalId{0};
+    int m_maxBarExternalId{0};
 };
 
 } // namespace Structura::App
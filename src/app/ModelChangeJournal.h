@@ -0,0 +1,231 @@
+#pragma once
+
+#include "../core/model/EntityHandle.h"
+#include <QHash>
+#include <QUuid>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace Structura::App {
+
+/**
+ * @brief Kind of entity a journal entry refers to.
+ */
+enum class EntityKind : std::uint8_t
+{
+    Node,
+    Bar,
+    Material,
+    Section,
+    GridLine,
+    LoadCase,
+    NodalLoad,
+    MemberLoad
+};
+
+constexpr size_t kEntityKindCount = 8;
+
+/**
+ * @brief Bits of ModelChange::fields.
+ */
+namespace ChangeField {
+enum : std::uint32_t
+{
+    Created      = 1u << 0,
+    Removed      = 1u << 1,
+    ExternalId   = 1u << 2,
+    Position     = 1u << 3, ///< Node coordinates
+    Restraints   = 1u << 4, ///< Node restraints
+    Connectivity = 1u << 5, ///< Bar start/end node
+    Properties   = 1u << 6, ///< Bar material/section assignment
+    Orientation  = 1u << 7, ///< Bar k-point
+    Data         = 1u << 8, ///< Any other attribute
+
+    Lifecycle    = Created | Removed,
+    Attributes   = ExternalId | Position | Restraints | Connectivity | Properties
+                 | Orientation | Data
+};
+}
+
+/**
+ * @brief One recorded change (or, from changesSince(), all changes of one
+ * entity coalesced).
+ */
+struct ModelChange
+{
+    std::uint64_t version{0};  ///< Journal version of the (latest) change
+    EntityKind kind{EntityKind::Node};
+    QUuid id;
+    std::uint32_t handleIndex{0};      ///< Node/bar handle; 0/0 for other kinds
+    std::uint32_t handleGeneration{0};
+    std::uint32_t fields{0};           ///< ChangeField bits
+
+    template <typename Entity>
+    Structura::Model::EntityHandle<Entity> handle() const
+    {
+        return Structura::Model::EntityHandle<Entity>(handleIndex, handleGeneration);
+    }
+};
+
+/**
+ * @brief Bounded, monotonically versioned log of repository changes.
+ *
+ * Every recorded change gets the next version number. Consumers remember the
+ * version they last synchronised with and ask for changesSince() it, which
+ * returns one coalesced entry per touched entity. When a consumer has fallen
+ * further behind than the retained history (or the journal was reset by a
+ * clear), changesSince() reports that and the consumer re-reads everything.
+ */
+class ModelChangeJournal
+{
+public:
+    static constexpr size_t kDefaultCapacity = 1u << 16;
+
+    /// Version of the most recent change (0 before any change)
+    std::uint64_t version() const { return m_version; }
+
+    /// Number of entries currently retained
+    size_t size() const { return m_entries.size(); }
+
+    /// Maximum number of retained entries; older ones are discarded
+    void setCapacity(size_t capacity)
+    {
+        m_capacity = std::max<size_t>(capacity, 1);
+        trim();
+    }
+
+    template <typename Entity>
+    void record(EntityKind kind, const QUuid &id,
+                Structura::Model::EntityHandle<Entity> handle, std::uint32_t fields)
+    {
+        record(kind, id, handle.index(), handle.generation(), fields);
+    }
+
+    void record(EntityKind kind, const QUuid &id, std::uint32_t fields)
+    {
+        record(kind, id, 0, 0, fields);
+    }
+
+    /**
+     * @brief Forget all history (used for bulk clears).
+     *
+     * Bumps the version so every consumer's next changesSince() fails and
+     * triggers a full re-read.
+     */
+    void reset()
+    {
+        m_entries.clear();
+        ++m_version;
+        m_floor = m_version;
+    }
+
+    /**
+     * @brief Collect what changed after @p since.
+     * @param since Version the caller last synchronised with
+     * @param changes Receives one entry per touched entity, in order of each
+     *        entity's first change, with its net effect: Created (did not
+     *        exist at @p since), Removed (no longer exists) or the OR of the
+     *        changed attribute bits. Entities created and removed again
+     *        within the range are omitted.
+     * @return false if history back to @p since is no longer available
+     */
+    bool changesSince(std::uint64_t since, std::vector<ModelChange> &changes) const
+    {
+        changes.clear();
+        if (since < m_floor) {
+            return false;
+        }
+
+        auto first = std::upper_bound(m_entries.begin(), m_entries.end(), since,
+                                      [](std::uint64_t v, const ModelChange &entry) {
+                                          return v < entry.version;
+                                      });
+
+        struct Lifecycle
+        {
+            bool existedBefore;
+            bool existsNow;
+            bool recreated;
+        };
+        std::array<QHash<QUuid, size_t>, kEntityKindCount> positionById;
+        std::vector<Lifecycle> lifecycles;
+        for (auto it = first; it != m_entries.end(); ++it) {
+            const bool created = (it->fields & ChangeField::Created) != 0;
+            const bool removed = (it->fields & ChangeField::Removed) != 0;
+            auto &positions = positionById[static_cast<size_t>(it->kind)];
+            const auto found = positions.constFind(it->id);
+            if (found == positions.constEnd()) {
+                positions.insert(it->id, changes.size());
+                changes.push_back(*it);
+                lifecycles.push_back({!created, !removed, false});
+                continue;
+            }
+            ModelChange &merged = changes[found.value()];
+            Lifecycle &lifecycle = lifecycles[found.value()];
+            merged.version = it->version;
+            merged.handleIndex = it->handleIndex;
+            merged.handleGeneration = it->handleGeneration;
+            merged.fields |= it->fields;
+            lifecycle.recreated = lifecycle.recreated || created;
+            lifecycle.existsNow = !removed;
+        }
+
+        // Reduce each entity to its net effect relative to `since`
+        size_t write = 0;
+        for (size_t read = 0; read < changes.size(); ++read) {
+            const Lifecycle &lifecycle = lifecycles[read];
+            ModelChange &change = changes[read];
+            const std::uint32_t attributes = change.fields & ChangeField::Attributes;
+            if (!lifecycle.existedBefore && !lifecycle.existsNow) {
+                continue; // created and removed again
+            }
+            if (!lifecycle.existedBefore) {
+                change.fields = ChangeField::Created | attributes;
+            } else if (!lifecycle.existsNow) {
+                change.fields = ChangeField::Removed;
+            } else if (lifecycle.recreated) {
+                change.fields = ChangeField::Attributes; // replaced wholesale
+            } else {
+                change.fields = attributes;
+            }
+            changes[write++] = change;
+        }
+        changes.resize(write);
+        return true;
+    }
+
+private:
+    void record(EntityKind kind, const QUuid &id,
+                std::uint32_t handleIndex, std::uint32_t handleGeneration,
+                std::uint32_t fields)
+    {
+        ModelChange entry;
+        entry.version = ++m_version;
+        entry.kind = kind;
+        entry.id = id;
+        entry.handleIndex = handleIndex;
+        entry.handleGeneration = handleGeneration;
+        entry.fields = fields;
+        m_entries.push_back(entry);
+        trim();
+    }
+
+    void trim()
+    {
+        while (m_entries.size() > m_capacity) {
+            m_floor = m_entries.front().version;
+            m_entries.pop_front();
+        }
+    }
+
+    std::deque<ModelChange> m_entries;
+    std::uint64_t m_version{0};
+    std::uint64_t m_floor{0};   ///< Oldest version changesSince() can answer
+    size_t m_capacity{kDefaultCapacity};
+};
+
+} // namespace Structura::App
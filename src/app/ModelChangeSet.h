@@ -0,0 +1,88 @@
+#pragma once
+
+#include <QMetaType>
+#include <QSet>
+#include <QUuid>
+
+namespace Structura::App {
+
+/**
+ * @brief IDs of the entities touched by a batch of model mutations.
+ *
+ * Changes are recorded net of each other: an entity created and deleted
+ * inside the same batch does not appear at all, and an entity created and
+ * then updated is reported only as created.
+ */
+struct ModelChangeSet
+{
+    QSet<QUuid> createdNodes;
+    QSet<QUuid> updatedNodes;
+    QSet<QUuid> deletedNodes;
+    QSet<QUuid> createdBars;
+    QSet<QUuid> updatedBars;
+    QSet<QUuid> deletedBars;
+
+    void noteNodeCreated(const QUuid &id) { noteCreated(createdNodes, deletedNodes, updatedNodes, id); }
+    void noteNodeUpdated(const QUuid &id) { noteUpdated(createdNodes, updatedNodes, id); }
+    void noteNodeDeleted(const QUuid &id) { noteDeleted(createdNodes, updatedNodes, deletedNodes, id); }
+    void noteBarCreated(const QUuid &id) { noteCreated(createdBars, deletedBars, updatedBars, id); }
+    void noteBarUpdated(const QUuid &id) { noteUpdated(createdBars, updatedBars, id); }
+    void noteBarDeleted(const QUuid &id) { noteDeleted(createdBars, updatedBars, deletedBars, id); }
+
+    bool touchesNodes() const
+    {
+        return !createdNodes.isEmpty() || !updatedNodes.isEmpty() || !deletedNodes.isEmpty();
+    }
+
+    bool touchesBars() const
+    {
+        return !createdBars.isEmpty() || !updatedBars.isEmpty() || !deletedBars.isEmpty();
+    }
+
+    bool isEmpty() const { return !touchesNodes() && !touchesBars(); }
+
+    /**
+     * @brief Fold in changes that happened after the ones already recorded.
+     */
+    void merge(const ModelChangeSet &later)
+    {
+        for (const QUuid &id : later.createdNodes) noteNodeCreated(id);
+        for (const QUuid &id : later.updatedNodes) noteNodeUpdated(id);
+        for (const QUuid &id : later.deletedNodes) noteNodeDeleted(id);
+        for (const QUuid &id : later.createdBars) noteBarCreated(id);
+        for (const QUuid &id : later.updatedBars) noteBarUpdated(id);
+        for (const QUuid &id : later.deletedBars) noteBarDeleted(id);
+    }
+
+private:
+    static void noteCreated(QSet<QUuid> &created, QSet<QUuid> &deleted,
+                            QSet<QUuid> &updated, const QUuid &id)
+    {
+        // Deleted then re-created (e.g. undo) reads as an update
+        if (deleted.remove(id)) {
+            updated.insert(id);
+        } else {
+            created.insert(id);
+        }
+    }
+
+    static void noteUpdated(const QSet<QUuid> &created, QSet<QUuid> &updated, const QUuid &id)
+    {
+        if (!created.contains(id)) {
+            updated.insert(id);
+        }
+    }
+
+    static void noteDeleted(QSet<QUuid> &created, QSet<QUuid> &updated,
+                            QSet<QUuid> &deleted, const QUuid &id)
+    {
+        updated.remove(id);
+        if (!created.remove(id)) {
+            deleted.insert(id);
+        }
+    }
+};
+
+} // namespace Structura::App
+
+Q_DECLARE_METATYPE(Structura::App::ModelChangeSet)
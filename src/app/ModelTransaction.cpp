@@ -0,0 +1,52 @@
+#include "ModelTransaction.h"
+#include "NodeService.h"
+#include "BarService.h"
+
+namespace Structura::App {
+
+ModelTransaction::ModelTransaction(NodeService *nodeService, BarService *barService)
+    : m_nodeService(nodeService)
+    , m_barService(barService)
+    , m_open(true)
+{
+    if (m_nodeService) {
+        m_nodeService->beginBatch();
+    }
+    if (m_barService) {
+        m_barService->beginBatch();
+    }
+}
+
+ModelTransaction::~ModelTransaction()
+{
+    commit();
+}
+
+void ModelTransaction::commit()
+{
+    if (!m_open) {
+        return;
+    }
+    m_open = false;
+
+    ModelChangeSet changes;
+    if (m_nodeService) {
+        changes.merge(m_nodeService->takeBatchChanges());
+    }
+    if (m_barService) {
+        changes.merge(m_barService->takeBatchChanges());
+    }
+
+    if (changes.isEmpty()) {
+        return;
+    }
+
+    // Publish once, through whichever service is present
+    if (m_nodeService) {
+        m_nodeService->publishBatchChanges(changes);
+    } else {
+        m_barService->publishBatchChanges(changes);
+    }
+}
+
+} // namespace Structura::App
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "ModelChangeSet.h"
+
+namespace Structura::App {
+
+class NodeService;
+class BarService;
+
+/**
+ * @brief Scoped batch of model mutations with a single change notification.
+ *
+ * While a transaction is open, NodeService and BarService apply mutations to
+ * the repository immediately but hold back their per-entity signals. On
+ * commit() the touched IDs of both services are merged and published once
+ * as modelBatchChanged, so observers such as SceneControllerFacade refresh
+ * once per transaction instead of once per entity.
+ *
+ * Mutations are not rolled back; "commit" only ends the batch. Destroying an
+ * open transaction commits it. Transactions may nest; only the outermost
+ * one publishes.
+ *
+ * Usage:
+ * @code
+ * ModelTransaction transaction(&nodeService, &barService);
+ * for (const auto &position : positions) {
+ *     nodeService.createNode(position);
+ * }
+ * transaction.commit();
+ * @endcode
+ */
+class ModelTransaction
+{
+public:
+    /**
+     * @brief Begin a batch on the given services.
+     * @param nodeService Node service (may be null)
+     * @param barService Bar service (may be null)
+     */
+    ModelTransaction(NodeService *nodeService, BarService *barService);
+    ~ModelTransaction();
+
+    ModelTransaction(const ModelTransaction&) = delete;
+    ModelTransaction& operator=(const ModelTransaction&) = delete;
+
+    /**
+     * @brief End the batch and publish the merged change set.
+     *
+     * Does nothing if already committed.
+     */
+    void commit();
+
+    bool isOpen() const { return m_open; }
+
+private:
+    NodeService *m_nodeService;
+    BarService *m_barService;
+    bool m_open;
+};
+
+} // namespace Structura::App
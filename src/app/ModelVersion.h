@@ -0,0 +1,153 @@
+#pragma once
+
+#include "../core/model/ModelEntities.h"
+#include "../core/model/EntityHandle.h"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+namespace Structura::App {
+
+/**
+ * @brief Immutable array stored as shared fixed-size chunks.
+ *
+ * Successive versions share every chunk that did not change, so building a
+ * new version costs O(changed chunks) and older versions held by readers stay
+ * valid and untouched.
+ */
+template <typename T>
+class VersionedArray
+{
+public:
+    static constexpr size_t kChunkSize = 512;
+
+    using Chunk = std::vector<T>;
+    using ChunkPtr = std::shared_ptr<const Chunk>;
+
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T *;
+        using reference = const T &;
+
+        const_iterator(const VersionedArray *array, size_t index)
+            : m_array(array)
+            , m_index(index)
+        {
+        }
+
+        reference operator*() const { return (*m_array)[m_index]; }
+        pointer operator->() const { return &(*m_array)[m_index]; }
+        const_iterator &operator++()
+        {
+            ++m_index;
+            return *this;
+        }
+        bool operator==(const const_iterator &other) const { return m_index == other.m_index; }
+        bool operator!=(const const_iterator &other) const { return m_index != other.m_index; }
+
+    private:
+        const VersionedArray *m_array;
+        size_t m_index;
+    };
+
+    const T &operator[](size_t index) const
+    {
+        return (*m_chunks[index / kChunkSize])[index % kChunkSize];
+    }
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, m_size); }
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+    size_t chunkCount() const { return m_chunks.size(); }
+    const ChunkPtr &chunk(size_t chunkIndex) const { return m_chunks[chunkIndex]; }
+
+    /**
+     * @brief Build the next version of an array.
+     * @param previous Version to share unchanged chunks with
+     * @param size Element count of the new version
+     * @param dirtyChunks Chunks written since @p previous (missing entries are clean)
+     * @param element Callable returning element i of the new version
+     *
+     * A chunk is shared if it is not dirty and has the same length as in
+     * @p previous; otherwise it is copied from @p element.
+     */
+    template <typename Element>
+    static VersionedArray build(const VersionedArray &previous,
+                                size_t size,
+                                const std::vector<bool> &dirtyChunks,
+                                Element &&element)
+    {
+        VersionedArray next;
+        next.m_size = size;
+        const size_t chunkCount = (size + kChunkSize - 1) / kChunkSize;
+        next.m_chunks.reserve(chunkCount);
+
+        for (size_t c = 0; c < chunkCount; ++c) {
+            const size_t first = c * kChunkSize;
+            const size_t length = std::min(kChunkSize, size - first);
+            const bool dirty = c < dirtyChunks.size() && dirtyChunks[c];
+            if (!dirty && c < previous.chunkCount() && previous.chunk(c)->size() == length) {
+                next.m_chunks.push_back(previous.chunk(c));
+                continue;
+            }
+
+            auto chunk = std::make_shared<Chunk>();
+            chunk->reserve(length);
+            for (size_t i = first; i < first + length; ++i) {
+                chunk->push_back(element(i));
+            }
+            next.m_chunks.push_back(std::move(chunk));
+        }
+        return next;
+    }
+
+private:
+    std::vector<ChunkPtr> m_chunks;
+    size_t m_size{0};
+};
+
+/**
+ * @brief Immutable, cheaply shareable version of the whole model.
+ *
+ * Obtained from IModelRepository::snapshot() and held through a
+ * std::shared_ptr<const ModelVersion>. A version never changes after it is
+ * published, so it can be read from any thread (analysis, export, render
+ * preparation) while the UI thread keeps editing the repository.
+ *
+ * Arrays are in the repository's dense order at the time of the snapshot;
+ * nodeHandles[i] / barHandles[i] are the handles of nodes[i] / bars[i],
+ * barEndNodes[i] the handles of the nodes bars[i] connects (invalid while a
+ * node is missing), and barMaterialIndices[i] / barSectionIndices[i] index into materials / sections
+ * (-1 if unresolved).
+ */
+struct ModelVersion
+{
+    /// Increases with every published version of the same repository
+    std::uint64_t number{0};
+
+    VersionedArray<Structura::Model::Node> nodes;
+    VersionedArray<Structura::Model::NodeHandle> nodeHandles;
+    VersionedArray<Structura::Model::Bar> bars;
+    VersionedArray<Structura::Model::BarHandle> barHandles;
+    VersionedArray<std::array<Structura::Model::NodeHandle, 2>> barEndNodes;
+    VersionedArray<std::int32_t> barMaterialIndices;
+    VersionedArray<std::int32_t> barSectionIndices;
+    VersionedArray<Structura::Model::Material> materials;
+    VersionedArray<Structura::Model::Section> sections;
+    VersionedArray<Structura::Model::GridLine> gridLines;
+    VersionedArray<Structura::Model::LoadCase> loadCases;
+    VersionedArray<Structura::Model::NodalLoad> nodalLoads;
+    VersionedArray<Structura::Model::MemberLoad> memberLoads;
+};
+
+} // namespace Structura::App
@@ -1,8 +1,108 @@
 #include "NodeService.h"
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <utility>
 
 namespace Structura::App {
 
+namespace {
+
+/**
+ * @brief Survivor nodes of a merge bucketed in cubic cells.
+ * 
+ * Cells are many tolerances wide, so a search box of +/- tolerance
+ * touches one cell most of the time and at most eight. Cell coordinates are
+ * 64-bit and hashed; unrelated cells sharing a hash only add candidates,
+ * which are always checked by distance.
+ */
+class SurvivorGrid
+{
+public:
+    SurvivorGrid(const double *xyz, size_t count, const double origin[3], double cellSize)
+        : m_xyz(xyz)
+        , m_inverseCellSize(1.0 / cellSize)
+        , m_next(count, -1)
+        , m_rank(count, -1)
+    {
+        std::copy(origin, origin + 3, m_origin);
+        m_heads.reserve(static_cast<int>(count));
+    }
+    
+    void insert(int index)
+    {
+        const double *p = m_xyz + 3 * static_cast<size_t>(index);
+        const quint64 key = keyOf(cell(p[0], 0), cell(p[1], 1), cell(p[2], 2));
+        auto head = m_heads.find(key);
+        if (head == m_heads.end()) {
+            m_heads.insert(key, index);
+        } else {
+            m_next[static_cast<size_t>(index)] = head.value();
+            head.value() = index;
+        }
+        m_rank[static_cast<size_t>(index)] = m_survivors++;
+    }
+    
+    /// Nearest survivor within @p tolerance of node @p index, or -1
+    int find(int index, double tolerance) const
+    {
+        const double *p = m_xyz + 3 * static_cast<size_t>(index);
+        std::int64_t lo[3];
+        std::int64_t hi[3];
+        for (int axis = 0; axis < 3; ++axis) {
+            lo[axis] = cell(p[axis] - tolerance, axis);
+            hi[axis] = cell(p[axis] + tolerance, axis);
+        }
+        
+        double best = tolerance * tolerance;
+        int bestIndex = -1;
+        for (std::int64_t x = lo[0]; x <= hi[0]; ++x) {
+            for (std::int64_t y = lo[1]; y <= hi[1]; ++y) {
+                for (std::int64_t z = lo[2]; z <= hi[2]; ++z) {
+                    for (int other = m_heads.value(keyOf(x, y, z), -1); other >= 0;
+                         other = m_next[static_cast<size_t>(other)]) {
+                        const double *q = m_xyz + 3 * static_cast<size_t>(other);
+                        const double dx = q[0] - p[0];
+                        const double dy = q[1] - p[1];
+                        const double dz = q[2] - p[2];
+                        const double d = dx * dx + dy * dy + dz * dz;
+                        if (d < best || (d == best && (bestIndex < 0 ||
+                                m_rank[static_cast<size_t>(other)] < m_rank[static_cast<size_t>(bestIndex)]))) {
+                            best = d;
+                            bestIndex = other;
+                        }
+                    }
+                }
+            }
+        }
+        return bestIndex;
+    }
+    
+private:
+    std::int64_t cell(double value, int axis) const
+    {
+        return static_cast<std::int64_t>(std::floor((value - m_origin[axis]) * m_inverseCellSize));
+    }
+    
+    static quint64 keyOf(std::int64_t x, std::int64_t y, std::int64_t z)
+    {
+        return static_cast<quint64>(x) * 0x9E3779B97F4A7C15ULL ^
+               static_cast<quint64>(y) * 0xC2B2AE3D27D4EB4FULL ^
+               static_cast<quint64>(z) * 0x165667B19E3779F9ULL;
+    }
+    
+    const double *m_xyz;
+    double m_origin[3];
+    double m_inverseCellSize;
+    QHash<quint64, int> m_heads;
+    std::vector<int> m_next;
+    std::vector<int> m_rank;
+    int m_survivors{0};
+};
+
+} // namespace
+
 NodeService::NodeService(IModelRepository *repository, QObject *parent)
     : QObject(parent)
     , m_repository(repository)
@@ -18,7 +118,7 @@ QUuid NodeService::createNode(const Vector3 &position)
     Node node(id, externalId, position);
     
     if (m_repository->addNode(node)) {
-        emit nodeCreated(id);
+        notifyNodeCreated(id);
         return id;
     }
     
@@ -36,7 +136,7 @@ QUuid NodeService::createNodeWithExternalId(const Vector3 &position, int externa
     Node node(id, externalId, position);
     
     if (m_repository->addNode(node)) {
-        emit nodeCreated(id);
+        notifyNodeCreated(id);
         return id;
     }
     
@@ -46,12 +146,47 @@ QUuid NodeService::createNodeWithExternalId(const Vector3 &position, int externa
 bool NodeService::deleteNode(const QUuid &id)
 {
     if (m_repository->removeNode(id)) {
-        emit nodeDeleted(id);
+        notifyNodeDeleted(id);
         return true;
     }
     return false;
 }
 
+std::vector<QUuid> NodeService::createNodes(const std::vector<Vector3> &positions)
+{
+    std::vector<QUuid> ids;
+    ids.reserve(positions.size());
+    
+    beginBatch();
+    for (const auto &position : positions) {
+        ids.push_back(createNode(position));
+    }
+    endBatch();
+    
+    return ids;
+}
+
+size_t NodeService::deleteNodes(const std::vector<QUuid> &ids)
+{
+    std::vector<QUuid> existing;
+    existing.reserve(ids.size());
+    for (const auto &id : ids) {
+        if (m_repository->findNodePtr(id)) {
+            existing.push_back(id);
+        }
+    }
+    
+    const size_t removed = m_repository->removeNodes(existing);
+    
+    beginBatch();
+    for (const auto &id : existing) {
+        notifyNodeDeleted(id);
+    }
+    endBatch();
+    
+    return removed;
+}
+
 bool NodeService::setNodePosition(const QUuid &id, const Vector3 &newPosition)
 {
     auto nodeOpt = m_repository->findNode(id);
@@ -63,8 +198,10 @@ bool NodeService::setNodePosition(const QUuid &id, const Vector3 &newPosition)
     node.setPosition(newPosition);
     
     if (m_repository->updateNode(node)) {
-        emit nodePositionChanged(id, newPosition);
-        emit nodeUpdated(id);
+        if (!isBatching()) {
+            emit nodePositionChanged(id, newPosition);
+        }
+        notifyNodeUpdated(id);
         return true;
     }
     
@@ -84,7 +221,7 @@ bool NodeService::setNodeRestraints(const QUuid &id, const std::array<bool, 6> &
     }
     
     if (m_repository->updateNode(node)) {
-        emit nodeUpdated(id);
+        notifyNodeUpdated(id);
         return true;
     }
     
@@ -113,24 +250,286 @@ size_t NodeService::nodeCount() const
 
 int NodeService::nextExternalId() const
 {
-    auto nodes = m_repository->allNodes();
-    if (nodes.empty()) {
-        return 1;
+    return m_repository->maxNodeExternalId() + 1;
+}
+
+bool NodeService::nodeExists(const QUuid &id) const
+{
+    return m_repository->findNodePtr(id) != nullptr;
+}
+
+NodeMergeResult NodeService::mergeCoincidentNodes(double tolerance)
+{
+    NodeMergeResult result;
+    const EntityView<Node> nodes = m_repository->nodes();
+    const double *xyz = m_repository->nodeCoordinates();
+    const size_t count = nodes.size();
+    if (count < 2) {
+        return result;
+    }
+    tolerance = std::max(tolerance, 0.0);
+    
+    // Grid origin and cell size from the model extent; non-finite
+    // coordinates never merge
+    double lo[3] = {std::numeric_limits<double>::max(), std::numeric_limits<double>::max(),
+                    std::numeric_limits<double>::max()};
+    double hi[3] = {std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest(),
+                    std::numeric_limits<double>::lowest()};
+    std::vector<int> order;
+    order.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        const double *p = xyz + 3 * i;
+        if (!std::isfinite(p[0]) || !std::isfinite(p[1]) || !std::isfinite(p[2])) {
+            continue;
+        }
+        for (int axis = 0; axis < 3; ++axis) {
+            lo[axis] = std::min(lo[axis], p[axis]);
+            hi[axis] = std::max(hi[axis], p[axis]);
+        }
+        order.push_back(static_cast<int>(i));
+    }
+    if (order.size() < 2) {
+        return result;
     }
+    const double extent = std::max({hi[0] - lo[0], hi[1] - lo[1], hi[2] - lo[2]});
+    double cellSize = std::max(16.0 * tolerance, std::ldexp(extent, -40));
+    if (!(cellSize > 0.0)) {
+        cellSize = 1.0; // every node at one point
+    }
+    
+    // Lowest external ID first, so it survives its cluster
+    std::sort(order.begin(), order.end(), [&nodes](int a, int b) {
+        const Node &lhs = nodes[static_cast<size_t>(a)];
+        const Node &rhs = nodes[static_cast<size_t>(b)];
+        if (lhs.externalId() != rhs.externalId()) {
+            return lhs.externalId() < rhs.externalId();
+        }
+        return lhs.id() < rhs.id();
+    });
     
-    int maxId = 0;
-    for (const auto &node : nodes) {
-        if (node.externalId() > maxId) {
-            maxId = node.externalId();
+    SurvivorGrid grid(xyz, count, lo, cellSize);
+    std::vector<int> survivorOf(count, -1);
+    std::vector<int> merged;
+    for (int index : order) {
+        const int survivor = grid.find(index, tolerance);
+        if (survivor < 0) {
+            grid.insert(index);
+        } else {
+            survivorOf[static_cast<size_t>(index)] = survivor;
+            merged.push_back(index);
         }
     }
+    if (merged.empty()) {
+        return result;
+    }
     
-    return maxId + 1;
+    // Survivors take the union of the merged restraints
+    QHash<int, Node> survivorsAfter;
+    std::vector<QUuid> removedNodeIds;
+    removedNodeIds.reserve(merged.size());
+    result.survivorOf.reserve(static_cast<int>(merged.size()));
+    result.removedNodes.reserve(merged.size());
+    for (int index : merged) {
+        const Node &node = nodes[static_cast<size_t>(index)];
+        const int survivor = survivorOf[static_cast<size_t>(index)];
+        result.survivorOf.insert(node.id(), nodes[static_cast<size_t>(survivor)].id());
+        result.removedNodes.push_back(node);
+        removedNodeIds.push_back(node.id());
+        for (const NodalLoad &load : m_repository->nodalLoadsAtNode(node.id())) {
+            result.remappedLoads.push_back(load);
+        }
+        
+        const auto restraints = node.restraints();
+        if (!node.hasRestraints()) {
+            continue;
+        }
+        auto after = survivorsAfter.find(survivor);
+        if (after == survivorsAfter.end()) {
+            after = survivorsAfter.insert(survivor, nodes[static_cast<size_t>(survivor)]);
+        }
+        for (int dof = 0; dof < 6; ++dof) {
+            if (restraints[static_cast<size_t>(dof)]) {
+                after.value().setRestraint(dof, true);
+            }
+        }
+    }
+    std::vector<Node> updatedNodes;
+    for (auto it = survivorsAfter.begin(); it != survivorsAfter.end(); ++it) {
+        const Node &before = nodes[static_cast<size_t>(it.key())];
+        if (before.restraints() != it.value().restraints()) {
+            result.updatedNodes.push_back(before);
+            updatedNodes.push_back(it.value());
+        }
+    }
+    
+    // Re-point bars at the survivors; drop the ones that collapse. End
+    // nodes are resolved through handles, so this is a linear sweep.
+    const auto survivorAt = [&](NodeHandle handle) {
+        const Node *node = m_repository->node(handle);
+        if (!node) {
+            return -1;
+        }
+        return survivorOf[static_cast<size_t>(node - nodes.data())];
+    };
+    const EntityView<Bar> bars = m_repository->bars();
+    std::vector<Bar> remappedBars;
+    std::vector<QUuid> removedBarIds;
+    for (size_t i = 0; i < bars.size(); ++i) {
+        const auto ends = m_repository->barEndNodes(m_repository->barHandleAt(i));
+        const int start = survivorAt(ends[0]);
+        const int end = survivorAt(ends[1]);
+        if (start < 0 && end < 0) {
+            continue;
+        }
+        
+        const Bar &bar = bars[i];
+        Bar after = bar;
+        if (start >= 0) {
+            after.setStartNodeId(nodes[static_cast<size_t>(start)].id());
+        }
+        if (end >= 0) {
+            after.setEndNodeId(nodes[static_cast<size_t>(end)].id());
+        }
+        if (after.startNodeId() == after.endNodeId()) {
+            result.removedBars.push_back(bar);
+            removedBarIds.push_back(bar.id());
+            if (const Vector3 *kPoint = m_repository->barKPoint(m_repository->barHandleAt(i))) {
+                result.removedKPoints.insert(bar.id(), *kPoint);
+            }
+            for (const MemberLoad &load : m_repository->memberLoadsOnBar(bar.id())) {
+                result.removedMemberLoads.push_back(load);
+            }
+        } else {
+            result.remappedBars.push_back(bar);
+            remappedBars.push_back(after);
+        }
+    }
+    
+    // Loads on merged nodes move to their survivors
+    std::vector<NodalLoad> remappedLoads = result.remappedLoads;
+    for (NodalLoad &load : remappedLoads) {
+        load.setNodeId(result.survivorOf.value(load.nodeId()));
+    }
+    
+    beginBatch();
+    for (const NodalLoad &load : remappedLoads) {
+        m_repository->updateNodalLoad(load);
+    }
+    for (const Bar &bar : remappedBars) {
+        m_repository->updateBar(bar);
+        m_batchChanges.noteBarUpdated(bar.id());
+    }
+    for (const MemberLoad &load : result.removedMemberLoads) {
+        m_repository->removeMemberLoad(load.id());
+    }
+    m_repository->removeBars(removedBarIds);
+    for (const QUuid &id : removedBarIds) {
+        m_batchChanges.noteBarDeleted(id);
+    }
+    m_repository->removeNodes(removedNodeIds);
+    for (const QUuid &id : removedNodeIds) {
+        notifyNodeDeleted(id);
+    }
+    for (const Node &node : updatedNodes) {
+        m_repository->updateNode(node);
+        notifyNodeUpdated(node.id());
+    }
+    endBatch();
+    
+    return result;
 }
 
-bool NodeService::nodeExists(const QUuid &id) const
+void NodeService::revertMerge(const NodeMergeResult &merge)
+{
+    if (merge.isEmpty()) {
+        return;
+    }
+    
+    beginBatch();
+    for (const Node &node : merge.removedNodes) {
+        if (m_repository->addNode(node)) {
+            notifyNodeCreated(node.id());
+        }
+    }
+    for (const Node &node : merge.updatedNodes) {
+        if (m_repository->updateNode(node)) {
+            notifyNodeUpdated(node.id());
+        }
+    }
+    for (const Bar &bar : merge.removedBars) {
+        if (m_repository->addBar(bar)) {
+            m_batchChanges.noteBarCreated(bar.id());
+        }
+    }
+    for (auto it = merge.removedKPoints.constBegin(); it != merge.removedKPoints.constEnd(); ++it) {
+        m_repository->setBarKPoint(it.key(), it.value());
+    }
+    for (const Bar &bar : merge.remappedBars) {
+        if (m_repository->updateBar(bar)) {
+            m_batchChanges.noteBarUpdated(bar.id());
+        }
+    }
+    for (const NodalLoad &load : merge.remappedLoads) {
+        m_repository->updateNodalLoad(load);
+    }
+    for (const MemberLoad &load : merge.removedMemberLoads) {
+        m_repository->addMemberLoad(load);
+    }
+    endBatch();
+}
+
+void NodeService::beginBatch()
+{
+    ++m_batchDepth;
+}
+
+void NodeService::endBatch()
+{
+    ModelChangeSet changes = takeBatchChanges();
+    if (!changes.isEmpty()) {
+        publishBatchChanges(changes);
+    }
+}
+
+ModelChangeSet NodeService::takeBatchChanges()
+{
+    Q_ASSERT(m_batchDepth > 0);
+    if (--m_batchDepth > 0) {
+        return ModelChangeSet();
+    }
+    return std::exchange(m_batchChanges, ModelChangeSet());
+}
+
+void NodeService::publishBatchChanges(const ModelChangeSet &changes)
 {
-    return m_repository->findNode(id).has_value();
+    emit modelBatchChanged(changes);
+}
+
+void NodeService::notifyNodeCreated(const QUuid &id)
+{
+    if (isBatching()) {
+        m_batchChanges.noteNodeCreated(id);
+    } else {
+        emit nodeCreated(id);
+    }
+}
+
+void NodeService::notifyNodeDeleted(const QUuid &id)
+{
+    if (isBatching()) {
+        m_batchChanges.noteNodeDeleted(id);
+    } else {
+        emit nodeDeleted(id);
+    }
+}
+
+void NodeService::notifyNodeUpdated(const QUuid &id)
+{
+    if (isBatching()) {
+        m_batchChanges.noteNodeUpdated(id);
+    } else {
+        emit nodeUpdated(id);
+    }
 }
 
 } // namespace Structura::App
@@ -1,7 +1,9 @@
 #pragma once
 
 #include "IModelRepository.h"
+#include "ModelChangeSet.h"
 #include "../core/model/Vector3.h"
+#include <QHash>
 #include <QObject>
 #include <QUuid>
 #include <memory>
@@ -11,6 +13,25 @@ namespace Structura::App {
 
 using Vector3 = Structura::Model::Vector3;
 
+/**
+ * @brief Record of a coincident-node merge, sufficient to revert it.
+ * 
+ * Entities are stored as they were before the merge.
+ */
+struct NodeMergeResult
+{
+    QHash<QUuid, QUuid> survivorOf;  ///< Removed node -> node it was merged into
+    std::vector<Node> removedNodes;  ///< Nodes merged away
+    std::vector<Node> updatedNodes;  ///< Surviving nodes whose restraints changed
+    std::vector<Bar> remappedBars;   ///< Bars re-pointed at surviving nodes
+    std::vector<Bar> removedBars;    ///< Bars that collapsed to zero length
+    QHash<QUuid, Vector3> removedKPoints; ///< K-points of the removed bars
+    std::vector<NodalLoad> remappedLoads; ///< Nodal loads moved to surviving nodes
+    std::vector<MemberLoad> removedMemberLoads; ///< Member loads on the removed bars
+    
+    bool isEmpty() const { return removedNodes.empty(); }
+};
+
 /**
  * @brief Service for managing Node entities.
  * 
@@ -53,6 +74,20 @@ public:
      */
     bool deleteNode(const QUuid &id);
     
+    /**
+     * @brief Create several nodes as one batch.
+     * @param positions Positions of the new nodes
+     * @return UUIDs of the created nodes, in input order
+     */
+    std::vector<QUuid> createNodes(const std::vector<Vector3> &positions);
+    
+    /**
+     * @brief Delete several nodes in one repository pass, as one batch.
+     * @param ids UUIDs of the nodes to delete (unknown IDs are ignored)
+     * @return Number of nodes deleted
+     */
+    size_t deleteNodes(const std::vector<QUuid> &ids);
+    
     /**
      * @brief Update the position of a node.
      * @param id UUID of the node
@@ -97,6 +132,9 @@ public:
     
     /**
      * @brief Generate the next available external ID for nodes.
+     * 
+     * O(1): derived from the repository's external ID high-water mark, so IDs
+     * of deleted nodes are not handed out again.
      * @return Next external ID
      */
     int nextExternalId() const;
@@ -107,6 +145,73 @@ public:
      * @return true if node exists
      */
     bool nodeExists(const QUuid &id) const;
+    
+    // ===== Merging =====
+    
+    /// Default merge distance, matching SceneController::kCoordTolerance
+    static constexpr double kDefaultMergeTolerance = 1e-6;
+    
+    /**
+     * @brief Fuse nodes that lie within @p tolerance of each other.
+     * 
+     * Nodes are visited in external ID order; each one either becomes a
+     * survivor or is merged into the nearest survivor within @p tolerance,
+     * so the lowest external ID of a cluster is kept. Survivors take the union
+     * of the merged restraints. Bars and nodal loads are re-pointed at the
+     * survivors, and bars whose ends collapse onto one node are removed
+     * together with their member loads.
+     * 
+     * Survivors are kept in a hash grid whose cells are 16 * @p tolerance
+     * wide, so the 2 * tolerance search box around a node spans at most two
+     * cells per axis; cells are never finer than 2^-40 of the model extent,
+     * which keeps the cell indices finite for a tiny tolerance. Lookups are
+     * expected O(1) unless many nodes crowd into one cell, so the run is
+     * dominated by the O(n log n) sort into external ID order. The merge is
+     * one batch: observers get a single modelBatchChanged covering the nodes
+     * and bars touched.
+     * @param tolerance Maximum distance between merged nodes (model units)
+     * @return What was changed, for revertMerge()
+     */
+    NodeMergeResult mergeCoincidentNodes(double tolerance = kDefaultMergeTolerance);
+    
+    /**
+     * @brief Undo a merge returned by mergeCoincidentNodes(), as one batch.
+     * 
+     * The model must be in the state the merge left it in.
+     * @param merge Result of the merge to revert
+     */
+    void revertMerge(const NodeMergeResult &merge);
+    
+    // ===== Batching (see ModelTransaction) =====
+    
+    /**
+     * @brief Start (or nest) a batch.
+     * 
+     * Until the matching endBatch()/takeBatchChanges(), mutations still reach
+     * the repository immediately but per-entity signals are held back and
+     * recorded in a ModelChangeSet instead.
+     */
+    void beginBatch();
+    
+    /**
+     * @brief End one batch level; the outermost one emits modelBatchChanged.
+     */
+    void endBatch();
+    
+    /**
+     * @brief End one batch level and hand over the recorded changes unpublished.
+     * @return Changes recorded since the outermost beginBatch(), or an empty
+     *         set while an outer batch is still open
+     */
+    ModelChangeSet takeBatchChanges();
+    
+    /**
+     * @brief Emit modelBatchChanged for changes collected elsewhere.
+     * @param changes Change set to publish
+     */
+    void publishBatchChanges(const ModelChangeSet &changes);
+    
+    bool isBatching() const { return m_batchDepth > 0; }
 
 signals:
     /**
@@ -133,9 +238,21 @@ signals:
      * @param newPosition New position
      */
     void nodePositionChanged(const QUuid &nodeId, const Vector3 &newPosition);
+    
+    /**
+     * @brief Emitted once per batch instead of the per-entity signals.
+     * @param changes IDs of everything created, updated or deleted in the batch
+     */
+    void modelBatchChanged(const Structura::App::ModelChangeSet &changes);
 
 private:
+    void notifyNodeCreated(const QUuid &id);
+    void notifyNodeDeleted(const QUuid &id);
+    void notifyNodeUpdated(const QUuid &id);
+    
     IModelRepository *m_repository;
+    int m_batchDepth{0};
+    ModelChangeSet m_batchChanges;
 };
 
 } // namespace Structura::App
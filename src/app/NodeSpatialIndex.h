@@ -0,0 +1,459 @@
+#pragma once
+
+#include <QHash>
+#include <QtGlobal>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <vector>
+
+namespace Structura::App {
+
+/**
+ * @brief Uniform-grid spatial hash over node positions.
+ *
+ * Nodes are identified by their dense index in the owner's storage
+ * (InMemoryModelRepository uses its node order). Each occupied grid cell
+ * keeps its nodes' coordinates inline next to their indices, so scanning a
+ * cell touches one contiguous block instead of chasing every node into the
+ * main arrays. Every node remembers its slot in its cell, so insert, move,
+ * remove and relocate are O(1) plus a logarithmic update of the per-plane
+ * counts that keep the occupied bounds exact, and the index follows
+ * swap-and-pop relocations without rebuilding.
+ *
+ * Queries only visit cells that can contain a hit: a nearest-node query
+ * checks the query's own cell first and then expanding rings of cells,
+ * skipping every cell farther away than the best node found so far. With a
+ * cell size of one to two typical node spacings this is a handful of hash
+ * lookups per query.
+ */
+class NodeSpatialIndex
+{
+public:
+    static constexpr double kDefaultCellSize = 2.0;
+
+    explicit NodeSpatialIndex(double cellSize = kDefaultCellSize)
+    {
+        setCellSizeValue(cellSize);
+    }
+
+    double cellSize() const { return m_cellSize; }
+
+    size_t size() const { return m_keys.size(); }
+
+    /**
+     * @brief Change the cell size and re-bucket @p count nodes.
+     * @param cellSize New edge length of a grid cell (model units, > 0)
+     * @param xyz Interleaved coordinates of the indexed nodes
+     * @param count Number of nodes in @p xyz
+     */
+    void rebuild(double cellSize, const double *xyz, size_t count)
+    {
+        clear();
+        setCellSizeValue(cellSize);
+        m_keys.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            insert(static_cast<int>(i), xyz + 3 * i);
+        }
+    }
+
+    /// Pre-size the per-node arrays for @p count nodes
+    void reserve(size_t count)
+    {
+        m_keys.reserve(count);
+        m_slots.reserve(count);
+    }
+
+    /// Add the node at dense @p index (== size()) positioned at @p xyz
+    void insert(int index, const double *xyz)
+    {
+        m_keys.push_back(0);
+        m_slots.push_back(0);
+        place(index, xyz);
+    }
+
+    /// Refresh the node at @p index after its coordinates changed
+    void update(int index, const double *xyz)
+    {
+        const Cell cell = cellOf(xyz);
+        if (keyOf(cell) == m_keys[static_cast<size_t>(index)]) {
+            Entry &entry = entryOf(index);
+            const Cell old = cellOf(entry);
+            if (old.x != cell.x || old.y != cell.y || old.z != cell.z) {
+                leavePlanes(old); // another cell aliased onto the same key
+                enterPlanes(cell);
+            }
+            entry.x = xyz[0];
+            entry.y = xyz[1];
+            entry.z = xyz[2];
+            return;
+        }
+        remove(index);
+        place(index, xyz);
+    }
+
+    /// Drop the node at @p index (its slot is reused by relocate/truncate)
+    void remove(int index)
+    {
+        auto cell = m_cells.find(m_keys[static_cast<size_t>(index)]);
+        std::vector<Entry> &entries = cell.value();
+        const int slot = m_slots[static_cast<size_t>(index)];
+        Entry &entry = entries[static_cast<size_t>(slot)];
+        leavePlanes(cellOf(entry));
+        entry = entries.back();
+        m_slots[static_cast<size_t>(entry.index)] = slot;
+        entries.pop_back();
+        if (entries.empty()) {
+            m_cells.erase(cell);
+        }
+    }
+
+    /// The node at @p from now lives at dense index @p to (whose slot is free)
+    void relocate(int from, int to)
+    {
+        entryOf(from).index = to;
+        m_keys[static_cast<size_t>(to)] = m_keys[static_cast<size_t>(from)];
+        m_slots[static_cast<size_t>(to)] = m_slots[static_cast<size_t>(from)];
+    }
+
+    /// Drop dense positions past @p count after removals
+    void truncate(size_t count)
+    {
+        m_keys.resize(count);
+        m_slots.resize(count);
+    }
+
+    void clear()
+    {
+        m_cells.clear();
+        m_keys.clear();
+        m_slots.clear();
+        for (std::map<int, int> &planes : m_planes) {
+            planes.clear();
+        }
+    }
+
+    /**
+     * @brief Append the indices of all nodes within @p radius of @p center.
+     */
+    void withinRadius(const double center[3], double radius, std::vector<size_t> &indices) const
+    {
+        const double lo[3] = {center[0] - radius, center[1] - radius, center[2] - radius};
+        const double hi[3] = {center[0] + radius, center[1] + radius, center[2] + radius};
+        const double radiusSquared = radius * radius;
+        forEachCandidate(lo, hi, [&](const Entry &entry) {
+            if (distanceSquared(entry, center) <= radiusSquared) {
+                indices.push_back(static_cast<size_t>(entry.index));
+            }
+        });
+    }
+
+    /**
+     * @brief Append the indices of all nodes inside the axis-aligned box
+     * [@p lo, @p hi] (bounds inclusive).
+     */
+    void inBox(const double lo[3], const double hi[3], std::vector<size_t> &indices) const
+    {
+        forEachCandidate(lo, hi, [&](const Entry &entry) {
+            if (entry.x >= lo[0] && entry.x <= hi[0] &&
+                entry.y >= lo[1] && entry.y <= hi[1] &&
+                entry.z >= lo[2] && entry.z <= hi[2]) {
+                indices.push_back(static_cast<size_t>(entry.index));
+            }
+        });
+    }
+
+    /**
+     * @brief Index of the node closest to @p point, or -1 if none lies
+     * within @p maxDistance.
+     */
+    int nearest(const double point[3],
+                double maxDistance = std::numeric_limits<double>::infinity()) const
+    {
+        if (isEmpty()) {
+            return -1;
+        }
+
+        const Cell home = cellOf(point);
+        const Cell low = lowerBounds();
+        const Cell high = upperBounds();
+        double best = maxDistance * maxDistance;
+        int bestIndex = -1;
+
+        // Distance from the query to the nearest face of its own cell: every
+        // node in ring k >= 1 is at least (k - 1) cells plus this far away
+        double gap = std::numeric_limits<double>::infinity();
+        const int homeCoords[3] = {home.x, home.y, home.z};
+        for (int axis = 0; axis < 3; ++axis) {
+            const double cellStart = homeCoords[axis] * m_cellSize;
+            gap = std::min(gap, std::min(point[axis] - cellStart, cellStart + m_cellSize - point[axis]));
+        }
+        gap = std::max(gap, 0.0);
+
+        // Rings closer than the occupied bounds are empty; rings past them too
+        const int firstRing = std::max({0,
+            low.x - home.x, home.x - high.x,
+            low.y - home.y, home.y - high.y,
+            low.z - home.z, home.z - high.z});
+        const int lastRing = std::max({
+            std::abs(low.x - home.x), std::abs(high.x - home.x),
+            std::abs(low.y - home.y), std::abs(high.y - home.y),
+            std::abs(low.z - home.z), std::abs(high.z - home.z)});
+
+        const auto visitCell = [&](int x, int y, int z) {
+            const double reach = cellDistanceSquared(x, y, z, point);
+            if (reach > best || (reach == best && bestIndex >= 0)) {
+                return;
+            }
+            const auto cell = m_cells.constFind(keyOf(Cell{x, y, z}));
+            if (cell == m_cells.constEnd()) {
+                return;
+            }
+            for (const Entry &entry : cell.value()) {
+                const double d = distanceSquared(entry, point);
+                if (d < best || (d == best && bestIndex < 0)) {
+                    best = d;
+                    bestIndex = entry.index;
+                }
+            }
+        };
+
+        for (int ring = firstRing; ring <= lastRing; ++ring) {
+            if (ring > 0) {
+                const double bound = (ring - 1) * m_cellSize + gap;
+                if (bound * bound > best) {
+                    break;
+                }
+            }
+
+            // Visit the shell of the (2 ring + 1)^3 cube, clipped to the bounds
+            const int x0 = std::max(home.x - ring, low.x), x1 = std::min(home.x + ring, high.x);
+            const int y0 = std::max(home.y - ring, low.y), y1 = std::min(home.y + ring, high.y);
+            const int z0 = std::max(home.z - ring, low.z), z1 = std::min(home.z + ring, high.z);
+            for (int x = x0; x <= x1; ++x) {
+                const bool xFace = std::abs(x - home.x) == ring;
+                for (int y = y0; y <= y1; ++y) {
+                    if (xFace || std::abs(y - home.y) == ring) {
+                        for (int z = z0; z <= z1; ++z) {
+                            visitCell(x, y, z);
+                        }
+                    } else {
+                        if (home.z - ring >= low.z) {
+                            visitCell(x, y, home.z - ring);
+                        }
+                        if (home.z + ring <= high.z) {
+                            visitCell(x, y, home.z + ring);
+                        }
+                    }
+                }
+            }
+        }
+        return bestIndex;
+    }
+
+    /// Approximate heap bytes held by the index (hash nodes are estimated)
+    size_t memoryUsage() const
+    {
+        size_t bytes = m_keys.capacity() * sizeof(quint64) + m_slots.capacity() * sizeof(int);
+        for (const std::map<int, int> &planes : m_planes) {
+            bytes += planes.size() * (sizeof(std::pair<const int, int>) + 4 * sizeof(void *));
+        }
+        for (auto it = m_cells.constBegin(); it != m_cells.constEnd(); ++it) {
+            bytes += sizeof(quint64) + sizeof(std::vector<Entry>) + 2 * sizeof(void *)
+                   + it.value().capacity() * sizeof(Entry);
+        }
+        return bytes;
+    }
+
+private:
+    struct Cell
+    {
+        int x;
+        int y;
+        int z;
+    };
+
+    struct Entry
+    {
+        double x;
+        double y;
+        double z;
+        int index;
+    };
+
+    // Cell coordinates are clamped well inside int range; keys pack 21 bits
+    // per axis, so cells 2^21 apart share a bucket. That only lengthens the
+    // bucket: candidates are always checked against their real coordinates.
+    static constexpr double kCellLimit = 1 << 30;
+    static constexpr quint64 kKeyMask = (quint64(1) << 21) - 1;
+
+    void setCellSizeValue(double cellSize)
+    {
+        m_cellSize = cellSize > 0.0 ? cellSize : kDefaultCellSize;
+        m_inverseCellSize = 1.0 / m_cellSize;
+    }
+
+    int cellCoordinate(double value) const
+    {
+        double c = std::floor(value * m_inverseCellSize);
+        if (!(c > -kCellLimit)) {
+            c = -kCellLimit; // also catches NaN
+        } else if (c > kCellLimit) {
+            c = kCellLimit;
+        }
+        return static_cast<int>(c);
+    }
+
+    Cell cellOf(const double *xyz) const
+    {
+        return Cell{cellCoordinate(xyz[0]), cellCoordinate(xyz[1]), cellCoordinate(xyz[2])};
+    }
+
+    static quint64 keyOf(const Cell &cell)
+    {
+        return ((static_cast<quint64>(static_cast<std::uint32_t>(cell.x)) & kKeyMask) << 42) |
+               ((static_cast<quint64>(static_cast<std::uint32_t>(cell.y)) & kKeyMask) << 21) |
+               (static_cast<quint64>(static_cast<std::uint32_t>(cell.z)) & kKeyMask);
+    }
+
+    static double distanceSquared(const Entry &entry, const double point[3])
+    {
+        const double dx = entry.x - point[0];
+        const double dy = entry.y - point[1];
+        const double dz = entry.z - point[2];
+        return dx * dx + dy * dy + dz * dz;
+    }
+
+    /// Squared distance from @p point to the closest point of cell (x, y, z)
+    double cellDistanceSquared(int x, int y, int z, const double point[3]) const
+    {
+        const int cell[3] = {x, y, z};
+        double sum = 0.0;
+        for (int axis = 0; axis < 3; ++axis) {
+            const double low = cell[axis] * m_cellSize;
+            const double d = point[axis] < low ? low - point[axis]
+                           : point[axis] > low + m_cellSize ? point[axis] - low - m_cellSize
+                           : 0.0;
+            sum += d * d;
+        }
+        return sum;
+    }
+
+    Cell cellOf(const Entry &entry) const
+    {
+        const double xyz[3] = {entry.x, entry.y, entry.z};
+        return cellOf(xyz);
+    }
+
+    Entry &entryOf(int index)
+    {
+        return m_cells[m_keys[static_cast<size_t>(index)]][static_cast<size_t>(m_slots[static_cast<size_t>(index)])];
+    }
+
+    /// Call @p visit for every entry in a cell overlapping [lo, hi]
+    template <typename Visit>
+    void forEachCandidate(const double lo[3], const double hi[3], Visit &&visit) const
+    {
+        if (isEmpty()) {
+            return;
+        }
+        const Cell low = lowerBounds();
+        const Cell high = upperBounds();
+        const Cell a = cellOf(lo);
+        const Cell b = cellOf(hi);
+        const int x0 = std::max(a.x, low.x), x1 = std::min(b.x, high.x);
+        const int y0 = std::max(a.y, low.y), y1 = std::min(b.y, high.y);
+        const int z0 = std::max(a.z, low.z), z1 = std::min(b.z, high.z);
+        if (x0 > x1 || y0 > y1 || z0 > z1) {
+            return;
+        }
+
+        // A box spanning more cells than are occupied is cheaper to sweep
+        const double cells = (double(x1) - x0 + 1) * (double(y1) - y0 + 1) * (double(z1) - z0 + 1);
+        if (cells > static_cast<double>(m_cells.size())) {
+            for (auto cell = m_cells.constBegin(); cell != m_cells.constEnd(); ++cell) {
+                for (const Entry &entry : cell.value()) {
+                    visit(entry);
+                }
+            }
+            return;
+        }
+
+        for (int x = x0; x <= x1; ++x) {
+            for (int y = y0; y <= y1; ++y) {
+                for (int z = z0; z <= z1; ++z) {
+                    const auto cell = m_cells.constFind(keyOf(Cell{x, y, z}));
+                    if (cell == m_cells.constEnd()) {
+                        continue;
+                    }
+                    for (const Entry &entry : cell.value()) {
+                        visit(entry);
+                    }
+                }
+            }
+        }
+    }
+
+    /// Put node @p index, whose key and slot are stale, into the cell of @p xyz
+    void place(int index, const double *xyz)
+    {
+        const Cell cell = cellOf(xyz);
+        const quint64 key = keyOf(cell);
+        std::vector<Entry> &entries = m_cells[key];
+        m_keys[static_cast<size_t>(index)] = key;
+        m_slots[static_cast<size_t>(index)] = static_cast<int>(entries.size());
+        entries.push_back(Entry{xyz[0], xyz[1], xyz[2], index});
+        enterPlanes(cell);
+    }
+
+    void enterPlanes(const Cell &cell)
+    {
+        ++m_planes[0][cell.x];
+        ++m_planes[1][cell.y];
+        ++m_planes[2][cell.z];
+    }
+
+    void leavePlanes(const Cell &cell)
+    {
+        const int coords[3] = {cell.x, cell.y, cell.z};
+        for (int axis = 0; axis < 3; ++axis) {
+            const auto plane = m_planes[axis].find(coords[axis]);
+            if (--plane->second == 0) {
+                m_planes[axis].erase(plane);
+            }
+        }
+    }
+
+    bool isEmpty() const { return m_planes[0].empty(); }
+
+    /// Lowest occupied cell coordinate per axis; the index must not be empty
+    Cell lowerBounds() const
+    {
+        return Cell{m_planes[0].begin()->first, m_planes[1].begin()->first, m_planes[2].begin()->first};
+    }
+
+    /// Highest occupied cell coordinate per axis; the index must not be empty
+    Cell upperBounds() const
+    {
+        return Cell{m_planes[0].rbegin()->first, m_planes[1].rbegin()->first, m_planes[2].rbegin()->first};
+    }
+
+    double m_cellSize{kDefaultCellSize};
+    double m_inverseCellSize{1.0 / kDefaultCellSize};
+
+    // Occupied cell -> its nodes, coordinates inline
+    QHash<quint64, std::vector<Entry>> m_cells;
+
+    // Cell key of each node and its position in that cell's entries, by dense index
+    std::vector<quint64> m_keys;
+    std::vector<int> m_slots;
+
+    // Nodes per occupied cell coordinate of each axis: the first and last
+    // keys bound the occupied cells exactly, also after removals and moves
+    std::map<int, int> m_planes[3];
+};
+
+} // namespace Structura::App
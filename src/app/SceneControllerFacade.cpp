@@ -1,5 +1,7 @@
 #include "SceneControllerFacade.h"
 
+#include <algorithm>
+
 namespace Structura::App {
 
 SceneControllerFacade::SceneControllerFacade(
@@ -22,6 +24,8 @@ SceneControllerFacade::SceneControllerFacade(
                 this, &SceneControllerFacade::onNodeDeleted);
         connect(m_nodeService, &NodeService::nodeUpdated,
                 this, &SceneControllerFacade::onNodeUpdated);
+        connect(m_nodeService, &NodeService::modelBatchChanged,
+                this, &SceneControllerFacade::onModelBatchChanged);
     }
     
     if (m_barService) {
@@ -31,6 +35,8 @@ SceneControllerFacade::SceneControllerFacade(
                 this, &SceneControllerFacade::onBarDeleted);
         connect(m_barService, &BarService::barUpdated,
                 this, &SceneControllerFacade::onBarUpdated);
+        connect(m_barService, &BarService::modelBatchChanged,
+                this, &SceneControllerFacade::onModelBatchChanged);
     }
 }
 
@@ -48,55 +54,110 @@ void SceneControllerFacade::refreshAll()
         return;
     }
     
-    Structura::Viz::ModelSnapshot snapshot;
-    buildModelSnapshot(snapshot);
-    m_renderer->renderSnapshot(snapshot);
+    syncSnapshot();
+    m_renderer->renderSnapshot(m_snapshot);
     
     emit modelChanged();
 }
 
-void SceneControllerFacade::buildModelSnapshot(Structura::Viz::ModelSnapshot& snapshot) const
+void SceneControllerFacade::refreshNodePositions()
 {
-    if (!m_repository) {
+    if (!m_renderer || !m_repository) {
         return;
     }
     
-    // Convert nodes
-    auto nodes = m_repository->allNodes();
-    snapshot.nodes.reserve(nodes.size());
-    for (const auto& node : nodes) {
-        auto nodeData = convertToNodeData(node);
-        nodeData.isSelected = m_selectedNodeIds.contains(node.id());
-        nodeData.isHighlighted = (m_highlightedNodeId == node.id());
-        snapshot.nodes.push_back(nodeData);
+    m_renderer->updateNodePositions(m_repository->nodeCoordinates(), m_repository->nodeCount());
+}
+
+void SceneControllerFacade::syncSnapshot()
+{
+    if (!m_repository) {
+        m_snapshot = Structura::Viz::ModelSnapshot();
+        m_snapshotVersion.reset();
+        return;
     }
     
-    // Convert bars
-    auto bars = m_repository->allBars();
-    snapshot.bars.reserve(bars.size());
-    for (const auto& bar : bars) {
-        auto barData = convertToBarData(bar);
-        barData.isSelected = m_selectedBarIds.contains(bar.id());
-        snapshot.bars.push_back(barData);
+    // Reads only the immutable version (plus selection state), so this does
+    // not touch the live repository
+    std::shared_ptr<const ModelVersion> version = m_repository->snapshot();
+    if (version == m_snapshotVersion && !m_snapshotFlagsStale) {
+        return;
     }
     
-    // Convert grid lines
-    snapshot.gridLines.reserve(m_gridLines.size());
-    for (const auto& line : m_gridLines) {
+    syncNodeData(*version, m_snapshotVersion.get());
+    syncBarData(*version, m_snapshotVersion.get());
+    
+    // Grid lines are few; convert them all
+    m_snapshot.gridLines.clear();
+    m_snapshot.gridLines.reserve(version->gridLines.size());
+    for (const auto& line : version->gridLines) {
         auto lineData = convertToGridLineData(line);
         lineData.isHighlighted = (m_highlightedGridLineId == line.id());
-        snapshot.gridLines.push_back(lineData);
+        m_snapshot.gridLines.push_back(lineData);
     }
     
-    // TODO: Add loads, supports, LCS when available
-    snapshot.showBarLCS = false;
+    // Loads, supports and bar axes are still drawn by SceneController
+    m_snapshot.showBarLCS = false;
+    
+    m_snapshotVersion = std::move(version);
+    m_snapshotFlagsStale = false;
+}
+
+void SceneControllerFacade::syncNodeData(const ModelVersion& version, const ModelVersion* previous)
+{
+    constexpr size_t chunkSize = VersionedArray<Structura::Model::Node>::kChunkSize;
+    m_snapshot.nodes.resize(version.nodes.size());
+    for (size_t c = 0; c < version.nodes.chunkCount(); ++c) {
+        const bool changed = !previous || c >= previous->nodes.chunkCount()
+                             || version.nodes.chunk(c) != previous->nodes.chunk(c)
+                             || version.nodeHandles.chunk(c) != previous->nodeHandles.chunk(c);
+        if (!changed && !m_snapshotFlagsStale) {
+            continue;
+        }
+        
+        const size_t end = std::min(version.nodes.size(), (c + 1) * chunkSize);
+        for (size_t i = c * chunkSize; i < end; ++i) {
+            auto& nodeData = m_snapshot.nodes[i];
+            if (changed) {
+                nodeData = convertToNodeData(version.nodes[i], version.nodeHandles[i]);
+            }
+            nodeData.isSelected = m_selectedNodeHandles.contains(nodeData.handle);
+            nodeData.isHighlighted = (m_highlightedNodeId == nodeData.id);
+        }
+    }
+}
+
+void SceneControllerFacade::syncBarData(const ModelVersion& version, const ModelVersion* previous)
+{
+    constexpr size_t chunkSize = VersionedArray<Structura::Model::Bar>::kChunkSize;
+    m_snapshot.bars.resize(version.bars.size());
+    for (size_t c = 0; c < version.bars.chunkCount(); ++c) {
+        const bool changed = !previous || c >= previous->bars.chunkCount()
+                             || version.bars.chunk(c) != previous->bars.chunk(c)
+                             || version.barHandles.chunk(c) != previous->barHandles.chunk(c)
+                             || version.barEndNodes.chunk(c) != previous->barEndNodes.chunk(c);
+        if (!changed && !m_snapshotFlagsStale) {
+            continue;
+        }
+        
+        const size_t end = std::min(version.bars.size(), (c + 1) * chunkSize);
+        for (size_t i = c * chunkSize; i < end; ++i) {
+            auto& barData = m_snapshot.bars[i];
+            if (changed) {
+                barData = convertToBarData(version.bars[i], version.barHandles[i], version.barEndNodes[i]);
+            }
+            barData.isSelected = m_selectedBarHandles.contains(barData.handle);
+        }
+    }
 }
 
 Structura::Viz::ModelSnapshot::NodeData 
-SceneControllerFacade::convertToNodeData(const Structura::Model::Node& node) const
+SceneControllerFacade::convertToNodeData(const Structura::Model::Node& node,
+                                         Structura::Model::NodeHandle handle) const
 {
     Structura::Viz::ModelSnapshot::NodeData data;
     data.id = node.id();
+    data.handle = handle;
     data.externalId = node.externalId();
     data.x = node.position().x();
     data.y = node.position().y();
@@ -107,13 +168,16 @@ SceneControllerFacade::convertToNodeData(const Structura::Model::Node& node) con
 }
 
 Structura::Viz::ModelSnapshot::BarData 
-SceneControllerFacade::convertToBarData(const Structura::Model::Bar& bar) const
+SceneControllerFacade::convertToBarData(const Structura::Model::Bar& bar,
+                                        Structura::Model::BarHandle handle,
+                                        const std::array<Structura::Model::NodeHandle, 2>& endNodes) const
 {
     Structura::Viz::ModelSnapshot::BarData data;
     data.id = bar.id();
+    data.handle = handle;
     data.externalId = bar.externalId();
-    data.startNodeId = bar.startNodeId();
-    data.endNodeId = bar.endNodeId();
+    data.startNode = endNodes[0];
+    data.endNode = endNodes[1];
     data.isSelected = false; // Set by caller
     return data;
 }
@@ -141,9 +205,16 @@ void SceneControllerFacade::setSelectedNodes(const QSet<QUuid>& nodeIds)
     }
     
     m_selectedNodeIds = nodeIds;
+    m_selectedNodeHandles.clear();
+    m_snapshotFlagsStale = true;
+    if (m_repository) {
+        for (const QUuid& id : nodeIds) {
+            m_selectedNodeHandles.insert(m_repository->nodeHandle(id));
+        }
+    }
     
     if (m_renderer) {
-        m_renderer->setSelectedNodes(nodeIds);
+        m_renderer->setSelectedNodes(selectedNodeHandles());
     }
     
     emit selectionChanged();
@@ -156,9 +227,16 @@ void SceneControllerFacade::setSelectedBars(const QSet<QUuid>& barIds)
     }
     
     m_selectedBarIds = barIds;
+    m_selectedBarHandles.clear();
+    m_snapshotFlagsStale = true;
+    if (m_repository) {
+        for (const QUuid& id : barIds) {
+            m_selectedBarHandles.insert(m_repository->barHandle(id));
+        }
+    }
     
     if (m_renderer) {
-        m_renderer->setSelectedBars(barIds);
+        m_renderer->setSelectedBars(selectedBarHandles());
     }
     
     emit selectionChanged();
@@ -170,10 +248,13 @@ void SceneControllerFacade::clearSelection()
     
     m_selectedNodeIds.clear();
     m_selectedBarIds.clear();
+    m_selectedNodeHandles.clear();
+    m_selectedBarHandles.clear();
+    m_snapshotFlagsStale = true;
     
     if (m_renderer) {
-        m_renderer->setSelectedNodes(QSet<QUuid>());
-        m_renderer->setSelectedBars(QSet<QUuid>());
+        m_renderer->setSelectedNodes({});
+        m_renderer->setSelectedBars({});
     }
     
     if (changed) {
@@ -192,9 +273,11 @@ void SceneControllerFacade::highlightNode(const QUuid& nodeId)
     m_highlightedNodeId = nodeId;
     m_highlightedBarId = QUuid();
     m_highlightedGridLineId = QUuid();
+    m_snapshotFlagsStale = true;
     
     if (m_renderer) {
-        m_renderer->highlightNode(nodeId);
+        m_renderer->highlightNode(m_repository && !nodeId.isNull() ? m_repository->nodeHandle(nodeId)
+                                                                   : Structura::Model::NodeHandle{});
     }
 }
 
@@ -204,9 +287,15 @@ void SceneControllerFacade::highlightBar(const QUuid& barId)
         return;
     }
     
+    const bool hadNode = !m_highlightedNodeId.isNull();
     m_highlightedNodeId = QUuid();
     m_highlightedBarId = barId;
     m_highlightedGridLineId = QUuid();
+    m_snapshotFlagsStale = true;
+    
+    if (m_renderer && hadNode) {
+        m_renderer->highlightNode({});
+    }
     
     // Bar highlighting would need implementation in ISceneRenderer
     // For now, just update state
@@ -218,11 +307,16 @@ void SceneControllerFacade::highlightGridLine(const QUuid& lineId)
         return;
     }
     
+    const bool hadNode = !m_highlightedNodeId.isNull();
     m_highlightedNodeId = QUuid();
     m_highlightedBarId = QUuid();
     m_highlightedGridLineId = lineId;
+    m_snapshotFlagsStale = true;
     
     if (m_renderer) {
+        if (hadNode) {
+            m_renderer->highlightNode({});
+        }
         m_renderer->highlightGridLine(lineId);
     }
 }
@@ -232,9 +326,10 @@ void SceneControllerFacade::clearHighlight()
     m_highlightedNodeId = QUuid();
     m_highlightedBarId = QUuid();
     m_highlightedGridLineId = QUuid();
+    m_snapshotFlagsStale = true;
     
     if (m_renderer) {
-        m_renderer->highlightNode(QUuid());
+        m_renderer->highlightNode({});
         m_renderer->highlightGridLine(QUuid());
     }
 }
@@ -243,7 +338,19 @@ void SceneControllerFacade::clearHighlight()
 
 void SceneControllerFacade::updateGridLines(const std::vector<Structura::Model::GridLine>& gridLines)
 {
-    m_gridLines = gridLines;
+    if (m_repository) {
+        std::vector<QUuid> previous;
+        previous.reserve(m_repository->gridLineCount());
+        for (const auto& line : m_repository->gridLines()) {
+            previous.push_back(line.id());
+        }
+        for (const QUuid& id : previous) {
+            m_repository->removeGridLine(id);
+        }
+        for (const auto& line : gridLines) {
+            m_repository->addGridLine(line);
+        }
+    }
     
     if (m_renderer) {
         std::vector<Structura::Viz::ModelSnapshot::GridLineData> gridData;
@@ -332,6 +439,11 @@ bool SceneControllerFacade::pickWorldPoint(int displayX, int displayY,
 
 void SceneControllerFacade::onNodeCreated(const QUuid& nodeId)
 {
+    // The selection may name a UUID before its entity exists
+    if (m_repository && m_selectedNodeIds.contains(nodeId)) {
+        m_selectedNodeHandles.insert(m_repository->nodeHandle(nodeId));
+        m_snapshotFlagsStale = true;
+    }
     updateNodeRendering();
     emit modelChanged();
 }
@@ -339,12 +451,20 @@ void SceneControllerFacade::onNodeCreated(const QUuid& nodeId)
 void SceneControllerFacade::onNodeDeleted(const QUuid& nodeId)
 {
     // Remove from selection if deleted
-    m_selectedNodeIds.remove(nodeId);
-    if (m_highlightedNodeId == nodeId) {
+    const bool wasSelected = m_selectedNodeIds.remove(nodeId);
+    const bool wasHighlighted = m_highlightedNodeId == nodeId;
+    if (wasHighlighted) {
         m_highlightedNodeId = QUuid();
+        m_snapshotFlagsStale = true;
     }
     
     updateNodeRendering();
+    if (m_renderer && wasSelected) {
+        m_renderer->setSelectedNodes(selectedNodeHandles());
+    }
+    if (m_renderer && wasHighlighted) {
+        m_renderer->highlightNode({});
+    }
     emit modelChanged();
 }
 
@@ -356,6 +476,10 @@ void SceneControllerFacade::onNodeUpdated(const QUuid& nodeId)
 
 void SceneControllerFacade::onBarCreated(const QUuid& barId)
 {
+    if (m_repository && m_selectedBarIds.contains(barId)) {
+        m_selectedBarHandles.insert(m_repository->barHandle(barId));
+        m_snapshotFlagsStale = true;
+    }
     updateBarRendering();
     emit modelChanged();
 }
@@ -363,12 +487,15 @@ void SceneControllerFacade::onBarCreated(const QUuid& barId)
 void SceneControllerFacade::onBarDeleted(const QUuid& barId)
 {
     // Remove from selection if deleted
-    m_selectedBarIds.remove(barId);
+    const bool wasSelected = m_selectedBarIds.remove(barId);
     if (m_highlightedBarId == barId) {
         m_highlightedBarId = QUuid();
     }
     
     updateBarRendering();
+    if (m_renderer && wasSelected) {
+        m_renderer->setSelectedBars(selectedBarHandles());
+    }
     emit modelChanged();
 }
 
@@ -378,6 +505,41 @@ void SceneControllerFacade::onBarUpdated(const QUuid& barId)
     emit modelChanged();
 }
 
+void SceneControllerFacade::onModelBatchChanged(const ModelChangeSet& changes)
+{
+    // Remove deleted entities from selection and highlight
+    for (const QUuid& id : changes.deletedNodes) {
+        m_selectedNodeIds.remove(id);
+        if (m_highlightedNodeId == id) {
+            m_highlightedNodeId = QUuid();
+        }
+    }
+    for (const QUuid& id : changes.deletedBars) {
+        m_selectedBarIds.remove(id);
+        if (m_highlightedBarId == id) {
+            m_highlightedBarId = QUuid();
+        }
+    }
+    
+    // The selection may name a UUID before its entity exists
+    if (m_repository) {
+        for (const QUuid& id : changes.createdNodes) {
+            if (m_selectedNodeIds.contains(id)) {
+                m_selectedNodeHandles.insert(m_repository->nodeHandle(id));
+            }
+        }
+        for (const QUuid& id : changes.createdBars) {
+            if (m_selectedBarIds.contains(id)) {
+                m_selectedBarHandles.insert(m_repository->barHandle(id));
+            }
+        }
+    }
+    
+    // One render (and one modelChanged) for the whole batch
+    m_snapshotFlagsStale = true;
+    refreshAll();
+}
+
 // Helper methods
 
 void SceneControllerFacade::updateNodeRendering()
@@ -386,18 +548,8 @@ void SceneControllerFacade::updateNodeRendering()
         return;
     }
     
-    auto nodes = m_repository->allNodes();
-    std::vector<Structura::Viz::ModelSnapshot::NodeData> nodeData;
-    nodeData.reserve(nodes.size());
-    
-    for (const auto& node : nodes) {
-        auto data = convertToNodeData(node);
-        data.isSelected = m_selectedNodeIds.contains(node.id());
-        data.isHighlighted = (m_highlightedNodeId == node.id());
-        nodeData.push_back(data);
-    }
-    
-    m_renderer->updateNodes(nodeData);
+    syncSnapshot();
+    m_renderer->updateNodes(m_snapshot.nodes);
 }
 
 void SceneControllerFacade::updateBarRendering()
@@ -406,17 +558,40 @@ void SceneControllerFacade::updateBarRendering()
         return;
     }
     
-    auto bars = m_repository->allBars();
-    std::vector<Structura::Viz::ModelSnapshot::BarData> barData;
-    barData.reserve(bars.size());
-    
-    for (const auto& bar : bars) {
-        auto data = convertToBarData(bar);
-        data.isSelected = m_selectedBarIds.contains(bar.id());
-        barData.push_back(data);
+    syncSnapshot();
+    m_renderer->updateBars(m_snapshot.bars);
+}
+
+std::vector<Structura::Model::NodeHandle> SceneControllerFacade::selectedNodeHandles() const
+{
+    std::vector<Structura::Model::NodeHandle> handles;
+    if (!m_repository) {
+        return handles;
     }
-    
-    m_renderer->updateBars(barData);
+    handles.reserve(static_cast<size_t>(m_selectedNodeIds.size()));
+    for (const QUuid& id : m_selectedNodeIds) {
+        const auto handle = m_repository->nodeHandle(id);
+        if (handle.isValid()) {
+            handles.push_back(handle);
+        }
+    }
+    return handles;
+}
+
+std::vector<Structura::Model::BarHandle> SceneControllerFacade::selectedBarHandles() const
+{
+    std::vector<Structura::Model::BarHandle> handles;
+    if (!m_repository) {
+        return handles;
+    }
+    handles.reserve(static_cast<size_t>(m_selectedBarIds.size()));
+    for (const QUuid& id : m_selectedBarIds) {
+        const auto handle = m_repository->barHandle(id);
+        if (handle.isValid()) {
+            handles.push_back(handle);
+        }
+    }
+    return handles;
 }
 
 } // namespace Structura::App
@@ -8,7 +8,9 @@
 
 #include <QObject>
 #include <QUuid>
+#include <array>
 #include <memory>
+#include <vector>
 
 namespace Structura::App {
 
@@ -45,6 +47,10 @@ public:
     // Full model synchronization
     void refreshAll();
     
+    // Geometry-only synchronization: pushes the repository's coordinate
+    // block straight to the renderer (no per-node conversion)
+    void refreshNodePositions();
+    
     // Selection management
     void setSelectedNodes(const QSet<QUuid>& nodeIds);
     void setSelectedBars(const QSet<QUuid>& barIds);
@@ -56,7 +62,8 @@ public:
     void highlightGridLine(const QUuid& lineId);
     void clearHighlight();
     
-    // Grid visualization
+    // Grid visualization. updateGridLines() replaces the repository's grid
+    // lines, so later full refreshes draw the same ones.
     void updateGridLines(const std::vector<Structura::Model::GridLine>& gridLines);
     void showGridGhostLine(int axis, const Vector3& start, const Vector3& end);
     void hideGridGhostLine();
@@ -85,15 +92,26 @@ private slots:
     void onBarCreated(const QUuid& barId);
     void onBarDeleted(const QUuid& barId);
     void onBarUpdated(const QUuid& barId);
+    
+    void onModelBatchChanged(const Structura::App::ModelChangeSet& changes);
 
 private:
     // Helper methods
-    void buildModelSnapshot(Structura::Viz::ModelSnapshot& snapshot) const;
+    void syncSnapshot();
+    void syncNodeData(const ModelVersion& version, const ModelVersion* previous);
+    void syncBarData(const ModelVersion& version, const ModelVersion* previous);
     void updateNodeRendering();
     void updateBarRendering();
     
-    Structura::Viz::ModelSnapshot::NodeData convertToNodeData(const Structura::Model::Node& node) const;
-    Structura::Viz::ModelSnapshot::BarData convertToBarData(const Structura::Model::Bar& bar) const;
+    // Handles of the selected entities that exist, for the renderer
+    std::vector<Structura::Model::NodeHandle> selectedNodeHandles() const;
+    std::vector<Structura::Model::BarHandle> selectedBarHandles() const;
+    
+    Structura::Viz::ModelSnapshot::NodeData convertToNodeData(const Structura::Model::Node& node,
+                                                              Structura::Model::NodeHandle handle) const;
+    Structura::Viz::ModelSnapshot::BarData convertToBarData(const Structura::Model::Bar& bar,
+                                                            Structura::Model::BarHandle handle,
+                                                            const std::array<Structura::Model::NodeHandle, 2>& endNodes) const;
     Structura::Viz::ModelSnapshot::GridLineData convertToGridLineData(const Structura::Model::GridLine& line) const;
 
 private:
@@ -103,17 +121,26 @@ private:
     BarService* m_barService;
     Structura::Viz::ISceneRenderer* m_renderer;
     
-    // Current selection state
+    // Current selection state. The UUID sets are what callers see; the
+    // renderer gets handles, and the handle sets answer per-entity queries
+    // during refresh by array indexing. Handles of deleted entities go stale
+    // on their own.
     QSet<QUuid> m_selectedNodeIds;
     QSet<QUuid> m_selectedBarIds;
+    Structura::Model::EntityHandleSet<Structura::Model::Node> m_selectedNodeHandles;
+    Structura::Model::EntityHandleSet<Structura::Model::Bar> m_selectedBarHandles;
     
     // Current highlight state
     QUuid m_highlightedNodeId;
     QUuid m_highlightedBarId;
     QUuid m_highlightedGridLineId;
     
-    // Grid lines (managed separately from repository)
-    std::vector<Structura::Model::GridLine> m_gridLines;
+    // Renderer data of the last published version. A refresh converts only
+    // the chunks that version does not share with m_snapshotVersion, and
+    // re-derives the selection and highlight flags when m_snapshotFlagsStale.
+    Structura::Viz::ModelSnapshot m_snapshot;
+    std::shared_ptr<const ModelVersion> m_snapshotVersion;
+    bool m_snapshotFlagsStale{true};
 };
 
 } // namespace Structura::App
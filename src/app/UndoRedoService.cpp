@@ -1,5 +1,6 @@
 #include "UndoRedoService.h"
 
+#include "NodeService.h"
 #include "../SceneController.h"
 
 #include <QAction>
@@ -103,6 +104,35 @@ private:
     std::optional<QUuid> m_newSection;
 };
 
+class MergeNodesCommandImpl : public QUndoCommand
+{
+public:
+    MergeNodesCommandImpl(NodeService *nodes, double tolerance, QUndoCommand *parent = nullptr)
+        : QUndoCommand(parent)
+        , m_nodes(nodes)
+        , m_tolerance(tolerance)
+    {
+        setText(QObject::tr("Mesclar nós coincidentes"));
+    }
+
+    void undo() override
+    {
+        m_nodes->revertMerge(m_merge);
+    }
+
+    void redo() override
+    {
+        m_merge = m_nodes->mergeCoincidentNodes(m_tolerance);
+        // A merge that found nothing is dropped by QUndoStack::push
+        setObsolete(m_merge.isEmpty());
+    }
+
+private:
+    NodeService *m_nodes;
+    double m_tolerance;
+    NodeMergeResult m_merge;
+};
+
 } // namespace
 
 UndoRedoService::UndoRedoService(QObject *parent)
@@ -160,4 +190,13 @@ void UndoRedoService::pushSetBarPropertiesCommand(SceneController *scene,
                                                   newSection));
 }
 
+void UndoRedoService::pushMergeNodesCommand(NodeService *nodes, double tolerance)
+{
+    if (!nodes) {
+        return;
+    }
+
+    m_stack->push(new MergeNodesCommandImpl(nodes, tolerance));
+}
+
 } // namespace Structura::App
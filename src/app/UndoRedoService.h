@@ -13,6 +13,8 @@ class SceneController;
 
 namespace Structura::App {
 
+class NodeService;
+
 /**
  * @brief Service wrapper around QUndoStack providing domain specific commands.
  */
@@ -39,6 +41,14 @@ public:
                                      const std::optional<QUuid> &newMaterial,
                                      const std::optional<QUuid> &newSection);
 
+    /**
+     * @brief Merge coincident nodes as one undoable step.
+     * 
+     * Nothing is pushed if no nodes lie within @p tolerance of each other.
+     * @see NodeService::mergeCoincidentNodes
+     */
+    void pushMergeNodesCommand(NodeService *nodes, double tolerance);
+
 private:
     class MoveNodesCommand;
     class SetBarPropertiesCommand;
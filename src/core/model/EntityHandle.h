@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Structura::Model {
+
+class Node;
+class Bar;
+
+/**
+ * @brief Compact runtime identity of a model entity.
+ *
+ * A handle is a slot index plus the generation of that slot. Resolving it is
+ * array indexing, and a handle goes stale (instead of silently aliasing a new
+ * entity) once its entity is removed and the slot reused. Handles are only
+ * meaningful within one repository instance and are not persisted; the QUuid
+ * remains the persistent key for files and undo.
+ *
+ * Invariants:
+ * - generation 0 is never issued, so a default-constructed handle is invalid
+ */
+template <typename Entity>
+class EntityHandle
+{
+public:
+    constexpr EntityHandle() noexcept = default;
+    constexpr EntityHandle(std::uint32_t index, std::uint32_t generation) noexcept
+        : m_index(index)
+        , m_generation(generation)
+    {
+    }
+
+    constexpr std::uint32_t index() const noexcept { return m_index; }
+    constexpr std::uint32_t generation() const noexcept { return m_generation; }
+    constexpr bool isValid() const noexcept { return m_generation != 0; }
+
+    constexpr bool operator==(const EntityHandle &other) const noexcept
+    {
+        return m_index == other.m_index && m_generation == other.m_generation;
+    }
+
+    constexpr bool operator!=(const EntityHandle &other) const noexcept
+    {
+        return !(*this == other);
+    }
+
+private:
+    std::uint32_t m_index{0};
+    std::uint32_t m_generation{0};
+};
+
+using NodeHandle = EntityHandle<Node>;
+using BarHandle = EntityHandle<Bar>;
+
+/**
+ * @brief Set of entity handles backed by a flat array indexed by slot.
+ *
+ * Membership tests are a bounds check and one compare. Handles whose entity
+ * was removed stop matching automatically because their generation no longer
+ * equals the one recorded for the slot's new occupant.
+ */
+template <typename Entity>
+class EntityHandleSet
+{
+public:
+    void insert(EntityHandle<Entity> handle)
+    {
+        if (!handle.isValid()) {
+            return;
+        }
+        if (handle.index() >= m_generations.size()) {
+            m_generations.resize(static_cast<std::size_t>(handle.index()) + 1, 0);
+        }
+        m_generations[handle.index()] = handle.generation();
+    }
+
+    void remove(EntityHandle<Entity> handle)
+    {
+        if (contains(handle)) {
+            m_generations[handle.index()] = 0;
+        }
+    }
+
+    bool contains(EntityHandle<Entity> handle) const noexcept
+    {
+        return handle.isValid() &&
+               handle.index() < m_generations.size() &&
+               m_generations[handle.index()] == handle.generation();
+    }
+
+    void clear() noexcept { m_generations.clear(); }
+
+private:
+    // Generation recorded per slot index; 0 means "not in the set"
+    std::vector<std::uint32_t> m_generations;
+};
+
+} // namespace Structura::Model
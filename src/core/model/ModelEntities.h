@@ -4,7 +4,9 @@
 #include <QUuid>
 #include <QString>
 #include <array>
+#include <cstdint>
 #include <optional>
+#include <type_traits>
 
 namespace Structura::Model {
 
@@ -19,6 +21,9 @@ namespace Structura::Model {
  * - externalId is used for display and export purposes
  * - position can be any valid point in 3D space
  * - restraints array has exactly 6 elements (UX, UY, UZ, RX, RY, RZ)
+ *
+ * Kept small because models hold millions of them: restraints are a 6-bit
+ * mask, and selection lives in SelectionModel, not here.
  */
 class Node
 {
@@ -26,24 +31,24 @@ public:
     /// Default constructor - creates node at origin with new UUID
     Node()
         : m_id(QUuid::createUuid())
-        , m_externalId(0)
         , m_position(0.0, 0.0, 0.0)
+        , m_externalId(0)
     {
     }
 
     /// Full constructor
     Node(const QUuid &id, int externalId, double x, double y, double z)
         : m_id(id)
-        , m_externalId(externalId)
         , m_position(x, y, z)
+        , m_externalId(externalId)
     {
     }
 
     /// Constructor with Vector3 position
     Node(const QUuid &id, int externalId, const Vector3 &position)
         : m_id(id)
-        , m_externalId(externalId)
         , m_position(position)
+        , m_externalId(externalId)
     {
     }
 
@@ -88,56 +93,68 @@ public:
         return m_position.distanceTo(other.m_position);
     }
 
-    // Selection state (UI concern, but kept for compatibility)
-    bool isSelected() const noexcept { return m_selected; }
-    void setSelected(bool selected) noexcept { m_selected = selected; }
-
     // Restraints (boundary conditions)
     /// Get all restraints as array [UX, UY, UZ, RX, RY, RZ]
-    std::array<bool, 6> restraints() const noexcept { return m_restraints; }
+    std::array<bool, 6> restraints() const noexcept
+    {
+        std::array<bool, 6> restraints{};
+        for (std::size_t i = 0; i < restraints.size(); ++i) {
+            restraints[i] = (m_restraintMask >> i) & 1u;
+        }
+        return restraints;
+    }
+    
+    /// Restraints as a bit mask, bit i set when DOF i (UX..RZ) is fixed
+    std::uint8_t restraintMask() const noexcept { return m_restraintMask; }
+    void setRestraintMask(std::uint8_t mask) noexcept { m_restraintMask = mask & kAllRestraints; }
     
     /// Set a specific restraint (index 0-5 for UX, UY, UZ, RX, RY, RZ)
     void setRestraint(int index, bool fixed) noexcept
     {
         if (index >= 0 && index < 6) {
-            m_restraints[static_cast<std::size_t>(index)] = fixed;
+            const auto bit = static_cast<std::uint8_t>(1u << index);
+            m_restraintMask = fixed ? (m_restraintMask | bit) : (m_restraintMask & ~bit);
         }
     }
     
     /// Clear all restraints (free node)
     void clearRestraints() noexcept
     {
-        m_restraints.fill(false);
+        m_restraintMask = 0;
     }
     
     /// Check if node has any restraints
     bool hasRestraints() const noexcept
     {
-        for (bool r : m_restraints) {
-            if (r) return true;
-        }
-        return false;
+        return m_restraintMask != 0;
     }
 
 private:
+    static constexpr std::uint8_t kAllRestraints = 0x3f;
+
     QUuid m_id;
-    int m_externalId;
     Vector3 m_position;
-    std::array<bool, 6> m_restraints{{false, false, false, false, false, false}};
-    bool m_selected{false};
+    int m_externalId;
+    std::uint8_t m_restraintMask{0};
 };
 
+static_assert(sizeof(Node) <= 48, "Node must stay within 48 bytes");
+
 /**
  * @brief Represents a structural bar (beam/column) element.
  * 
  * A Bar connects two nodes and has material and section properties.
- * It can optionally have a K-point for defining local coordinate system.
+ * Its optional K-point, which orients the local coordinate system, is kept
+ * by the repository (IModelRepository::barKPoint()).
  * 
  * Invariants:
  * - id is always valid and unique
  * - startNodeId and endNodeId must reference existing nodes
  * - startNodeId != endNodeId (a bar cannot connect to itself)
- * - materialId and sectionId should reference existing entities (optional validation)
+ * - materialId and sectionId should reference existing entities (optional
+ *   validation)
+ *
+ * Selection lives in SelectionModel.
  */
 class Bar
 {
@@ -182,37 +199,7 @@ public:
     const QUuid& sectionId() const noexcept { return m_sectionId; }
     void setSectionId(const QUuid &id) noexcept { m_sectionId = id; }
 
-    // Selection state
-    bool isSelected() const noexcept { return m_selected; }
-    void setSelected(bool selected) noexcept { m_selected = selected; }
-
     // Local Coordinate System (LCS) support
-    /// Get the K-point used for defining local coordinate system
-    const std::optional<Vector3>& kPoint() const noexcept { return m_kPoint; }
-    
-    /// Set K-point and mark LCS as dirty
-    void setKPoint(const Vector3 &point) noexcept
-    {
-        m_kPoint = point;
-        m_lcsDirty = true;
-    }
-    
-    /// Set K-point from array and mark LCS as dirty
-    void setKPoint(const std::array<double, 3> &point) noexcept
-    {
-        m_kPoint = Vector3(point[0], point[1], point[2]);
-        m_lcsDirty = true;
-    }
-    
-    /// Clear K-point and mark LCS as dirty
-    void clearKPoint() noexcept
-    {
-        m_kPoint.reset();
-        m_lcsDirty = true;
-    }
-    
-    bool hasKPoint() const noexcept { return m_kPoint.has_value(); }
-    
     /// Check if local coordinate system needs recomputation
     bool isLCSDirty() const noexcept { return m_lcsDirty; }
     void setLCSDirty(bool dirty) noexcept { m_lcsDirty = dirty; }
@@ -230,18 +217,19 @@ public:
 
 private:
     QUuid m_id;
-    int m_externalId{0};
     QUuid m_startNodeId;
     QUuid m_endNodeId;
     QUuid m_materialId;
     QUuid m_sectionId;
-    bool m_selected{false};
+    int m_externalId{0};
     
     // Local Coordinate System attributes
-    std::optional<Vector3> m_kPoint;
     bool m_lcsDirty{true};
 };
 
+static_assert(sizeof(Bar) <= 88, "Bar must stay within 88 bytes");
+static_assert(std::is_trivially_copyable_v<Bar>, "Bar must stay trivially copyable");
+
 /**
  * @brief Represents material properties for structural analysis.
  * 
@@ -489,4 +477,160 @@ private:
     Vector3 m_endPoint{0.0, 0.0, 0.0};
 };
 
+/**
+ * @brief A named group of loads that is analysed together (e.g. "Dead", "Wind X").
+ *
+ * Invariants:
+ * - id is always valid and unique
+ * - name should not be empty (recommended)
+ */
+class LoadCase
+{
+public:
+    /// Default constructor
+    LoadCase()
+        : m_id(QUuid::createUuid())
+    {
+    }
+
+    /// Full constructor
+    LoadCase(const QUuid &id, int externalId, QString name)
+        : m_id(id)
+        , m_externalId(externalId)
+        , m_name(std::move(name))
+    {
+    }
+
+    // Identification
+    const QUuid& id() const noexcept { return m_id; }
+
+    int externalId() const noexcept { return m_externalId; }
+    void setExternalId(int externalId) noexcept { m_externalId = externalId; }
+
+    const QString& name() const noexcept { return m_name; }
+    void setName(const QString &name) { m_name = name; }
+
+    bool isValid() const noexcept { return !m_name.isEmpty(); }
+
+private:
+    QUuid m_id;
+    int m_externalId{0};
+    QString m_name;
+};
+
+/**
+ * @brief Concentrated force and moment applied to a node, in global axes.
+ *
+ * Invariants:
+ * - id is always valid and unique
+ * - loadCaseId references the load case the load belongs to
+ * - nodeId should reference an existing node (optional validation)
+ */
+class NodalLoad
+{
+public:
+    /// Default constructor
+    NodalLoad()
+        : m_id(QUuid::createUuid())
+    {
+    }
+
+    /// Full constructor
+    NodalLoad(const QUuid &id,
+              const QUuid &loadCaseId,
+              const QUuid &nodeId,
+              const Vector3 &force,
+              const Vector3 &moment = Vector3(0.0, 0.0, 0.0))
+        : m_id(id)
+        , m_loadCaseId(loadCaseId)
+        , m_nodeId(nodeId)
+        , m_force(force)
+        , m_moment(moment)
+    {
+    }
+
+    // Identification
+    const QUuid& id() const noexcept { return m_id; }
+
+    const QUuid& loadCaseId() const noexcept { return m_loadCaseId; }
+    void setLoadCaseId(const QUuid &id) noexcept { m_loadCaseId = id; }
+
+    const QUuid& nodeId() const noexcept { return m_nodeId; }
+    void setNodeId(const QUuid &id) noexcept { m_nodeId = id; }
+
+    // Values (Fx, Fy, Fz / Mx, My, Mz)
+    const Vector3& force() const noexcept { return m_force; }
+    void setForce(const Vector3 &force) noexcept { m_force = force; }
+
+    const Vector3& moment() const noexcept { return m_moment; }
+    void setMoment(const Vector3 &moment) noexcept { m_moment = moment; }
+
+private:
+    QUuid m_id;
+    QUuid m_loadCaseId;
+    QUuid m_nodeId;
+    Vector3 m_force{0.0, 0.0, 0.0};
+    Vector3 m_moment{0.0, 0.0, 0.0};
+};
+
+/**
+ * @brief Uniformly distributed load along a bar.
+ *
+ * Invariants:
+ * - id is always valid and unique
+ * - loadCaseId references the load case the load belongs to
+ * - barId should reference an existing bar (optional validation)
+ */
+class MemberLoad
+{
+public:
+    enum class System {
+        Global,
+        Local
+    };
+
+    /// Default constructor
+    MemberLoad()
+        : m_id(QUuid::createUuid())
+    {
+    }
+
+    /// Full constructor
+    MemberLoad(const QUuid &id,
+               const QUuid &loadCaseId,
+               const QUuid &barId,
+               const Vector3 &intensity,
+               System system = System::Global)
+        : m_id(id)
+        , m_loadCaseId(loadCaseId)
+        , m_barId(barId)
+        , m_intensity(intensity)
+        , m_system(system)
+    {
+    }
+
+    // Identification
+    const QUuid& id() const noexcept { return m_id; }
+
+    const QUuid& loadCaseId() const noexcept { return m_loadCaseId; }
+    void setLoadCaseId(const QUuid &id) noexcept { m_loadCaseId = id; }
+
+    const QUuid& barId() const noexcept { return m_barId; }
+    void setBarId(const QUuid &id) noexcept { m_barId = id; }
+
+    // Force per unit length (qx, qy, qz) in the given axis system
+    const Vector3& intensity() const noexcept { return m_intensity; }
+    void setIntensity(const Vector3 &intensity) noexcept { m_intensity = intensity; }
+
+    System system() const noexcept { return m_system; }
+    void setSystem(System system) noexcept { m_system = system; }
+
+private:
+    QUuid m_id;
+    QUuid m_loadCaseId;
+    QUuid m_barId;
+    Vector3 m_intensity{0.0, 0.0, 0.0};
+    System m_system{System::Global};
+};
+
 } // namespace Structura::Model
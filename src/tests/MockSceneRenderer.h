@@ -1,7 +1,6 @@
 #pragma once
 
 #include "../viz/ISceneRenderer.h"
-#include <QSet>
 #include <QUuid>
 #include <vector>
 
@@ -51,6 +50,11 @@ public:
         m_lastNodes = nodes;
     }
 
+    void updateNodePositions(const double* coordinates, size_t nodeCount) override {
+        m_updateNodePositionsCallCount++;
+        m_lastNodeCoordinates.assign(coordinates, coordinates + 3 * nodeCount);
+    }
+
     void updateBars(const std::vector<Structura::Viz::ModelSnapshot::BarData>& bars) override {
         m_updateBarsCalled = true;
         m_updateBarsCallCount++;
@@ -63,19 +67,19 @@ public:
         m_lastGridLines = gridLines;
     }
 
-    void highlightNode(const QUuid& nodeId) override {
+    void highlightNode(Structura::Model::NodeHandle node) override {
         m_highlightNodeCalled = true;
-        m_lastHighlightedNodeId = nodeId;
+        m_lastHighlightedNode = node;
     }
 
-    void setSelectedNodes(const QSet<QUuid>& nodeIds) override {
+    void setSelectedNodes(const std::vector<Structura::Model::NodeHandle>& nodes) override {
         m_setSelectedNodesCalled = true;
-        m_lastSelectedNodeIds = nodeIds;
+        m_lastSelectedNodes = nodes;
     }
 
-    void setSelectedBars(const QSet<QUuid>& barIds) override {
+    void setSelectedBars(const std::vector<Structura::Model::BarHandle>& bars) override {
         m_setSelectedBarsCalled = true;
-        m_lastSelectedBarIds = barIds;
+        m_lastSelectedBars = bars;
     }
 
     void highlightGridLine(const QUuid& lineId) override {
@@ -167,16 +171,18 @@ public:
         
         m_renderSnapshotCallCount = 0;
         m_updateNodesCallCount = 0;
+        m_updateNodePositionsCallCount = 0;
         m_updateBarsCallCount = 0;
         m_updateGridLinesCallCount = 0;
         m_refreshCallCount = 0;
         
         m_lastNodes.clear();
+        m_lastNodeCoordinates.clear();
         m_lastBars.clear();
         m_lastGridLines.clear();
-        m_lastSelectedNodeIds.clear();
-        m_lastSelectedBarIds.clear();
-        m_lastHighlightedNodeId = QUuid();
+        m_lastSelectedNodes.clear();
+        m_lastSelectedBars.clear();
+        m_lastHighlightedNode = {};
         m_lastHighlightedGridLineId = QUuid();
     }
 
@@ -199,12 +205,14 @@ public:
     
     int renderSnapshotCallCount() const { return m_renderSnapshotCallCount; }
     int updateNodesCallCount() const { return m_updateNodesCallCount; }
+    int updateNodePositionsCallCount() const { return m_updateNodePositionsCallCount; }
     int updateBarsCallCount() const { return m_updateBarsCallCount; }
     int updateGridLinesCallCount() const { return m_updateGridLinesCallCount; }
     int refreshCallCount() const { return m_refreshCallCount; }
     
     const Structura::Viz::ModelSnapshot& lastSnapshot() const { return m_lastSnapshot; }
     const std::vector<Structura::Viz::ModelSnapshot::NodeData>& lastNodes() const { return m_lastNodes; }
+    const std::vector<double>& lastNodeCoordinates() const { return m_lastNodeCoordinates; }
     const std::vector<Structura::Viz::ModelSnapshot::BarData>& lastBars() const { return m_lastBars; }
     const std::vector<Structura::Viz::ModelSnapshot::GridLineData>& lastGridLines() const { return m_lastGridLines; }
     
@@ -212,9 +220,9 @@ public:
     size_t lastBarCount() const { return m_lastBars.size(); }
     size_t lastGridLineCount() const { return m_lastGridLines.size(); }
     
-    const QSet<QUuid>& lastSelectedNodeIds() const { return m_lastSelectedNodeIds; }
-    const QSet<QUuid>& lastSelectedBarIds() const { return m_lastSelectedBarIds; }
-    QUuid lastHighlightedNodeId() const { return m_lastHighlightedNodeId; }
+    const std::vector<Structura::Model::NodeHandle>& lastSelectedNodes() const { return m_lastSelectedNodes; }
+    const std::vector<Structura::Model::BarHandle>& lastSelectedBars() const { return m_lastSelectedBars; }
+    Structura::Model::NodeHandle lastHighlightedNode() const { return m_lastHighlightedNode; }
     QUuid lastHighlightedGridLineId() const { return m_lastHighlightedGridLineId; }
     
     // Mock return value setters (for pick operations)
@@ -253,6 +261,7 @@ private:
     // Call counters
     int m_renderSnapshotCallCount;
     int m_updateNodesCallCount;
+    int m_updateNodePositionsCallCount;
     int m_updateBarsCallCount;
     int m_updateGridLinesCallCount;
     int m_refreshCallCount;
@@ -261,11 +270,12 @@ private:
     QVTKOpenGLNativeWidget* m_widget = nullptr;
     Structura::Viz::ModelSnapshot m_lastSnapshot;
     std::vector<Structura::Viz::ModelSnapshot::NodeData> m_lastNodes;
+    std::vector<double> m_lastNodeCoordinates;
     std::vector<Structura::Viz::ModelSnapshot::BarData> m_lastBars;
     std::vector<Structura::Viz::ModelSnapshot::GridLineData> m_lastGridLines;
-    QSet<QUuid> m_lastSelectedNodeIds;
-    QSet<QUuid> m_lastSelectedBarIds;
-    QUuid m_lastHighlightedNodeId;
+    std::vector<Structura::Model::NodeHandle> m_lastSelectedNodes;
+    std::vector<Structura::Model::BarHandle> m_lastSelectedBars;
+    Structura::Model::NodeHandle m_lastHighlightedNode;
     QUuid m_lastHighlightedGridLineId;
     int m_lastGhostLineAxis;
     std::array<double, 3> m_lastGhostLineStart;
@@ -0,0 +1,1517 @@
+#include <QtTest/QtTest>
+#include "../analysis/ConjugateGradient.h"
+#include "../analysis/ElementColouring.h"
+#include "../analysis/LinearStaticAnalysis.h"
+#include "../analysis/MatrixFreeOperator.h"
+#include "../analysis/SmoothedAggregation.h"
+#include "../analysis/SkylineLdlt.h"
+#include "../analysis/SparseLdlt.h"
+#include "../analysis/StiffnessAssembly.h"
+#include "../analysis/SupernodalLdlt.h"
+#include "../analysis/ThreadPool.h"
+#include "../LocalCoordinateSystem.h"
+#include "../app/AnalysisService.h"
+#include "../app/BarService.h"
+#include "../app/InMemoryModelRepository.h"
+#include <QSignalSpy>
+#include <cmath>
+#include <memory>
+#include <numeric>
+#include <random>
+
+using namespace Structura::Analysis;
+using namespace Structura::App;
+
+namespace {
+
+constexpr double kE = 200e9;
+constexpr double kG = 80e9;
+constexpr double kA = 0.01;
+constexpr double kIy = 2e-5;
+constexpr double kIz = 8e-5;
+constexpr double kJ = 1e-5;
+constexpr std::uint8_t kFixed = 0x3f;
+
+FrameElement steelElement(int start, int end)
+{
+    FrameElement element;
+    element.nodes = {{start, end}};
+    element.youngModulus = kE;
+    element.shearModulus = kG;
+    element.area = kA;
+    element.iy = kIy;
+    element.iz = kIz;
+    element.torsionalConstant = kJ;
+    return element;
+}
+
+bool closeTo(double actual, double expected, double relative = 1e-6)
+{
+    return std::abs(actual - expected) <= relative * std::max(1e-12, std::abs(expected));
+}
+
+/// Square grillage in the XY plane, clamped along its edges, loaded in -Z
+FrameModel grillageModel(int divisions)
+{
+    FrameModel model;
+    auto index = [divisions](int i, int j) { return j * (divisions + 1) + i; };
+    for (int j = 0; j <= divisions; ++j) {
+        for (int i = 0; i <= divisions; ++i) {
+            const bool edge = i == 0 || j == 0 || i == divisions || j == divisions;
+            model.addNode(2.0 * i, 2.0 * j, 0.0, edge ? kFixed : 0);
+        }
+    }
+    for (int j = 0; j <= divisions; ++j) {
+        for (int i = 0; i <= divisions; ++i) {
+            if (i < divisions) {
+                model.elements.push_back(steelElement(index(i, j), index(i + 1, j)));
+            }
+            if (j < divisions) {
+                model.elements.push_back(steelElement(index(i, j), index(i, j + 1)));
+            }
+        }
+    }
+    for (int j = 1; j < divisions; ++j) {
+        for (int i = 1; i < divisions; ++i) {
+            model.addNodalLoad(index(i, j), {{0.0, 0.0, -1000.0, 0.0, 0.0, 0.0}});
+        }
+    }
+    return model;
+}
+
+/**
+ * @brief Plane frame (bays x storeys, in XZ, fixed at the base) whose node
+ *        and element numbering is randomly permuted, like a .dat file with
+ *        arbitrary external ids.
+ */
+FrameModel scrambledGridFrame(int bays, int storeys, unsigned seed)
+{
+    const int nodeCount = (bays + 1) * (storeys + 1);
+    std::vector<int> position(static_cast<size_t>(nodeCount));
+    std::iota(position.begin(), position.end(), 0);
+    std::mt19937 random(seed);
+    std::shuffle(position.begin(), position.end(), random);
+
+    FrameModel model;
+    model.coordinates.resize(3 * static_cast<size_t>(nodeCount));
+    model.restraints.resize(static_cast<size_t>(nodeCount));
+    auto index = [&](int i, int k) { return position[static_cast<size_t>(k * (bays + 1) + i)]; };
+    for (int k = 0; k <= storeys; ++k) {
+        for (int i = 0; i <= bays; ++i) {
+            const auto node = static_cast<size_t>(index(i, k));
+            model.coordinates[3 * node] = 6.0 * i;
+            model.coordinates[3 * node + 2] = 3.0 * k;
+            // Plane frame: out-of-plane DOFs (UY, RX, RZ) restrained everywhere
+            model.restraints[node] = k == 0 ? kFixed : 0x2a;
+        }
+    }
+    for (int k = 1; k <= storeys; ++k) {
+        for (int i = 0; i <= bays; ++i) {
+            model.elements.push_back(steelElement(index(i, k - 1), index(i, k)));
+            if (i < bays) {
+                model.elements.push_back(steelElement(index(i, k), index(i + 1, k)));
+            }
+            model.addNodalLoad(index(i, k), {{500.0, 0.0, -2000.0, 0.0, 0.0, 0.0}});
+        }
+    }
+    std::shuffle(model.elements.begin(), model.elements.end(), random);
+    return model;
+}
+
+/// Space frame of nx x ny bays and nz storeys, fixed at the base, with gravity and wind loads
+FrameModel buildingFrame(int nx, int ny, int nz)
+{
+    FrameModel model;
+    auto index = [nx, ny](int i, int j, int k) { return (k * (ny + 1) + j) * (nx + 1) + i; };
+    for (int k = 0; k <= nz; ++k) {
+        for (int j = 0; j <= ny; ++j) {
+            for (int i = 0; i <= nx; ++i) {
+                model.addNode(6.0 * i, 5.0 * j, 3.0 * k, k == 0 ? kFixed : 0);
+            }
+        }
+    }
+    for (int k = 1; k <= nz; ++k) {
+        for (int j = 0; j <= ny; ++j) {
+            for (int i = 0; i <= nx; ++i) {
+                model.elements.push_back(steelElement(index(i, j, k - 1), index(i, j, k)));
+                if (i < nx) {
+                    model.elements.push_back(steelElement(index(i, j, k), index(i + 1, j, k)));
+                }
+                if (j < ny) {
+                    model.elements.push_back(steelElement(index(i, j, k), index(i, j + 1, k)));
+                }
+                model.addNodalLoad(index(i, j, k), {{1000.0, 500.0, -5000.0, 0.0, 0.0, 0.0}});
+            }
+        }
+    }
+    return model;
+}
+
+/// @p model with every element split into @p segments equal elements
+FrameModel subdivided(const FrameModel &model, int segments)
+{
+    FrameModel result = model;
+    result.elements.clear();
+    for (const FrameElement &element : model.elements) {
+        const auto a = static_cast<size_t>(element.nodes[0]);
+        const auto b = static_cast<size_t>(element.nodes[1]);
+        int previous = element.nodes[0];
+        for (int s = 1; s <= segments; ++s) {
+            int next = element.nodes[1];
+            if (s < segments) {
+                const double t = static_cast<double>(s) / segments;
+                next = result.addNode(model.coordinates[3 * a] + t * (model.coordinates[3 * b] - model.coordinates[3 * a]),
+                                      model.coordinates[3 * a + 1] + t * (model.coordinates[3 * b + 1] - model.coordinates[3 * a + 1]),
+                                      model.coordinates[3 * a + 2] + t * (model.coordinates[3 * b + 2] - model.coordinates[3 * a + 2]));
+            }
+            FrameElement part = element;
+            part.nodes = {{previous, next}};
+            result.elements.push_back(part);
+            previous = next;
+        }
+    }
+    if (!result.nodalLoads.empty()) {
+        result.nodalLoads.resize(kNodeDofs * result.nodeCount(), 0.0);
+    }
+    return result;
+}
+
+/// Full symmetric CSR of a dense row-major matrix, dropping zeros
+CsrMatrix denseToCsr(const std::vector<double> &dense, int size)
+{
+    CsrMatrix matrix;
+    matrix.size = size;
+    for (int row = 0; row < size; ++row) {
+        for (int column = 0; column < size; ++column) {
+            const double value = dense[static_cast<size_t>(row * size + column)];
+            if (value != 0.0) {
+                matrix.columns.push_back(column);
+                matrix.values.push_back(value);
+            }
+        }
+        matrix.rowStart.push_back(matrix.columns.size());
+    }
+    return matrix;
+}
+
+std::vector<ElementAxes> elementAxes(const FrameModel &model)
+{
+    Structura::Geometry::DefaultLocalAxisProvider provider;
+    std::vector<ElementAxes> axes(model.elementCount());
+    for (size_t e = 0; e < axes.size(); ++e) {
+        computeElementAxes(model, model.elements[e], provider, axes[e]);
+    }
+    return axes;
+}
+
+} // namespace
+
+/**
+ * @brief Unit tests for the linear static analysis engine and AnalysisService
+ */
+class TestAnalysis : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testCantileverClosedForm()
+    {
+        // Tip loads on a 4-element cantilever along X
+        FrameModel model;
+        const double L = 4.0;
+        const int divisions = 4;
+        for (int i = 0; i <= divisions; ++i) {
+            model.addNode(L * i / divisions, 0.0, 0.0, i == 0 ? kFixed : 0);
+        }
+        for (int i = 0; i < divisions; ++i) {
+            model.elements.push_back(steelElement(i, i + 1));
+        }
+        const double F = 2000.0, P = 1000.0, T = 500.0;
+        model.addNodalLoad(divisions, {{F, -P, -P, T, 0.0, 0.0}});
+
+        const AnalysisResult result = LinearStaticAnalysis().run(model);
+        QVERIFY(result.succeeded());
+
+        const double *tip = &result.displacements[6 * divisions];
+        QVERIFY(closeTo(tip[0], F * L / (kE * kA)));
+        QVERIFY(closeTo(tip[1], -P * L * L * L / (3 * kE * kIz)));
+        QVERIFY(closeTo(tip[2], -P * L * L * L / (3 * kE * kIy)));
+        QVERIFY(closeTo(tip[3], T * L / (kG * kJ)));
+
+        const double *support = &result.reactions[0];
+        QVERIFY(closeTo(support[0], -F));
+        QVERIFY(closeTo(support[1], P));
+        QVERIFY(closeTo(support[2], P));
+        QVERIFY(closeTo(support[3], -T));
+        QVERIFY(closeTo(support[4], -P * L));
+        QVERIFY(closeTo(support[5], P * L));
+    }
+
+    void testKPointOrientsSection()
+    {
+        // k-point on +Z turns local y' to global Z: a vertical tip load bends
+        // the strong axis (iz) instead of the weak one
+        FrameModel model;
+        const double L = 3.0;
+        model.addNode(0.0, 0.0, 0.0, kFixed);
+        model.addNode(L, 0.0, 0.0);
+        FrameElement element = steelElement(0, 1);
+        element.kPoint = std::array<double, 3>{{0.0, 0.0, 1.0}};
+        model.elements.push_back(element);
+        model.addNodalLoad(1, {{0.0, 0.0, -1000.0, 0.0, 0.0, 0.0}});
+
+        const AnalysisResult result = LinearStaticAnalysis().run(model);
+        QVERIFY(result.succeeded());
+        QVERIFY(closeTo(result.displacements[8], -1000.0 * L * L * L / (3 * kE * kIz)));
+        QVERIFY(closeTo(result.elementForces[1], 1000.0));
+        QVERIFY(closeTo(result.elementForces[7], -1000.0));
+    }
+
+    void testFixedFixedUniformLoad()
+    {
+        FrameModel model;
+        const double L = 6.0, q = -5000.0;
+        model.addNode(0.0, 0.0, 0.0, kFixed);
+        model.addNode(L / 2, 0.0, 0.0);
+        model.addNode(L, 0.0, 0.0, kFixed);
+        model.elements.push_back(steelElement(0, 1));
+        model.elements.push_back(steelElement(1, 2));
+        model.elementLoads.push_back({0, {{0.0, 0.0, q}}, false});
+        model.elementLoads.push_back({1, {{0.0, 0.0, q}}, false});
+
+        const AnalysisResult result = LinearStaticAnalysis().run(model);
+        QVERIFY(result.succeeded());
+        QVERIFY(closeTo(result.displacements[8], q * L * L * L * L / (384 * kE * kIy)));
+        QVERIFY(closeTo(result.reactions[2], -q * L / 2));
+        QVERIFY(closeTo(result.reactions[14], -q * L / 2));
+        QVERIFY(closeTo(result.reactions[4], q * L * L / 12));
+
+        // Local axes of a bar along X (no k-point) coincide with global ones
+        FrameModel local = model;
+        for (UniformElementLoad &load : local.elementLoads) {
+            load.local = true;
+        }
+        const AnalysisResult localResult = LinearStaticAnalysis().run(local);
+        QVERIFY(localResult.succeeded());
+        QVERIFY(closeTo(localResult.displacements[8], result.displacements[8]));
+    }
+
+    void testBuildingEquilibrium()
+    {
+        const int nx = 4, ny = 3, nz = 5;
+        FrameModel model;
+        auto index = [](int i, int j, int k) { return (k * (ny + 1) + j) * (nx + 1) + i; };
+        for (int k = 0; k <= nz; ++k) {
+            for (int j = 0; j <= ny; ++j) {
+                for (int i = 0; i <= nx; ++i) {
+                    model.addNode(6.0 * i, 5.0 * j, 3.0 * k, k == 0 ? kFixed : 0);
+                }
+            }
+        }
+        double totalGravity = 0.0;
+        double totalLateral = 0.0;
+        for (int k = 1; k <= nz; ++k) {
+            for (int j = 0; j <= ny; ++j) {
+                for (int i = 0; i <= nx; ++i) {
+                    model.elements.push_back(steelElement(index(i, j, k - 1), index(i, j, k)));
+                    if (i < nx) {
+                        model.elements.push_back(steelElement(index(i, j, k), index(i + 1, j, k)));
+                    }
+                    if (j < ny) {
+                        model.elements.push_back(steelElement(index(i, j, k), index(i, j + 1, k)));
+                    }
+                    model.addNodalLoad(index(i, j, k), {{1000.0, 0.0, -5000.0, 0.0, 0.0, 0.0}});
+                    totalGravity += 5000.0;
+                    totalLateral += 1000.0;
+                }
+            }
+        }
+
+        const AnalysisResult result = LinearStaticAnalysis().run(model);
+        QVERIFY(result.succeeded());
+        double sumX = 0.0, sumZ = 0.0;
+        for (size_t node = 0; node < model.nodeCount(); ++node) {
+            sumX += result.reactions[6 * node];
+            sumZ += result.reactions[6 * node + 2];
+        }
+        QVERIFY(closeTo(sumX, -totalLateral, 1e-8));
+        QVERIFY(closeTo(sumZ, totalGravity, 1e-8));
+    }
+
+    void testUnstableAndInvalidModels()
+    {
+        FrameModel free;
+        free.addNode(0.0, 0.0, 0.0);
+        free.addNode(1.0, 0.0, 0.0);
+        free.elements.push_back(steelElement(0, 1));
+        QCOMPARE(LinearStaticAnalysis().run(free).status, AnalysisStatus::Unstable);
+
+        // Pinned at both ends: free to spin about its own axis
+        FrameModel pinned;
+        pinned.addNode(0.0, 0.0, 0.0, 0x07);
+        pinned.addNode(1.0, 0.0, 0.0, 0x07);
+        pinned.elements.push_back(steelElement(0, 1));
+        const AnalysisResult spinning = LinearStaticAnalysis().run(pinned);
+        QCOMPARE(spinning.status, AnalysisStatus::Unstable);
+        QCOMPARE(spinning.failedDof, 3);
+
+        FrameModel degenerate;
+        degenerate.addNode(0.0, 0.0, 0.0, kFixed);
+        degenerate.addNode(0.0, 0.0, 0.0);
+        degenerate.elements.push_back(steelElement(0, 1));
+        const AnalysisResult invalid = LinearStaticAnalysis().run(degenerate);
+        QCOMPARE(invalid.status, AnalysisStatus::InvalidElement);
+        QCOMPARE(invalid.failedElement, 0);
+
+        QCOMPARE(LinearStaticAnalysis().run(FrameModel()).status, AnalysisStatus::EmptyModel);
+    }
+
+    void testAnalysisServiceRunsLoadCase()
+    {
+        InMemoryModelRepository repo;
+        const double L = 5.0, P = 2000.0, q = -1000.0;
+        Material steel(QUuid::createUuid(), 1, "Aço", kE, kG);
+        Section section(QUuid::createUuid(), 1, "W", kA, kIz, kIy, kJ);
+        repo.addMaterial(steel);
+        repo.addSection(section);
+
+        Node base(QUuid::createUuid(), 1, 0.0, 0.0, 0.0);
+        base.setRestraintMask(kFixed);
+        Node tip(QUuid::createUuid(), 2, L, 0.0, 0.0);
+        repo.addNode(base);
+        repo.addNode(tip);
+        Bar bar(QUuid::createUuid(), base.id(), tip.id(), steel.id(), section.id());
+        bar.setExternalId(1);
+        repo.addBar(bar);
+
+        LoadCase dead(QUuid::createUuid(), 1, "Dead");
+        repo.addLoadCase(dead);
+        repo.addNodalLoad(NodalLoad(QUuid::createUuid(), dead.id(), tip.id(), Vector3(0.0, -P, 0.0)));
+        repo.addMemberLoad(MemberLoad(QUuid::createUuid(), dead.id(), bar.id(), Vector3(0.0, 0.0, q)));
+
+        AnalysisService service(&repo);
+        QSignalSpy completed(&service, &AnalysisService::analysisCompleted);
+        QVERIFY(service.runLinearStatic(dead.id()));
+        QCOMPARE(completed.count(), 1);
+        QVERIFY(service.hasResults());
+        QVERIFY(service.resultsAreCurrent());
+        QCOMPARE(service.resultLoadCase(), dead.id());
+
+        const auto displacement = service.nodeDisplacement(tip.id());
+        QVERIFY(displacement.has_value());
+        QVERIFY(closeTo((*displacement)[1], -P * L * L * L / (3 * kE * kIz)));
+        QVERIFY(closeTo((*displacement)[2], q * L * L * L * L / (8 * kE * kIy)));
+
+        const auto reaction = service.nodeReaction(base.id());
+        QVERIFY(reaction.has_value());
+        QVERIFY(closeTo((*reaction)[1], P));
+        QVERIFY(closeTo((*reaction)[2], -q * L));
+
+        const auto forces = service.barEndForces(bar.id());
+        QVERIFY(forces.has_value());
+        QVERIFY(closeTo((*forces)[1], P));
+        QVERIFY(!service.nodeDisplacement(QUuid::createUuid()).has_value());
+
+        // Editing the model leaves the results stale
+        Node moved = tip;
+        moved.setPosition(Vector3(L, 0.0, 1.0));
+        repo.updateNode(moved);
+        QVERIFY(service.hasResults());
+        QVERIFY(!service.resultsAreCurrent());
+
+        QSignalSpy cleared(&service, &AnalysisService::resultsCleared);
+        service.clearResults();
+        QCOMPARE(cleared.count(), 1);
+        QVERIFY(!service.nodeDisplacement(tip.id()).has_value());
+    }
+
+    void testAnalysisServiceReportsFailures()
+    {
+        InMemoryModelRepository repo;
+        Node a(QUuid::createUuid(), 1, 0.0, 0.0, 0.0);
+        Node b(QUuid::createUuid(), 7, 3.0, 0.0, 0.0);
+        repo.addNode(a);
+        repo.addNode(b);
+        Bar bar(QUuid::createUuid(), a.id(), b.id());
+        bar.setExternalId(1);
+        repo.addBar(bar);
+        LoadCase dead(QUuid::createUuid(), 1, "Dead");
+        repo.addLoadCase(dead);
+
+        AnalysisService service(&repo);
+        QSignalSpy failed(&service, &AnalysisService::analysisFailed);
+        QVERIFY(!service.runLinearStatic(QUuid::createUuid()));
+        QVERIFY(!service.runLinearStatic(dead.id())); // bar without properties
+        QCOMPARE(failed.count(), 2);
+
+        Material steel(QUuid::createUuid(), 1, "Aço", kE, kG);
+        Section section(QUuid::createUuid(), 1, "W", kA, kIz, kIy, kJ);
+        repo.addMaterial(steel);
+        repo.addSection(section);
+        Bar assigned = bar;
+        assigned.setMaterialId(steel.id());
+        assigned.setSectionId(section.id());
+        repo.updateBar(assigned);
+
+        // No supports at all
+        QVERIFY(!service.runLinearStatic(dead.id()));
+        QVERIFY(!service.hasResults());
+        QVERIFY(service.lastError().contains(QStringLiteral("instável")));
+    }
+
+    void testTwoPhaseAssemblyMatchesDenseSum()
+    {
+        // Partially restrained nodes, an inclined bar with a k-point and a
+        // duplicated (parallel) element
+        FrameModel model;
+        model.addNode(0.0, 0.0, 0.0, kFixed);
+        model.addNode(3.0, 0.0, 0.0, 0x05);
+        model.addNode(3.0, 2.0, 1.0);
+        model.addNode(0.0, 2.0, 4.0, 0x38);
+        model.addNode(9.0, 9.0, 9.0); // not connected: no equations
+        model.elements.push_back(steelElement(0, 1));
+        model.elements.push_back(steelElement(1, 2));
+        model.elements.push_back(steelElement(2, 3));
+        model.elements.push_back(steelElement(2, 3));
+        model.elements.push_back(steelElement(3, 1));
+        model.elements[2].kPoint = std::array<double, 3>{{1.0, 1.0, 5.0}};
+        const std::vector<ElementAxes> axes = elementAxes(model);
+
+        const NodeGraph graph = NodeGraph::fromModel(model);
+        StiffnessAssembly assembly;
+        assembly.analyse(model, graph, nestedDissectionOrder(model, graph));
+        const CsrMatrix &matrix = assembly.assemble(model, axes);
+        const int n = assembly.equationCount();
+        QCOMPARE(n, 4 + 6 + 3);
+        QCOMPARE(assembly.equations()[6 * 4], -1);
+
+        std::vector<double> dense(static_cast<size_t>(n * n), 0.0);
+        ElementMatrix ke;
+        for (size_t e = 0; e < model.elementCount(); ++e) {
+            globalStiffness(model.elements[e], axes[e], ke);
+            for (int i = 0; i < kElementDofs; ++i) {
+                const int row = assembly.equations()[static_cast<size_t>(kNodeDofs * model.elements[e].nodes[static_cast<size_t>(i / kNodeDofs)] + i % kNodeDofs)];
+                for (int j = 0; j < kElementDofs; ++j) {
+                    const int column = assembly.equations()[static_cast<size_t>(kNodeDofs * model.elements[e].nodes[static_cast<size_t>(j / kNodeDofs)] + j % kNodeDofs)];
+                    if (row >= 0 && column >= 0) {
+                        dense[static_cast<size_t>(row * n + column)] += ke[static_cast<size_t>(i * kElementDofs + j)];
+                    }
+                }
+            }
+        }
+
+        std::vector<double> fromCsr(dense.size(), 0.0);
+        for (int row = 0; row < n; ++row) {
+            for (size_t p = matrix.rowStart[static_cast<size_t>(row)]; p < matrix.rowStart[static_cast<size_t>(row) + 1]; ++p) {
+                if (p > matrix.rowStart[static_cast<size_t>(row)]) {
+                    QVERIFY(matrix.columns[p] > matrix.columns[p - 1]);
+                }
+                fromCsr[static_cast<size_t>(row * n + matrix.columns[p])] = matrix.values[p];
+            }
+        }
+        for (size_t i = 0; i < dense.size(); ++i) {
+            QVERIFY(std::abs(fromCsr[i] - dense[i]) <= 1e-9 * std::max(1.0, std::abs(dense[i])));
+        }
+
+        // Numeric phase again with other properties: same structure, new values
+        FrameModel stiffer = model;
+        for (FrameElement &element : stiffer.elements) {
+            element.youngModulus *= 2.0;
+        }
+        const CsrMatrix &doubled = assembly.assemble(stiffer, axes);
+        QVERIFY(assembly.fits(stiffer));
+        for (int row = 0; row < n; ++row) {
+            const size_t diagonal = static_cast<size_t>(std::lower_bound(doubled.columns.begin() + static_cast<std::ptrdiff_t>(doubled.rowStart[static_cast<size_t>(row)]),
+                                                                         doubled.columns.begin() + static_cast<std::ptrdiff_t>(doubled.rowStart[static_cast<size_t>(row) + 1]), row)
+                                                        - doubled.columns.begin());
+            QCOMPARE(doubled.columns[diagonal], row);
+            QVERIFY(doubled.values[diagonal] > dense[static_cast<size_t>(row * n + row)]);
+        }
+    }
+
+    void testAnalysisServiceReusesStructure()
+    {
+        InMemoryModelRepository repo;
+        Material steel(QUuid::createUuid(), 1, "Aço", kE, kG);
+        Section light(QUuid::createUuid(), 1, "Leve", kA, kIz, kIy, kJ);
+        Section heavy(QUuid::createUuid(), 2, "Pesada", kA, 2 * kIz, 2 * kIy, kJ);
+        repo.addMaterial(steel);
+        repo.addSection(light);
+        repo.addSection(heavy);
+        Node base(QUuid::createUuid(), 1, 0.0, 0.0, 0.0);
+        base.setRestraintMask(kFixed);
+        Node tip(QUuid::createUuid(), 2, 4.0, 0.0, 0.0);
+        repo.addNode(base);
+        repo.addNode(tip);
+        BarService bars(&repo);
+        const QUuid barId = bars.createBar(base.id(), tip.id(), steel.id(), light.id());
+        LoadCase dead(QUuid::createUuid(), 1, "Dead");
+        LoadCase live(QUuid::createUuid(), 2, "Live");
+        repo.addLoadCase(dead);
+        repo.addLoadCase(live);
+        repo.addNodalLoad(NodalLoad(QUuid::createUuid(), dead.id(), tip.id(), Vector3(0.0, -1000.0, 0.0)));
+        repo.addNodalLoad(NodalLoad(QUuid::createUuid(), live.id(), tip.id(), Vector3(0.0, -3000.0, 0.0)));
+
+        AnalysisService service(&repo);
+        QVERIFY(!service.canReuseStructure());
+        QVERIFY(service.runLinearStatic(dead.id()));
+        QVERIFY(!service.lastResult().statistics.symbolicReused);
+        const double lightDeflection = (*service.nodeDisplacement(tip.id()))[1];
+
+        // Another load case and a property change keep the structure
+        QVERIFY(service.runLinearStatic(live.id()));
+        QVERIFY(service.lastResult().statistics.symbolicReused);
+        QVERIFY(closeTo((*service.nodeDisplacement(tip.id()))[1], 3.0 * lightDeflection));
+
+        QVERIFY(bars.assignProperties(barId, steel.id(), heavy.id()));
+        QVERIFY(service.canReuseStructure());
+        QVERIFY(service.runLinearStatic(dead.id()));
+        QVERIFY(service.lastResult().statistics.symbolicReused);
+        QVERIFY(closeTo((*service.nodeDisplacement(tip.id()))[1], 0.5 * lightDeflection));
+
+        // New restraints or members need a new structure
+        Node restrained = *repo.findNode(tip.id());
+        restrained.setRestraint(0, true);
+        repo.updateNode(restrained);
+        QVERIFY(!service.canReuseStructure());
+        QVERIFY(service.runLinearStatic(dead.id()));
+        QVERIFY(!service.lastResult().statistics.symbolicReused);
+
+        Node extra(QUuid::createUuid(), 3, 4.0, 0.0, 3.0);
+        repo.addNode(extra);
+        bars.createBar(tip.id(), extra.id(), steel.id(), light.id());
+        QVERIFY(!service.canReuseStructure());
+        QVERIFY(service.runLinearStatic(dead.id()));
+        QVERIFY(!service.lastResult().statistics.symbolicReused);
+    }
+
+    void testSharedAssemblyRebuildsOnTopologyChange()
+    {
+        FrameModel model = grillageModel(6);
+        StiffnessAssembly assembly;
+        const LinearStaticAnalysis analysis;
+        QVERIFY(analysis.run(model, &assembly).succeeded());
+
+        // Same topology: the structure is reused
+        const AnalysisResult again = analysis.run(model, &assembly);
+        QVERIFY(again.succeeded());
+        QVERIFY(again.statistics.symbolicReused);
+
+        // Freeing a support changes the equations, even with equal counts
+        model.restraints[3] = 0;
+        const AnalysisResult freed = analysis.run(model, &assembly);
+        const AnalysisResult fresh = analysis.run(model);
+        QVERIFY(freed.succeeded());
+        QVERIFY(!freed.statistics.symbolicReused);
+        QCOMPARE(freed.statistics.equations, fresh.statistics.equations);
+        for (size_t i = 0; i < fresh.displacements.size(); ++i) {
+            QVERIFY(std::abs(freed.displacements[i] - fresh.displacements[i])
+                    <= 1e-9 * std::max(1e-12, std::abs(fresh.displacements[i])) + 1e-15);
+        }
+
+        // Reconnecting an element changes the structure too
+        model.elements.back().nodes[0] = 0;
+        QVERIFY(!assembly.fits(model));
+        const AnalysisResult reconnected = analysis.run(model, &assembly);
+        QVERIFY(reconnected.succeeded());
+        QVERIFY(!reconnected.statistics.symbolicReused);
+        QVERIFY(assembly.fits(model));
+    }
+
+    void benchmarkAssembly_data()
+    {
+        QTest::addColumn<bool>("symbolic");
+        QTest::newRow("symbolic+numeric") << true;
+        QTest::newRow("numeric") << false;
+    }
+
+    void benchmarkAssembly()
+    {
+        QFETCH(bool, symbolic);
+        const FrameModel model = grillageModel(130);
+        const std::vector<ElementAxes> axes = elementAxes(model);
+        const NodeGraph graph = NodeGraph::fromModel(model);
+        const std::vector<int> order = nestedDissectionOrder(model, graph);
+        StiffnessAssembly assembly;
+        assembly.analyse(model, graph, order);
+
+        const int rounds = 5;
+        QElapsedTimer timer;
+        timer.start();
+        for (int round = 0; round < rounds; ++round) {
+            if (symbolic) {
+                assembly.analyse(model, graph, order);
+            }
+            assembly.assemble(model, axes);
+        }
+        const double seconds = std::max<qint64>(timer.elapsed(), 1) / 1000.0;
+        const double elementsPerSecond = rounds * static_cast<double>(model.elementCount()) / seconds;
+        qInfo("%zu elements, nnz(K) %zu: %.2f M elements/s",
+              model.elementCount(), assembly.matrix().nonZeros(), elementsPerSecond / 1e6);
+
+        QBENCHMARK {
+            if (symbolic) {
+                assembly.analyse(model, graph, order);
+            }
+            assembly.assemble(model, axes);
+        }
+    }
+
+    void testParallelAssemblyIsReproducible()
+    {
+        const FrameModel model = buildingFrame(7, 6, 5);
+        const std::vector<ElementAxes> axes = elementAxes(model);
+        const NodeGraph graph = NodeGraph::fromModel(model);
+        StiffnessAssembly assembly;
+        assembly.analyse(model, graph, nodeOrder(OrderingMethod::ApproximateMinimumDegree, model, graph));
+        const std::vector<double> reference = assembly.assemble(model, axes).values;
+        const double largest = std::abs(*std::max_element(reference.begin(), reference.end(), [](double a, double b) {
+            return std::abs(a) < std::abs(b);
+        }));
+
+        for (AssemblyMethod method : {AssemblyMethod::Coloured, AssemblyMethod::PartialMatrices}) {
+            const std::vector<double> serial = assembly.assemble(model, axes, method).values;
+            for (size_t i = 0; i < reference.size(); ++i) {
+                QVERIFY(std::abs(serial[i] - reference[i]) <= 1e-14 * largest);
+            }
+            for (int threads : {2, 3, 4}) {
+                ThreadPool pool(threads);
+                QVERIFY(assembly.assemble(model, axes, method, &pool).values == serial);
+            }
+        }
+
+        // The whole analysis then gives the same bits on any thread count
+        AnalysisOptions options;
+        options.solver = SolverMethod::UpLookingLdlt;
+        options.assembly = AssemblyMethod::PartialMatrices;
+        options.threads = 1;
+        const AnalysisResult serial = LinearStaticAnalysis(options).run(model);
+        QVERIFY(serial.succeeded());
+        options.threads = 3;
+        const AnalysisResult parallel = LinearStaticAnalysis(options).run(model);
+        QVERIFY(parallel.succeeded());
+        QCOMPARE(parallel.statistics.threads, 3);
+        QVERIFY(parallel.displacements == serial.displacements);
+    }
+
+    void benchmarkParallelAssembly_data()
+    {
+        QTest::addColumn<int>("method");
+        QTest::addColumn<int>("threads");
+        const int coloured = static_cast<int>(AssemblyMethod::Coloured);
+        const int partial = static_cast<int>(AssemblyMethod::PartialMatrices);
+        QTest::newRow("coloured, 1 thread") << coloured << 1;
+        QTest::newRow("partial matrices, 1 thread") << partial << 1;
+        QTest::newRow("coloured, 2 threads") << coloured << 2;
+        QTest::newRow("partial matrices, 2 threads") << partial << 2;
+        QTest::newRow("coloured, 4 threads") << coloured << 4;
+        QTest::newRow("partial matrices, 4 threads") << partial << 4;
+    }
+
+    void benchmarkParallelAssembly()
+    {
+        QFETCH(int, method);
+        QFETCH(int, threads);
+        const FrameModel model = grillageModel(130);
+        const std::vector<ElementAxes> axes = elementAxes(model);
+        const NodeGraph graph = NodeGraph::fromModel(model);
+        StiffnessAssembly assembly;
+        assembly.analyse(model, graph, nestedDissectionOrder(model, graph));
+        ThreadPool pool(threads);
+
+        const int rounds = 5;
+        QElapsedTimer timer;
+        timer.start();
+        for (int round = 0; round < rounds; ++round) {
+            assembly.assemble(model, axes, static_cast<AssemblyMethod>(method), &pool);
+        }
+        const double seconds = std::max<qint64>(timer.elapsed(), 1) / 1000.0;
+        qInfo("%zu elements, %d threads: %.2f M elements/s", model.elementCount(), pool.threadCount(),
+              rounds * static_cast<double>(model.elementCount()) / seconds / 1e6);
+
+        QBENCHMARK {
+            assembly.assemble(model, axes, static_cast<AssemblyMethod>(method), &pool);
+        }
+    }
+
+    void testOrderingsArePermutations()
+    {
+        // Two separate frames and an unconnected node
+        FrameModel model = scrambledGridFrame(6, 5, 7);
+        const int offset = static_cast<int>(model.nodeCount());
+        model.addNode(100.0, 0.0, 0.0, kFixed);
+        model.addNode(100.0, 0.0, 3.0);
+        model.addNode(200.0, 0.0, 0.0);
+        model.elements.push_back(steelElement(offset, offset + 1));
+        const NodeGraph graph = NodeGraph::fromModel(model);
+
+        for (OrderingMethod method : {OrderingMethod::Natural, OrderingMethod::ReverseCuthillMcKee,
+                                      OrderingMethod::ApproximateMinimumDegree, OrderingMethod::NestedDissection}) {
+            std::vector<int> order = nodeOrder(method, model, graph);
+            QCOMPARE(order.size(), model.nodeCount());
+            std::sort(order.begin(), order.end());
+            for (size_t i = 0; i < order.size(); ++i) {
+                QCOMPARE(order[i], static_cast<int>(i));
+            }
+        }
+    }
+
+    void testOrderingDoesNotChangeResults()
+    {
+        const FrameModel model = scrambledGridFrame(8, 6, 11);
+        const AnalysisResult reference = LinearStaticAnalysis().run(model);
+        QVERIFY(reference.succeeded());
+
+        for (OrderingMethod method : {OrderingMethod::Natural, OrderingMethod::ReverseCuthillMcKee,
+                                      OrderingMethod::NestedDissection}) {
+            AnalysisOptions options;
+            options.ordering = method;
+            const AnalysisResult result = LinearStaticAnalysis(options).run(model);
+            QVERIFY(result.succeeded());
+            QCOMPARE(result.statistics.ordering, method);
+            QCOMPARE(result.statistics.predictedFactorNonZeros, result.statistics.factorNonZeros);
+            for (size_t i = 0; i < result.displacements.size(); ++i) {
+                QVERIFY(std::abs(result.displacements[i] - reference.displacements[i])
+                        <= 1e-9 * std::max(1e-6, std::abs(reference.displacements[i])));
+            }
+        }
+    }
+
+    void testReorderingReducesBandwidthAndFill()
+    {
+        const FrameModel model = scrambledGridFrame(20, 20, 3);
+        auto estimate = [&model](OrderingMethod method) {
+            AnalysisOptions options;
+            options.ordering = method;
+            return LinearStaticAnalysis(options).estimate(model);
+        };
+        const AnalysisStatistics natural = estimate(OrderingMethod::Natural);
+        const AnalysisStatistics rcm = estimate(OrderingMethod::ReverseCuthillMcKee);
+        const AnalysisStatistics amd = estimate(OrderingMethod::ApproximateMinimumDegree);
+        QCOMPARE(rcm.equations, natural.equations);
+
+        // A 20 x 20 grid has a bandwidth of about one storey row of nodes
+        QVERIFY(rcm.bandwidth * 5 < natural.bandwidth);
+        QVERIFY(rcm.profile * 5 < natural.profile);
+        QVERIFY(amd.predictedFactorNonZeros * 3 < natural.predictedFactorNonZeros);
+        QVERIFY(amd.predictedFactorNonZeros < rcm.predictedFactorNonZeros);
+        QCOMPARE(natural.factorNonZeros, size_t(0)); // estimate() factorizes nothing
+    }
+
+    void benchmarkScrambledOrdering_data()
+    {
+        QTest::addColumn<int>("method");
+        QTest::newRow("natural") << static_cast<int>(OrderingMethod::Natural);
+        QTest::newRow("rcm") << static_cast<int>(OrderingMethod::ReverseCuthillMcKee);
+        QTest::newRow("amd") << static_cast<int>(OrderingMethod::ApproximateMinimumDegree);
+        QTest::newRow("nested-dissection") << static_cast<int>(OrderingMethod::NestedDissection);
+    }
+
+    void benchmarkScrambledOrdering()
+    {
+        QFETCH(int, method);
+        const FrameModel model = scrambledGridFrame(40, 40, 5);
+        AnalysisOptions options;
+        options.ordering = static_cast<OrderingMethod>(method);
+        const LinearStaticAnalysis analysis(options);
+
+        AnalysisResult result;
+        QBENCHMARK {
+            result = analysis.run(model);
+        }
+        QVERIFY(result.succeeded());
+        qInfo("%d equations: bandwidth %d, profile %zu, nnz(L) %zu; ordering %.1f ms, factorization %.1f ms",
+              result.statistics.equations, result.statistics.bandwidth, result.statistics.profile,
+              result.statistics.predictedFactorNonZeros, result.statistics.orderingMs, result.statistics.factorMs);
+    }
+
+    void testSolversAgree()
+    {
+        const FrameModel model = buildingFrame(5, 4, 6);
+        AnalysisOptions options;
+        options.solver = SolverMethod::UpLookingLdlt;
+        const AnalysisResult reference = LinearStaticAnalysis(options).run(model);
+        QVERIFY(reference.succeeded());
+
+        options.solver = SolverMethod::SupernodalLdlt;
+        options.threads = 1;
+        const AnalysisResult serial = LinearStaticAnalysis(options).run(model);
+        QVERIFY(serial.succeeded());
+        QCOMPARE(serial.statistics.solver, SolverMethod::SupernodalLdlt);
+        QCOMPARE(serial.statistics.threads, 1);
+        QCOMPARE(serial.statistics.predictedFactorNonZeros, serial.statistics.factorNonZeros);
+        // Relaxed supernodes store some explicit zeros, but not many
+        QVERIFY(serial.statistics.factorNonZeros >= reference.statistics.factorNonZeros);
+        QVERIFY(serial.statistics.factorNonZeros < reference.statistics.factorNonZeros * 5 / 4);
+        for (size_t i = 0; i < reference.displacements.size(); ++i) {
+            QVERIFY(std::abs(serial.displacements[i] - reference.displacements[i])
+                    <= 1e-9 * std::max(1e-6, std::abs(reference.displacements[i])));
+        }
+
+        // Subtrees run in parallel, but every supernode is computed the same
+        // way: the result does not depend on the thread count
+        options.solver = SolverMethod::SkylineLdlt;
+        const AnalysisResult skyline = LinearStaticAnalysis(options).run(model);
+        QVERIFY(skyline.succeeded());
+        for (size_t i = 0; i < reference.displacements.size(); ++i) {
+            QVERIFY(std::abs(skyline.displacements[i] - reference.displacements[i])
+                    <= 1e-9 * std::max(1e-6, std::abs(reference.displacements[i])));
+        }
+
+        options.solver = SolverMethod::SupernodalLdlt;
+        options.threads = 4;
+        const AnalysisResult parallel = LinearStaticAnalysis(options).run(model);
+        QVERIFY(parallel.succeeded());
+        QCOMPARE(parallel.statistics.threads, 4);
+        QVERIFY(parallel.displacements == serial.displacements);
+        QVERIFY(parallel.elementForces == serial.elementForces);
+    }
+
+    void testSupernodalSolvesConstrainedSystem()
+    {
+        // Saddle-point system [K C^T; C 0] of a two-bay frame whose two top
+        // corners are tied (equal UX) by a Lagrange multiplier, numbered last
+        FrameModel model = scrambledGridFrame(2, 1, 1);
+        const std::vector<ElementAxes> axes = elementAxes(model);
+        const NodeGraph graph = NodeGraph::fromModel(model);
+        StiffnessAssembly assembly;
+        assembly.analyse(model, graph, nodeOrder(OrderingMethod::Natural, model, graph));
+        const CsrMatrix &stiffness = assembly.assemble(model, axes);
+        const int n = stiffness.size;
+        const int size = n + 1;
+        std::vector<double> dense(static_cast<size_t>(size * size), 0.0);
+        for (int row = 0; row < n; ++row) {
+            for (size_t p = stiffness.rowStart[static_cast<size_t>(row)]; p < stiffness.rowStart[static_cast<size_t>(row) + 1]; ++p) {
+                dense[static_cast<size_t>(row * size + stiffness.columns[p])] = stiffness.values[p];
+            }
+        }
+        const std::vector<int> &equations = assembly.equations();
+        int left = -1, right = -1;
+        for (size_t node = 0; node < model.nodeCount(); ++node) {
+            if (model.coordinates[3 * node + 2] > 0.0 && model.coordinates[3 * node] == 0.0) {
+                left = equations[kNodeDofs * node];
+            }
+            if (model.coordinates[3 * node + 2] > 0.0 && model.coordinates[3 * node] == 12.0) {
+                right = equations[kNodeDofs * node];
+            }
+        }
+        QVERIFY(left >= 0 && right >= 0);
+        for (int k : {left, right}) {
+            const double c = k == left ? 1.0 : -1.0;
+            dense[static_cast<size_t>(n * size + k)] = c;
+            dense[static_cast<size_t>(k * size + n)] = c;
+        }
+        const CsrMatrix system = denseToCsr(dense, size);
+
+        std::vector<double> b(static_cast<size_t>(size), 0.0);
+        b[static_cast<size_t>(left)] = 1000.0;
+        ThreadPool pool(2);
+        SupernodalLdlt factor;
+        factor.setThreadPool(&pool);
+        QVERIFY(factor.factorize(system, 1e-12));
+        std::vector<double> x = b;
+        factor.solve(x.data());
+
+        std::vector<double> residual(static_cast<size_t>(size));
+        system.multiply(x.data(), residual.data());
+        for (int i = 0; i < size; ++i) {
+            QVERIFY(std::abs(residual[static_cast<size_t>(i)] - b[static_cast<size_t>(i)]) < 1e-6);
+        }
+        QVERIFY(closeTo(x[static_cast<size_t>(left)], x[static_cast<size_t>(right)], 1e-9));
+        QVERIFY(x[static_cast<size_t>(left)] > 0.0);
+        // The multiplier is the tension in the tie, holding the loaded corner back
+        QVERIFY(x[static_cast<size_t>(n)] > 0.0);
+
+        SparseLdlt upLooking;
+        SkylineLdlt skyline;
+        for (DirectSolver *other : {static_cast<DirectSolver *>(&upLooking), static_cast<DirectSolver *>(&skyline)}) {
+            QVERIFY(other->factorize(system, 1e-12));
+            std::vector<double> y = b;
+            other->solve(y.data());
+            for (int i = 0; i < size; ++i) {
+                QVERIFY(closeTo(y[static_cast<size_t>(i)], x[static_cast<size_t>(i)], 1e-8));
+            }
+        }
+    }
+
+    void testSkylineFactorizesInTheEnvelope()
+    {
+        // A slender tower: RCM keeps the envelope narrow
+        const FrameModel model = buildingFrame(3, 2, 20);
+        const AnalysisResult reference = LinearStaticAnalysis().run(model);
+        QVERIFY(reference.succeeded());
+
+        AnalysisOptions options;
+        options.ordering = OrderingMethod::ReverseCuthillMcKee;
+        options.solver = SolverMethod::SkylineLdlt;
+        const AnalysisResult skyline = LinearStaticAnalysis(options).run(model);
+        QVERIFY(skyline.succeeded());
+        QCOMPARE(skyline.statistics.solver, SolverMethod::SkylineLdlt);
+        QCOMPARE(skyline.statistics.factorNonZeros, skyline.statistics.profile);
+        QCOMPARE(skyline.statistics.factorNonZeros, skyline.statistics.predictedFactorNonZeros);
+        // Tall and slender: small rotations carry round-off of the sway,
+        // so compare against the largest displacement
+        double largest = 0.0;
+        for (double value : reference.displacements) {
+            largest = std::max(largest, std::abs(value));
+        }
+        for (size_t i = 0; i < reference.displacements.size(); ++i) {
+            QVERIFY(std::abs(skyline.displacements[i] - reference.displacements[i]) <= 1e-9 * largest);
+        }
+
+        // Same numbering: one offset per row beats indices per entry
+        options.solver = SolverMethod::SupernodalLdlt;
+        const AnalysisStatistics supernodal = LinearStaticAnalysis(options).estimate(model);
+        QVERIFY(skyline.statistics.factorBytes < supernodal.factorBytes);
+        QVERIFY(skyline.statistics.factorBytes
+                == (skyline.statistics.profile + static_cast<size_t>(skyline.statistics.equations)) * sizeof(double)
+                       + static_cast<size_t>(skyline.statistics.equations) * (sizeof(int) + sizeof(size_t))
+                       + sizeof(size_t));
+
+        options.solver = SolverMethod::SkylineLdlt;
+        FrameModel free = model;
+        free.restraints.assign(free.restraints.size(), 0);
+        QCOMPARE(LinearStaticAnalysis(options).run(free).status, AnalysisStatus::Unstable);
+    }
+
+    void benchmarkSkylineVersusSparse_data()
+    {
+        QTest::addColumn<int>("solver");
+        QTest::addColumn<int>("ordering");
+        QTest::newRow("skyline, rcm") << static_cast<int>(SolverMethod::SkylineLdlt)
+                                      << static_cast<int>(OrderingMethod::ReverseCuthillMcKee);
+        QTest::newRow("supernodal, rcm") << static_cast<int>(SolverMethod::SupernodalLdlt)
+                                         << static_cast<int>(OrderingMethod::ReverseCuthillMcKee);
+        QTest::newRow("supernodal, amd") << static_cast<int>(SolverMethod::SupernodalLdlt)
+                                         << static_cast<int>(OrderingMethod::ApproximateMinimumDegree);
+        QTest::newRow("up-looking, amd") << static_cast<int>(SolverMethod::UpLookingLdlt)
+                                         << static_cast<int>(OrderingMethod::ApproximateMinimumDegree);
+    }
+
+    void benchmarkSkylineVersusSparse()
+    {
+        QFETCH(int, solver);
+        QFETCH(int, ordering);
+        // 6 x 4 bays, 40 storeys: about 8.4k equations with a narrow profile
+        const FrameModel model = buildingFrame(6, 4, 40);
+        AnalysisOptions options;
+        options.solver = static_cast<SolverMethod>(solver);
+        options.ordering = static_cast<OrderingMethod>(ordering);
+        options.threads = 1;
+        const LinearStaticAnalysis analysis(options);
+
+        AnalysisResult result;
+        QBENCHMARK {
+            result = analysis.run(model);
+        }
+        QVERIFY(result.succeeded());
+        qInfo("%d equations, profile %zu: nnz(L) %zu, factor %.1f MB; factorization %.1f ms, solve %.1f ms",
+              result.statistics.equations, result.statistics.profile, result.statistics.factorNonZeros,
+              result.statistics.factorBytes / 1e6, result.statistics.factorMs, result.statistics.solveMs);
+    }
+
+    void testSupernodalReportsMechanism()
+    {
+        // A building plus a detached bar pinned at both ends, free to spin
+        // about its own axis
+        FrameModel model = buildingFrame(4, 3, 5);
+        const int first = static_cast<int>(model.nodeCount());
+        model.addNode(100.0, 0.0, 0.0, 0x07);
+        model.addNode(101.0, 0.0, 0.0, 0x07);
+        model.elements.push_back(steelElement(first, first + 1));
+
+        AnalysisResult serial;
+        for (int threads : {1, 4}) {
+            AnalysisOptions options;
+            options.threads = threads;
+            const AnalysisResult result = LinearStaticAnalysis(options).run(model);
+            QCOMPARE(result.status, AnalysisStatus::Unstable);
+            QVERIFY(result.failedNode == first || result.failedNode == first + 1);
+            QCOMPARE(result.failedDof, 3);
+            if (threads == 1) {
+                serial = result;
+            }
+            QCOMPARE(result.failedNode, serial.failedNode);
+        }
+
+        // The iterative solvers, also when Automatic picks one, check the
+        // supports before iterating
+        for (SolverMethod solver : {SolverMethod::ConjugateGradient, SolverMethod::MatrixFreeConjugateGradient,
+                                    SolverMethod::Automatic}) {
+            AnalysisOptions options;
+            options.solver = solver;
+            options.directFactorLimit = 0;
+            const AnalysisResult result = LinearStaticAnalysis(options).run(model);
+            QCOMPARE(result.status, AnalysisStatus::Unstable);
+            QVERIFY(result.failedNode == first || result.failedNode == first + 1);
+            QCOMPARE(result.failedDof, 3);
+        }
+    }
+
+    void benchmarkSupernodalScaling_data()
+    {
+        QTest::addColumn<int>("threads");
+        QTest::newRow("1 thread") << 1;
+        QTest::newRow("2 threads") << 2;
+        QTest::newRow("4 threads") << 4;
+        QTest::newRow("8 threads") << 8;
+    }
+
+    void benchmarkSupernodalScaling()
+    {
+        QFETCH(int, threads);
+        // 20 x 20 bays, 10 storeys: about 26k equations
+        const FrameModel model = buildingFrame(20, 20, 10);
+        const NodeGraph graph = NodeGraph::fromModel(model);
+        StiffnessAssembly assembly;
+        assembly.analyse(model, graph, nodeOrder(OrderingMethod::ApproximateMinimumDegree, model, graph));
+        const CsrMatrix &stiffness = assembly.assemble(model, elementAxes(model));
+
+        ThreadPool pool(threads);
+        SupernodalLdlt factor;
+        factor.setThreadPool(&pool);
+        factor.analyse(stiffness);
+        bool factorized = false;
+        QElapsedTimer timer;
+        timer.start();
+        QBENCHMARK {
+            factorized = factor.factorizeNumeric(stiffness, 1e-10);
+        }
+        QVERIFY(factorized);
+        qInfo("%d equations, nnz(L) %zu, %d supernodes: %d of %u hardware threads, %lld ms",
+              stiffness.size, factor.factorNonZeros(), factor.supernodeCount(), pool.threadCount(),
+              std::thread::hardware_concurrency(), timer.elapsed());
+    }
+
+    void testConjugateGradientMatchesDirect()
+    {
+        const FrameModel model = buildingFrame(5, 4, 6);
+        AnalysisOptions options;
+        options.solver = SolverMethod::SupernodalLdlt;
+        const AnalysisResult reference = LinearStaticAnalysis(options).run(model);
+        QVERIFY(reference.succeeded());
+        double largest = 0.0;
+        for (double u : reference.displacements) {
+            largest = std::max(largest, std::abs(u));
+        }
+
+        options.solver = SolverMethod::ConjugateGradient;
+        options.iterativeTolerance = 1e-12;
+        for (PreconditionerMethod preconditioner : {PreconditionerMethod::Jacobi, PreconditionerMethod::BlockJacobi,
+                                                    PreconditionerMethod::IncompleteCholesky}) {
+            options.preconditioner = preconditioner;
+            const AnalysisResult result = LinearStaticAnalysis(options).run(model);
+            QVERIFY(result.succeeded());
+            const AnalysisStatistics &statistics = result.statistics;
+            QCOMPARE(statistics.solver, SolverMethod::ConjugateGradient);
+            QCOMPARE(statistics.factorNonZeros, size_t(0));
+            QVERIFY(statistics.iterations > 0);
+            QVERIFY(statistics.iterations < statistics.equations);
+            QCOMPARE(statistics.residualHistory.size(), static_cast<size_t>(statistics.iterations) + 1);
+            QCOMPARE(statistics.residualHistory.front(), 1.0);
+            QCOMPARE(statistics.residualHistory.back(), statistics.relativeResidual);
+            QVERIFY(statistics.relativeResidual <= 1e-12);
+            for (size_t i = 0; i < reference.displacements.size(); ++i) {
+                QVERIFY(std::abs(result.displacements[i] - reference.displacements[i]) <= 1e-9 * largest);
+            }
+        }
+    }
+
+    void testConjugateGradientIsThreadIndependent()
+    {
+        const FrameModel model = buildingFrame(8, 6, 8);
+        AnalysisOptions options;
+        options.solver = SolverMethod::ConjugateGradient;
+        options.threads = 1;
+        const AnalysisResult serial = LinearStaticAnalysis(options).run(model);
+        QVERIFY(serial.succeeded());
+
+        // Rows of K x and chunks of the dot products are summed in a fixed
+        // order, so every iterate is the same on any number of threads
+        options.threads = 4;
+        const AnalysisResult parallel = LinearStaticAnalysis(options).run(model);
+        QVERIFY(parallel.succeeded());
+        QCOMPARE(parallel.statistics.threads, 4);
+        QCOMPARE(parallel.statistics.iterations, serial.statistics.iterations);
+        QVERIFY(parallel.statistics.residualHistory == serial.statistics.residualHistory);
+        QVERIFY(parallel.displacements == serial.displacements);
+    }
+
+    void testAutomaticSolverFollowsPredictedFill()
+    {
+        const FrameModel model = buildingFrame(6, 5, 6);
+        AnalysisOptions options;
+        QCOMPARE(options.solver, SolverMethod::Automatic);
+        const AnalysisResult direct = LinearStaticAnalysis(options).run(model);
+        QVERIFY(direct.succeeded());
+        QCOMPARE(direct.statistics.solver, SolverMethod::SupernodalLdlt);
+        QCOMPARE(LinearStaticAnalysis(options).estimate(model).solver, SolverMethod::SupernodalLdlt);
+
+        options.directFactorLimit = direct.statistics.predictedFactorNonZeros - 1;
+        const AnalysisResult iterative = LinearStaticAnalysis(options).run(model);
+        QVERIFY(iterative.succeeded());
+        QCOMPARE(iterative.statistics.solver, SolverMethod::ConjugateGradient);
+        QCOMPARE(iterative.statistics.predictedFactorNonZeros, direct.statistics.predictedFactorNonZeros);
+        QCOMPARE(iterative.statistics.factorNonZeros, size_t(0));
+        QVERIFY(iterative.statistics.iterations > 0);
+        QCOMPARE(LinearStaticAnalysis(options).estimate(model).solver, SolverMethod::ConjugateGradient);
+    }
+
+    void testConjugateGradientReportsNonConvergence()
+    {
+        const FrameModel model = buildingFrame(4, 3, 5);
+        AnalysisOptions options;
+        options.solver = SolverMethod::ConjugateGradient;
+        options.maxIterations = 3;
+        const AnalysisResult result = LinearStaticAnalysis(options).run(model);
+        QCOMPARE(result.status, AnalysisStatus::NotConverged);
+        QVERIFY(!result.succeeded());
+        QVERIFY(result.displacements.empty());
+        QCOMPARE(result.statistics.iterations, 3);
+        QCOMPARE(result.statistics.residualHistory.size(), size_t(4));
+        QVERIFY(result.statistics.relativeResidual > options.iterativeTolerance);
+
+        // A bar free to twist, loaded only in bending: CG would converge on
+        // the singular K, so the mechanism must be reported instead
+        FrameModel twisting;
+        twisting.addNode(0.0, 0.0, 0.0, 0x07);
+        twisting.addNode(4.0, 0.0, 0.0, 0x06);
+        twisting.elements.push_back(steelElement(0, 1));
+        twisting.addNodalLoad(1, {{0.0, 0.0, 0.0, 0.0, 0.0, 1000.0}});
+        for (SolverMethod solver : {SolverMethod::SupernodalLdlt, SolverMethod::ConjugateGradient,
+                                    SolverMethod::MatrixFreeConjugateGradient}) {
+            AnalysisOptions twistOptions;
+            twistOptions.solver = solver;
+            const AnalysisResult twisted = LinearStaticAnalysis(twistOptions).run(twisting);
+            QCOMPARE(twisted.status, AnalysisStatus::Unstable);
+            QCOMPARE(twisted.failedDof, 3);
+        }
+
+        // A support off the bar axis stops the twist
+        twisting.addNode(0.0, 0.0, 3.0, 0x02);
+        twisting.elements.push_back(steelElement(0, 2));
+        twisting.nodalLoads.resize(kNodeDofs * twisting.nodeCount(), 0.0);
+        for (SolverMethod solver : {SolverMethod::SupernodalLdlt, SolverMethod::ConjugateGradient}) {
+            AnalysisOptions twistOptions;
+            twistOptions.solver = solver;
+            QVERIFY(LinearStaticAnalysis(twistOptions).run(twisting).succeeded());
+        }
+    }
+
+    void benchmarkPreconditioners_data()
+    {
+        QTest::addColumn<int>("preconditioner");
+        QTest::addColumn<int>("ordering");
+        QTest::newRow("jacobi") << static_cast<int>(PreconditionerMethod::Jacobi)
+                                << static_cast<int>(OrderingMethod::ApproximateMinimumDegree);
+        QTest::newRow("block-jacobi") << static_cast<int>(PreconditionerMethod::BlockJacobi)
+                                      << static_cast<int>(OrderingMethod::ApproximateMinimumDegree);
+        QTest::newRow("ic0, amd") << static_cast<int>(PreconditionerMethod::IncompleteCholesky)
+                                  << static_cast<int>(OrderingMethod::ApproximateMinimumDegree);
+        QTest::newRow("ic0, rcm") << static_cast<int>(PreconditionerMethod::IncompleteCholesky)
+                                  << static_cast<int>(OrderingMethod::ReverseCuthillMcKee);
+        QTest::newRow("amg") << static_cast<int>(PreconditionerMethod::SmoothedAggregation)
+                             << static_cast<int>(OrderingMethod::ApproximateMinimumDegree);
+    }
+
+    void benchmarkPreconditioners()
+    {
+        QFETCH(int, preconditioner);
+        QFETCH(int, ordering);
+        // 20 x 20 bays, 10 storeys: about 26k equations
+        const FrameModel model = buildingFrame(20, 20, 10);
+        AnalysisOptions options;
+        options.solver = SolverMethod::ConjugateGradient;
+        options.preconditioner = static_cast<PreconditionerMethod>(preconditioner);
+        options.ordering = static_cast<OrderingMethod>(ordering);
+        const LinearStaticAnalysis analysis(options);
+
+        AnalysisResult result;
+        QBENCHMARK {
+            result = analysis.run(model);
+        }
+        QVERIFY(result.succeeded());
+        qInfo("%d equations, %d threads: %d iterations to %.1e; setup %.1f ms, iterations %.1f ms",
+              result.statistics.equations, result.statistics.threads, result.statistics.iterations,
+              result.statistics.relativeResidual, result.statistics.preconditionerMs, result.statistics.solveMs);
+    }
+
+    void testElementColouringIsConflictFree()
+    {
+        const FrameModel model = buildingFrame(6, 5, 4);
+        const ElementColouring colouring = colourElements(model);
+        QCOMPARE(colouring.elements.size(), model.elements.size());
+        QCOMPARE(colouring.colourStart.back(), static_cast<int>(model.elements.size()));
+
+        // Interior nodes of a building carry 6 bars: at most 11 colours
+        QVERIFY(colouring.colourCount() >= 6);
+        QVERIFY(colouring.colourCount() <= 11);
+        std::vector<int> seen(model.elements.size(), 0);
+        std::vector<int> nodeColour(model.nodeCount(), -1);
+        for (int c = 0; c < colouring.colourCount(); ++c) {
+            for (int p = colouring.colourStart[static_cast<size_t>(c)]; p < colouring.colourStart[static_cast<size_t>(c) + 1]; ++p) {
+                const int e = colouring.elements[static_cast<size_t>(p)];
+                ++seen[static_cast<size_t>(e)];
+                for (int node : model.elements[static_cast<size_t>(e)].nodes) {
+                    QVERIFY(nodeColour[static_cast<size_t>(node)] != c);
+                    nodeColour[static_cast<size_t>(node)] = c;
+                }
+            }
+        }
+        QVERIFY(std::all_of(seen.begin(), seen.end(), [](int count) { return count == 1; }));
+    }
+
+    void testMatrixFreeProductMatchesAssembledMatrix()
+    {
+        const FrameModel model = scrambledGridFrame(5, 4, 13);
+        const NodeGraph graph = NodeGraph::fromModel(model);
+        StiffnessAssembly assembly;
+        assembly.analyse(model, graph, nodeOrder(OrderingMethod::ApproximateMinimumDegree, model, graph));
+        const std::vector<ElementAxes> axes = elementAxes(model);
+        const CsrMatrix &stiffness = assembly.assemble(model, axes);
+        const auto n = static_cast<size_t>(stiffness.size);
+
+        std::mt19937 random(3);
+        std::uniform_real_distribution<double> value(-1.0, 1.0);
+        std::vector<double> x(n);
+        for (double &xi : x) {
+            xi = value(random);
+        }
+        std::vector<double> expected(n);
+        stiffness.multiply(x.data(), expected.data());
+        double largest = 0.0;
+        for (double yi : expected) {
+            largest = std::max(largest, std::abs(yi));
+        }
+
+        ThreadPool pool(3);
+        for (ElementStorage storage : {ElementStorage::GlobalMatrices, ElementStorage::LocalCoefficients}) {
+            const MatrixFreeOperator serial(model, axes, assembly.equations(), stiffness.size, storage);
+            QCOMPARE(serial.size(), stiffness.size);
+            std::vector<double> y(n);
+            serial.apply(x.data(), y.data());
+            for (size_t i = 0; i < n; ++i) {
+                QVERIFY(std::abs(y[i] - expected[i]) <= 1e-12 * largest);
+            }
+
+            const MatrixFreeOperator parallel(model, axes, assembly.equations(), stiffness.size, storage, &pool);
+            std::vector<double> z(n);
+            parallel.apply(x.data(), z.data());
+            QVERIFY(z == y);
+        }
+
+        // Nodal diagonal blocks, entry for entry
+        const CsrMatrix blocks = nodalBlockDiagonal(model, axes, assembly.equations(), assembly.dofOfEquation());
+        QCOMPARE(blocks.size, stiffness.size);
+        for (size_t row = 0; row < n; ++row) {
+            const int node = assembly.dofOfEquation()[row] / kNodeDofs;
+            for (size_t p = stiffness.rowStart[row]; p < stiffness.rowStart[row + 1]; ++p) {
+                const int column = stiffness.columns[p];
+                if (assembly.dofOfEquation()[static_cast<size_t>(column)] / kNodeDofs != node) {
+                    continue;
+                }
+                const auto first = blocks.columns.begin() + static_cast<std::ptrdiff_t>(blocks.rowStart[row]);
+                const auto last = blocks.columns.begin() + static_cast<std::ptrdiff_t>(blocks.rowStart[row + 1]);
+                const auto it = std::find(first, last, column);
+                QVERIFY(it != last);
+                QVERIFY(closeTo(blocks.values[static_cast<size_t>(it - blocks.columns.begin())], stiffness.values[p], 1e-12)
+                        || std::abs(stiffness.values[p]) < 1e-9 * largest);
+            }
+        }
+    }
+
+    void testMatrixFreeSolveMatchesDirect()
+    {
+        FrameModel model = buildingFrame(5, 4, 6);
+        model.elementLoads.push_back({3, {{0.0, 0.0, -8e3}}, false});
+        AnalysisOptions options;
+        options.solver = SolverMethod::SupernodalLdlt;
+        const AnalysisResult reference = LinearStaticAnalysis(options).run(model);
+        QVERIFY(reference.succeeded());
+        double largest = 0.0;
+        for (double u : reference.displacements) {
+            largest = std::max(largest, std::abs(u));
+        }
+
+        options.solver = SolverMethod::MatrixFreeConjugateGradient;
+        options.iterativeTolerance = 1e-12;
+        for (ElementStorage storage : {ElementStorage::GlobalMatrices, ElementStorage::LocalCoefficients}) {
+            options.elementStorage = storage;
+            const AnalysisResult result = LinearStaticAnalysis(options).run(model);
+            QVERIFY(result.succeeded());
+            QCOMPARE(result.statistics.solver, SolverMethod::MatrixFreeConjugateGradient);
+            QCOMPARE(result.statistics.equations, reference.statistics.equations);
+            QCOMPARE(result.statistics.matrixNonZeros, size_t(0));
+            QVERIFY(result.statistics.stiffnessBytes > 0);
+            QCOMPARE(LinearStaticAnalysis(options).estimate(model).stiffnessBytes,
+                     model.elements.size() * MatrixFreeOperator::bytesPerElement(storage));
+            for (size_t i = 0; i < reference.displacements.size(); ++i) {
+                QVERIFY(std::abs(result.displacements[i] - reference.displacements[i]) <= 1e-9 * largest);
+            }
+            for (size_t i = 0; i < reference.reactions.size(); ++i) {
+                QVERIFY(std::abs(result.reactions[i] - reference.reactions[i])
+                        <= 1e-6 * std::max(1.0, std::abs(reference.reactions[i])));
+            }
+        }
+
+        // The coefficients form costs a small fraction of the assembled matrix
+        QVERIFY(LinearStaticAnalysis(options).estimate(model).stiffnessBytes * 4 < reference.statistics.stiffnessBytes);
+    }
+
+    void benchmarkMatrixFreeProduct_data()
+    {
+        QTest::addColumn<int>("storage");
+        QTest::newRow("assembled csr") << -1;
+        QTest::newRow("element matrices") << static_cast<int>(ElementStorage::GlobalMatrices);
+        QTest::newRow("local coefficients") << static_cast<int>(ElementStorage::LocalCoefficients);
+    }
+
+    void benchmarkMatrixFreeProduct()
+    {
+        QFETCH(int, storage);
+        // 20 x 20 bays, 10 storeys: about 26k equations
+        const FrameModel model = buildingFrame(20, 20, 10);
+        const NodeGraph graph = NodeGraph::fromModel(model);
+        StiffnessAssembly assembly;
+        assembly.analyse(model, graph, nodeOrder(OrderingMethod::ReverseCuthillMcKee, model, graph));
+        const std::vector<ElementAxes> axes = elementAxes(model);
+        const CsrMatrix &stiffness = assembly.assemble(model, axes);
+
+        ThreadPool pool;
+        std::unique_ptr<LinearOperator> product;
+        size_t bytes = stiffness.rowStart.size() * sizeof(size_t) + stiffness.nonZeros() * (sizeof(int) + sizeof(double));
+        if (storage < 0) {
+            product = std::make_unique<CsrOperator>(stiffness, &pool);
+        } else {
+            auto matrixFree = std::make_unique<MatrixFreeOperator>(model, axes, assembly.equations(), stiffness.size,
+                                                                   static_cast<ElementStorage>(storage), &pool);
+            bytes = matrixFree->bytes();
+            product = std::move(matrixFree);
+        }
+        std::vector<double> x(static_cast<size_t>(stiffness.size), 1.0);
+        std::vector<double> y(x.size());
+        QElapsedTimer timer;
+        timer.start();
+        int products = 0;
+        QBENCHMARK {
+            for (int i = 0; i < 20; ++i) {
+                product->apply(x.data(), y.data());
+                ++products;
+            }
+        }
+        qInfo("%d equations, %d threads: %.2f MB, %.3f ms per product", stiffness.size, pool.threadCount(),
+              bytes / 1e6, static_cast<double>(timer.elapsed()) / products);
+    }
+
+    void testMultigridHierarchy()
+    {
+        const FrameModel model = grillageModel(40);
+        const NodeGraph graph = NodeGraph::fromModel(model);
+        StiffnessAssembly assembly;
+        assembly.analyse(model, graph, nodeOrder(OrderingMethod::ApproximateMinimumDegree, model, graph));
+        const CsrMatrix &stiffness = assembly.assemble(model, elementAxes(model));
+
+        const SmoothedAggregationPreconditioner multigrid(stiffness, assembly.dofOfEquation(), model.coordinates);
+        QCOMPARE(multigrid.failedEquation(), -1);
+        QVERIFY(multigrid.levelCount() >= 2);
+        QCOMPARE(multigrid.levelSize(0), stiffness.size);
+        for (int level = 1; level < multigrid.levelCount(); ++level) {
+            QVERIFY(multigrid.levelSize(level) * 4 < multigrid.levelSize(level - 1));
+        }
+        QVERIFY(multigrid.levelSize(multigrid.levelCount() - 1) <= SmoothedAggregationPreconditioner::kCoarsestEquations);
+        QVERIFY(multigrid.operatorComplexity() < 2.0);
+
+        // One V-cycle is a symmetric operator: x^T M^-1 y == y^T M^-1 x
+        std::mt19937 random(5);
+        std::uniform_real_distribution<double> value(-1.0, 1.0);
+        const auto n = static_cast<size_t>(stiffness.size);
+        std::vector<double> x(n);
+        std::vector<double> y(n);
+        for (size_t i = 0; i < n; ++i) {
+            x[i] = value(random);
+            y[i] = value(random);
+        }
+        std::vector<double> mx(n);
+        std::vector<double> my(n);
+        multigrid.apply(x.data(), mx.data());
+        multigrid.apply(y.data(), my.data());
+        const double xMy = std::inner_product(x.begin(), x.end(), my.begin(), 0.0);
+        const double yMx = std::inner_product(y.begin(), y.end(), mx.begin(), 0.0);
+        QVERIFY(std::abs(xMy - yMx) <= 1e-10 * std::abs(xMy));
+    }
+
+    void testMultigridIterationsStayFlatUnderRefinement()
+    {
+        // Slender columns under a very stiff transfer floor, with every bar
+        // split into 1, 2 and 4 elements
+        FrameModel base = buildingFrame(6, 5, 6);
+        for (FrameElement &element : base.elements) {
+            const double z0 = base.coordinates[3 * static_cast<size_t>(element.nodes[0]) + 2];
+            const double z1 = base.coordinates[3 * static_cast<size_t>(element.nodes[1]) + 2];
+            const double scale = z0 != z1 ? 0.2 : (z0 == 6.0 ? 1000.0 : 1.0);
+            element.area *= scale;
+            element.iy *= scale;
+            element.iz *= scale;
+            element.torsionalConstant *= scale;
+        }
+
+        std::vector<int> multigridIterations;
+        std::vector<int> blockJacobiIterations;
+        for (int segments : {1, 2, 4}) {
+            const FrameModel model = subdivided(base, segments);
+            AnalysisOptions options;
+            options.solver = SolverMethod::SupernodalLdlt;
+            const AnalysisResult reference = LinearStaticAnalysis(options).run(model);
+            QVERIFY(reference.succeeded());
+            double largest = 0.0;
+            for (double u : reference.displacements) {
+                largest = std::max(largest, std::abs(u));
+            }
+
+            options.solver = SolverMethod::ConjugateGradient;
+            options.maxIterations = 20000;
+            options.preconditioner = PreconditionerMethod::SmoothedAggregation;
+            const AnalysisResult multigrid = LinearStaticAnalysis(options).run(model);
+            QVERIFY(multigrid.succeeded());
+            for (size_t i = 0; i < reference.displacements.size(); ++i) {
+                QVERIFY(std::abs(multigrid.displacements[i] - reference.displacements[i]) <= 1e-7 * largest);
+            }
+            multigridIterations.push_back(multigrid.statistics.iterations);
+
+            options.preconditioner = PreconditionerMethod::BlockJacobi;
+            const AnalysisResult blockJacobi = LinearStaticAnalysis(options).run(model);
+            QVERIFY(blockJacobi.succeeded());
+            blockJacobiIterations.push_back(blockJacobi.statistics.iterations);
+            qInfo("%d segments, %d equations: multigrid %d iterations (setup %.1f ms, solve %.1f ms), "
+                  "block-Jacobi %d iterations",
+                  segments, multigrid.statistics.equations, multigrid.statistics.iterations,
+                  multigrid.statistics.preconditionerMs, multigrid.statistics.solveMs,
+                  blockJacobi.statistics.iterations);
+        }
+        QVERIFY(multigridIterations.back() * 2 < multigridIterations.front() * 3);
+        QVERIFY(blockJacobiIterations.back() > 3 * blockJacobiIterations.front());
+        QVERIFY(multigridIterations.back() * 4 < blockJacobiIterations.back());
+    }
+
+    void benchmarkLargeGrillage()
+    {
+        // 130 x 130 bays: about 100k free DOFs
+        const FrameModel model = grillageModel(130);
+        QElapsedTimer timer;
+        timer.start();
+        const AnalysisResult result = LinearStaticAnalysis().run(model);
+        const qint64 elapsed = timer.elapsed();
+
+        QVERIFY(result.succeeded());
+        QVERIFY(result.statistics.equations > 99000);
+        qInfo("%d equations, nnz(K) %zu, nnz(L) %zu: ordering %.0f ms, assembly %.0f ms, "
+              "factorization %.0f ms, solve %.0f ms",
+              result.statistics.equations, result.statistics.matrixNonZeros,
+              result.statistics.factorNonZeros, result.statistics.orderingMs,
+              result.statistics.assemblyMs, result.statistics.factorMs, result.statistics.solveMs);
+        QTest::setBenchmarkResult(double(elapsed), QTest::WalltimeMilliseconds);
+    }
+};
+
+QTEST_MAIN(TestAnalysis)
+#include "TestAnalysis.moc"
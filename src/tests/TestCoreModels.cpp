@@ -149,7 +149,6 @@ private slots:
         QCOMPARE(node.x(), 0.0);
         QCOMPARE(node.y(), 0.0);
         QCOMPARE(node.z(), 0.0);
-        QVERIFY(!node.isSelected());
         QVERIFY(!node.hasRestraints());
     }
 
@@ -202,16 +201,16 @@ private slots:
         QVERIFY(!restraints[1]);
         QVERIFY(restraints[2]);
         
+        QCOMPARE(node.restraintMask(), std::uint8_t(0b101));
+        
         node.clearRestraints();
         QVERIFY(!node.hasRestraints());
-    }
-
-    void testSelection()
-    {
-        Node node;
-        QVERIFY(!node.isSelected());
-        node.setSelected(true);
-        QVERIFY(node.isSelected());
+        
+        node.setRestraintMask(0xff);
+        QCOMPARE(node.restraintMask(), std::uint8_t(0x3f));
+        node.setRestraint(5, false);
+        QVERIFY(!node.restraints()[5]);
+        QVERIFY(node.restraints()[4]);
     }
 };
 
@@ -228,8 +227,6 @@ private slots:
         Bar bar;
         QVERIFY(!bar.id().isNull());
         QCOMPARE(bar.externalId(), 0);
-        QVERIFY(!bar.isSelected());
-        QVERIFY(!bar.hasKPoint());
         QVERIFY(bar.isLCSDirty());
     }
 
@@ -249,24 +246,6 @@ private slots:
         QCOMPARE(bar.sectionId(), secId);
     }
 
-    void testKPoint()
-    {
-        Bar bar;
-        QVERIFY(!bar.hasKPoint());
-        
-        Vector3 kp(1.0, 2.0, 3.0);
-        bar.setKPoint(kp);
-        
-        QVERIFY(bar.hasKPoint());
-        QVERIFY(bar.isLCSDirty());
-        QCOMPARE(bar.kPoint()->x(), 1.0);
-        QCOMPARE(bar.kPoint()->y(), 2.0);
-        QCOMPARE(bar.kPoint()->z(), 3.0);
-        
-        bar.clearKPoint();
-        QVERIFY(!bar.hasKPoint());
-    }
-
     void testCalculateLength()
     {
         Vector3 start(0.0, 0.0, 0.0);
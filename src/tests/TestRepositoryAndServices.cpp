@@ -1,11 +1,71 @@
 #include <QtTest/QtTest>
 #include "../app/InMemoryModelRepository.h"
+#include "../app/ConcurrentModelRepository.h"
 #include "../app/NodeService.h"
 #include "../app/BarService.h"
+#include "../app/ModelTransaction.h"
+#include "../app/DatModelReader.h"
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <cstdio>
+#include <random>
+#include <thread>
+#ifdef Q_OS_UNIX
+#include <sys/resource.h>
+#endif
 
 using namespace Structura::App;
 using namespace Structura::Model;
 
+/// Peak resident set size of this process in bytes (0 where unsupported)
+static qint64 peakResidentBytes()
+{
+#ifdef Q_OS_UNIX
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#ifdef Q_OS_MACOS
+        return static_cast<qint64>(usage.ru_maxrss);
+#else
+        return static_cast<qint64>(usage.ru_maxrss) * 1024;
+#endif
+    }
+#endif
+    return 0;
+}
+
+/// Best of three wall times, in nanoseconds, for emptying a repository of
+/// @p count nodes one by one or with one removeNodes() call
+static qint64 nodeRemovalNanoseconds(int count, bool bulk)
+{
+    qint64 best = std::numeric_limits<qint64>::max();
+    for (int run = 0; run < 3; ++run) {
+        InMemoryModelRepository repo;
+        std::vector<QUuid> ids;
+        ids.reserve(static_cast<size_t>(count));
+        for (int i = 0; i < count; ++i) {
+            Node node(QUuid::createUuid(), i + 1, i, 0.0, 0.0);
+            ids.push_back(node.id());
+            repo.addNode(node);
+        }
+
+        QElapsedTimer timer;
+        timer.start();
+        if (bulk) {
+            repo.removeNodes(ids);
+        } else {
+            for (const QUuid &id : ids) {
+                repo.removeNode(id);
+            }
+        }
+        best = std::min(best, timer.nsecsElapsed());
+        if (repo.nodeCount() != 0) {
+            return -1;
+        }
+    }
+    return best;
+}
+
 /**
  * @brief Unit tests for InMemoryModelRepository
  */
@@ -124,6 +184,972 @@ private slots:
         QCOMPARE(repo.barCount(), static_cast<size_t>(0));
         QCOMPARE(repo.materialCount(), static_cast<size_t>(0));
     }
+
+    void testRemoveKeepsIndexConsistent()
+    {
+        InMemoryModelRepository repo;
+
+        std::vector<QUuid> ids;
+        for (int i = 0; i < 5; ++i) {
+            Node node(QUuid::createUuid(), i + 1, i, 0.0, 0.0);
+            ids.push_back(node.id());
+            repo.addNode(node);
+        }
+
+        // Removing from the middle moves the last node into the hole
+        QVERIFY(repo.removeNode(ids[1]));
+        QVERIFY(!repo.removeNode(ids[1]));
+        QCOMPARE(repo.nodeCount(), static_cast<size_t>(4));
+
+        for (size_t i = 0; i < ids.size(); ++i) {
+            auto found = repo.findNode(ids[i]);
+            QCOMPARE(found.has_value(), i != 1);
+            if (found) {
+                QCOMPARE(found->id(), ids[i]);
+                QCOMPARE(found->externalId(), static_cast<int>(i) + 1);
+            }
+        }
+    }
+
+    void testRemoveNodesBulk()
+    {
+        InMemoryModelRepository repo;
+
+        std::vector<QUuid> ids;
+        for (int i = 0; i < 10; ++i) {
+            Node node(QUuid::createUuid(), i + 1, i, 0.0, 0.0);
+            ids.push_back(node.id());
+            repo.addNode(node);
+        }
+
+        // Unknown and duplicate IDs are ignored
+        std::vector<QUuid> doomed = {ids[0], ids[3], ids[3], ids[9], QUuid::createUuid()};
+        QCOMPARE(repo.removeNodes(doomed), static_cast<size_t>(3));
+        QCOMPARE(repo.nodeCount(), static_cast<size_t>(7));
+
+        // Survivors keep their relative order and remain findable
+        auto nodes = repo.allNodes();
+        std::vector<int> externalIds;
+        for (const auto &node : nodes) {
+            externalIds.push_back(node.externalId());
+            QCOMPARE(repo.findNode(node.id())->externalId(), node.externalId());
+        }
+        QCOMPARE(externalIds, (std::vector<int>{2, 3, 5, 6, 7, 8, 9}));
+
+        QCOMPARE(repo.removeNodes({}), static_cast<size_t>(0));
+    }
+
+    void testExternalIdIndex()
+    {
+        InMemoryModelRepository repo;
+
+        Node node1(QUuid::createUuid(), 1, 0.0, 0.0, 0.0);
+        Node node2(QUuid::createUuid(), 2, 1.0, 0.0, 0.0);
+        Node node3(QUuid::createUuid(), 3, 2.0, 0.0, 0.0);
+        repo.addNode(node1);
+        repo.addNode(node2);
+        repo.addNode(node3);
+        QCOMPARE(repo.maxNodeExternalId(), 3);
+
+        // Renumbering moves the index entry
+        Node renumbered = node2;
+        renumbered.setExternalId(20);
+        QVERIFY(repo.updateNode(renumbered));
+        QVERIFY(!repo.findNodeByExternalId(2).has_value());
+        QCOMPARE(repo.findNodeByExternalId(20)->id(), node2.id());
+        QCOMPARE(repo.maxNodeExternalId(), 20);
+
+        // Removal swaps node3 into node1's slot; its entry must follow
+        QVERIFY(repo.removeNode(node1.id()));
+        QVERIFY(!repo.findNodeByExternalId(1).has_value());
+        QCOMPARE(repo.findNodeByExternalId(3)->id(), node3.id());
+        QCOMPARE(repo.findNodeByExternalId(20)->id(), node2.id());
+
+        // The high-water mark survives removals and resets on clear
+        QVERIFY(repo.removeNode(node2.id()));
+        QCOMPARE(repo.maxNodeExternalId(), 20);
+        repo.clearNodes();
+        QCOMPARE(repo.maxNodeExternalId(), 0);
+        QVERIFY(!repo.findNodeByExternalId(3).has_value());
+
+        Bar bar(QUuid::createUuid(), QUuid::createUuid(), QUuid::createUuid());
+        bar.setExternalId(7);
+        repo.addBar(bar);
+        QCOMPARE(repo.findBarByExternalId(7)->id(), bar.id());
+        QCOMPARE(repo.maxBarExternalId(), 7);
+        QCOMPARE(repo.removeBars({bar.id()}), static_cast<size_t>(1));
+        QVERIFY(!repo.findBarByExternalId(7).has_value());
+    }
+
+    void testBarsAtNodeTracksMutations()
+    {
+        InMemoryModelRepository repo;
+
+        QUuid a = QUuid::createUuid();
+        QUuid b = QUuid::createUuid();
+        QUuid c = QUuid::createUuid();
+        Bar ab(QUuid::createUuid(), a, b);
+        Bar bc(QUuid::createUuid(), b, c);
+        Bar ca(QUuid::createUuid(), c, a);
+        repo.addBar(ab);
+        repo.addBar(bc);
+        repo.addBar(ca);
+
+        QCOMPARE(repo.barsAtNode(a).size(), static_cast<size_t>(2));
+        QCOMPARE(repo.barsAtNode(b).size(), static_cast<size_t>(2));
+
+        // Reconnecting moves the bar between adjacency lists
+        Bar reconnected = ca;
+        reconnected.setEndNodeId(b);
+        QVERIFY(repo.updateBar(reconnected));
+        QCOMPARE(repo.barsAtNode(a).size(), static_cast<size_t>(1));
+        QCOMPARE(repo.barsAtNode(b).size(), static_cast<size_t>(3));
+
+        // Swap-and-pop removal must re-point the moved bar's entries
+        QVERIFY(repo.removeBar(ab.id()));
+        QVERIFY(repo.barsAtNode(a).empty());
+        for (const Bar &bar : repo.barsAtNode(b)) {
+            QVERIFY(bar.startNodeId() == b || bar.endNodeId() == b);
+        }
+        QCOMPARE(repo.barsAtNode(c).size(), static_cast<size_t>(2));
+
+        QCOMPARE(repo.removeBars({bc.id()}), static_cast<size_t>(1));
+        QCOMPARE(repo.barsAtNode(c).size(), static_cast<size_t>(1));
+        QCOMPARE(repo.barsAtNode(c).begin()->id(), ca.id());
+
+        repo.clearBars();
+        QVERIFY(repo.barsAtNode(b).empty());
+    }
+
+    void benchmarkBarsAtNode_data()
+    {
+        QTest::addColumn<int>("totalBars");
+        QTest::newRow("1k bars") << 1000;
+        QTest::newRow("10k bars") << 10000;
+        QTest::newRow("100k bars") << 100000;
+    }
+
+    void benchmarkBarsAtNode()
+    {
+        // The probe node always has valence 2; the query time reported for
+        // each row should stay flat as the total bar count grows.
+        QFETCH(int, totalBars);
+        InMemoryModelRepository repo;
+
+        std::vector<QUuid> chain(static_cast<size_t>(totalBars) + 1);
+        for (QUuid &id : chain) {
+            id = QUuid::createUuid();
+        }
+        for (int i = 0; i < totalBars; ++i) {
+            Bar bar(QUuid::createUuid(), chain[static_cast<size_t>(i)], chain[static_cast<size_t>(i) + 1]);
+            bar.setExternalId(i + 1);
+            repo.addBar(bar);
+        }
+
+        const QUuid probe = chain[chain.size() / 2];
+        int checksum = 0;
+        QBENCHMARK {
+            for (const Bar &bar : repo.barsAtNode(probe)) {
+                checksum += bar.externalId();
+            }
+        }
+        QVERIFY(checksum > 0);
+    }
+
+    void testViewsReadStorageInPlace()
+    {
+        InMemoryModelRepository repo;
+        Node n1(QUuid::createUuid(), 1, 0.0, 0.0, 0.0);
+        Node n2(QUuid::createUuid(), 2, 1.0, 0.0, 0.0);
+        repo.addNode(n1);
+        repo.addNode(n2);
+        repo.addBar(Bar(QUuid::createUuid(), n1.id(), n2.id()));
+
+        const auto nodes = repo.nodes();
+        QCOMPARE(nodes.size(), size_t(2));
+        QCOMPARE(repo.bars().size(), size_t(1));
+        QVERIFY(repo.materials().empty());
+
+        // Pointer lookups point into the same storage the views expose.
+        const Node *found = repo.findNodePtr(n2.id());
+        QVERIFY(found != nullptr);
+        QVERIFY(found >= nodes.begin() && found < nodes.end());
+        QCOMPARE(found->externalId(), 2);
+        QVERIFY(repo.findNodePtr(QUuid::createUuid()) == nullptr);
+
+        int visited = 0;
+        repo.forEachNode([&visited](const Node &) { ++visited; });
+        QCOMPARE(visited, 2);
+    }
+
+    void testNodeCoordinateBlockFollowsStorage()
+    {
+        InMemoryModelRepository repo;
+        std::vector<QUuid> ids;
+        for (int i = 0; i < 5; ++i) {
+            Node node(QUuid::createUuid(), i + 1, i, 10.0 * i, 100.0 * i);
+            ids.push_back(node.id());
+            repo.addNode(node);
+        }
+
+        auto checkBlock = [&repo]() {
+            const double *xyz = repo.nodeCoordinates();
+            const auto nodes = repo.nodes();
+            for (size_t i = 0; i < nodes.size(); ++i) {
+                QCOMPARE(xyz[3 * i], nodes[i].x());
+                QCOMPARE(xyz[3 * i + 1], nodes[i].y());
+                QCOMPARE(xyz[3 * i + 2], nodes[i].z());
+            }
+        };
+        checkBlock();
+
+        Node moved = *repo.findNode(ids[1]);
+        moved.setPosition(Vector3(-1.0, -2.0, -3.0));
+        repo.updateNode(moved);
+        checkBlock();
+
+        repo.removeNode(ids[0]);
+        checkBlock();
+        repo.removeNodes({ids[2], ids[3]});
+        QCOMPARE(repo.nodeCount(), size_t(2));
+        checkBlock();
+
+        repo.clearNodes();
+        QCOMPARE(repo.nodeCount(), size_t(0));
+    }
+
+    void testHandlesGoStaleAndResolveBarEnds()
+    {
+        InMemoryModelRepository repo;
+        Node n1(QUuid::createUuid(), 1, 0.0, 0.0, 0.0);
+        Node n2(QUuid::createUuid(), 2, 1.0, 0.0, 0.0);
+        Node n3(QUuid::createUuid(), 3, 2.0, 0.0, 0.0);
+        repo.addNode(n1);
+        repo.addNode(n2);
+
+        // Bar added before its end node exists
+        Bar bar(QUuid::createUuid(), n2.id(), n3.id());
+        repo.addBar(bar);
+        const BarHandle barHandle = repo.barHandle(bar.id());
+        QVERIFY(barHandle.isValid());
+        QCOMPARE(repo.bar(barHandle)->id(), bar.id());
+        QVERIFY(repo.node(repo.barEndNodes(barHandle)[1]) == nullptr);
+
+        repo.addNode(n3);
+        const auto ends = repo.barEndNodes(barHandle);
+        QCOMPARE(repo.node(ends[0])->id(), n2.id());
+        QCOMPARE(repo.node(ends[1])->id(), n3.id());
+
+        // Removing n1 moves n3 into its dense slot; handles stay put
+        const NodeHandle h1 = repo.nodeHandle(n1.id());
+        const NodeHandle h3 = repo.nodeHandle(n3.id());
+        repo.removeNode(n1.id());
+        QVERIFY(repo.node(h1) == nullptr);
+        QCOMPARE(repo.node(h3)->id(), n3.id());
+        QCOMPARE(repo.nodeHandleAt(0), h3);
+
+        // A recycled slot must not resurrect the old handle
+        Node n4(QUuid::createUuid(), 4, 3.0, 0.0, 0.0);
+        repo.addNode(n4);
+        const NodeHandle h4 = repo.nodeHandle(n4.id());
+        QCOMPARE(h4.index(), h1.index());
+        QVERIFY(h4 != h1);
+        QVERIFY(repo.node(h1) == nullptr);
+
+        repo.removeBar(bar.id());
+        QVERIFY(repo.bar(barHandle) == nullptr);
+        QVERIFY(!repo.barEndNodes(barHandle)[0].isValid());
+
+        repo.clearNodes();
+        QVERIFY(repo.node(h3) == nullptr);
+        QVERIFY(!repo.nodeHandle(n3.id()).isValid());
+    }
+
+    void testBarPropertyIndicesFollowTables()
+    {
+        InMemoryModelRepository repo;
+        Material steel(QUuid::createUuid(), 1, "Steel", 200e9, 80e9);
+        Material concrete(QUuid::createUuid(), 2, "Concrete", 30e9, 12e9);
+        Section ipe(QUuid::createUuid(), 1, "IPE200", 0.00285, 1.94e-5, 1.42e-6, 6.98e-8);
+        repo.addMaterial(steel);
+        repo.addSection(ipe);
+
+        Bar b1(QUuid::createUuid(), QUuid::createUuid(), QUuid::createUuid(), steel.id(), ipe.id());
+        Bar b2(QUuid::createUuid(), QUuid::createUuid(), QUuid::createUuid(), concrete.id(), QUuid());
+        repo.addBar(b1);
+        repo.addBar(b2);
+
+        auto materialOf = [&repo](size_t bar) { return repo.barMaterialIndices()[bar]; };
+        auto sectionOf = [&repo](size_t bar) { return repo.barSectionIndices()[bar]; };
+        QCOMPARE(materialOf(0), repo.materialIndex(steel.id()));
+        QCOMPARE(sectionOf(0), repo.sectionIndex(ipe.id()));
+        QCOMPARE(materialOf(1), -1); // material not added yet
+        QCOMPARE(sectionOf(1), -1);  // no section assigned
+
+        // Adding a referenced material resolves the bars waiting for it
+        repo.addMaterial(concrete);
+        QCOMPARE(repo.materials()[static_cast<size_t>(materialOf(1))].id(), concrete.id());
+
+        // Removing a material moves another into its slot; bars follow it
+        repo.removeMaterial(steel.id());
+        QCOMPARE(materialOf(0), -1);
+        QCOMPARE(repo.materials()[static_cast<size_t>(materialOf(1))].id(), concrete.id());
+
+        // Reassignment and bar relocation keep the arrays parallel to bars()
+        b1.setMaterialId(concrete.id());
+        repo.updateBar(b1);
+        repo.removeBar(b2.id());
+        QCOMPARE(repo.bars()[0].id(), b1.id());
+        QCOMPARE(materialOf(0), repo.materialIndex(concrete.id()));
+        QCOMPARE(sectionOf(0), repo.sectionIndex(ipe.id()));
+
+        const auto version = repo.snapshot();
+        QCOMPARE(version->barMaterialIndices[0], materialOf(0));
+        QCOMPARE(version->barSectionIndices[0], sectionOf(0));
+
+        repo.clearSections();
+        QCOMPARE(sectionOf(0), -1);
+        QCOMPARE(repo.snapshot()->barSectionIndices[0], -1);
+        QCOMPARE(version->barSectionIndices[0], 0);
+    }
+
+    void testLoadsIndexedByCaseAndTarget()
+    {
+        InMemoryModelRepository repo;
+        Node n1(QUuid::createUuid(), 1, 0.0, 0.0, 0.0);
+        Node n2(QUuid::createUuid(), 2, 1.0, 0.0, 0.0);
+        n1.setRestraint(2, true);
+        repo.addNode(n1);
+        repo.addNode(n2);
+        Bar bar(QUuid::createUuid(), n1.id(), n2.id());
+        repo.addBar(bar);
+
+        LoadCase dead(QUuid::createUuid(), 1, "Dead");
+        LoadCase wind(QUuid::createUuid(), 2, "Wind X");
+        QVERIFY(repo.addLoadCase(dead));
+        QVERIFY(repo.addLoadCase(wind));
+
+        // Loads need an existing case
+        QVERIFY(!repo.addNodalLoad(NodalLoad(QUuid::createUuid(), QUuid::createUuid(), n1.id(),
+                                             Vector3(0.0, 0.0, -1.0))));
+
+        NodalLoad p1(QUuid::createUuid(), dead.id(), n2.id(), Vector3(0.0, 0.0, -10.0));
+        NodalLoad p2(QUuid::createUuid(), wind.id(), n2.id(), Vector3(5.0, 0.0, 0.0));
+        NodalLoad p3(QUuid::createUuid(), dead.id(), n1.id(), Vector3(0.0, 0.0, -2.0));
+        MemberLoad q1(QUuid::createUuid(), dead.id(), bar.id(), Vector3(0.0, 0.0, -3.0));
+        MemberLoad q2(QUuid::createUuid(), wind.id(), bar.id(), Vector3(0.0, 1.0, 0.0),
+                      MemberLoad::System::Local);
+        QVERIFY(repo.addNodalLoad(p1));
+        QVERIFY(repo.addNodalLoad(p2));
+        QVERIFY(repo.addNodalLoad(p3));
+        QVERIFY(repo.addMemberLoad(q1));
+        QVERIFY(repo.addMemberLoad(q2));
+
+        QCOMPARE(repo.nodalLoadsAtNode(n2.id()).size(), size_t(2));
+        QCOMPARE(repo.nodalLoadsAtNode(n1.id()).size(), size_t(1));
+        QCOMPARE(repo.nodalLoadsInCase(dead.id()).size(), size_t(2));
+        QCOMPARE(repo.memberLoadsOnBar(bar.id()).size(), size_t(2));
+        QCOMPARE(repo.memberLoadsInCase(wind.id()).begin()->system(), MemberLoad::System::Local);
+
+        // Removal swaps another load into the hole; the indices follow it
+        QVERIFY(repo.removeNodalLoad(p1.id()));
+        QCOMPARE(repo.nodalLoadsAtNode(n2.id()).size(), size_t(1));
+        QCOMPARE(repo.nodalLoadsAtNode(n2.id()).begin()->id(), p2.id());
+        QCOMPARE(repo.nodalLoadsInCase(dead.id()).begin()->id(), p3.id());
+
+        // Moving a load to another node and case
+        p3.setNodeId(n2.id());
+        p3.setLoadCaseId(wind.id());
+        QVERIFY(repo.updateNodalLoad(p3));
+        QVERIFY(repo.nodalLoadsAtNode(n1.id()).empty());
+        QVERIFY(repo.nodalLoadsInCase(dead.id()).empty());
+        QCOMPARE(repo.nodalLoadsInCase(wind.id()).size(), size_t(2));
+
+        // Removing a case takes its loads with it
+        QVERIFY(repo.removeLoadCase(wind.id()));
+        QCOMPARE(repo.nodalLoads().size(), size_t(0));
+        QCOMPARE(repo.memberLoads().size(), size_t(1));
+        QCOMPARE(repo.memberLoadsOnBar(bar.id()).begin()->id(), q1.id());
+        QVERIFY(repo.findMemberLoadPtr(q2.id()) == nullptr);
+        QCOMPARE(repo.snapshot()->memberLoads.size(), size_t(1));
+
+        // Supports are the restrained nodes
+        QCOMPARE(repo.supportedNodes().size(), size_t(1));
+        QCOMPARE(repo.supportedNodes().begin()->id(), n1.id());
+        n2.setRestraint(0, true);
+        repo.updateNode(n2);
+        repo.removeNode(n1.id());
+        QCOMPARE(repo.supportedNodes().size(), size_t(1));
+        QCOMPARE(repo.supportedNodes().begin()->id(), n2.id());
+
+        repo.clearAll();
+        QVERIFY(repo.isEmpty());
+        QVERIFY(repo.memberLoadsOnBar(bar.id()).empty());
+    }
+
+    void testSnapshotSharesUnchangedChunks()
+    {
+        InMemoryModelRepository repo;
+        const size_t chunk = VersionedArray<Node>::kChunkSize;
+        std::vector<QUuid> ids;
+        for (size_t i = 0; i < 4 * chunk; ++i) {
+            Node node(QUuid::createUuid(), static_cast<int>(i) + 1, double(i), 0.0, 0.0);
+            ids.push_back(node.id());
+            repo.addNode(node);
+        }
+
+        const auto v1 = repo.snapshot();
+        QCOMPARE(v1->nodes.size(), 4 * chunk);
+        QCOMPARE(repo.snapshot(), v1); // no mutation, same version
+
+        Node moved = *repo.findNode(ids[10]);
+        moved.setPosition(-1.0, -1.0, -1.0);
+        repo.updateNode(moved);
+        const auto v2 = repo.snapshot();
+        QVERIFY(v2->number > v1->number);
+        QVERIFY(v2->nodes.chunk(0) != v1->nodes.chunk(0));
+        for (size_t c = 1; c < 4; ++c) {
+            QCOMPARE(v2->nodes.chunk(c), v1->nodes.chunk(c));
+        }
+
+        // Older versions are unaffected by later edits
+        QCOMPARE(v1->nodes[10].x(), 10.0);
+        QCOMPARE(v2->nodes[10].x(), -1.0);
+
+        // Swap-and-pop removal only touches the hole and the tail
+        repo.removeNode(ids[chunk + 3]);
+        const auto v3 = repo.snapshot();
+        QCOMPARE(v3->nodes.size(), 4 * chunk - 1);
+        QCOMPARE(v3->nodes.chunk(0), v2->nodes.chunk(0));
+        QCOMPARE(v3->nodes.chunk(2), v2->nodes.chunk(2));
+        size_t index = 0;
+        for (const Node &node : v3->nodes) {
+            QCOMPARE(node.id(), repo.nodes()[index].id());
+            QCOMPARE(v3->nodeHandles[index], repo.nodeHandleAt(index));
+            ++index;
+        }
+        QCOMPARE(index, repo.nodeCount());
+
+        repo.clearNodes();
+        QVERIFY(repo.snapshot()->nodes.empty());
+        QCOMPARE(v3->nodes.size(), 4 * chunk - 1);
+    }
+
+    void testChangeJournalReportsNetChanges()
+    {
+        InMemoryModelRepository repo;
+        Node n1(QUuid::createUuid(), 1, 0.0, 0.0, 0.0);
+        Node n2(QUuid::createUuid(), 2, 1.0, 0.0, 0.0);
+        repo.addNode(n1);
+        repo.addNode(n2);
+        Bar bar(QUuid::createUuid(), n1.id(), n2.id());
+        repo.addBar(bar);
+
+        const std::uint64_t synced = repo.changeVersion();
+        std::vector<ModelChange> changes;
+        QVERIFY(repo.changesSince(synced, changes));
+        QVERIFY(changes.empty());
+
+        // Field masks accumulate per entity; no-op updates are not recorded
+        Node moved = n1;
+        moved.setPosition(5.0, 0.0, 0.0);
+        repo.updateNode(moved);
+        moved.setRestraint(0, true);
+        repo.updateNode(moved);
+        repo.updateNode(moved);
+        Bar assigned = bar;
+        assigned.setMaterialId(QUuid::createUuid());
+        repo.updateBar(assigned);
+
+        // Created and removed again in the range: not reported
+        Node transient(QUuid::createUuid(), 3, 2.0, 0.0, 0.0);
+        repo.addNode(transient);
+        repo.removeNode(transient.id());
+
+        Node n4(QUuid::createUuid(), 4, 3.0, 0.0, 0.0);
+        repo.addNode(n4);
+        repo.removeNode(n2.id());
+
+        QVERIFY(repo.changeVersion() > synced);
+        QVERIFY(repo.changesSince(synced, changes));
+        QCOMPARE(changes.size(), size_t(4));
+
+        QCOMPARE(changes[0].id, n1.id());
+        QCOMPARE(changes[0].kind, EntityKind::Node);
+        QCOMPARE(changes[0].fields, std::uint32_t(ChangeField::Position | ChangeField::Restraints));
+        QCOMPARE(changes[0].handle<Node>(), repo.nodeHandle(n1.id()));
+
+        QCOMPARE(changes[1].id, bar.id());
+        QCOMPARE(changes[1].kind, EntityKind::Bar);
+        QCOMPARE(changes[1].fields, std::uint32_t(ChangeField::Properties));
+
+        QCOMPARE(changes[2].id, n4.id());
+        QCOMPARE(changes[2].fields, std::uint32_t(ChangeField::Created));
+
+        QCOMPARE(changes[3].id, n2.id());
+        QCOMPARE(changes[3].fields, std::uint32_t(ChangeField::Removed));
+        QVERIFY(repo.node(changes[3].handle<Node>()) == nullptr);
+
+        // Later consumers see only what followed their own sync point
+        QVERIFY(repo.changesSince(repo.changeVersion(), changes));
+        QVERIFY(changes.empty());
+
+        // Clears and exhausted history force a full re-read
+        const std::uint64_t beforeClear = repo.changeVersion();
+        repo.clearBars();
+        QVERIFY(!repo.changesSince(beforeClear, changes));
+
+        repo.setChangeJournalCapacity(2);
+        const std::uint64_t stale = repo.changeVersion();
+        Node a(QUuid::createUuid(), 5, 0.0, 1.0, 0.0);
+        Node b(QUuid::createUuid(), 6, 0.0, 2.0, 0.0);
+        Node c(QUuid::createUuid(), 7, 0.0, 3.0, 0.0);
+        repo.addNode(a);
+        const std::uint64_t recent = repo.changeVersion();
+        repo.addNode(b);
+        repo.addNode(c);
+        QVERIFY(!repo.changesSince(stale, changes));
+        QVERIFY(repo.changesSince(recent, changes));
+        QCOMPARE(changes.size(), size_t(2));
+    }
+
+    void testSpatialQueriesMatchBruteForce()
+    {
+        InMemoryModelRepository repo;
+        repo.setNodeIndexCellSize(2.0);
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<double> coordinate(-20.0, 20.0);
+        std::vector<QUuid> ids;
+        for (int i = 0; i < 2000; ++i) {
+            Node node(QUuid::createUuid(), i + 1, coordinate(rng), coordinate(rng), coordinate(rng));
+            ids.push_back(node.id());
+            repo.addNode(node);
+        }
+
+        // Far nodes, one whose cell shares its key with an occupied cell near
+        // the origin, that move and leave again: the occupied bounds follow
+        const double aliasX = 2.0 * (1 << 21);
+        Node outlier(QUuid::createUuid(), 5001, 1.0e6, 0.0, 0.0);
+        Node aliased(QUuid::createUuid(), 5002, aliasX + 1.0, 1.0, 1.0);
+        repo.addNode(outlier);
+        repo.addNode(aliased);
+        QCOMPARE(repo.nearestNode(Vector3(1.0e6 - 1.0, 0.0, 0.0))->id(), outlier.id());
+        aliased.setPosition(aliasX + 0.5, 1.0, 1.0);
+        repo.updateNode(aliased);
+        QCOMPARE(repo.nearestNode(Vector3(aliasX, 1.0, 1.0))->id(), aliased.id());
+        outlier.setPosition(-1.0e6, 0.0, 0.0);
+        repo.updateNode(outlier);
+        QCOMPARE(repo.nearestNode(Vector3(-1.0e6, 0.0, 0.0))->id(), outlier.id());
+        repo.removeNode(outlier.id());
+        repo.removeNode(aliased.id());
+
+        // Move, swap-and-pop and bulk-remove so the index follows relocations
+        for (int i = 0; i < 300; ++i) {
+            Node node = *repo.findNode(ids[static_cast<size_t>(i)]);
+            node.setPosition(coordinate(rng), coordinate(rng), coordinate(rng));
+            repo.updateNode(node);
+        }
+        for (int i = 0; i < 200; ++i) {
+            repo.removeNode(ids[static_cast<size_t>(i * 3)]);
+        }
+        repo.removeNodes(std::vector<QUuid>(ids.begin() + 1500, ids.end()));
+
+        const auto distance = [&repo](size_t index, const Vector3 &point) {
+            return repo.nodes()[index].position().distanceTo(point);
+        };
+        for (int q = 0; q < 200; ++q) {
+            const Vector3 point(coordinate(rng), coordinate(rng), coordinate(rng));
+
+            double closest = std::numeric_limits<double>::infinity();
+            std::vector<size_t> expected;
+            for (size_t i = 0; i < repo.nodeCount(); ++i) {
+                closest = std::min(closest, distance(i, point));
+                if (distance(i, point) <= 3.0) {
+                    expected.push_back(i);
+                }
+            }
+
+            const Node *nearest = repo.nearestNode(point);
+            QVERIFY(nearest != nullptr);
+            QCOMPARE(nearest->position().distanceTo(point), closest);
+
+            std::vector<size_t> found = repo.nodesWithinRadius(point, 3.0);
+            std::sort(found.begin(), found.end());
+            QCOMPARE(found, expected);
+        }
+
+        const std::vector<size_t> boxed = repo.nodesInBox(Vector3(-5.0, -5.0, -5.0), Vector3(5.0, 5.0, 5.0));
+        size_t inside = 0;
+        for (const Node &node : repo.nodes()) {
+            const Vector3 &p = node.position();
+            inside += std::abs(p.x()) <= 5.0 && std::abs(p.y()) <= 5.0 && std::abs(p.z()) <= 5.0;
+        }
+        QCOMPARE(boxed.size(), inside);
+
+        QVERIFY(repo.nearestNode(Vector3(1000.0, 0.0, 0.0), 10.0) == nullptr);
+        repo.clearNodes();
+        QVERIFY(repo.nearestNode(Vector3(0.0, 0.0, 0.0)) == nullptr);
+    }
+
+    void benchmarkNearestNode()
+    {
+        // 1M random nodes in a 100^3 cube, about eight per default-size cell.
+        // Each iteration runs 1000 queries; divide the reported time by 1000
+        // for the per-query average.
+        const int count = 1000000;
+        InMemoryModelRepository repo;
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<double> coordinate(0.0, 100.0);
+        for (int i = 0; i < count; ++i) {
+            repo.addNode(Node(QUuid::createUuid(), i + 1, coordinate(rng), coordinate(rng), coordinate(rng)));
+        }
+
+        std::vector<Vector3> queries;
+        for (int i = 0; i < 1000; ++i) {
+            queries.emplace_back(coordinate(rng), coordinate(rng), coordinate(rng));
+        }
+
+        const Node *found = nullptr;
+        QBENCHMARK {
+            for (const Vector3 &query : queries) {
+                found = repo.nearestNode(query);
+            }
+        }
+        QVERIFY(found != nullptr);
+    }
+
+    void benchmarkMemoryFootprint_data()
+    {
+        QTest::addColumn<bool>("perBar");
+        QTest::addColumn<double>("budget");
+        QTest::newRow("bytes per node") << false << 320.0;
+        QTest::newRow("bytes per bar") << true << 384.0;
+    }
+
+    void benchmarkMemoryFootprint()
+    {
+        // A 300 x 300 planar frame (90k nodes, ~180k bars). The reported
+        // figure covers the entity plus every index kept for it, so a
+        // 1M-bar model needs about a million times the per-bar result.
+        QFETCH(bool, perBar);
+        QFETCH(double, budget);
+        const int side = 300;
+        InMemoryModelRepository repo;
+        std::vector<QUuid> ids;
+        for (int i = 0; i < side; ++i) {
+            for (int j = 0; j < side; ++j) {
+                Node node(QUuid::createUuid(), i * side + j + 1, double(i), double(j), 0.0);
+                ids.push_back(node.id());
+                repo.addNode(node);
+            }
+        }
+        int externalId = 1;
+        for (int i = 0; i < side; ++i) {
+            for (int j = 0; j + 1 < side; ++j) {
+                Bar alongY(QUuid::createUuid(), ids[static_cast<size_t>(i * side + j)],
+                           ids[static_cast<size_t>(i * side + j + 1)]);
+                Bar alongX(QUuid::createUuid(), ids[static_cast<size_t>(j * side + i)],
+                           ids[static_cast<size_t>((j + 1) * side + i)]);
+                alongY.setExternalId(externalId++);
+                alongX.setExternalId(externalId++);
+                repo.addBar(alongY);
+                repo.addBar(alongX);
+            }
+        }
+
+        const auto footprint = repo.memoryFootprint();
+        const double bytes = perBar ? double(footprint.barBytes) / double(repo.barCount())
+                                    : double(footprint.nodeBytes) / double(repo.nodeCount());
+        QTest::setBenchmarkResult(bytes, QTest::BytesAllocated);
+        QVERIFY2(bytes <= budget,
+                 qPrintable(QStringLiteral("%1 bytes over a budget of %2").arg(bytes).arg(budget)));
+    }
+
+    void testReserveKeepsStorageInPlace()
+    {
+        InMemoryModelRepository repo;
+        Node first(QUuid::createUuid(), 1, 0.0, 0.0, 0.0);
+        QVERIFY(repo.addNode(first));
+        repo.reserveNodes(1000);
+        repo.reserveBars(1000);
+        QCOMPARE(repo.nodeCount(), static_cast<size_t>(1));
+        QVERIFY(repo.findNodePtr(first.id()) != nullptr);
+
+        const Node *nodes = repo.nodes().data();
+        const double *coordinates = repo.nodeCoordinates();
+        std::vector<QUuid> ids{first.id()};
+        for (int i = 1; i < 1000; ++i) {
+            Node node(QUuid::createUuid(), i + 1, double(i), 0.0, 0.0);
+            ids.push_back(node.id());
+            QVERIFY(repo.addNode(node));
+        }
+        QCOMPARE(repo.nodes().data(), nodes);
+        QCOMPARE(repo.nodeCoordinates(), coordinates);
+
+        for (int i = 0; i + 1 < 1000; ++i) {
+            QVERIFY(repo.addBar(Bar(QUuid::createUuid(), ids[static_cast<size_t>(i)],
+                                    ids[static_cast<size_t>(i + 1)])));
+        }
+        const Bar *bars = repo.bars().data();
+        repo.reserveBars(10); // never shrinks
+        QCOMPARE(repo.bars().data(), bars);
+        QCOMPARE(repo.nearestNode(Vector3(500.2, 0.0, 0.0))->externalId(), 501);
+    }
+
+    void testReadDatModel()
+    {
+        InMemoryModelRepository repo;
+        const QUuid loadCaseId = QUuid::createUuid();
+        repo.addLoadCase(LoadCase(loadCaseId, 1, QStringLiteral("Caso 1")));
+        const QByteArray contents =
+            "# portico\n"
+            "[materials]\n1 200e9 80e9\n"
+            "[SECTIONS]\n1 0.01 1e-4 2e-4 3e-4\n"
+            "[MEMBERS]\n1 1 2 1 1\n2 1 9 1 1\n3 2 2 1 1\n"
+            "[NODES]\n1 0 0 0 1 1 1 0 0 0\n2 1 0 0 0 0 x 0 0 1\n"
+            "[NODAL_LOADS]\n2 1 2 3 0 0 0\n7 1 2 3 0 0 0\n2 1\n"
+            "[MEMBER_LOADS]\n1 local 0 0 -5\n1 GLOBAL 0 0 -5\n";
+
+        const DatReadResult result = readDatModel(contents, repo, loadCaseId);
+        QVERIFY(result.ok());
+        QCOMPARE(result.danglingMembers, std::vector<int>{2});
+        QCOMPARE(repo.nodeCount(), size_t(2));
+        QCOMPARE(repo.barCount(), size_t(1)); // member 3 starts and ends at node 2
+        QCOMPARE(repo.findNodeByExternalId(1)->restraintMask(), std::uint8_t(0b000111));
+        QCOMPARE(repo.findNodeByExternalId(2)->restraintMask(), std::uint8_t(0b100000));
+        const std::optional<Bar> bar = repo.findBarByExternalId(1);
+        QVERIFY(bar.has_value());
+        QCOMPARE(bar->materialId(), repo.materials()[0].id());
+        QCOMPARE(bar->sectionId(), repo.sections()[0].id());
+        QCOMPARE(repo.nodalLoads().size(), size_t(1));
+        QCOMPARE(repo.memberLoads().size(), size_t(2));
+        QCOMPARE(repo.memberLoads()[0].system(), MemberLoad::System::Local);
+        QCOMPARE(repo.memberLoads()[1].system(), MemberLoad::System::Global);
+        QCOMPARE(repo.memberLoads()[0].loadCaseId(), loadCaseId);
+
+        InMemoryModelRepository bad;
+        DatReadResult error = readDatModel("[NODES]\n1 0 0 0 0 0 0 0 0 0\n\n2 a 0 0 0 0 0 0 0 0\n", bad, loadCaseId);
+        QCOMPARE(error.error, DatReadError::InvalidCoordinates);
+        QCOMPARE(error.line, 4);
+        error = readDatModel("[MEMBERS]\n1 2 x 4 5\n", bad, loadCaseId);
+        QCOMPARE(error.error, DatReadError::InvalidMemberLine);
+        QCOMPARE(error.line, 2);
+    }
+
+    void benchmarkBulkLoad()
+    {
+        // Cold load of a generated 1M-node .dat (250k members, 1% of nodes
+        // and members loaded): parse and insert into an empty repository,
+        // as File > Open does before handing the model to the scene. The
+        // wall time of one load is the reported result; the process peak
+        // RSS afterwards is printed alongside it.
+        const int nodeCount = 1000000;
+        const int memberCount = nodeCount / 4;
+        QByteArray contents;
+        contents.reserve(nodeCount * 64);
+        contents += "[MATERIALS]\n1 2.1e11 8.1e10\n[SECTIONS]\n1 0.01 1e-4 1e-4 2e-4\n[NODES]\n";
+        std::mt19937 rng(11);
+        std::uniform_real_distribution<double> coordinate(0.0, 100.0);
+        char line[128];
+        for (int i = 1; i <= nodeCount; ++i) {
+            std::snprintf(line, sizeof line, "%d %.6f %.6f %.6f %d %d %d 0 0 0\n", i, coordinate(rng),
+                          coordinate(rng), coordinate(rng), i <= 1000, i <= 1000, i <= 1000);
+            contents += line;
+        }
+        contents += "[MEMBERS]\n";
+        for (int i = 1; i <= memberCount; ++i) {
+            std::snprintf(line, sizeof line, "%d %d %d 1 1\n", i, 4 * i - 3, 4 * i - 2);
+            contents += line;
+        }
+        contents += "[NODAL_LOADS]\n";
+        for (int i = 1; i <= nodeCount; i += 100) {
+            std::snprintf(line, sizeof line, "%d 0 0 -1000 0 0 0\n", i);
+            contents += line;
+        }
+        contents += "[MEMBER_LOADS]\n";
+        for (int i = 1; i <= memberCount; i += 100) {
+            std::snprintf(line, sizeof line, "%d GLOBAL 0 0 -500\n", i);
+            contents += line;
+        }
+
+        QElapsedTimer timer;
+        timer.start();
+        InMemoryModelRepository repo;
+        const QUuid loadCaseId = QUuid::createUuid();
+        repo.addLoadCase(LoadCase(loadCaseId, 1, QStringLiteral("Caso 1")));
+        const DatReadResult result = readDatModel(contents, repo, loadCaseId);
+        const qint64 elapsed = timer.elapsed();
+
+        QVERIFY(result.ok());
+        QCOMPARE(repo.nodeCount(), static_cast<size_t>(nodeCount));
+        QCOMPARE(repo.barCount(), static_cast<size_t>(memberCount));
+        QCOMPARE(repo.nodalLoads().size(), static_cast<size_t>(nodeCount / 100));
+        QCOMPARE(repo.supportedNodes().size(), size_t(1000));
+        QTest::setBenchmarkResult(double(elapsed), QTest::WalltimeMilliseconds);
+        qInfo(".dat load of %.1f MiB: %lld ms, peak RSS %.1f MiB", double(contents.size()) / (1024.0 * 1024.0),
+              static_cast<long long>(elapsed), double(peakResidentBytes()) / (1024.0 * 1024.0));
+    }
+
+    void testConcurrentReadersAndWriter()
+    {
+        // N reader threads check model invariants while one writer adds,
+        // moves and removes node pairs joined by a bar. Build with
+        // -fsanitize=thread to also catch unsynchronised access.
+        InMemoryModelRepository model;
+        ConcurrentModelRepository repo(&model);
+        const int readerCount = static_cast<int>(std::max(2u, std::thread::hardware_concurrency()));
+        std::atomic<bool> done{false};
+        std::atomic<int> failures{0};
+        std::atomic<long long> reads{0};
+
+        auto reader = [&](unsigned seed) {
+            std::mt19937 rng(seed);
+            while (!done.load()) {
+                // Every write adds or removes a whole pair with its bar, and
+                // moves keep y == z on both nodes; anything else is a torn read
+                const bool consistent = repo.read([](const IModelRepository &r) {
+                    if (r.nodeCount() != 2 * r.barCount()) {
+                        return false;
+                    }
+                    for (const Bar &bar : r.bars()) {
+                        const Node *start = r.findNodePtr(bar.startNodeId());
+                        const Node *end = r.findNodePtr(bar.endNodeId());
+                        if (!start || !end || start->x() != end->x() || start->y() != end->y()) {
+                            return false;
+                        }
+                    }
+                    for (const Node &node : r.nodes()) {
+                        if (node.y() != node.z()) {
+                            return false;
+                        }
+                    }
+                    return true;
+                });
+
+                // The decorator's own pointers and views, borrowed under the
+                // lock, read the same state
+                const Vector3 probe(static_cast<double>(rng() % 4000), 0.0, 0.0);
+                const bool borrowedConsistent = repo.read([&](const IModelRepository &) {
+                    const EntityView<Node> nodes = repo.nodes();
+                    const double *xyz = repo.nodeCoordinates();
+                    if (nodes.size() != repo.nodeCount()) {
+                        return false;
+                    }
+                    for (size_t i = 0; i < nodes.size(); ++i) {
+                        if (xyz[3 * i] != nodes[i].x() || xyz[3 * i + 1] != nodes[i].y()) {
+                            return false;
+                        }
+                    }
+                    const Node *nearest = repo.nearestNode(probe);
+                    if (nearest == nullptr) {
+                        return nodes.empty();
+                    }
+                    if (repo.findNodePtr(nearest->id()) != nearest) {
+                        return false;
+                    }
+                    const IndexedRange<Bar> bars = repo.barsAtNode(nearest->id());
+                    if (bars.size() != 1) {
+                        return false;
+                    }
+                    const Node *start = repo.findNodePtr(bars.begin()->startNodeId());
+                    const Node *end = repo.findNodePtr(bars.begin()->endNodeId());
+                    return start && end && start->x() == end->x() && start->y() == end->y();
+                });
+
+                // Published versions are immutable and taken between writes
+                const auto version = repo.snapshot();
+                const bool versionConsistent = version->nodes.size() == 2 * version->bars.size();
+
+                // Plain value reads through the decorator
+                const auto node = repo.findNodeByExternalId(static_cast<int>(rng() % 4000) + 1);
+                const bool valueConsistent = !node || node->y() == node->z();
+
+                if (!consistent || !borrowedConsistent || !versionConsistent || !valueConsistent) {
+                    ++failures;
+                }
+                ++reads;
+            }
+        };
+
+        std::vector<std::thread> readers;
+        for (int i = 0; i < readerCount; ++i) {
+            readers.emplace_back(reader, static_cast<unsigned>(i + 1));
+        }
+
+        struct Pair
+        {
+            QUuid start;
+            QUuid end;
+            QUuid bar;
+        };
+        std::vector<Pair> live;
+        int externalId = 0;
+        for (int round = 0; round < 4000; ++round) {
+            if (round % 4 < 2 || live.empty()) {
+                Pair pair{QUuid::createUuid(), QUuid::createUuid(), QUuid::createUuid()};
+                const double x = round;
+                repo.write([&](IModelRepository &r) {
+                    r.addNode(Node(pair.start, ++externalId, x, 0.0, 0.0));
+                    r.addNode(Node(pair.end, ++externalId, x, 0.0, 0.0));
+                    r.addBar(Bar(pair.bar, pair.start, pair.end));
+                });
+                live.push_back(pair);
+            } else if (round % 4 == 2) {
+                const Pair &pair = live[static_cast<size_t>(round) % live.size()];
+                const double height = round;
+                repo.write([&](IModelRepository &r) {
+                    for (const QUuid &id : {pair.start, pair.end}) {
+                        Node moved = *r.findNodePtr(id);
+                        moved.setPosition(moved.x(), height, height);
+                        r.updateNode(moved);
+                    }
+                });
+            } else {
+                const Pair pair = live.front();
+                live.erase(live.begin());
+                repo.write([&](IModelRepository &r) {
+                    r.removeBar(pair.bar);
+                    r.removeNodes({pair.start, pair.end});
+                });
+            }
+        }
+        done = true;
+        for (std::thread &thread : readers) {
+            thread.join();
+        }
+
+        QCOMPARE(failures.load(), 0);
+        QVERIFY(reads.load() > 0);
+        QCOMPARE(repo.barCount(), live.size());
+        QCOMPARE(repo.nodeCount(), 2 * live.size());
+    }
+
+    void benchmarkNodeRemoval_data()
+    {
+        QTest::addColumn<bool>("bulk");
+        QTest::newRow("one by one") << false;
+        QTest::newRow("bulk") << true;
+    }
+
+    void benchmarkNodeRemoval()
+    {
+        // Deleting a 20k-node selection used to rebuild the whole index on
+        // every removal (quadratic, many seconds). Removal must stay linear:
+        // four times the nodes may cost at most twelve times as long (cache
+        // effects put linear removal near six), where a quadratic regression
+        // costs sixteen or more. The larger run's wall time is the reported
+        // result.
+        QFETCH(bool, bulk);
+        const qint64 small = nodeRemovalNanoseconds(10000, bulk);
+        const qint64 large = nodeRemovalNanoseconds(40000, bulk);
+
+        QVERIFY(small > 0);
+        QVERIFY(large > 0);
+        QVERIFY2(large < 12 * small,
+                 qPrintable(QString("10k removals took %1 us, 40k took %2 us")
+                                .arg(small / 1000).arg(large / 1000)));
+        QTest::setBenchmarkResult(double(large) / 1e6, QTest::WalltimeMilliseconds);
+    }
 };
 
 /**
@@ -226,9 +1252,206 @@ private slots:
         service.createNode(Vector3(0, 0, 0));
         QCOMPARE(service.nextExternalId(), 2);
         
-        service.createNode(Vector3(1, 1, 1));
+        QUuid last = service.createNode(Vector3(1, 1, 1));
+        QCOMPARE(service.nextExternalId(), 3);
+
+        // External IDs are not reused after the highest node is deleted
+        service.deleteNode(last);
         QCOMPARE(service.nextExternalId(), 3);
     }
+    
+    void testBatchEmitsSingleChangeSet()
+    {
+        qRegisterMetaType<ModelChangeSet>();
+        InMemoryModelRepository repo;
+        NodeService service(&repo);
+        QSignalSpy createdSpy(&service, &NodeService::nodeCreated);
+        QSignalSpy deletedSpy(&service, &NodeService::nodeDeleted);
+        QSignalSpy batchSpy(&service, &NodeService::modelBatchChanged);
+        
+        const auto ids = service.createNodes({Vector3(0, 0, 0), Vector3(1, 0, 0), Vector3(2, 0, 0)});
+        QCOMPARE(ids.size(), static_cast<size_t>(3));
+        QCOMPARE(createdSpy.count(), 0);
+        QCOMPARE(batchSpy.count(), 1);
+        auto changes = batchSpy.takeFirst().at(0).value<ModelChangeSet>();
+        QCOMPARE(changes.createdNodes.size(), 3);
+        
+        QCOMPARE(service.deleteNodes({ids[0], ids[2], QUuid::createUuid()}), static_cast<size_t>(2));
+        QCOMPARE(deletedSpy.count(), 0);
+        QCOMPARE(batchSpy.count(), 1);
+        changes = batchSpy.takeFirst().at(0).value<ModelChangeSet>();
+        QCOMPARE(changes.deletedNodes.size(), 2);
+        QCOMPARE(service.nodeCount(), static_cast<size_t>(1));
+        
+        // Net effect: created and deleted within one batch is not reported
+        service.beginBatch();
+        service.beginBatch();
+        const QUuid transient = service.createNode(Vector3(5, 5, 5));
+        service.setNodePosition(ids[1], Vector3(9, 9, 9));
+        service.deleteNode(transient);
+        service.endBatch();
+        QCOMPARE(batchSpy.count(), 0);
+        service.endBatch();
+        QCOMPARE(batchSpy.count(), 1);
+        changes = batchSpy.takeFirst().at(0).value<ModelChangeSet>();
+        QVERIFY(changes.createdNodes.isEmpty());
+        QVERIFY(changes.deletedNodes.isEmpty());
+        QCOMPARE(changes.updatedNodes.size(), 1);
+        QVERIFY(changes.updatedNodes.contains(ids[1]));
+    }
+    
+    void testTransactionSpansServices()
+    {
+        qRegisterMetaType<ModelChangeSet>();
+        InMemoryModelRepository repo;
+        NodeService nodeService(&repo);
+        BarService barService(&repo);
+        QSignalSpy nodeBatchSpy(&nodeService, &NodeService::modelBatchChanged);
+        QSignalSpy barBatchSpy(&barService, &BarService::modelBatchChanged);
+        QSignalSpy barCreatedSpy(&barService, &BarService::barCreated);
+        
+        {
+            ModelTransaction transaction(&nodeService, &barService);
+            QUuid previous = nodeService.createNode(Vector3(0, 0, 0));
+            for (int i = 1; i <= 10; ++i) {
+                QUuid next = nodeService.createNode(Vector3(i, 0, 0));
+                barService.createBar(previous, next);
+                previous = next;
+            }
+            QCOMPARE(nodeBatchSpy.count(), 0);
+        } // committed on scope exit
+        
+        QCOMPARE(barCreatedSpy.count(), 0);
+        QCOMPARE(nodeBatchSpy.count() + barBatchSpy.count(), 1);
+        const auto changes = nodeBatchSpy.takeFirst().at(0).value<ModelChangeSet>();
+        QCOMPARE(changes.createdNodes.size(), 11);
+        QCOMPARE(changes.createdBars.size(), 10);
+        QCOMPARE(repo.barCount(), static_cast<size_t>(10));
+    }
+    
+    void testMergeCoincidentNodes()
+    {
+        qRegisterMetaType<ModelChangeSet>();
+        InMemoryModelRepository repo;
+        NodeService nodeService(&repo);
+        BarService barService(&repo);
+        
+        // a - b - c along x, with c' on top of c and b' within tolerance of b
+        const QUuid a = nodeService.createNode(Vector3(0, 0, 0));
+        const QUuid b = nodeService.createNode(Vector3(1, 0, 0));
+        const QUuid c = nodeService.createNode(Vector3(2, 0, 0));
+        const QUuid c2 = nodeService.createNode(Vector3(2, 0, 0));
+        const QUuid b2 = nodeService.createNode(Vector3(1, 0.5e-6, 0));
+        const QUuid far = nodeService.createNode(Vector3(1, 1e-3, 0));
+        nodeService.setNodeRestraints(c2, {true, true, true, false, false, false});
+        const QUuid ab = barService.createBar(a, b);
+        const QUuid bc2 = barService.createBar(b2, c2);
+        const QUuid cc2 = barService.createBar(c, c2); // collapses
+        const QUuid farBar = barService.createBar(far, c);
+        LoadCase dead(QUuid::createUuid(), 1, "Dead");
+        NodalLoad load(QUuid::createUuid(), dead.id(), c2, Vector3(0, 0, -1));
+        MemberLoad onCollapsed(QUuid::createUuid(), dead.id(), cc2, Vector3(0, 0, -2));
+        MemberLoad onKept(QUuid::createUuid(), dead.id(), bc2, Vector3(0, 0, -3));
+        repo.addLoadCase(dead);
+        repo.addNodalLoad(load);
+        repo.addMemberLoad(onCollapsed);
+        repo.addMemberLoad(onKept);
+        barService.setKPoint(cc2, Vector3(0, 0, 1));
+        
+        QSignalSpy batchSpy(&nodeService, &NodeService::modelBatchChanged);
+        const NodeMergeResult merge = nodeService.mergeCoincidentNodes();
+        
+        QCOMPARE(batchSpy.count(), 1);
+        QCOMPARE(repo.nodeCount(), static_cast<size_t>(4));
+        QVERIFY(!repo.findNodePtr(b2) && !repo.findNodePtr(c2));
+        QCOMPARE(merge.survivorOf.value(b2), b);
+        QCOMPARE(merge.survivorOf.value(c2), c);
+        QVERIFY(repo.findNode(c)->restraints()[2]);
+        QVERIFY(!repo.findNode(c)->restraints()[3]);
+        
+        QCOMPARE(repo.barCount(), static_cast<size_t>(3));
+        QVERIFY(!repo.findBarPtr(cc2));
+        QCOMPARE(repo.findBar(bc2)->startNodeId(), b);
+        QCOMPARE(repo.findBar(bc2)->endNodeId(), c);
+        QCOMPARE(repo.findBar(ab)->endNodeId(), b);
+        QCOMPARE(repo.findBar(farBar)->startNodeId(), far);
+        QCOMPARE(repo.barsAtNode(c).size(), static_cast<size_t>(2));
+        QCOMPARE(repo.findNodalLoadPtr(load.id())->nodeId(), c);
+        
+        // The collapsed bar's member load goes with it
+        QCOMPARE(merge.removedMemberLoads.size(), static_cast<size_t>(1));
+        QCOMPARE(merge.removedMemberLoads.front().id(), onCollapsed.id());
+        QVERIFY(!repo.findMemberLoadPtr(onCollapsed.id()));
+        QVERIFY(repo.memberLoadsOnBar(cc2).empty());
+        QCOMPARE(repo.memberLoads().size(), static_cast<size_t>(1));
+        QCOMPARE(repo.findMemberLoadPtr(onKept.id())->barId(), bc2);
+        QCOMPARE(merge.removedKPoints.size(), 1);
+        QVERIFY(merge.removedKPoints.contains(cc2));
+        
+        const auto changes = batchSpy.takeFirst().at(0).value<ModelChangeSet>();
+        QCOMPARE(changes.deletedNodes.size(), 2);
+        QVERIFY(changes.updatedNodes.contains(c));
+        QVERIFY(changes.deletedBars.contains(cc2));
+        QVERIFY(changes.updatedBars.contains(bc2));
+        
+        // Nothing left to merge
+        QVERIFY(nodeService.mergeCoincidentNodes().isEmpty());
+        
+        nodeService.revertMerge(merge);
+        QCOMPARE(batchSpy.count(), 2);
+        QCOMPARE(repo.nodeCount(), static_cast<size_t>(6));
+        QCOMPARE(repo.barCount(), static_cast<size_t>(4));
+        QCOMPARE(repo.findBar(bc2)->startNodeId(), b2);
+        QCOMPARE(repo.findBar(cc2)->endNodeId(), c2);
+        QVERIFY(!repo.findNode(c)->hasRestraints());
+        QVERIFY(repo.findNode(c2)->restraints()[0]);
+        QCOMPARE(repo.findNodalLoadPtr(load.id())->nodeId(), c2);
+        QCOMPARE(repo.findMemberLoadPtr(onCollapsed.id())->barId(), cc2);
+        QCOMPARE(repo.memberLoadsOnBar(cc2).size(), static_cast<size_t>(1));
+        QCOMPARE(repo.memberLoads().size(), static_cast<size_t>(2));
+        QVERIFY(repo.barKPoint(repo.barHandle(cc2)));
+        QCOMPARE(repo.barKPoint(repo.barHandle(cc2))->z(), 1.0);
+        
+        // A larger tolerance reaches the offset node too
+        const NodeMergeResult wide = nodeService.mergeCoincidentNodes(1e-2);
+        QCOMPARE(wide.survivorOf.value(far), b);
+        QCOMPARE(repo.nodeCount(), static_cast<size_t>(3));
+    }
+    
+    void benchmarkMergeCoincidentNodes()
+    {
+        // 250k grid points, each duplicated within tolerance (500k nodes),
+        // chained by 250k bars that all need remapping. Pairwise comparison
+        // would take hours; the wall time of the grid-based merge is the
+        // reported result.
+        InMemoryModelRepository repo;
+        NodeService nodeService(&repo);
+        const int side = 500;
+        int externalId = 0;
+        QUuid previous;
+        for (int i = 0; i < side; ++i) {
+            for (int j = 0; j < side; ++j) {
+                Node original(QUuid::createUuid(), ++externalId, i * 0.5, j * 0.5, 0.0);
+                Node duplicate(QUuid::createUuid(), ++externalId, i * 0.5 + 1e-7, j * 0.5, 0.0);
+                repo.addNode(original);
+                repo.addNode(duplicate);
+                if (!previous.isNull()) {
+                    repo.addBar(Bar(QUuid::createUuid(), previous, duplicate.id()));
+                }
+                previous = duplicate.id();
+            }
+        }
+
+        QElapsedTimer timer;
+        timer.start();
+        const NodeMergeResult merge = nodeService.mergeCoincidentNodes();
+        const qint64 elapsed = timer.elapsed();
+
+        QCOMPARE(merge.removedNodes.size(), static_cast<size_t>(side * side));
+        QCOMPARE(merge.remappedBars.size(), static_cast<size_t>(side * side - 1));
+        QCOMPARE(repo.nodeCount(), static_cast<size_t>(side * side));
+        QTest::setBenchmarkResult(double(elapsed), QTest::WalltimeMilliseconds);
+    }
 };
 
 /**
@@ -364,8 +1587,54 @@ private slots:
         QVERIFY(barService.setKPoint(barId, kp));
         
         auto bar = barService.findBar(barId);
-        QVERIFY(bar->hasKPoint());
+        const Vector3 *stored = repo.barKPoint(repo.barHandle(barId));
+        QVERIFY(stored);
+        QCOMPARE(stored->y(), 1.0);
         QVERIFY(bar->isLCSDirty());
+        
+        QVERIFY(barService.clearKPoint(barId));
+        QVERIFY(!repo.barKPoint(repo.barHandle(barId)));
+        QVERIFY(!barService.setKPoint(QUuid::createUuid(), kp));
+    }
+    
+    void testKPointsFollowBarRemovals()
+    {
+        InMemoryModelRepository repo;
+        Node a(QUuid::createUuid(), 1, 0, 0, 0);
+        Node b(QUuid::createUuid(), 2, 1, 0, 0);
+        repo.addNode(a);
+        repo.addNode(b);
+        std::vector<QUuid> barIds;
+        for (int i = 0; i < 5; ++i) {
+            barIds.push_back(QUuid::createUuid());
+            repo.addBar(Bar(barIds.back(), a.id(), b.id()));
+        }
+        repo.setBarKPoint(barIds[0], Vector3(0, 0, 1));
+        repo.setBarKPoint(barIds[3], Vector3(0, 3, 0));
+        repo.setBarKPoint(barIds[4], Vector3(0, 4, 0));
+        const auto kPointOf = [&repo](const QUuid &id) { return repo.barKPoint(repo.barHandle(id)); };
+        
+        // Swap-remove moves the last bar, and its K-point, into slot 0
+        QVERIFY(repo.removeBar(barIds[0]));
+        QVERIFY(kPointOf(barIds[4]));
+        QCOMPARE(kPointOf(barIds[4])->y(), 4.0);
+        QVERIFY(!kPointOf(barIds[1]));
+        
+        // Compaction shifts the survivors down
+        QCOMPARE(repo.removeBars({barIds[1], barIds[2]}), size_t(2));
+        QVERIFY(kPointOf(barIds[3]));
+        QCOMPARE(kPointOf(barIds[3])->y(), 3.0);
+        QCOMPARE(kPointOf(barIds[4])->y(), 4.0);
+        
+        // A bar re-added under a removed bar's slot starts without one
+        const QUuid fresh = QUuid::createUuid();
+        repo.addBar(Bar(fresh, a.id(), b.id()));
+        QVERIFY(!kPointOf(fresh));
+        QVERIFY(!repo.barKPoint(BarHandle()));
+        
+        repo.clearBars();
+        repo.addBar(Bar(barIds[3], a.id(), b.id()));
+        QVERIFY(!kPointOf(barIds[3]));
     }
 };
 
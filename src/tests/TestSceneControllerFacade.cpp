@@ -3,8 +3,39 @@
 #include "../app/InMemoryModelRepository.h"
 #include "../app/NodeService.h"
 #include "../app/BarService.h"
+#include "../app/ModelTransaction.h"
 #include "MockSceneRenderer.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+// Counts every heap allocation in the test binary so benchmarks can report
+// allocations per facade refresh.
+std::atomic<size_t> g_allocationCount{0};
+}
+
+void *operator new(std::size_t size)
+{
+    ++g_allocationCount;
+    if (void *ptr = std::malloc(size ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
 using namespace Structura::App;
 using namespace Structura::Core::Model;
 using namespace Structura::Tests;
@@ -44,6 +75,11 @@ private slots:
     void testBarUpdatedTriggersUpdate();
     void testBarDeletedClearsSelection();
     
+    // Batched mutations
+    void testTransactionRefreshesOnce();
+    void testBulkDeleteClearsSelection();
+    void testRefreshReusesUnchangedChunks();
+    
     // Selection management
     void testSetSelectedNodes();
     void testSetSelectedBars();
@@ -57,6 +93,7 @@ private slots:
     void testHighlightingOneTypeClearsOthers();
     
     // Grid operations
+    void testRefreshNodePositions();
     void testUpdateGridLines();
     void testShowHideGridGhostLine();
     
@@ -73,6 +110,10 @@ private slots:
     // Signal emission
     void testModelChangedSignal();
     void testSelectionChangedSignal();
+    
+    // Allocation benchmarks
+    void benchmarkRefreshAllocations_data();
+    void benchmarkRefreshAllocations();
 
 private:
     InMemoryModelRepository* m_repository;
@@ -177,13 +218,15 @@ void TestSceneControllerFacade::testNodeDeletedClearsSelection()
     selection.insert(node1);
     selection.insert(node2);
     m_facade->setSelectedNodes(selection);
+    const auto handle1 = m_repository->nodeHandle(node1);
+    const auto handle2 = m_repository->nodeHandle(node2);
     
     m_nodeService->deleteNode(node1);
     
     // Verify node1 was removed from selection
-    const auto& lastSelection = m_mockRenderer->lastSelectedNodeIds();
-    QVERIFY(!lastSelection.contains(node1));
-    QVERIFY(lastSelection.contains(node2));
+    const auto& lastSelection = m_mockRenderer->lastSelectedNodes();
+    QVERIFY(std::find(lastSelection.begin(), lastSelection.end(), handle1) == lastSelection.end());
+    QVERIFY(std::find(lastSelection.begin(), lastSelection.end(), handle2) != lastSelection.end());
 }
 
 void TestSceneControllerFacade::testNodeDeletedClearsHighlight()
@@ -195,8 +238,8 @@ void TestSceneControllerFacade::testNodeDeletedClearsHighlight()
     
     m_nodeService->deleteNode(nodeId);
     
-    // After deletion, highlight should be cleared (null UUID)
-    QVERIFY(m_mockRenderer->lastHighlightedNodeId().isNull());
+    // After deletion, highlight should be cleared (invalid handle)
+    QVERIFY(!m_mockRenderer->lastHighlightedNode().isValid());
 }
 
 void TestSceneControllerFacade::testBarCreatedTriggersUpdate()
@@ -254,12 +297,100 @@ void TestSceneControllerFacade::testBarDeletedClearsSelection()
     selection.insert(bar1);
     selection.insert(bar2);
     m_facade->setSelectedBars(selection);
+    const auto handle1 = m_repository->barHandle(bar1);
+    const auto handle2 = m_repository->barHandle(bar2);
     
     m_barService->deleteBar(bar1);
     
-    const auto& lastSelection = m_mockRenderer->lastSelectedBarIds();
-    QVERIFY(!lastSelection.contains(bar1));
-    QVERIFY(lastSelection.contains(bar2));
+    const auto& lastSelection = m_mockRenderer->lastSelectedBars();
+    QVERIFY(std::find(lastSelection.begin(), lastSelection.end(), handle1) == lastSelection.end());
+    QVERIFY(std::find(lastSelection.begin(), lastSelection.end(), handle2) != lastSelection.end());
+}
+
+void TestSceneControllerFacade::testTransactionRefreshesOnce()
+{
+    QSignalSpy spy(m_facade, &SceneControllerFacade::modelChanged);
+    m_mockRenderer->reset();
+    
+    {
+        ModelTransaction transaction(m_nodeService, m_barService);
+        QUuid previous = m_nodeService->createNode(Vector3{0, 0, 0});
+        for (int i = 1; i < 100; ++i) {
+            QUuid next = m_nodeService->createNode(Vector3{double(i), 0, 0});
+            m_barService->createBar(previous, next);
+            previous = next;
+        }
+        transaction.commit();
+    }
+    
+    QCOMPARE(m_mockRenderer->renderSnapshotCallCount(), 1);
+    QCOMPARE(m_mockRenderer->updateNodesCallCount(), 0);
+    QCOMPARE(m_mockRenderer->updateBarsCallCount(), 0);
+    QCOMPARE(m_mockRenderer->lastSnapshot().nodes.size(), size_t(100));
+    QCOMPARE(m_mockRenderer->lastSnapshot().bars.size(), size_t(99));
+    QCOMPARE(spy.count(), 1);
+}
+
+void TestSceneControllerFacade::testBulkDeleteClearsSelection()
+{
+    auto node1 = m_nodeService->createNode(Vector3{1, 2, 3});
+    auto node2 = m_nodeService->createNode(Vector3{4, 5, 6});
+    
+    QSet<QUuid> selection;
+    selection.insert(node1);
+    selection.insert(node2);
+    m_facade->setSelectedNodes(selection);
+    m_facade->highlightNode(node1);
+    m_mockRenderer->reset();
+    
+    m_nodeService->deleteNodes({node1});
+    
+    QCOMPARE(m_mockRenderer->renderSnapshotCallCount(), 1);
+    const auto& nodes = m_mockRenderer->lastSnapshot().nodes;
+    QCOMPARE(nodes.size(), size_t(1));
+    QVERIFY(nodes[0].isSelected);
+    QVERIFY(!nodes[0].isHighlighted);
+}
+
+void TestSceneControllerFacade::testRefreshReusesUnchangedChunks()
+{
+    // Three snapshot chunks of nodes
+    std::vector<QUuid> ids;
+    for (int i = 0; i < 1500; ++i) {
+        Node node(QUuid::createUuid(), i + 1, i, 0.0, 0.0);
+        m_repository->addNode(node);
+        ids.push_back(node.id());
+    }
+    m_facade->refreshAll();
+    QCOMPARE(m_mockRenderer->lastSnapshot().nodes.size(), size_t(1500));
+    
+    // An unchanged model is handed over again without converting anything
+    const size_t before = g_allocationCount.load();
+    m_facade->refreshAll();
+    QCOMPARE(g_allocationCount.load() - before, size_t(0));
+    
+    // An edit in the last chunk is picked up, the other chunks are kept
+    m_nodeService->setNodePosition(ids[1200], Vector3{-1, 2, 3});
+    m_facade->refreshAll();
+    const auto& nodes = m_mockRenderer->lastSnapshot().nodes;
+    QCOMPARE(nodes[1200].x, -1.0);
+    QCOMPARE(nodes[1200].y, 2.0);
+    QCOMPARE(nodes[0].id, ids[0]);
+    QCOMPARE(nodes[700].x, 700.0);
+    
+    // Selection and highlight reach unchanged chunks too
+    QSet<QUuid> selection;
+    selection.insert(ids[5]);
+    m_facade->setSelectedNodes(selection);
+    m_facade->highlightNode(ids[600]);
+    m_facade->refreshAll();
+    QVERIFY(m_mockRenderer->lastSnapshot().nodes[5].isSelected);
+    QVERIFY(m_mockRenderer->lastSnapshot().nodes[600].isHighlighted);
+    QVERIFY(!m_mockRenderer->lastSnapshot().nodes[1200].isSelected);
+    
+    m_facade->clearSelection();
+    m_facade->refreshAll();
+    QVERIFY(!m_mockRenderer->lastSnapshot().nodes[5].isSelected);
 }
 
 void TestSceneControllerFacade::testSetSelectedNodes()
@@ -274,9 +405,10 @@ void TestSceneControllerFacade::testSetSelectedNodes()
     m_facade->setSelectedNodes(selection);
     
     QVERIFY(m_mockRenderer->wasSetSelectedNodesCalled());
-    QCOMPARE(m_mockRenderer->lastSelectedNodeIds().size(), 2);
-    QVERIFY(m_mockRenderer->lastSelectedNodeIds().contains(node1));
-    QVERIFY(m_mockRenderer->lastSelectedNodeIds().contains(node2));
+    const auto& lastSelection = m_mockRenderer->lastSelectedNodes();
+    QCOMPARE(lastSelection.size(), size_t(2));
+    QVERIFY(std::find(lastSelection.begin(), lastSelection.end(), m_repository->nodeHandle(node1)) != lastSelection.end());
+    QVERIFY(std::find(lastSelection.begin(), lastSelection.end(), m_repository->nodeHandle(node2)) != lastSelection.end());
 }
 
 void TestSceneControllerFacade::testSetSelectedBars()
@@ -291,8 +423,8 @@ void TestSceneControllerFacade::testSetSelectedBars()
     m_facade->setSelectedBars(selection);
     
     QVERIFY(m_mockRenderer->wasSetSelectedBarsCalled());
-    QCOMPARE(m_mockRenderer->lastSelectedBarIds().size(), 1);
-    QVERIFY(m_mockRenderer->lastSelectedBarIds().contains(bar1));
+    QCOMPARE(m_mockRenderer->lastSelectedBars().size(), size_t(1));
+    QCOMPARE(m_mockRenderer->lastSelectedBars().front(), m_repository->barHandle(bar1));
 }
 
 void TestSceneControllerFacade::testClearSelection()
@@ -309,8 +441,8 @@ void TestSceneControllerFacade::testClearSelection()
     
     QVERIFY(m_mockRenderer->wasSetSelectedNodesCalled());
     QVERIFY(m_mockRenderer->wasSetSelectedBarsCalled());
-    QCOMPARE(m_mockRenderer->lastSelectedNodeIds().size(), 0);
-    QCOMPARE(m_mockRenderer->lastSelectedBarIds().size(), 0);
+    QCOMPARE(m_mockRenderer->lastSelectedNodes().size(), size_t(0));
+    QCOMPARE(m_mockRenderer->lastSelectedBars().size(), size_t(0));
 }
 
 void TestSceneControllerFacade::testSelectionPersistsAcrossUpdates()
@@ -346,7 +478,7 @@ void TestSceneControllerFacade::testHighlightNode()
     m_facade->highlightNode(nodeId);
     
     QVERIFY(m_mockRenderer->wasHighlightNodeCalled());
-    QCOMPARE(m_mockRenderer->lastHighlightedNodeId(), nodeId);
+    QCOMPARE(m_mockRenderer->lastHighlightedNode(), m_repository->nodeHandle(nodeId));
 }
 
 void TestSceneControllerFacade::testHighlightGridLine()
@@ -369,7 +501,7 @@ void TestSceneControllerFacade::testClearHighlight()
     m_facade->clearHighlight();
     
     QVERIFY(m_mockRenderer->wasHighlightNodeCalled());
-    QVERIFY(m_mockRenderer->lastHighlightedNodeId().isNull());
+    QVERIFY(!m_mockRenderer->lastHighlightedNode().isValid());
 }
 
 void TestSceneControllerFacade::testHighlightingOneTypeClearsOthers()
@@ -379,14 +511,29 @@ void TestSceneControllerFacade::testHighlightingOneTypeClearsOthers()
     
     // Highlight node first
     m_facade->highlightNode(nodeId);
-    QCOMPARE(m_mockRenderer->lastHighlightedNodeId(), nodeId);
+    QCOMPARE(m_mockRenderer->lastHighlightedNode(), m_repository->nodeHandle(nodeId));
     
     // Highlight grid line should clear node highlight
     m_facade->highlightGridLine(lineId);
-    QVERIFY(m_mockRenderer->lastHighlightedNodeId().isNull());
+    QVERIFY(!m_mockRenderer->lastHighlightedNode().isValid());
     QCOMPARE(m_mockRenderer->lastHighlightedGridLineId(), lineId);
 }
 
+void TestSceneControllerFacade::testRefreshNodePositions()
+{
+    m_nodeService->createNode(Vector3{1, 2, 3});
+    auto nodeId = m_nodeService->createNode(Vector3{4, 5, 6});
+    m_nodeService->setNodePosition(nodeId, Vector3{7, 8, 9});
+    m_mockRenderer->reset();
+    
+    m_facade->refreshNodePositions();
+    
+    QCOMPARE(m_mockRenderer->updateNodePositionsCallCount(), 1);
+    QVERIFY(!m_mockRenderer->wasUpdateNodesCalled());
+    const std::vector<double> expected{1, 2, 3, 7, 8, 9};
+    QCOMPARE(m_mockRenderer->lastNodeCoordinates(), expected);
+}
+
 void TestSceneControllerFacade::testUpdateGridLines()
 {
     std::vector<GridLine> gridLines;
@@ -399,6 +546,15 @@ void TestSceneControllerFacade::testUpdateGridLines()
     
     QVERIFY(m_mockRenderer->wasUpdateGridLinesCalled());
     QCOMPARE(m_mockRenderer->lastGridLineCount(), 1);
+    
+    // The lines are the repository's, so a full refresh draws them too
+    QCOMPARE(m_repository->gridLineCount(), size_t(1));
+    m_facade->refreshAll();
+    QCOMPARE(m_mockRenderer->lastSnapshot().gridLines.size(), size_t(1));
+    QCOMPARE(m_mockRenderer->lastSnapshot().gridLines[0].id, line1.id());
+    
+    m_facade->updateGridLines({});
+    QCOMPARE(m_repository->gridLineCount(), size_t(0));
 }
 
 void TestSceneControllerFacade::testShowHideGridGhostLine()
@@ -493,5 +649,50 @@ void TestSceneControllerFacade::testSelectionChangedSignal()
     QCOMPARE(spy.count(), 1);
 }
 
+void TestSceneControllerFacade::benchmarkRefreshAllocations_data()
+{
+    QTest::addColumn<int>("nodeCount");
+    QTest::addColumn<bool>("copying");
+    QTest::newRow("1k nodes, allNodes()/allBars() copies") << 1000 << true;
+    QTest::newRow("1k nodes, repository views") << 1000 << false;
+    QTest::newRow("10k nodes, allNodes()/allBars() copies") << 10000 << true;
+    QTest::newRow("10k nodes, repository views") << 10000 << false;
+}
+
+void TestSceneControllerFacade::benchmarkRefreshAllocations()
+{
+    // Reports heap allocations per refresh. The "copies" rows reproduce the
+    // read path the facade used before repository views existed; the
+    // difference to the "views" rows is what each refresh no longer pays.
+    QFETCH(int, nodeCount);
+    QFETCH(bool, copying);
+    
+    QUuid previous;
+    for (int i = 0; i < nodeCount; ++i) {
+        Node node(QUuid::createUuid(), i + 1, i, 0.0, 0.0);
+        m_repository->addNode(node);
+        if (!previous.isNull()) {
+            Bar bar(QUuid::createUuid(), previous, node.id());
+            bar.setExternalId(i);
+            m_repository->addBar(bar);
+        }
+        previous = node.id();
+    }
+    
+    size_t allocations = 0;
+    QBENCHMARK {
+        const size_t before = g_allocationCount.load();
+        if (copying) {
+            const auto nodes = m_repository->allNodes();
+            const auto bars = m_repository->allBars();
+            QCOMPARE(nodes.size() + bars.size(), size_t(2 * nodeCount - 1));
+        }
+        m_facade->refreshAll();
+        allocations = g_allocationCount.load() - before;
+    }
+    QTest::setBenchmarkResult(static_cast<qreal>(allocations), QTest::Events);
+    QCOMPARE(m_mockRenderer->lastNodeCount(), nodeCount);
+}
+
 QTEST_MAIN(TestSceneControllerFacade)
 #include "TestSceneControllerFacade.moc"
@@ -17,9 +17,6 @@ MainWindowPresenter::MainWindowPresenter(const Dependencies &deps, QObject *pare
     , m_sections(deps.sections)
     , m_lastMaterialId(deps.lastMaterialId)
     , m_lastSectionId(deps.lastSectionId)
-    , m_supports(deps.supports)
-    , m_nodalLoads(deps.nodalLoads)
-    , m_memberLoads(deps.memberLoads)
     , m_lastNodalPreset(deps.lastNodalPreset)
     , m_lastDistributedPreset(deps.lastDistributedPreset)
 {
@@ -42,29 +42,6 @@ public:
         double j {0.0};
     };
 
-    struct NodeSupport {
-        int nodeId {0};
-        bool restraints[6] {false, false, false, false, false, false};
-    };
-
-    struct NodalLoad {
-        int nodeId {0};
-        double fx {0.0};
-        double fy {0.0};
-        double fz {0.0};
-        double mx {0.0};
-        double my {0.0};
-        double mz {0.0};
-    };
-
-    struct MemberLoad {
-        int memberId {0};
-        QString system;
-        double qx {0.0};
-        double qy {0.0};
-        double qz {0.0};
-    };
-
     struct NodalLoadPreset {
         double fx {0.0};
         double fy {0.0};
@@ -89,9 +66,6 @@ public:
         QVector<SectionInfo> *sections {nullptr};
         QUuid *lastMaterialId {nullptr};
         QUuid *lastSectionId {nullptr};
-        QVector<NodeSupport> *supports {nullptr};
-        QVector<NodalLoad> *nodalLoads {nullptr};
-        QVector<MemberLoad> *memberLoads {nullptr};
         NodalLoadPreset *lastNodalPreset {nullptr};
         DistributedLoadPreset *lastDistributedPreset {nullptr};
     };
@@ -117,13 +91,6 @@ public:
     [[nodiscard]] const QUuid &lastSectionId() const noexcept { return *m_lastSectionId; }
     void setLastSectionId(const QUuid &id) noexcept { *m_lastSectionId = id; }
 
-    [[nodiscard]] QVector<NodeSupport> &supports() noexcept { return *m_supports; }
-    [[nodiscard]] const QVector<NodeSupport> &supports() const noexcept { return *m_supports; }
-    [[nodiscard]] QVector<NodalLoad> &nodalLoads() noexcept { return *m_nodalLoads; }
-    [[nodiscard]] const QVector<NodalLoad> &nodalLoads() const noexcept { return *m_nodalLoads; }
-    [[nodiscard]] QVector<MemberLoad> &memberLoads() noexcept { return *m_memberLoads; }
-    [[nodiscard]] const QVector<MemberLoad> &memberLoads() const noexcept { return *m_memberLoads; }
-
     [[nodiscard]] NodalLoadPreset &lastNodalPreset() noexcept { return *m_lastNodalPreset; }
     [[nodiscard]] const NodalLoadPreset &lastNodalPreset() const noexcept { return *m_lastNodalPreset; }
     [[nodiscard]] DistributedLoadPreset &lastDistributedPreset() noexcept { return *m_lastDistributedPreset; }
@@ -143,9 +110,6 @@ private:
     QUuid *m_lastMaterialId;
     QUuid *m_lastSectionId;
 
-    QVector<NodeSupport> *m_supports;
-    QVector<NodalLoad> *m_nodalLoads;
-    QVector<MemberLoad> *m_memberLoads;
     NodalLoadPreset *m_lastNodalPreset;
     DistributedLoadPreset *m_lastDistributedPreset;
 };
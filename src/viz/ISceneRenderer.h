@@ -1,7 +1,7 @@
 #pragma once
 
+#include "../core/model/EntityHandle.h"
 #include <QUuid>
-#include <QSet>
 #include <QVector>
 #include <array>
 #include <vector>
@@ -21,6 +21,7 @@ namespace Structura::Viz {
 struct ModelSnapshot {
     struct NodeData {
         QUuid id;
+        Structura::Model::NodeHandle handle;
         int externalId;
         double x, y, z;
         bool isSelected;
@@ -30,9 +31,10 @@ struct ModelSnapshot {
     
     struct BarData {
         QUuid id;
+        Structura::Model::BarHandle handle;
         int externalId;
-        QUuid startNodeId;
-        QUuid endNodeId;
+        Structura::Model::NodeHandle startNode;
+        Structura::Model::NodeHandle endNode;
         bool isSelected;
         std::optional<std::array<double, 3>> kPoint;
     };
@@ -120,6 +122,16 @@ public:
      */
     virtual void updateNodes(const std::vector<ModelSnapshot::NodeData> &nodes) = 0;
     
+    /**
+     * @brief Move the rendered nodes without rebuilding their visuals.
+     * @param coordinates Interleaved x,y,z per node, in the order of the last node list
+     * @param nodeCount Number of nodes in @p coordinates
+     * 
+     * Colors and selection state are kept. Ignored if @p nodeCount does not
+     * match the number of nodes currently rendered.
+     */
+    virtual void updateNodePositions(const double *coordinates, size_t nodeCount) = 0;
+    
     /**
      * @brief Update only bar visuals (color).
      * @param bars Bars to update
@@ -134,21 +146,21 @@ public:
     
     /**
      * @brief Highlight a specific node.
-     * @param nodeId UUID of node to highlight (null to clear)
+     * @param node Handle of the node to highlight (invalid to clear)
      */
-    virtual void highlightNode(const QUuid &nodeId) = 0;
+    virtual void highlightNode(Structura::Model::NodeHandle node) = 0;
     
     /**
      * @brief Set selected nodes.
-     * @param nodeIds Set of selected node UUIDs
+     * @param nodes Handles of the selected nodes; stale ones are ignored
      */
-    virtual void setSelectedNodes(const QSet<QUuid> &nodeIds) = 0;
+    virtual void setSelectedNodes(const std::vector<Structura::Model::NodeHandle> &nodes) = 0;
     
     /**
      * @brief Set selected bars.
-     * @param barIds Set of selected bar UUIDs
+     * @param bars Handles of the selected bars; stale ones are ignored
      */
-    virtual void setSelectedBars(const QSet<QUuid> &barIds) = 0;
+    virtual void setSelectedBars(const std::vector<Structura::Model::BarHandle> &bars) = 0;
     
     /**
      * @brief Highlight a grid line.
@@ -261,7 +261,12 @@ void VtkSceneRenderer::rebuildNodeGeometry(const std::vector<ModelSnapshot::Node
     m_points->Reset();
     m_vertices->Reset();
     m_pointColors->Reset();
-    m_nodeIndexById.clear();
+    m_nodeIndexBySlot.clear();
+    
+    // The snapshot carries the selection and highlight, so adopt them
+    m_highlightedNode = {};
+    m_selectedNodes.clear();
+    m_selectedNodeSet.clear();
     
     for (size_t i = 0; i < nodes.size(); ++i) {
         const auto &node = nodes[i];
@@ -278,7 +283,21 @@ void VtkSceneRenderer::rebuildNodeGeometry(const std::vector<ModelSnapshot::Node
         }
         
         m_pointColors->InsertNextTypedTuple(color);
-        m_nodeIndexById[node.id] = static_cast<int>(i);
+        
+        if (!node.handle.isValid()) {
+            continue;
+        }
+        if (node.handle.index() >= m_nodeIndexBySlot.size()) {
+            m_nodeIndexBySlot.resize(node.handle.index() + 1);
+        }
+        m_nodeIndexBySlot[node.handle.index()] = {node.handle, static_cast<int>(i)};
+        if (node.isHighlighted) {
+            m_highlightedNode = node.handle;
+        }
+        if (node.isSelected) {
+            m_selectedNodes.push_back(node.handle);
+            m_selectedNodeSet.insert(node.handle);
+        }
     }
     
     m_pointCloud->Modified();
@@ -291,19 +310,21 @@ void VtkSceneRenderer::rebuildBarGeometry(const std::vector<ModelSnapshot::BarDa
     barPoints->Reset();
     m_barLines->Reset();
     m_barColors->Reset();
-    m_barIndexById.clear();
+    m_barIndexBySlot.clear();
+    m_selectedBars.clear();
+    m_selectedBarSet.clear();
     
-    // Build node lookup
-    QHash<QUuid, const ModelSnapshot::NodeData*> nodeById;
-    for (const auto &node : nodes) {
-        nodeById[node.id] = &node;
-    }
+    // Bar ends resolve through the node slots filled for the same node list
+    const auto nodeAt = [&](Structura::Model::NodeHandle handle) -> const ModelSnapshot::NodeData * {
+        const int index = findNodeIndex(handle);
+        return index >= 0 && static_cast<size_t>(index) < nodes.size() ? &nodes[static_cast<size_t>(index)] : nullptr;
+    };
     
     for (size_t i = 0; i < bars.size(); ++i) {
         const auto &bar = bars[i];
         
-        auto startNode = nodeById.value(bar.startNodeId, nullptr);
-        auto endNode = nodeById.value(bar.endNodeId, nullptr);
+        const auto *startNode = nodeAt(bar.startNode);
+        const auto *endNode = nodeAt(bar.endNode);
         
         if (!startNode || !endNode) {
             continue; // Skip if nodes not found
@@ -313,13 +334,23 @@ void VtkSceneRenderer::rebuildBarGeometry(const std::vector<ModelSnapshot::BarDa
         vtkIdType p1 = barPoints->InsertNextPoint(endNode->x, endNode->y, endNode->z);
         
         vtkIdType lineIds[2] = {p0, p1};
-        m_barLines->InsertNextCell(2, lineIds);
+        const vtkIdType cellId = m_barLines->InsertNextCell(2, lineIds);
         
         // Determine color
         const unsigned char *color = bar.isSelected ? m_selectedBarColor : m_defaultBarColor;
         m_barColors->InsertNextTypedTuple(color);
         
-        m_barIndexById[bar.id] = static_cast<int>(i);
+        if (!bar.handle.isValid()) {
+            continue;
+        }
+        if (bar.handle.index() >= m_barIndexBySlot.size()) {
+            m_barIndexBySlot.resize(bar.handle.index() + 1);
+        }
+        m_barIndexBySlot[bar.handle.index()] = {bar.handle, static_cast<int>(cellId)};
+        if (bar.isSelected) {
+            m_selectedBars.push_back(bar.handle);
+            m_selectedBarSet.insert(bar.handle);
+        }
     }
     
     m_barData->Modified();
@@ -359,6 +390,30 @@ void VtkSceneRenderer::updateNodes(const std::vector<ModelSnapshot::NodeData> &n
     refresh();
 }
 
+void VtkSceneRenderer::updateNodePositions(const double *coordinates, size_t nodeCount)
+{
+    if (nodeCount != m_currentNodes.size()) {
+        return;
+    }
+    
+    // Points were inserted in node order, so point i is node i
+    for (size_t i = 0; i < nodeCount; ++i) {
+        const double *xyz = coordinates + 3 * i;
+        m_points->SetPoint(static_cast<vtkIdType>(i), xyz);
+        
+        auto &node = m_currentNodes[i];
+        node.x = xyz[0];
+        node.y = xyz[1];
+        node.z = xyz[2];
+    }
+    m_points->Modified();
+    m_pointCloud->Modified();
+    
+    // Bar end points are copies of node positions
+    rebuildBarGeometry(m_currentBars, m_currentNodes);
+    refresh();
+}
+
 void VtkSceneRenderer::updateBars(const std::vector<ModelSnapshot::BarData> &bars)
 {
     rebuildBarGeometry(bars, m_currentNodes);
@@ -373,47 +428,47 @@ void VtkSceneRenderer::updateGridLines(const std::vector<ModelSnapshot::GridLine
     refresh();
 }
 
-void VtkSceneRenderer::highlightNode(const QUuid &nodeId)
+void VtkSceneRenderer::highlightNode(Structura::Model::NodeHandle node)
 {
     // Clear previous highlight
-    if (!m_highlightedNodeId.isNull() && m_highlightedNodeId != nodeId) {
-        int prevIndex = findNodeIndex(m_highlightedNodeId);
+    if (m_highlightedNode.isValid() && m_highlightedNode != node) {
+        int prevIndex = findNodeIndex(m_highlightedNode);
         if (prevIndex >= 0) {
-            bool isSelected = m_selectedNodeIds.contains(m_highlightedNodeId);
+            bool isSelected = m_selectedNodeSet.contains(m_highlightedNode);
             const unsigned char *color = isSelected ? m_selectedNodeColor : m_defaultNodeColor;
             applyNodeColor(prevIndex, color);
         }
     }
     
-    m_highlightedNodeId = nodeId;
+    m_highlightedNode = node;
     
     // Apply new highlight
-    if (!nodeId.isNull()) {
-        int index = findNodeIndex(nodeId);
-        if (index >= 0) {
-            applyNodeColor(index, m_hoverNodeColor);
-        }
+    int index = findNodeIndex(node);
+    if (index >= 0) {
+        applyNodeColor(index, m_hoverNodeColor);
     }
     
     refresh();
 }
 
-void VtkSceneRenderer::setSelectedNodes(const QSet<QUuid> &nodeIds)
+void VtkSceneRenderer::setSelectedNodes(const std::vector<Structura::Model::NodeHandle> &nodes)
 {
     // Clear previous selection colors
-    for (const auto &id : m_selectedNodeIds) {
-        int index = findNodeIndex(id);
-        if (index >= 0 && id != m_highlightedNodeId) {
+    for (const auto &node : m_selectedNodes) {
+        int index = findNodeIndex(node);
+        if (index >= 0 && node != m_highlightedNode) {
             applyNodeColor(index, m_defaultNodeColor);
         }
     }
     
-    m_selectedNodeIds = nodeIds;
+    m_selectedNodes = nodes;
+    m_selectedNodeSet.clear();
     
     // Apply new selection colors
-    for (const auto &id : m_selectedNodeIds) {
-        int index = findNodeIndex(id);
-        if (index >= 0 && id != m_highlightedNodeId) {
+    for (const auto &node : m_selectedNodes) {
+        m_selectedNodeSet.insert(node);
+        int index = findNodeIndex(node);
+        if (index >= 0 && node != m_highlightedNode) {
             applyNodeColor(index, m_selectedNodeColor);
         }
     }
@@ -421,21 +476,23 @@ void VtkSceneRenderer::setSelectedNodes(const QSet<QUuid> &nodeIds)
     refresh();
 }
 
-void VtkSceneRenderer::setSelectedBars(const QSet<QUuid> &barIds)
+void VtkSceneRenderer::setSelectedBars(const std::vector<Structura::Model::BarHandle> &bars)
 {
     // Clear previous selection colors
-    for (const auto &id : m_selectedBarIds) {
-        int index = findBarIndex(id);
+    for (const auto &bar : m_selectedBars) {
+        int index = findBarIndex(bar);
         if (index >= 0) {
             applyBarColor(index, m_defaultBarColor);
         }
     }
     
-    m_selectedBarIds = barIds;
+    m_selectedBars = bars;
+    m_selectedBarSet.clear();
     
     // Apply new selection colors
-    for (const auto &id : m_selectedBarIds) {
-        int index = findBarIndex(id);
+    for (const auto &bar : m_selectedBars) {
+        m_selectedBarSet.insert(bar);
+        int index = findBarIndex(bar);
         if (index >= 0) {
             applyBarColor(index, m_selectedBarColor);
         }
@@ -560,14 +617,16 @@ void VtkSceneRenderer::clearAll()
     m_gridCells->Reset();
     m_gridColors->Reset();
     
-    m_nodeIndexById.clear();
-    m_barIndexById.clear();
+    m_nodeIndexBySlot.clear();
+    m_barIndexBySlot.clear();
     m_gridLineIndexById.clear();
     
-    m_highlightedNodeId = QUuid();
+    m_highlightedNode = {};
     m_highlightedGridLineId = QUuid();
-    m_selectedNodeIds.clear();
-    m_selectedBarIds.clear();
+    m_selectedNodes.clear();
+    m_selectedNodeSet.clear();
+    m_selectedBars.clear();
+    m_selectedBarSet.clear();
     
     refresh();
 }
@@ -760,14 +819,22 @@ void VtkSceneRenderer::applyGridLineColor(int lineIndex, const unsigned char col
     }
 }
 
-int VtkSceneRenderer::findNodeIndex(const QUuid &id) const
+int VtkSceneRenderer::findNodeIndex(Structura::Model::NodeHandle node) const
 {
-    return m_nodeIndexById.value(id, -1);
+    if (!node.isValid() || node.index() >= m_nodeIndexBySlot.size()) {
+        return -1;
+    }
+    const auto &entry = m_nodeIndexBySlot[node.index()];
+    return entry.handle == node ? entry.index : -1;
 }
 
-int VtkSceneRenderer::findBarIndex(const QUuid &id) const
+int VtkSceneRenderer::findBarIndex(Structura::Model::BarHandle bar) const
 {
-    return m_barIndexById.value(id, -1);
+    if (!bar.isValid() || bar.index() >= m_barIndexBySlot.size()) {
+        return -1;
+    }
+    const auto &entry = m_barIndexBySlot[bar.index()];
+    return entry.handle == bar ? entry.index : -1;
 }
 
 int VtkSceneRenderer::findGridLineIndex(const QUuid &id) const
@@ -46,11 +46,12 @@ public:
     void initialize(QVTKOpenGLNativeWidget *widget) override;
     void renderSnapshot(const ModelSnapshot &snapshot) override;
     void updateNodes(const std::vector<ModelSnapshot::NodeData> &nodes) override;
+    void updateNodePositions(const double *coordinates, size_t nodeCount) override;
     void updateBars(const std::vector<ModelSnapshot::BarData> &bars) override;
     void updateGridLines(const std::vector<ModelSnapshot::GridLineData> &gridLines) override;
-    void highlightNode(const QUuid &nodeId) override;
-    void setSelectedNodes(const QSet<QUuid> &nodeIds) override;
-    void setSelectedBars(const QSet<QUuid> &barIds) override;
+    void highlightNode(Structura::Model::NodeHandle node) override;
+    void setSelectedNodes(const std::vector<Structura::Model::NodeHandle> &nodes) override;
+    void setSelectedBars(const std::vector<Structura::Model::BarHandle> &bars) override;
     void highlightGridLine(const QUuid &lineId) override;
     void showGridGhostLine(int axis,
                           const std::array<double, 3> &startPoint,
@@ -93,8 +94,8 @@ private:
     void applyBarColor(int barIndex, const unsigned char color[3]);
     void applyGridLineColor(int lineIndex, const unsigned char color[3]);
     
-    int findNodeIndex(const QUuid &id) const;
-    int findBarIndex(const QUuid &id) const;
+    int findNodeIndex(Structura::Model::NodeHandle node) const;
+    int findBarIndex(Structura::Model::BarHandle bar) const;
     int findGridLineIndex(const QUuid &id) const;
     
     // VTK objects
@@ -158,15 +159,24 @@ private:
     std::vector<ModelSnapshot::BarData> m_currentBars;
     std::vector<ModelSnapshot::GridLineData> m_currentGridLines;
     
-    QHash<QUuid, int> m_nodeIndexById;
-    QHash<QUuid, int> m_barIndexById;
+    // Point of each rendered node and line cell of each rendered bar, by
+    // handle slot. The stored handle turns lookups with a stale one into misses.
+    template <typename Entity>
+    struct SlotEntry {
+        Structura::Model::EntityHandle<Entity> handle;
+        int index {-1};
+    };
+    std::vector<SlotEntry<Structura::Model::Node>> m_nodeIndexBySlot;
+    std::vector<SlotEntry<Structura::Model::Bar>> m_barIndexBySlot;
     QHash<QUuid, int> m_gridLineIndexById;
     QHash<vtkIdType, int> m_gridCellToLineIndex;
     
-    QUuid m_highlightedNodeId;
+    Structura::Model::NodeHandle m_highlightedNode;
     QUuid m_highlightedGridLineId;
-    QSet<QUuid> m_selectedNodeIds;
-    QSet<QUuid> m_selectedBarIds;
+    std::vector<Structura::Model::NodeHandle> m_selectedNodes;
+    Structura::Model::EntityHandleSet<Structura::Model::Node> m_selectedNodeSet;
+    std::vector<Structura::Model::BarHandle> m_selectedBars;
+    Structura::Model::EntityHandleSet<Structura::Model::Bar> m_selectedBarSet;
     
     // Colors
     unsigned char m_defaultNodeColor[3] {228, 74, 25};